@@ -119,6 +119,7 @@
 #include <nnstreamer_log.h>
 #include <nnstreamer_util.h>
 #include "tensordecutil.h"
+#include "tensordecnms.h"
 
 void init_bb (void) __attribute__((constructor));
 void fini_bb (void) __attribute__((destructor));
@@ -1471,8 +1472,7 @@ update_centroids (void **pdata, GArray * boxes)
  */
 #define _get_object_i_mobilenet_ssd(bb, index, total_labels, boxprior, boxinputptr, detinputptr, result) \
   do { \
-    unsigned int c; \
-    gfloat highscore = -FLT_MAX; \
+    int c; \
     properties_MOBILENET_SSD *data = &bb->mobilenet_ssd; \
     float sigmoid_threshold = data->sigmoid_threshold; \
     float y_scale = data->params[MOBILENET_SSD_PARAMS_Y_SCALE_IDX]; \
@@ -1480,29 +1480,30 @@ update_centroids (void **pdata, GArray * boxes)
     float h_scale = data->params[MOBILENET_SSD_PARAMS_H_SCALE_IDX]; \
     float w_scale = data->params[MOBILENET_SSD_PARAMS_W_SCALE_IDX]; \
     result->valid = FALSE; \
-    for (c = 1; c < total_labels; c++) { \
-      if (detinputptr[c] >= sigmoid_threshold) { \
-        gfloat score = _expit (detinputptr[c]); \
-        float ycenter = boxinputptr[0] / y_scale * boxprior[2][index] + boxprior[0][index]; \
-        float xcenter = boxinputptr[1] / x_scale * boxprior[3][index] + boxprior[1][index]; \
-        float h = (float) expf (boxinputptr[2] / h_scale) * boxprior[2][index]; \
-        float w = (float) expf (boxinputptr[3] / w_scale) * boxprior[3][index]; \
-        float ymin = ycenter - h / 2.f; \
-        float xmin = xcenter - w / 2.f; \
-        int x = xmin * bb->i_width; \
-        int y = ymin * bb->i_height; \
-        int width = w * bb->i_width; \
-        int height = h * bb->i_height; \
-        if (highscore < score) { \
-          result->class_id = c; \
-          result->x = MAX (0, x); \
-          result->y = MAX (0, y); \
-          result->width = width; \
-          result->height = height; \
-          result->prob = score; \
-          result->valid = TRUE; \
-        } \
-      } \
+    /* The last class over the threshold is taken. Find it from the end, and get the box only once. */ \
+    for (c = (int) (total_labels) - 1; c >= 1; c--) { \
+      if (detinputptr[c] >= sigmoid_threshold) \
+        break; \
+    } \
+    if (c >= 1) { \
+      gfloat score = _expit (detinputptr[c]); \
+      float ycenter = boxinputptr[0] / y_scale * boxprior[2][index] + boxprior[0][index]; \
+      float xcenter = boxinputptr[1] / x_scale * boxprior[3][index] + boxprior[1][index]; \
+      float h = (float) expf (boxinputptr[2] / h_scale) * boxprior[2][index]; \
+      float w = (float) expf (boxinputptr[3] / w_scale) * boxprior[3][index]; \
+      float ymin = ycenter - h / 2.f; \
+      float xmin = xcenter - w / 2.f; \
+      int x = xmin * bb->i_width; \
+      int y = ymin * bb->i_height; \
+      int width = w * bb->i_width; \
+      int height = h * bb->i_height; \
+      result->class_id = c; \
+      result->x = MAX (0, x); \
+      result->y = MAX (0, y); \
+      result->width = width; \
+      result->height = height; \
+      result->prob = score; \
+      result->valid = TRUE; \
     } \
   } while (0);
 
@@ -1541,76 +1542,47 @@ update_centroids (void **pdata, GArray * boxes)
   _get_objects_mobilenet_ssd (bdata, type, typename, (bdata->mobilenet_ssd.box_priors), (boxes->data), (detections->data), config, results)
 
 /**
- * @brief Compare Function for g_array_sort with detectedObject.
- */
-static gint
-compare_detection (gconstpointer _a, gconstpointer _b)
-{
-  const detectedObject *a = _a;
-  const detectedObject *b = _b;
-
-  /* Larger comes first */
-  return (a->prob > b->prob) ? -1 : ((a->prob == b->prob) ? 0 : 1);
-}
-
-/**
- * @brief Calculate the intersected surface
- */
-static gfloat
-iou (detectedObject * a, detectedObject * b)
-{
-  int x1 = MAX (a->x, b->x);
-  int y1 = MAX (a->y, b->y);
-  int x2 = MIN (a->x + a->width, b->x + b->width);
-  int y2 = MIN (a->y + a->height, b->y + b->height);
-  int w = MAX (0, (x2 - x1 + 1));
-  int h = MAX (0, (y2 - y1 + 1));
-  float inter = w * h;
-  float areaA = a->width * a->height;
-  float areaB = b->width * b->height;
-  float o = inter / (areaA + areaB - inter);
-  return (o >= 0) ? o : 0;
-}
-
-/**
- * @brief Apply NMS to the given results (objects[MOBILENET_SSD_DETECTION_MAX])
- * @param[in/out] results The results to be filtered with nms
+ * @brief Apply NMS to the given results
+ * @param[in/out] results The results to be filtered with nms, sorted in the descending order of score
  */
 static void
 nms (GArray * results, gfloat threshold)
 {
-  guint boxes_size;
-  guint i, j;
+  nms_boxes_t boxes;
+  detectedObject *objects, *kept;
+  guint *index, *keep;
+  guint i, num_kept;
 
-  boxes_size = results->len;
-  if (boxes_size == 0U)
+  if (results->len == 0U)
     return;
 
-  g_array_sort (results, compare_detection);
+  objects = (detectedObject *) results->data;
+  nms_boxes_init (&boxes, results->len);
+  index = g_new (guint, results->len);
 
-  for (i = 0; i < boxes_size; i++) {
-    detectedObject *a = &g_array_index (results, detectedObject, i);
+  /* Invalid objects are not added, and removed from the results. */
+  for (i = 0; i < results->len; i++) {
+    detectedObject *a = &objects[i];
     if (a->valid == TRUE) {
-      for (j = i + 1; j < boxes_size; j++) {
-        detectedObject *b = &g_array_index (results, detectedObject, j);
-        if (b->valid == TRUE) {
-          if (iou (a, b) > threshold) {
-            b->valid = FALSE;
-          }
-        }
-      }
+      index[boxes.len] = i;
+      nms_boxes_add (&boxes, a->x, a->y, a->width, a->height, a->prob, 0);
     }
   }
 
-  i = 0;
-  do {
-    detectedObject *a = &g_array_index (results, detectedObject, i);
-    if (a->valid == FALSE)
-      g_array_remove_index (results, i);
-    else
-      i++;
-  } while (i < results->len);
+  keep = g_new (guint, MAX (boxes.len, 1U));
+  num_kept = nms_boxes_run (&boxes, threshold, keep);
+
+  /* Compact the kept objects in a single pass. */
+  kept = g_new (detectedObject, MAX (num_kept, 1U));
+  for (i = 0; i < num_kept; i++)
+    kept[i] = objects[index[keep[i]]];
+  memcpy (objects, kept, sizeof (detectedObject) * num_kept);
+  g_array_set_size (results, num_kept);
 
+  g_free (kept);
+  g_free (keep);
+  g_free (index);
+  nms_boxes_free (&boxes);
 }
 
 /**
@@ -1733,6 +1705,11 @@ nms (GArray * results, gfloat threshold)
     guint i_height_ = bb->i_height; \
     int num_ = bb->max_detection; \
     size_t boxbpi_ = config->info.info[0].dimension[0]; \
+    gdouble th_ = data->min_score_threshold; \
+    /* Sigmoid is monotonic, reject the raw score under the logit of threshold (with a margin for the rounding) before exp. */ \
+    gfloat raw_th_ = (th_ > 0.0 && th_ < 1.0) ? (gfloat) (log (th_ / (1.0 - th_)) - 0.01) : -G_MAXFLOAT; \
+    if (raw_th_ <= -100.0f) \
+      raw_th_ = -G_MAXFLOAT; \
     results = g_array_sized_new (FALSE, TRUE, sizeof (detectedObject), num_); \
     for (d_ = 0; d_ < num_; d_++) { \
       gfloat y_center, x_center, h, w; \
@@ -1742,6 +1719,8 @@ nms (GArray * results, gfloat threshold)
       gfloat score = (gfloat)scores_[d_]; \
       _type * box = boxes_ + boxbpi_ * d_; \
       anchor * a = &g_array_index (data->anchors, anchor, d_); \
+      if (score < raw_th_) \
+        continue; \
       score = MAX(score, -100.0f); \
       score = MIN(score, 100.0f); \
       score = 1.0f / (1.0f + exp (-score)); \
@@ -1773,6 +1752,108 @@ nms (GArray * results, gfloat threshold)
 #define _get_objects_mp_palm_detection_(type, typename) \
   _get_objects_mp_palm_detection (bdata, data, type, typename, (detections->data), (boxes->data), config, results)
 
+/**
+ * @brief Number of lanes to find the max class confidence, the loop over the lanes can be vectorized.
+ */
+#define YOLO_MAX_LANES (8)
+
+/**
+ * @brief Get the candidates over the confidence threshold for YOLOv5 and YOLOv8 model
+ * @param[in] bdata The bounding-box internal data.
+ * @param[in] boxinput Input Tensor Data, boxinput[max_detection][num_info + total_labels]
+ * @param[in] num_info The number of box info before the class confidences. YOLOv5 has the objectness at index 4.
+ * @return The candidates (GArray with detectedObject)
+ */
+static GArray *
+_get_objects_yolo (bounding_boxes * bdata, const float *boxinput,
+    const int num_info)
+{
+  const int num_boxes = bdata->max_detection;
+  const int num_classes = bdata->labeldata.total_labels;
+  const int stride = num_info + num_classes;
+  const gboolean has_objectness = (num_info == YOLOV5_DETECTION_NUM_INFO);
+  const gfloat threshold = bdata->yolo_pp.conf_threshold;
+  const int is_output_scaled = bdata->yolo_pp.scaled_output;
+  GArray *results;
+  detectedObject *objects;
+  guint num = 0;
+  int bIdx, cIdx, l;
+
+  /* The candidates are written into the preallocated array. */
+  results = g_array_sized_new (FALSE, TRUE, sizeof (detectedObject), num_boxes);
+  g_array_set_size (results, num_boxes);
+  objects = (detectedObject *) results->data;
+
+  for (bIdx = 0; bIdx < num_boxes; ++bIdx) {
+    const float *box = boxinput + (size_t) bIdx * stride;
+    const float *conf = box + num_info;
+    float lanes[YOLO_MAX_LANES];
+    float maxClassConfVal = -INFINITY;
+    float score, cx, cy, w, h;
+    int maxClassIdx = 0;
+    detectedObject *object;
+
+    /**
+     * The objectness and class confidences of YOLOv5 are not larger than 1,
+     * the score (class confidence * objectness) cannot be larger than the objectness.
+     */
+    if (has_objectness && box[4] >= 0.f && box[4] <= threshold)
+      continue;
+
+    for (l = 0; l < YOLO_MAX_LANES; ++l)
+      lanes[l] = -INFINITY;
+
+    for (cIdx = 0; cIdx + YOLO_MAX_LANES <= num_classes;
+        cIdx += YOLO_MAX_LANES) {
+      for (l = 0; l < YOLO_MAX_LANES; ++l)
+        lanes[l] = (conf[cIdx + l] > lanes[l]) ? conf[cIdx + l] : lanes[l];
+    }
+    for (; cIdx < num_classes; ++cIdx)
+      lanes[0] = (conf[cIdx] > lanes[0]) ? conf[cIdx] : lanes[0];
+    for (l = 0; l < YOLO_MAX_LANES; ++l)
+      maxClassConfVal = (lanes[l] > maxClassConfVal) ? lanes[l] :
+          maxClassConfVal;
+
+    score = has_objectness ? maxClassConfVal * box[4] : maxClassConfVal;
+    if (!(score > threshold))
+      continue;
+
+    /* The first class with the max confidence, only for the candidates */
+    for (cIdx = 0; cIdx < num_classes; ++cIdx) {
+      if (conf[cIdx] == maxClassConfVal) {
+        maxClassIdx = cIdx;
+        break;
+      }
+    }
+
+    cx = box[0];
+    cy = box[1];
+    w = box[2];
+    h = box[3];
+
+    if (!is_output_scaled) {
+      cx *= (float) bdata->i_width;
+      cy *= (float) bdata->i_height;
+      w *= (float) bdata->i_width;
+      h *= (float) bdata->i_height;
+    }
+
+    object = &objects[num++];
+    object->x = (int) (MAX (0.f, (cx - w / 2.f)));
+    object->y = (int) (MAX (0.f, (cy - h / 2.f)));
+    object->width = (int) (MIN ((float) bdata->i_width, w));
+    object->height = (int) (MIN ((float) bdata->i_height, h));
+
+    object->prob = score;
+    object->class_id = maxClassIdx;
+    object->tracking_id = 0;
+    object->valid = TRUE;
+  }
+
+  g_array_set_size (results, num);
+  return results;
+}
+
 /**
  * @brief Draw with the given results (objects[MOBILENET_SSD_DETECTION_MAX]) to the output buffer
  * @param[out] out_info The output buffer (RGBA plain)
@@ -2018,118 +2099,15 @@ bb_decode (void **pdata, const GstTensorsConfig * config,
         g_assert (0);
     }
   } else if (bdata->mode == YOLOV5_BOUNDING_BOX) {
-    int bIdx, numTotalBox;
-    int cIdx, numTotalClass, cStartIdx, cIdxMax;
-    float *boxinput;
-    int is_output_scaled = bdata->yolo_pp.scaled_output;
-
-    numTotalBox = bdata->max_detection;
-    numTotalClass = bdata->labeldata.total_labels;
-    cStartIdx = YOLOV5_DETECTION_NUM_INFO;
-    cIdxMax = numTotalClass + cStartIdx;
-
-    /* boxinput[numTotalBox][cIdxMax] */
-    boxinput = (float *) input[0].data;
-
     /** Only support for float type model */
     g_assert (config->info.info[0].type == _NNS_FLOAT32);
 
-    results =
-        g_array_sized_new (FALSE, TRUE, sizeof (detectedObject), numTotalBox);
-    for (bIdx = 0; bIdx < numTotalBox; ++bIdx) {
-      float maxClassConfVal = -INFINITY;
-      int maxClassIdx = -1;
-      for (cIdx = cStartIdx; cIdx < cIdxMax; ++cIdx) {
-        if (boxinput[bIdx * cIdxMax + cIdx] > maxClassConfVal) {
-          maxClassConfVal = boxinput[bIdx * cIdxMax + cIdx];
-          maxClassIdx = cIdx;
-        }
-      }
-
-      if (maxClassConfVal * boxinput[bIdx * cIdxMax + 4] >
-          bdata->yolo_pp.conf_threshold) {
-        detectedObject object;
-        float cx, cy, w, h;
-        cx = boxinput[bIdx * cIdxMax + 0];
-        cy = boxinput[bIdx * cIdxMax + 1];
-        w = boxinput[bIdx * cIdxMax + 2];
-        h = boxinput[bIdx * cIdxMax + 3];
-
-        if (!is_output_scaled) {
-          cx *= (float) bdata->i_width;
-          cy *= (float) bdata->i_height;
-          w *= (float) bdata->i_width;
-          h *= (float) bdata->i_height;
-        }
-
-        object.x = (int) (MAX (0.f, (cx - w / 2.f)));
-        object.y = (int) (MAX (0.f, (cy - h / 2.f)));
-        object.width = (int) (MIN ((float) bdata->i_width, w));
-        object.height = (int) (MIN ((float) bdata->i_height, h));
-
-        object.prob = maxClassConfVal * boxinput[bIdx * cIdxMax + 4];
-        object.class_id = maxClassIdx - YOLOV5_DETECTION_NUM_INFO;
-        object.tracking_id = 0;
-        object.valid = TRUE;
-        g_array_append_val (results, object);
-      }
-    }
-
+    results = _get_objects_yolo (bdata, (const float *) input[0].data,
+        YOLOV5_DETECTION_NUM_INFO);
     nms (results, bdata->yolo_pp.iou_threshold);
   } else if (bdata->mode == YOLOV8_BOUNDING_BOX) {
-    int bIdx, numTotalBox;
-    int cIdx, numTotalClass, cStartIdx, cIdxMax;
-    float *boxinput;
-    int is_output_scaled = bdata->yolo_pp.scaled_output;
-
-    numTotalBox = bdata->max_detection;
-    numTotalClass = bdata->labeldata.total_labels;
-    cStartIdx = YOLOV8_DETECTION_NUM_INFO;
-    cIdxMax = numTotalClass + cStartIdx;
-
-    /* boxinput[numTotalBox][cIdxMax] */
-    boxinput = (float *) input[0].data;
-
-    results =
-        g_array_sized_new (FALSE, TRUE, sizeof (detectedObject), numTotalBox);
-    for (bIdx = 0; bIdx < numTotalBox; ++bIdx) {
-      float maxClassConfVal = -INFINITY;
-      int maxClassIdx = -1;
-      for (cIdx = cStartIdx; cIdx < cIdxMax; ++cIdx) {
-        if (boxinput[bIdx * cIdxMax + cIdx] > maxClassConfVal) {
-          maxClassConfVal = boxinput[bIdx * cIdxMax + cIdx];
-          maxClassIdx = cIdx;
-        }
-      }
-
-      if (maxClassConfVal > bdata->yolo_pp.conf_threshold) {
-        detectedObject object;
-        float cx, cy, w, h;
-        cx = boxinput[bIdx * cIdxMax + 0];
-        cy = boxinput[bIdx * cIdxMax + 1];
-        w = boxinput[bIdx * cIdxMax + 2];
-        h = boxinput[bIdx * cIdxMax + 3];
-
-        if (!is_output_scaled) {
-          cx *= (float) bdata->i_width;
-          cy *= (float) bdata->i_height;
-          w *= (float) bdata->i_width;
-          h *= (float) bdata->i_height;
-        }
-
-        object.x = (int) (MAX (0.f, (cx - w / 2.f)));
-        object.y = (int) (MAX (0.f, (cy - h / 2.f)));
-        object.width = (int) (MIN ((float) bdata->i_width, w));
-        object.height = (int) (MIN ((float) bdata->i_height, h));
-
-        object.prob = maxClassConfVal;
-        object.class_id = maxClassIdx - YOLOV8_DETECTION_NUM_INFO;
-        object.tracking_id = 0;
-        object.valid = TRUE;
-        g_array_append_val (results, object);
-      }
-    }
-
+    results = _get_objects_yolo (bdata, (const float *) input[0].data,
+        YOLOV8_DETECTION_NUM_INFO);
     nms (results, bdata->yolo_pp.iou_threshold);
   } else if (bdata->mode == MP_PALM_DETECTION_BOUNDING_BOX) {
     const GstTensorMemory *boxes = NULL;
@@ -88,14 +88,25 @@
 #include <arm_neon.h>
 
 #define NEON64_ENABLED
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+
+#define SSE2_ENABLED
+#endif
+
 #define GRAYSCALE_HEX (0x00010101)
 #define ALPHA_HEX     (0xFF000000)
-#endif
 
 #define DEFAULT_LABELS  (20)
 #define RGBA_CHANNEL    (4)
 #define MAX_RGB         (255)
 
+/**
+ * @brief The pixels are divided into the threads if the image has pixels more than this.
+ */
+#define PARALLEL_MIN_PIXELS (256 * 256)
+#define MAX_THREADS     (4)
+
 void init_is (void) __attribute__ ((constructor));
 void fini_is (void) __attribute__ ((destructor));
 
@@ -128,7 +139,6 @@ static const char *is_modes[] = {
 typedef struct
 {
   image_segment_modes mode; /**< The image segmentation decoding mode */
-  float *segment_map;       /**< The image segmentated map */
 
   guint max_labels;         /**< Maximum number of labels */
   guint *color_map;         /**< The RGBA color map (up to max labels) */
@@ -138,8 +148,35 @@ typedef struct
 
   GRand *rand;              /**< random value generator */
   guint rgb_modifier;       /**< rgb modifier according to # labels */
+
+  GThreadPool *pool;        /**< workers to process the pixels in parallel */
+  guint num_threads;        /**< number of threads including the caller */
+  GMutex lock;              /**< lock to wait for the workers */
+  GCond cond;               /**< condition to wait for the workers */
+  guint pending;            /**< number of jobs in the workers */
 } image_segments;
 
+typedef struct _image_segment_job image_segment_job;
+
+/**
+ * @brief Function to process the pixels in a job.
+ */
+typedef void (*image_segment_job_func) (image_segments * idata,
+    image_segment_job * job);
+
+/**
+ * @brief Data structure for a job, processing a range of pixels.
+ */
+struct _image_segment_job
+{
+  image_segment_job_func func; /**< function to process the pixels */
+  const float *input;       /**< input tensor */
+  uint32_t *output;         /**< RGBA output */
+  guint start;              /**< index of the first pixel */
+  guint end;                /**< index of the last pixel + 1 */
+  float value;              /**< max grayscale (given or found) */
+};
+
 /** @brief tensordec-plugin's GstTensorDecoderDef callback */
 static int
 is_init (void **pdata)
@@ -157,10 +194,15 @@ is_init (void **pdata)
   idata->width = 0;
   idata->height = 0;
   idata->max_labels = DEFAULT_LABELS;
-  idata->segment_map = NULL;
   idata->color_map = NULL;
   idata->rgb_modifier = 0;
 
+  idata->pool = NULL;
+  idata->num_threads = CLAMP (g_get_num_processors (), 1, MAX_THREADS);
+  g_mutex_init (&idata->lock);
+  g_cond_init (&idata->cond);
+  idata->pending = 0;
+
   return TRUE;
 }
 
@@ -168,11 +210,13 @@ is_init (void **pdata)
 static void
 _free_resources (image_segments * idata)
 {
-  g_free (idata->segment_map);
+  if (idata->pool)
+    g_thread_pool_free (idata->pool, FALSE, TRUE);
+
   g_free (idata->color_map);
   g_rand_free (idata->rand);
 
-  idata->segment_map = NULL;
+  idata->pool = NULL;
   idata->color_map = NULL;
   idata->rand = NULL;
 }
@@ -184,6 +228,8 @@ is_exit (void **pdata)
   image_segments *idata = *pdata;
 
   _free_resources (idata);
+  g_mutex_clear (&idata->lock);
+  g_cond_clear (&idata->cond);
 
   g_free (*pdata);
   *pdata = NULL;
@@ -247,18 +293,7 @@ is_setOption (void **pdata, int op_num, const char *param)
 static gboolean
 _init_modes (image_segments * idata)
 {
-  if (idata->mode == MODE_TFLITE_DEEPLAB) {
-    /* init image segments if seg map is null */
-    if (idata->segment_map == NULL)
-      idata->segment_map = g_new0 (float, idata->height * idata->width);
-
-    if (idata->color_map == NULL) {
-      idata->color_map = g_new (guint, idata->max_labels + 1);
-      _fill_color_map (idata);
-    }
-
-    return TRUE;
-  } else if (idata->mode == MODE_SNPE_DEEPLAB) {
+  if (idata->mode == MODE_TFLITE_DEEPLAB || idata->mode == MODE_SNPE_DEEPLAB) {
     if (idata->color_map == NULL) {
       idata->color_map = g_new (guint, idata->max_labels + 1);
       _fill_color_map (idata);
@@ -323,14 +358,94 @@ is_getTransformSize (void **pdata, const GstTensorsConfig * config,
   /** @todo Use appropriate values */
 }
 
+/** @brief Worker to process the pixels of a job */
+static void
+_job_worker (gpointer data, gpointer user_data)
+{
+  image_segment_job *job = (image_segment_job *) data;
+  image_segments *idata = (image_segments *) user_data;
+
+  job->func (idata, job);
+
+  g_mutex_lock (&idata->lock);
+  if (--idata->pending == 0)
+    g_cond_signal (&idata->cond);
+  g_mutex_unlock (&idata->lock);
+}
+
+/**
+ * @brief Divide the pixels into the jobs and run them in parallel.
+ * @return The number of jobs.
+ */
+static guint
+_run_jobs (image_segments * idata, image_segment_job * jobs,
+    image_segment_job_func func, const float *input, uint32_t * output,
+    float value)
+{
+  const guint num_pixels = idata->height * idata->width;
+  guint i, num_jobs = 1, chunk;
+
+  if (num_pixels >= PARALLEL_MIN_PIXELS && idata->num_threads > 1) {
+    if (idata->pool == NULL) {
+      GError *error = NULL;
+
+      idata->pool = g_thread_pool_new (_job_worker, idata,
+          idata->num_threads - 1, FALSE, &error);
+      if (!idata->pool) {
+        ml_logw ("Failed to create the workers of tensordec-imagesegment: %s",
+            error ? error->message : "unknown error");
+        g_clear_error (&error);
+        idata->num_threads = 1;
+      }
+    }
+
+    if (idata->pool)
+      num_jobs = idata->num_threads;
+  }
+
+  /**
+   * The jobs are not aligned to the rows. Each job has a multiple of 16 pixels
+   * (64 bytes of output), so the jobs do not share a cache line of the output.
+   */
+  chunk = (((num_pixels + num_jobs - 1) / num_jobs) + 15) & ~15U;
+
+  for (i = 0; i < num_jobs; i++) {
+    jobs[i].func = func;
+    jobs[i].input = input;
+    jobs[i].output = output;
+    jobs[i].start = MIN (i * chunk, num_pixels);
+    jobs[i].end = MIN ((i + 1) * chunk, num_pixels);
+    jobs[i].value = value;
+  }
+
+  if (num_jobs > 1) {
+    g_mutex_lock (&idata->lock);
+    idata->pending = num_jobs - 1;
+    g_mutex_unlock (&idata->lock);
+
+    for (i = 1; i < num_jobs; i++)
+      g_thread_pool_push (idata->pool, &jobs[i], NULL);
+  }
+
+  func (idata, &jobs[0]);
+
+  if (num_jobs > 1) {
+    g_mutex_lock (&idata->lock);
+    while (idata->pending > 0)
+      g_cond_wait (&idata->cond, &idata->lock);
+    g_mutex_unlock (&idata->lock);
+  }
+
+  return num_jobs;
+}
+
 /** @brief Set color according to each pixel's label (RGBA) */
 static void
-set_color_according_to_label (image_segments * idata, GstMapInfo * out_info)
+set_color_according_to_label (image_segments * idata, image_segment_job * job)
 {
-  float *input = idata->segment_map;
-  uint32_t *output = (uint32_t *) out_info->data;
-  guint num_pixels = idata->height * idata->width;
-  guint label_idx, idx = 0;
+  const float *input = job->input;
+  uint32_t *output = job->output;
+  guint label_idx, idx = job->start;
 
 #if defined (NEON64_ENABLED)
   float32x4_t v_src_float;
@@ -338,23 +453,28 @@ set_color_according_to_label (image_segments * idata, GstMapInfo * out_info)
   uint32x4_t v_src_uint;
   uint32x4_t v_magic;
   uint32x4_t v_mask;
+  uint32x4_t v_valid;
   uint32x4_t v_alpha;
   uint32x4_t v_zero;
+  uint32x4_t v_max_label;
 
   guint num_lanes = 4;
 
   v_magic = vdupq_n_u32 (idata->rgb_modifier);
   v_alpha = vdupq_n_u32 (ALPHA_HEX);
   v_zero = vdupq_n_u32 (0);
+  v_max_label = vdupq_n_u32 (idata->max_labels);
 
-  for (idx = 0; idx < num_pixels; idx += num_lanes) {
+  for (; idx + num_lanes <= job->end; idx += num_lanes) {
     /* load float32 vector */
-    v_src_float = vld1q_f32 (input);
-    input += num_lanes;
+    v_src_float = vld1q_f32 (input + idx);
 
     /* convert float32 vector to uint32 vector */
     v_src_uint = vcvtq_u32_f32 (v_src_float);
 
+    /* If out-of-range, don't draw it */
+    v_valid = vcleq_u32 (v_src_uint, v_max_label);
+
     /* multiply by magic number to fill RGB values */
     v_src_uint = vmulq_u32 (v_src_uint, v_magic);
 
@@ -364,88 +484,75 @@ set_color_according_to_label (image_segments * idata, GstMapInfo * out_info)
 
     /* set the alpha value unless it's background */
     v_src_uint = vorrq_u32 (v_src_uint, v_mask);
+    v_src_uint = vandq_u32 (v_src_uint, v_valid);
 
     /* store uint32 vector */
-    vst1q_u32 (output, v_src_uint);
-    output += num_lanes;
+    vst1q_u32 (output + idx, v_src_uint);
   }
-
-  if (num_pixels == idx)
-    return;
-
-  /* handle remaining data */
-  input = (float *) idata->segment_map;
-  output = (uint32_t *) out_info->data;
-  idx -= num_lanes;
 #endif
-  for (; idx < num_pixels; idx++) {
+  /* handle remaining data */
+  for (; idx < job->end; idx++) {
     label_idx = (guint) input[idx];
 
     /* If out-of-range, don't draw it */
-    if (G_UNLIKELY (label_idx > idata->max_labels))
-      continue;
-
-    output[idx] = idata->color_map[label_idx];
+    output[idx] = G_LIKELY (label_idx <= idata->max_labels) ?
+        idata->color_map[label_idx] : 0;
   }
 }
 
 /** @brief Find the maximum grayscale value */
-static float
-find_max_grayscale (image_segments * idata)
+static void
+find_max_grayscale (image_segments * idata, image_segment_job * job)
 {
-  float *input = idata->segment_map;
+  const float *input = job->input;
   float gray_max = 0.0;
-  guint num_pixels = idata->height * idata->width;
-  guint idx = 0;
+  guint idx = job->start;
 
 #if defined (NEON64_ENABLED)
-  float32x4_t v_src, v_max;
+  float32x4_t v_max;
   guint num_lanes = 4;
 
   v_max = vdupq_n_f32 (0);
 
   /* find the maximum value per lane */
-  for (idx = 0; idx < num_pixels; idx += num_lanes) {
-    v_src = vld1q_f32 (input);
-    input += num_lanes;
-
-    v_max = vmaxq_f32 (v_src, v_max);
-  }
+  for (; idx + num_lanes <= job->end; idx += num_lanes)
+    v_max = vmaxq_f32 (vld1q_f32 (input + idx), v_max);
 
   /* find the maximum value among all lanes */
-  gray_max = MAX (gray_max, vgetq_lane_f32 (v_max, 0));
-  gray_max = MAX (gray_max, vgetq_lane_f32 (v_max, 1));
-  gray_max = MAX (gray_max, vgetq_lane_f32 (v_max, 2));
-  gray_max = MAX (gray_max, vgetq_lane_f32 (v_max, 3));
+  gray_max = vmaxvq_f32 (v_max);
+#elif defined (SSE2_ENABLED)
+  __m128 v_max;
+  float lanes[4];
+  guint num_lanes = 4;
 
-  if (num_pixels == idx)
-    return gray_max;
+  v_max = _mm_setzero_ps ();
 
-  /* handle remaining data */
-  input = idata->segment_map;
-  idx -= num_lanes;
+  /* find the maximum value per lane */
+  for (; idx + num_lanes <= job->end; idx += num_lanes)
+    v_max = _mm_max_ps (_mm_loadu_ps (input + idx), v_max);
+
+  /* find the maximum value among all lanes */
+  _mm_storeu_ps (lanes, v_max);
+  gray_max = MAX (MAX (lanes[0], lanes[1]), MAX (lanes[2], lanes[3]));
 #endif
-  for (; idx < num_pixels; idx++)
+  UNUSED (idata);
+
+  /* handle remaining data */
+  for (; idx < job->end; idx++)
     gray_max = MAX (gray_max, input[idx]);
 
-  return gray_max;
+  job->value = gray_max;
 }
 
 /** @brief Set color with grayscale value */
 static void
-set_color_grayscale (image_segments * idata, GstMapInfo * out_info)
+set_color_grayscale (image_segments * idata, image_segment_job * job)
 {
-  float *input = idata->segment_map;
-  uint32_t *output = (uint32_t *) out_info->data;
-  float max_grayscale;
-  guint num_pixels = idata->height * idata->width;
+  const float *input = job->input;
+  uint32_t *output = job->output;
+  const float max_grayscale = job->value;
   guint grayscale;
-  guint idx = 0;
-
-  /* find the maximum grayscale value */
-  max_grayscale = find_max_grayscale (idata);
-  if (G_UNLIKELY (max_grayscale == 0.0))
-    return;
+  guint idx = job->start;
 
 #if defined (NEON64_ENABLED)
   {
@@ -464,10 +571,9 @@ set_color_grayscale (image_segments * idata, GstMapInfo * out_info)
     v_magic = vdupq_n_u32 (GRAYSCALE_HEX);
     v_alpha = vdupq_n_u32 (ALPHA_HEX);
 
-    for (idx = 0; idx < num_pixels; idx += num_lanes) {
+    for (; idx + num_lanes <= job->end; idx += num_lanes) {
       /* load float32 vector */
-      v_src_float = vld1q_f32 (input);
-      input += num_lanes;
+      v_src_float = vld1q_f32 (input + idx);
 
       /* normalized_gray = (gray / max_gray) x max_rgb */
       v_src_float = vdivq_f32 (v_src_float, v_max_gray);
@@ -481,61 +587,128 @@ set_color_grayscale (image_segments * idata, GstMapInfo * out_info)
       v_src_uint = vaddq_u32 (v_src_uint, v_alpha);
 
       /* store uint32 vector */
-      vst1q_u32 (output, v_src_uint);
-      output += num_lanes;
+      vst1q_u32 (output + idx, v_src_uint);
     }
+  }
+#elif defined (SSE2_ENABLED)
+  {
+    __m128 v_src_float;
+    __m128i v_src_int;
+    __m128i v_invalid;
 
-    if (num_pixels == idx)
-      return;
+    const __m128 v_max_gray = _mm_set1_ps (max_grayscale);
+    const __m128 v_max_rgb = _mm_set1_ps (MAX_RGB);
+    const __m128i v_max_int = _mm_set1_epi32 (MAX_RGB);
+    const __m128i v_zero = _mm_setzero_si128 ();
+    const __m128i v_alpha = _mm_set1_epi32 ((int) ALPHA_HEX);
+
+    guint num_lanes = 4;
 
-    /* handle remaining data */
-    input = idata->segment_map;
-    output = (uint32_t *) out_info->data;
-    idx -= num_lanes;
+    for (; idx + num_lanes <= job->end; idx += num_lanes) {
+      /* normalized_gray = (gray / max_gray) x max_rgb */
+      v_src_float = _mm_div_ps (_mm_loadu_ps (input + idx), v_max_gray);
+      v_src_float = _mm_mul_ps (v_src_float, v_max_rgb);
+      v_src_int = _mm_cvttps_epi32 (v_src_float);
+
+      /* Should be in 0 ~ 255, don't draw it otherwise */
+      v_invalid = _mm_or_si128 (_mm_cmpgt_epi32 (v_src_int, v_max_int),
+          _mm_cmplt_epi32 (v_src_int, v_zero));
+
+      /* fill the same RGB values */
+      v_src_int = _mm_or_si128 (v_src_int, _mm_slli_epi32 (v_src_int, 8));
+      v_src_int = _mm_or_si128 (v_src_int, _mm_slli_epi32 (v_src_int, 8));
+      v_src_int = _mm_or_si128 (v_src_int, v_alpha);
+
+      _mm_storeu_si128 ((__m128i *) (output + idx),
+          _mm_andnot_si128 (v_invalid, v_src_int));
+    }
   }
 #endif
-  for (; idx < num_pixels; idx++) {
+  UNUSED (idata);
+
+  /* handle remaining data */
+  for (; idx < job->end; idx++) {
     /* normalize grayscale values to RGB_MAX */
     grayscale = (guint) ((input[idx] / max_grayscale) * MAX_RGB);
 
     /* Should be less than 256 */
-    if (G_UNLIKELY (grayscale > MAX_RGB))
+    if (G_UNLIKELY (grayscale > MAX_RGB)) {
+      output[idx] = 0;
       continue;
+    }
 
-    grayscale = grayscale | (grayscale << 8) | (grayscale << 16) | 0xFF000000;
-    output[idx] = grayscale;
+    output[idx] = grayscale * GRAYSCALE_HEX | ALPHA_HEX;
   }
 }
 
-/** @brief Set label index according to each pixel's label probabilities */
+/**
+ * @brief Set label index according to each pixel's label probabilities, and set color of the label.
+ */
 static void
-set_label_index (image_segments * idata, void *data)
+set_label_index (image_segments * idata, image_segment_job * job)
 {
-  float *prob_map = (float *) data;
-  guint idx, i, j;
-  int max_idx;
+  const float *prob_map = job->input;
+  uint32_t *output = job->output;
+  const guint total_labels = idata->max_labels + 1;
+  guint idx = job->start, label, max_idx;
   float max_prob;
-  guint total_labels = idata->max_labels + 1;
-
-  memset (idata->segment_map, '\x00',
-      (size_t) idata->width * idata->height * sizeof (float));
-
-  for (i = 0; i < idata->height; i++) {
-    for (j = 0; j < idata->width; j++) {
-      max_idx = 0;
-      max_prob = prob_map[i * idata->width * total_labels + j * total_labels];
-      for (idx = 1; idx < total_labels; idx++) {
-        float prob = prob_map[i * idata->width * total_labels
-            + j * total_labels + idx];
-        if (prob > max_prob) {
-          max_prob = prob;
-          max_idx = idx;
-        }
+
+#if defined (SSE2_ENABLED)
+  {
+    /* find the label of 4 pixels at once, each lane has the probabilities of a pixel */
+    const size_t stride = total_labels;
+    const __m128 v_threshold = _mm_set1_ps (DETECTION_THRESHOLD);
+    __m128 v_prob, v_max;
+    __m128i v_idx, v_gt;
+    guint32 labels[4];
+    guint num_lanes = 4;
+
+    for (; idx + num_lanes <= job->end; idx += num_lanes) {
+      const float *prob = prob_map + (size_t) idx * total_labels;
+
+      v_max = _mm_setr_ps (prob[0], prob[stride], prob[2 * stride],
+          prob[3 * stride]);
+      v_idx = _mm_setzero_si128 ();
+
+      for (label = 1; label < total_labels; label++) {
+        v_prob = _mm_setr_ps (prob[label], prob[stride + label],
+            prob[2 * stride + label], prob[3 * stride + label]);
+
+        /* keep the first label with the max probability */
+        v_gt = _mm_castps_si128 (_mm_cmpgt_ps (v_prob, v_max));
+        v_max = _mm_max_ps (v_prob, v_max);
+        v_idx = _mm_or_si128 (_mm_and_si128 (v_gt, _mm_set1_epi32 (label)),
+            _mm_andnot_si128 (v_gt, v_idx));
+      }
+
+      /* regarded as background if the probability is lower than the threshold */
+      v_idx = _mm_and_si128 (v_idx,
+          _mm_castps_si128 (_mm_cmpgt_ps (v_max, v_threshold)));
+      _mm_storeu_si128 ((__m128i *) labels, v_idx);
+
+      output[idx] = idata->color_map[labels[0]];
+      output[idx + 1] = idata->color_map[labels[1]];
+      output[idx + 2] = idata->color_map[labels[2]];
+      output[idx + 3] = idata->color_map[labels[3]];
+    }
+  }
+#endif
+  /* handle remaining data */
+  for (; idx < job->end; idx++) {
+    const float *prob = prob_map + (size_t) idx * total_labels;
+
+    max_idx = 0;
+    max_prob = prob[0];
+    for (label = 1; label < total_labels; label++) {
+      if (prob[label] > max_prob) {
+        max_prob = prob[label];
+        max_idx = label;
       }
-      if (max_prob > DETECTION_THRESHOLD) {
-        idata->segment_map[i * idata->width + j] = (float) max_idx;
-      }                         /* otherwise, regarded as background */
     }
+
+    /* otherwise, regarded as background */
+    output[idx] = idata->color_map[(max_prob > DETECTION_THRESHOLD) ?
+        max_idx : 0];
   }
 }
 
@@ -543,22 +716,31 @@ set_label_index (image_segments * idata, void *data)
 static void
 set_color (image_segments * idata, void *data, GstMapInfo * out_info)
 {
-  /* tflite-deeplab needs to perform extra post-processing to set labels */
-  if (idata->mode == MODE_TFLITE_DEEPLAB) {
-    set_label_index (idata, data);
-    set_color_according_to_label (idata, out_info);
-    return;
-  }
+  image_segment_job jobs[MAX_THREADS];
+  const float *input = (const float *) data;
+  uint32_t *output = (uint32_t *) out_info->data;
+  float max_grayscale = 0.0;
+  guint i, num_jobs;
 
-  /* snpe-deeplab already has labeled data as input */
-  idata->segment_map = data;
+  if (idata->mode == MODE_TFLITE_DEEPLAB) {
+    /* tflite-deeplab needs to perform extra post-processing to set labels */
+    _run_jobs (idata, jobs, set_label_index, input, output, 0.0);
+  } else if (idata->mode == MODE_SNPE_DEEPLAB) {
+    /* snpe-deeplab already has labeled data as input */
+    _run_jobs (idata, jobs, set_color_according_to_label, input, output, 0.0);
+  } else if (idata->mode == MODE_SNPE_DEPTH) {
+    /* find the maximum grayscale value */
+    num_jobs = _run_jobs (idata, jobs, find_max_grayscale, input, output, 0.0);
+    for (i = 0; i < num_jobs; i++)
+      max_grayscale = MAX (max_grayscale, jobs[i].value);
 
-  if (idata->mode == MODE_SNPE_DEEPLAB)
-    set_color_according_to_label (idata, out_info);
-  else if (idata->mode == MODE_SNPE_DEPTH)
-    set_color_grayscale (idata, out_info);
+    if (G_UNLIKELY (max_grayscale == 0.0)) {
+      memset (output, '\x00', out_info->size);
+      return;
+    }
 
-  idata->segment_map = NULL;
+    _run_jobs (idata, jobs, set_color_grayscale, input, output, max_grayscale);
+  }
 }
 
 /** @brief sanity check for each mode */
@@ -606,8 +788,7 @@ is_decode (void **pdata, const GstTensorsConfig * config,
     goto error_free;
   }
 
-  memset (out_info.data, '\x00', size);
-
+  /* each pixel of output is set in set_color () */
   if (!check_sanity (idata, config)) {
     ml_loge ("Invalid input data format detected.\n");
     goto error_unmap;
@@ -58,6 +58,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "tensordecutil.h"
+#include "tensordecnms.h"
 
 #define _tensor_region_size_default_ 1
 void init_tr (void) __attribute__ ((constructor));
@@ -513,75 +514,47 @@ gst_tensor_top_detectedObjects_cropInfo (GstMapInfo *out_info, const tensor_regi
       (boxes->data), (detections->data), config, results)
 
 /**
- * @brief Compare Function for g_array_sort with detectedObject.
- */
-static gint
-compare_detection (gconstpointer _a, gconstpointer _b)
-{
-  const detected_object *a = _a;
-  const detected_object *b = _b;
-
-  /**Larger comes first */
-  return (a->score > b->score) ? -1 : ((a->score == b->score) ? 0 : 1);
-}
-
-/**
- * @brief Calculate the intersected surface
- */
-static gfloat
-iou (detected_object *a, detected_object *b)
-{
-  int x1 = MAX (a->x, b->x);
-  int y1 = MAX (a->y, b->y);
-  int x2 = MIN (a->x + a->width, b->x + b->width);
-  int y2 = MIN (a->y + a->height, b->y + b->height);
-  int w = MAX (0, (x2 - x1 + 1));
-  int h = MAX (0, (y2 - y1 + 1));
-  float inter = w * h;
-  float areaA = a->width * a->height;
-  float areaB = b->width * b->height;
-  float o = inter / (areaA + areaB - inter);
-  return (o >= 0) ? o : 0;
-}
-
-/**
- * @brief Apply NMS to the given results (objects[])
- * @param[in/out] results The results to be filtered with nms
+ * @brief Apply NMS to the given results
+ * @param[in/out] results The results to be filtered with nms, sorted in the descending order of score
  */
 static void
 nms (GArray *results, gfloat threshold)
 {
-  guint boxes_size;
-  guint i, j;
+  nms_boxes_t boxes;
+  detected_object *objects, *kept;
+  guint *index, *keep;
+  guint i, num_kept;
 
-  boxes_size = results->len;
-  if (boxes_size == 0U)
+  if (results->len == 0U)
     return;
 
-  g_array_sort (results, compare_detection);
+  objects = (detected_object *) results->data;
+  nms_boxes_init (&boxes, results->len);
+  index = g_new (guint, results->len);
 
-  for (i = 0; i < boxes_size; i++) {
-    detected_object *a = &g_array_index (results, detected_object, i);
+  /* Invalid objects are not added, and removed from the results. */
+  for (i = 0; i < results->len; i++) {
+    detected_object *a = &objects[i];
     if (a->valid == TRUE) {
-      for (j = i + 1; j < boxes_size; j++) {
-        detected_object *b = &g_array_index (results, detected_object, j);
-        if (b->valid == TRUE) {
-          if (iou (a, b) > threshold) {
-            b->valid = FALSE;
-          }
-        }
-      }
+      index[boxes.len] = i;
+      nms_boxes_add (&boxes, a->x, a->y, a->width, a->height, a->score, 0);
     }
   }
 
-  i = 0;
-  do {
-    detected_object *a = &g_array_index (results, detected_object, i);
-    if (a->valid == FALSE)
-      g_array_remove_index (results, i);
-    else
-      i++;
-  } while (i < results->len);
+  keep = g_new (guint, MAX (boxes.len, 1U));
+  num_kept = nms_boxes_run (&boxes, threshold, keep);
+
+  /* Compact the kept objects in a single pass. */
+  kept = g_new (detected_object, MAX (num_kept, 1U));
+  for (i = 0; i < num_kept; i++)
+    kept[i] = objects[index[keep[i]]];
+  memcpy (objects, kept, sizeof (detected_object) * num_kept);
+  g_array_set_size (results, num_kept);
+
+  g_free (kept);
+  g_free (keep);
+  g_free (index);
+  nms_boxes_free (&boxes);
 }
 
 /**
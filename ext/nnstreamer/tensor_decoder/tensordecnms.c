@@ -0,0 +1,303 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * GStreamer/NNStreamer Tensor-Decoder
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ */
+/**
+ * @file	tensordecnms.c
+ * @date	16 Oct 2026
+ * @brief	Non-maximum suppression shared by the tensor decoder subplugins
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @bug		No known bugs except for NYI items
+ */
+
+#include <glib.h>
+#include <string.h>
+#include "tensordecnms.h"
+
+/**
+ * @brief Max number of grid cells in each axis.
+ */
+#define NMS_GRID_DIM (16U)
+
+/**
+ * @brief The boxes are not divided into the grid if the number of boxes is less than this.
+ */
+#define NMS_GRID_MIN_BOXES (64U)
+
+/**
+ * @brief Number of kept boxes compared at once, before checking the result.
+ */
+#define NMS_BLOCK_SIZE (16U)
+
+/**
+ * @brief Initialize the boxes. The arrays are allocated for the given number of boxes and grow if needed.
+ */
+void
+nms_boxes_init (nms_boxes_t * boxes, guint capacity)
+{
+  g_return_if_fail (boxes != NULL);
+
+  boxes->x1 = g_new (gfloat, capacity);
+  boxes->y1 = g_new (gfloat, capacity);
+  boxes->x2 = g_new (gfloat, capacity);
+  boxes->y2 = g_new (gfloat, capacity);
+  boxes->area = g_new (gfloat, capacity);
+  boxes->score = g_new (gfloat, capacity);
+  boxes->group = g_new (gint, capacity);
+  boxes->len = 0;
+  boxes->capacity = capacity;
+}
+
+/**
+ * @brief Free the arrays of the boxes.
+ */
+void
+nms_boxes_free (nms_boxes_t * boxes)
+{
+  g_return_if_fail (boxes != NULL);
+
+  g_free (boxes->x1);
+  g_free (boxes->y1);
+  g_free (boxes->x2);
+  g_free (boxes->y2);
+  g_free (boxes->area);
+  g_free (boxes->score);
+  g_free (boxes->group);
+  memset (boxes, 0, sizeof (nms_boxes_t));
+}
+
+/**
+ * @brief Internal function to append a box with the corners.
+ */
+static void
+_nms_boxes_append (nms_boxes_t * boxes, gfloat x1, gfloat y1, gfloat x2,
+    gfloat y2, gfloat area, gfloat score, gint group)
+{
+  guint i = boxes->len;
+
+  if (i >= boxes->capacity) {
+    guint capacity = MAX (boxes->capacity * 2, NMS_BLOCK_SIZE);
+
+    boxes->x1 = g_renew (gfloat, boxes->x1, capacity);
+    boxes->y1 = g_renew (gfloat, boxes->y1, capacity);
+    boxes->x2 = g_renew (gfloat, boxes->x2, capacity);
+    boxes->y2 = g_renew (gfloat, boxes->y2, capacity);
+    boxes->area = g_renew (gfloat, boxes->area, capacity);
+    boxes->score = g_renew (gfloat, boxes->score, capacity);
+    boxes->group = g_renew (gint, boxes->group, capacity);
+    boxes->capacity = capacity;
+  }
+
+  boxes->x1[i] = x1;
+  boxes->y1[i] = y1;
+  boxes->x2[i] = x2;
+  boxes->y2[i] = y2;
+  boxes->area[i] = area;
+  boxes->score[i] = score;
+  boxes->group[i] = group;
+  boxes->len++;
+}
+
+/**
+ * @brief Add a box.
+ */
+void
+nms_boxes_add (nms_boxes_t * boxes, gint x, gint y, gint width, gint height,
+    gfloat score, gint group)
+{
+  g_return_if_fail (boxes != NULL);
+
+  /* The area is calculated in integer, same as the decoders did before. */
+  _nms_boxes_append (boxes, (gfloat) x, (gfloat) y, (gfloat) (x + width),
+      (gfloat) (y + height), (gfloat) (width * height), score, group);
+}
+
+/**
+ * @brief Compare function to sort the indices in the descending order of score.
+ * The indices with the same score keep the order, same as the stable g_array_sort().
+ */
+static gint
+_nms_compare_score (gconstpointer _a, gconstpointer _b, gpointer user_data)
+{
+  const gfloat *score = (const gfloat *) user_data;
+  const guint a = *(const guint *) _a;
+  const guint b = *(const guint *) _b;
+
+  if (score[a] > score[b])
+    return -1;
+  if (score[a] < score[b])
+    return 1;
+  return (a < b) ? -1 : ((a > b) ? 1 : 0);
+}
+
+/**
+ * @brief Check whether the box is suppressed by one of the kept boxes.
+ * The IoU counts the pixels inclusively, same as the decoders did before.
+ * The inner loop has no branch, so that the compiler can vectorize it.
+ */
+static gboolean
+_nms_is_suppressed (const nms_boxes_t * kept, const nms_boxes_t * boxes,
+    guint idx, gfloat threshold)
+{
+  const gfloat x1 = boxes->x1[idx];
+  const gfloat y1 = boxes->y1[idx];
+  const gfloat x2 = boxes->x2[idx];
+  const gfloat y2 = boxes->y2[idx];
+  const gfloat area = boxes->area[idx];
+  const gint group = boxes->group[idx];
+  guint i, j, end;
+
+  for (i = 0; i < kept->len; i += NMS_BLOCK_SIZE) {
+    gint hit = 0;
+
+    end = MIN (i + NMS_BLOCK_SIZE, kept->len);
+    for (j = i; j < end; j++) {
+      gfloat w = MIN (x2, kept->x2[j]) - MAX (x1, kept->x1[j]) + 1.f;
+      gfloat h = MIN (y2, kept->y2[j]) - MAX (y1, kept->y1[j]) + 1.f;
+      gfloat inter, o;
+
+      w = MAX (0.f, w);
+      h = MAX (0.f, h);
+      inter = w * h;
+      o = inter / (kept->area[j] + area - inter);
+      o = (o >= 0.f) ? o : 0.f;
+
+      hit |= (o > threshold) & (kept->group[j] == group);
+    }
+
+    if (hit)
+      return TRUE;
+  }
+
+  return FALSE;
+}
+
+/**
+ * @brief Internal function to keep the first box of each group, if any box suppresses all others in the group.
+ */
+static guint
+_nms_keep_first_of_groups (const nms_boxes_t * boxes, const guint * order,
+    guint * keep)
+{
+  GHashTable *groups;
+  guint i, num_kept = 0;
+
+  groups = g_hash_table_new (g_direct_hash, g_direct_equal);
+
+  for (i = 0; i < boxes->len; i++) {
+    gpointer key = GINT_TO_POINTER (boxes->group[order[i]]);
+
+    if (g_hash_table_add (groups, key))
+      keep[num_kept++] = order[i];
+  }
+
+  g_hash_table_destroy (groups);
+  return num_kept;
+}
+
+/**
+ * @brief Get the cell index of the coordinate.
+ */
+static inline guint
+_nms_get_cell (gfloat v, gfloat min, gfloat scale, guint dim)
+{
+  gint c = (gint) ((v - min) * scale);
+
+  return (guint) CLAMP (c, 0, (gint) dim - 1);
+}
+
+/**
+ * @brief Apply NMS to the boxes.
+ */
+guint
+nms_boxes_run (const nms_boxes_t * boxes, gfloat threshold, guint * keep)
+{
+  GArray *order;
+  nms_boxes_t *cells;
+  guint *idx;
+  guint i, num_kept = 0, dim, cx, cy;
+  gfloat min_x = G_MAXFLOAT, min_y = G_MAXFLOAT;
+  gfloat max_x = -G_MAXFLOAT, max_y = -G_MAXFLOAT;
+  gfloat scale_x, scale_y;
+
+  g_return_val_if_fail (boxes != NULL, 0);
+  g_return_val_if_fail (keep != NULL || boxes->len == 0, 0);
+
+  if (boxes->len == 0U)
+    return 0;
+
+  order = g_array_sized_new (FALSE, FALSE, sizeof (guint), boxes->len);
+  for (i = 0; i < boxes->len; i++)
+    g_array_append_val (order, i);
+  g_array_sort_with_data (order, _nms_compare_score, boxes->score);
+  idx = (guint *) order->data;
+
+  if (threshold < 0.f) {
+    /* IoU is not negative, the box with the highest score suppresses all others. */
+    num_kept = _nms_keep_first_of_groups (boxes, idx, keep);
+    goto done;
+  }
+
+  for (i = 0; i < boxes->len; i++) {
+    if (boxes->x2[i] < boxes->x1[i] || boxes->y2[i] < boxes->y1[i])
+      continue;
+
+    min_x = MIN (min_x, boxes->x1[i]);
+    min_y = MIN (min_y, boxes->y1[i]);
+    max_x = MAX (max_x, boxes->x2[i]);
+    max_y = MAX (max_y, boxes->y2[i]);
+  }
+
+  dim = (boxes->len < NMS_GRID_MIN_BOXES) ? 1U : NMS_GRID_DIM;
+  scale_x = (max_x > min_x) ? (gfloat) dim / (max_x - min_x + 1.f) : 0.f;
+  scale_y = (max_y > min_y) ? (gfloat) dim / (max_y - min_y + 1.f) : 0.f;
+  cells = g_new0 (nms_boxes_t, dim * dim);
+
+  for (i = 0; i < boxes->len; i++) {
+    const guint b = idx[i];
+    guint cx0, cx1, cy0, cy1;
+
+    /**
+     * The box with negative size does not intersect with any box.
+     * Two boxes intersect only if both cover a common point, so the box is
+     * compared with the kept boxes in the cells it covers.
+     */
+    if (boxes->x2[b] < boxes->x1[b] || boxes->y2[b] < boxes->y1[b]) {
+      keep[num_kept++] = b;
+      continue;
+    }
+
+    cx0 = _nms_get_cell (boxes->x1[b], min_x, scale_x, dim);
+    cx1 = _nms_get_cell (boxes->x2[b], min_x, scale_x, dim);
+    cy0 = _nms_get_cell (boxes->y1[b], min_y, scale_y, dim);
+    cy1 = _nms_get_cell (boxes->y2[b], min_y, scale_y, dim);
+
+    for (cy = cy0; cy <= cy1; cy++) {
+      for (cx = cx0; cx <= cx1; cx++) {
+        if (_nms_is_suppressed (&cells[cy * dim + cx], boxes, b, threshold))
+          goto next;
+      }
+    }
+
+    keep[num_kept++] = b;
+
+    for (cy = cy0; cy <= cy1; cy++) {
+      for (cx = cx0; cx <= cx1; cx++) {
+        _nms_boxes_append (&cells[cy * dim + cx], boxes->x1[b], boxes->y1[b],
+            boxes->x2[b], boxes->y2[b], boxes->area[b], boxes->score[b],
+            boxes->group[b]);
+      }
+    }
+  next:
+    continue;
+  }
+
+  for (i = 0; i < dim * dim; i++)
+    nms_boxes_free (&cells[i]);
+  g_free (cells);
+
+done:
+  g_array_free (order, TRUE);
+  return num_kept;
+}
@@ -0,0 +1,74 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * GStreamer/NNStreamer Tensor-Decoder
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ */
+/**
+ * @file	tensordecnms.h
+ * @date	16 Oct 2026
+ * @brief	Non-maximum suppression shared by the tensor decoder subplugins
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @bug		No known bugs except for NYI items
+ *
+ * The boxes are stored in SoA layout. The candidates are visited in the
+ * descending order of score, and each candidate is compared only with the
+ * kept boxes registered in the grid cells it covers, so the IoU loop runs
+ * over contiguous arrays of nearby boxes.
+ */
+#ifndef _TENSORDECNMS_H__
+#define _TENSORDECNMS_H__
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include <glib.h>
+
+/**
+ * @brief Boxes in SoA layout for NMS.
+ */
+typedef struct {
+  gfloat *x1; /**< left */
+  gfloat *y1; /**< top */
+  gfloat *x2; /**< right (x + width) */
+  gfloat *y2; /**< bottom (y + height) */
+  gfloat *area; /**< width * height */
+  gfloat *score; /**< score to sort the boxes */
+  gint *group; /**< boxes in different groups do not suppress each other */
+  guint len; /**< number of boxes */
+  guint capacity; /**< allocated number of boxes */
+} nms_boxes_t;
+
+/**
+ * @brief Initialize the boxes. The arrays are allocated for the given number of boxes and grow if needed.
+ */
+extern void
+nms_boxes_init (nms_boxes_t *boxes, guint capacity);
+
+/**
+ * @brief Free the arrays of the boxes.
+ */
+extern void
+nms_boxes_free (nms_boxes_t *boxes);
+
+/**
+ * @brief Add a box.
+ * @param group The group of the box. Use the same value (e.g., 0) for class-agnostic NMS,
+ *              the class id for class-aware NMS, and a combination of the batch index
+ *              and the class id (e.g., batch * num_classes + class) for batched NMS.
+ */
+extern void
+nms_boxes_add (nms_boxes_t *boxes, gint x, gint y, gint width, gint height,
+    gfloat score, gint group);
+
+/**
+ * @brief Apply NMS to the boxes.
+ * @param threshold The box is suppressed if the IoU with a kept box of higher score in the same group is larger than this.
+ * @param[out] keep The indices of the kept boxes in the descending order of score. The caller should allocate it for boxes->len indices.
+ * @return The number of kept boxes.
+ */
+extern guint
+nms_boxes_run (const nms_boxes_t *boxes, gfloat threshold, guint *keep);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* _TENSORDECNMS_H__ */
@@ -27,6 +27,7 @@
  */
 
 #include <algorithm>
+#include <functional>
 #include <limits.h>
 #include <thread>
 #include <unistd.h>
@@ -131,6 +132,7 @@ typedef struct {
   gint num_threads; /**< the number of threads */
   const gchar *ext_delegate_path; /**< path to external delegate lib */
   GHashTable *ext_delegate_kv_table; /**< external delegate key values options */
+  gint num_interpreters; /**< the number of interpreters in the pool of shared model */
 } tflite_option_s;
 
 /**
@@ -162,7 +164,8 @@ class TFLiteInterpreter
   ~TFLiteInterpreter ();
 
   int invoke (const GstTensorMemory *input, GstTensorMemory *output);
-  int loadModel (int num_threads, tflite_delegate_e delegate);
+  int loadModel (int num_threads, tflite_delegate_e delegate,
+      TFLiteInterpreter *base = nullptr);
 
   int setInputTensorProp ();
   int setOutputTensorProp ();
@@ -177,6 +180,12 @@ class TFLiteInterpreter
     return model_path;
   }
 
+  /** @brief check whether the model is loaded */
+  bool isLoaded ()
+  {
+    return interpreter != nullptr;
+  }
+
   /** @brief return input tensor meta */
   const GstTensorsInfo *getInputTensorsInfo ()
   {
@@ -222,7 +231,7 @@ class TFLiteInterpreter
   GHashTable *ext_delegate_kv_table; /**< external delegate key values options */
 
   std::unique_ptr<tflite::Interpreter> interpreter;
-  std::unique_ptr<tflite::FlatBufferModel> model;
+  std::shared_ptr<tflite::FlatBufferModel> model; /**< mmapped model, shared by the interpreters in the pool */
 
   GstTensorsInfo inputTensorMeta; /**< The tensor info of input tensors */
   GstTensorsInfo outputTensorMeta; /**< The tensor info of output tensors */
@@ -242,7 +251,7 @@ class TFLiteInterpreter
 class TFLiteCore
 {
   public:
-  TFLiteCore (const GstTensorFilterProperties *prop);
+  TFLiteCore (const GstTensorFilterProperties *prop, int num_interpreters = 1);
   ~TFLiteCore ();
   int init (tflite_option_s *option);
   int loadModel ();
@@ -270,8 +279,12 @@ class TFLiteCore
   TFLiteInterpreter *interpreter_sub;
 
   gchar *shared_tensor_filter_key;
+  int num_interpreters; /**< the number of interpreters in the pool of shared model */
+  void *pool; /**< the pool of shared model, NULL if the interpreter is not pooled */
   gboolean checkSharedInterpreter (const GstTensorFilterProperties *prop);
   int reloadInterpreter (TFLiteInterpreter *new_interpreter);
+  int reloadPool (const char *model_path);
+  int forEachInterpreter (std::function<int (TFLiteInterpreter *)> func);
   void setAccelerator (const char *accelerators, tflite_delegate_e d);
 };
 
@@ -405,10 +418,11 @@ TFLiteInterpreter::invoke (const GstTensorMemory *input, GstTensorMemory *output
 
 /**
  * @brief Internal implementation of TFLiteCore's loadModel()
+ * @param base the interpreter loaded from the same model file. If given, the mmapped model (weights) is shared with it.
  * @return 0 if OK. non-zero if error.
  */
 int
-TFLiteInterpreter::loadModel (int num_threads, tflite_delegate_e delegate_e)
+TFLiteInterpreter::loadModel (int num_threads, tflite_delegate_e delegate_e, TFLiteInterpreter *base)
 {
   TfLiteDelegate *delegate;
 #if (DBG)
@@ -416,7 +430,10 @@ TFLiteInterpreter::loadModel (int num_threads, tflite_delegate_e delegate_e)
   start_time = g_get_monotonic_time ();
 #endif
 
-  model = tflite::FlatBufferModel::BuildFromFile (model_path);
+  if (base && base->model && g_strcmp0 (base->getModelPath (), model_path) == 0)
+    model = base->model;
+  else
+    model = tflite::FlatBufferModel::BuildFromFile (model_path);
   if (!model) {
     ml_loge ("Failed to mmap model\n");
     return -1;
@@ -858,13 +875,21 @@ fail_exit:
 /**
  * @brief	TFLiteCore constructor
  */
-TFLiteCore::TFLiteCore (const GstTensorFilterProperties *prop)
+TFLiteCore::TFLiteCore (const GstTensorFilterProperties *prop, int _num_interpreters)
 {
   num_threads = -1;
   accelerator = ACCL_NONE;
   delegate = TFLITE_DELEGATE_NONE;
   interpreter_sub = nullptr;
   shared_tensor_filter_key = NULL;
+  num_interpreters = MAX (_num_interpreters, 1);
+  pool = NULL;
+
+  if (num_interpreters > 1 && !prop->shared_tensor_filter_key) {
+    ml_logw ("The pool of interpreters requires shared-tensor-filter-key. NumInterpreters (%d) is ignored.",
+        num_interpreters);
+    num_interpreters = 1;
+  }
 
   if (prop->shared_tensor_filter_key) {
     shared_tensor_filter_key = g_strdup (prop->shared_tensor_filter_key);
@@ -915,7 +940,29 @@ TFLiteCore::checkSharedInterpreter (const GstTensorFilterProperties *prop)
   interpreter = (TFLiteInterpreter *) nnstreamer_filter_shared_model_get (
       this, shared_tensor_filter_key);
 
-  if (!interpreter) {
+  if (!interpreter && num_interpreters > 1) {
+    /* create new pool of interpreters, the model is loaded in init () */
+    TFLiteInterpreter **new_interpreters = g_new0 (TFLiteInterpreter *, num_interpreters);
+    int i;
+
+    for (i = 0; i < num_interpreters; i++)
+      new_interpreters[i] = new TFLiteInterpreter ();
+
+    interpreter = (TFLiteInterpreter *) nnstreamer_filter_shared_model_insert_pool_and_get (
+        this, shared_tensor_filter_key, (void **) new_interpreters,
+        num_interpreters, free_interpreter);
+    if (!interpreter) {
+      G_UNLOCK (slock);
+      ml_loge ("Failed to insert the pool of model representation!");
+      g_free (shared_tensor_filter_key);
+      shared_tensor_filter_key = NULL;
+      for (i = 0; i < num_interpreters; i++)
+        delete new_interpreters[i];
+      g_free (new_interpreters);
+      return FALSE;
+    }
+    g_free (new_interpreters);
+  } else if (!interpreter) {
     /* create new interpreter */
     TFLiteInterpreter *new_interpreter = new TFLiteInterpreter ();
     interpreter = (TFLiteInterpreter *) nnstreamer_filter_shared_model_insert_and_get (
@@ -938,6 +985,9 @@ TFLiteCore::checkSharedInterpreter (const GstTensorFilterProperties *prop)
     shared_tensor_filter_key = NULL;
     return FALSE;
   }
+
+  /* the first instance decides whether the interpreters are pooled */
+  pool = nnstreamer_filter_shared_model_get_pool (shared_tensor_filter_key);
   G_UNLOCK (slock);
 
   ml_logd ("The model representation is shared: key=[%s]", shared_tensor_filter_key);
@@ -1035,13 +1085,15 @@ TFLiteCore::compareModelPath (const char *model_path)
 int
 TFLiteCore::loadModel ()
 {
-  int err;
-
-  interpreter->lock ();
-  err = interpreter->loadModel (num_threads, delegate);
-  interpreter->unlock ();
-
-  return err;
+  return forEachInterpreter ([&] (TFLiteInterpreter *member) {
+    /* the pool is loaded once by the first instance */
+    if (pool && member->isLoaded ())
+      return 0;
+
+    /* the interpreters in the pool share the mmapped model */
+    return member->loadModel (num_threads, delegate,
+        (member == interpreter) ? nullptr : interpreter);
+  });
 }
 
 /**
@@ -1051,13 +1103,8 @@ TFLiteCore::loadModel ()
 int
 TFLiteCore::setInputTensorProp ()
 {
-  int err;
-
-  interpreter->lock ();
-  err = interpreter->setInputTensorProp ();
-  interpreter->unlock ();
-
-  return err;
+  return forEachInterpreter (
+      [] (TFLiteInterpreter *member) { return member->setInputTensorProp (); });
 }
 
 /**
@@ -1067,13 +1114,8 @@ TFLiteCore::setInputTensorProp ()
 int
 TFLiteCore::setOutputTensorProp ()
 {
-  int err;
-
-  interpreter->lock ();
-  err = interpreter->setOutputTensorProp ();
-  interpreter->unlock ();
-
-  return err;
+  return forEachInterpreter (
+      [] (TFLiteInterpreter *member) { return member->setOutputTensorProp (); });
 }
 
 /**
@@ -1117,13 +1159,8 @@ TFLiteCore::getOutputTensorDim (GstTensorsInfo *info)
 int
 TFLiteCore::setInputTensorDim (const GstTensorsInfo *info)
 {
-  int err;
-
-  interpreter->lock ();
-  err = interpreter->setInputTensorsInfo (info);
-  interpreter->unlock ();
-
-  return err;
+  return forEachInterpreter (
+      [&] (TFLiteInterpreter *member) { return member->setInputTensorsInfo (info); });
 }
 
 /**
@@ -1191,6 +1228,10 @@ TFLiteCore::reloadModel (const char *_model_path)
     ml_loge ("The path of model file(s), %s, to reload is invalid.", _model_path);
     return -EINVAL;
   }
+
+  if (pool)
+    return reloadPool (_model_path);
+
   interpreter_sub = new TFLiteInterpreter ();
   interpreter_sub->setModelPath (_model_path);
   interpreter->getExtDelegate (&_ext_delegate_path, &_ext_delegate_kv);
@@ -1232,6 +1273,87 @@ TFLiteCore::reloadModel (const char *_model_path)
   return 0;
 }
 
+/**
+ * @brief	reload a model into the new pool of interpreters and swap the whole pool.
+ * @param[in] _model_path : the path of model file
+ * @return 0 if OK. non-zero if error.
+ */
+int
+TFLiteCore::reloadPool (const char *_model_path)
+{
+  TFLiteInterpreter **new_interpreters;
+  const char *_ext_delegate_path;
+  GHashTable *_ext_delegate_kv;
+  gboolean matched;
+  int i, err = 0;
+
+  new_interpreters = g_new0 (TFLiteInterpreter *, num_interpreters);
+  interpreter->getExtDelegate (&_ext_delegate_path, &_ext_delegate_kv);
+
+  /* load the model once, and the other interpreters share the mmapped model */
+  for (i = 0; i < num_interpreters; i++) {
+    TFLiteInterpreter *member = new TFLiteInterpreter ();
+
+    new_interpreters[i] = member;
+    member->setModelPath (_model_path);
+    member->setExtDelegate (_ext_delegate_path, _ext_delegate_kv);
+
+    if (member->loadModel (num_threads, delegate, (i > 0) ? new_interpreters[0] : nullptr) != 0) {
+      ml_loge ("Failed to load model %s\n", _model_path);
+      err = -EINVAL;
+      goto error;
+    }
+    if (member->setInputTensorProp () != 0) {
+      ml_loge ("Failed to initialize input tensor\n");
+      err = -EINVAL;
+      goto error;
+    }
+    if (member->setOutputTensorProp () != 0) {
+      ml_loge ("Failed to initialize output tensor\n");
+      err = -EINVAL;
+      goto error;
+    }
+    if (member->cacheInOutTensorPtr () != 0) {
+      ml_loge ("Failed to cache input and output tensors storage\n");
+      err = -EINVAL;
+      goto error;
+    }
+  }
+
+  /* the instances sharing the pool keep the tensor info */
+  interpreter->lock ();
+  matched = gst_tensors_info_is_equal (interpreter->getInputTensorsInfo (),
+                new_interpreters[0]->getInputTensorsInfo ())
+            && gst_tensors_info_is_equal (interpreter->getOutputTensorsInfo (),
+                new_interpreters[0]->getOutputTensorsInfo ());
+  interpreter->unlock ();
+
+  if (!matched) {
+    ml_loge ("The model has unmatched tensors info\n");
+    err = -EINVAL;
+    goto error;
+  }
+
+  G_LOCK (slock);
+  if (!nnstreamer_filter_shared_model_pool_replace (this, shared_tensor_filter_key,
+          (void **) new_interpreters, num_interpreters, replace_interpreter)) {
+    G_UNLOCK (slock);
+    ml_loge ("Failed to replace the pool of interpreters\n");
+    err = -EINVAL;
+    goto error;
+  }
+  G_UNLOCK (slock);
+
+  g_free (new_interpreters);
+  return 0;
+
+error:
+  for (i = 0; i < num_interpreters; i++)
+    delete new_interpreters[i];
+  g_free (new_interpreters);
+  return err;
+}
+
 /**
  * @brief	run the model with the input.
  * @param[in] input : The array of input tensors
@@ -1241,12 +1363,27 @@ TFLiteCore::reloadModel (const char *_model_path)
 int
 TFLiteCore::invoke (const GstTensorMemory *input, GstTensorMemory *output)
 {
+  TFLiteInterpreter *member;
+  void *handle;
   int err;
 
-  interpreter->lock ();
-  err = interpreter->invoke (input, output);
-  interpreter->unlock ();
+  if (!pool) {
+    interpreter->lock ();
+    err = interpreter->invoke (input, output);
+    interpreter->unlock ();
+    return err;
+  }
 
+  /* any free interpreter in the pool, the lock is not contended */
+  member = (TFLiteInterpreter *) nnstreamer_filter_shared_model_pool_acquire (pool, &handle);
+  if (!member)
+    return -EINVAL;
+
+  member->lock ();
+  err = member->invoke (input, output);
+  member->unlock ();
+
+  nnstreamer_filter_shared_model_pool_release (pool, handle);
   return err;
 }
 
@@ -1256,10 +1393,50 @@ TFLiteCore::invoke (const GstTensorMemory *input, GstTensorMemory *output)
 int
 TFLiteCore::cacheInOutTensorPtr ()
 {
+  return forEachInterpreter (
+      [] (TFLiteInterpreter *member) { return member->cacheInOutTensorPtr (); });
+}
+
+/**
+ * @brief Data for the callback iterating the interpreters in the pool
+ */
+typedef struct {
+  std::function<int (TFLiteInterpreter *)> *func; /**< the function to be called */
+} tflite_pool_iter_s;
+
+/**
+ * @brief Callback to call the function for the interpreter in the pool
+ */
+static int
+tflite_pool_iter_cb (void *interpreter, void *user_data)
+{
+  tflite_pool_iter_s *iter = static_cast<tflite_pool_iter_s *> (user_data);
+  TFLiteInterpreter *member = reinterpret_cast<TFLiteInterpreter *> (interpreter);
   int err;
 
+  member->lock ();
+  err = (*iter->func) (member);
+  member->unlock ();
+
+  return err;
+}
+
+/**
+ * @brief Call the function for the interpreter (or each interpreter in the pool) with the lock.
+ * @return 0 if OK. non-zero if error.
+ */
+int
+TFLiteCore::forEachInterpreter (std::function<int (TFLiteInterpreter *)> func)
+{
+  int err;
+
+  if (pool) {
+    tflite_pool_iter_s iter = { &func };
+    return nnstreamer_filter_shared_model_pool_foreach (pool, tflite_pool_iter_cb, &iter);
+  }
+
   interpreter->lock ();
-  err = interpreter->cacheInOutTensorPtr ();
+  err = func (interpreter);
   interpreter->unlock ();
 
   return err;
@@ -1280,6 +1457,7 @@ tflite_parseCustomOption (const GstTensorFilterProperties *prop, tflite_option_s
   option->num_threads = -1;
   option->ext_delegate_path = nullptr;
   option->ext_delegate_kv_table = nullptr;
+  option->num_interpreters = 1;
 
   if (prop->custom_properties) {
     gchar **strv;
@@ -1297,6 +1475,8 @@ tflite_parseCustomOption (const GstTensorFilterProperties *prop, tflite_option_s
 
         if (g_ascii_strcasecmp (pair[0], "NumThreads") == 0) {
           option->num_threads = (int) g_ascii_strtoll (pair[1], NULL, 10);
+        } else if (g_ascii_strcasecmp (pair[0], "NumInterpreters") == 0) {
+          option->num_interpreters = (int) g_ascii_strtoll (pair[1], NULL, 10);
         } else if (g_ascii_strcasecmp (pair[0], "Delegate") == 0) {
           if (g_ascii_strcasecmp (pair[1], "NNAPI") == 0)
             option->delegate = TFLITE_DELEGATE_NNAPI;
@@ -1400,7 +1580,7 @@ tflite_loadModelFile (const GstTensorFilterProperties *prop, void **private_data
     tflite_close (prop, private_data);
   }
 
-  core = new TFLiteCore (prop);
+  core = new TFLiteCore (prop, option.num_interpreters);
   if (core == NULL) {
     g_printerr ("Failed to allocate memory for filter subplugin.");
     ret = -1;
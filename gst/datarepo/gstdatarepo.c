@@ -10,6 +10,7 @@
  * @bug		No known bugs except for NYI items
  */
 
+#include <string.h>
 #include "gstdatarepo.h"
 #include "gstdatareposrc.h"
 #include "gstdatareposink.h"
@@ -48,6 +49,59 @@ gst_data_repo_get_data_type_from_caps (const GstCaps * caps)
   return GST_DATA_REPO_DATA_UNKNOWN;
 }
 
+/**
+ * @brief Get the file name of the binary sample index of the data file.
+ */
+gchar *
+gst_data_repo_get_index_filename (const gchar * data_filename)
+{
+  g_return_val_if_fail (data_filename != NULL, NULL);
+
+  return g_strconcat (data_filename, GST_DATA_REPO_INDEX_SUFFIX, NULL);
+}
+
+/**
+ * @brief Check the header of the binary sample index, and get the records.
+ */
+gboolean
+gst_data_repo_parse_index (const guint8 * data, gsize size,
+    const GstDataRepoIndexSample ** samples, guint64 * num_samples,
+    const guint64 ** tensor_sizes, guint64 * num_tensors)
+{
+  GstDataRepoIndexHeader header;
+  gsize records;
+
+  g_return_val_if_fail (samples != NULL, FALSE);
+  g_return_val_if_fail (num_samples != NULL, FALSE);
+  g_return_val_if_fail (tensor_sizes != NULL, FALSE);
+  g_return_val_if_fail (num_tensors != NULL, FALSE);
+
+  if (data == NULL || size < sizeof (header))
+    return FALSE;
+
+  memcpy (&header, data, sizeof (header));
+  if (memcmp (header.magic, GST_DATA_REPO_INDEX_MAGIC, sizeof (header.magic))
+      || GUINT32_FROM_LE (header.version) != GST_DATA_REPO_INDEX_VERSION)
+    return FALSE;
+
+  *num_samples = GUINT64_FROM_LE (header.num_samples);
+  *num_tensors = GUINT64_FROM_LE (header.num_tensors);
+
+  /* the records should fill the file exactly */
+  records = size - sizeof (header);
+  if (*num_samples > records / sizeof (GstDataRepoIndexSample))
+    return FALSE;
+  records -= *num_samples * sizeof (GstDataRepoIndexSample);
+  if (*num_tensors != records / sizeof (guint64)
+      || records % sizeof (guint64) != 0)
+    return FALSE;
+
+  *samples = (const GstDataRepoIndexSample *) (data + sizeof (header));
+  *tensor_sizes = (const guint64 *) (*samples + *num_samples);
+
+  return TRUE;
+}
+
 /**
  * @brief The entry point of the Gstreamer datarepo plugin
  */
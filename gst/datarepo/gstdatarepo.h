@@ -33,11 +33,71 @@ typedef enum
   GST_DATA_REPO_DATA_MAX
 } GstDataRepoDataType;
 
+/**
+ * @brief Suffix of the binary sample index of flexible or sparse tensors, appended to the data file name.
+ */
+#define GST_DATA_REPO_INDEX_SUFFIX ".idx"
+
+/**
+ * @brief Magic of the binary sample index.
+ */
+#define GST_DATA_REPO_INDEX_MAGIC "NDRI"
+
+/**
+ * @brief Version of the binary sample index.
+ */
+#define GST_DATA_REPO_INDEX_VERSION 1
+
+/**
+ * @brief Header of the binary sample index. All fields are little-endian.
+ *
+ * The header is followed by num_samples records of GstDataRepoIndexSample,
+ * then num_tensors records of the tensor size (guint64).
+ */
+typedef struct
+{
+  gchar magic[4];               /**< GST_DATA_REPO_INDEX_MAGIC */
+  guint32 version;              /**< GST_DATA_REPO_INDEX_VERSION */
+  guint64 num_samples;          /**< the number of sample records */
+  guint64 num_tensors;          /**< the number of tensor size records */
+} GstDataRepoIndexHeader;
+
+/**
+ * @brief Sample record of the binary sample index. All fields are little-endian.
+ */
+typedef struct
+{
+  guint64 offset;               /**< offset of the sample in the data file */
+  guint64 first_tensor;         /**< the number of cumulative tensors before the sample, index of its first tensor size record */
+} GstDataRepoIndexSample;
+
 /**
  * @brief Get data type from caps.
  */
 GstDataRepoDataType
 gst_data_repo_get_data_type_from_caps (const GstCaps * caps);
 
+/**
+ * @brief Get the file name of the binary sample index of the data file.
+ * @return Newly allocated file name, caller should free it.
+ */
+gchar *
+gst_data_repo_get_index_filename (const gchar * data_filename);
+
+/**
+ * @brief Check the header of the binary sample index, and get the records.
+ * @param[in] data The contents of the index file
+ * @param[in] size The size of the index file
+ * @param[out] samples The sample records
+ * @param[out] num_samples The number of sample records
+ * @param[out] tensor_sizes The tensor size records
+ * @param[out] num_tensors The number of tensor size records
+ * @return TRUE if the index is valid
+ */
+gboolean
+gst_data_repo_parse_index (const guint8 * data, gsize size,
+    const GstDataRepoIndexSample ** samples, guint64 * num_samples,
+    const guint64 ** tensor_sizes, guint64 * num_tensors);
+
 G_END_DECLS
 #endif /* __GST_DATA_REPO_H__ */
@@ -19,6 +19,11 @@
  * other/tensors, format=static, num_tensors=2, framerate=0/1, dimensions=1:1:784:1.1:1:10:1, types=float32.float32 ! \
  * datareposink location=hyunil.dat json=file.json
  * ]|
+ *
+ * For flexible or sparse tensors, the offset of each sample and the size of each tensor are
+ * written to the JSON file. Set binary-index=true to write them to the binary index
+ * (location + ".idx") instead, so that datareposrc can look them up without parsing JSON arrays.
+ * The binary index cannot be read by the datareposrc of the previous releases.
  */
 
 #ifdef HAVE_CONFIG_H
@@ -31,6 +36,8 @@
 #include <sys/types.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <errno.h>
+#include <string.h>
 #include <nnstreamer_plugin_api.h>
 #include <tensor_common.h>
 #include <nnstreamer_util.h>
@@ -84,9 +91,12 @@ enum
 {
   PROP_0,
   PROP_LOCATION,
-  PROP_JSON
+  PROP_JSON,
+  PROP_BINARY_INDEX
 };
 
+#define DEFAULT_BINARY_INDEX FALSE
+
 GST_DEBUG_CATEGORY_STATIC (gst_data_repo_sink_debug);
 #define GST_CAT_DEFAULT gst_data_repo_sink_debug
 #define _do_init \
@@ -146,6 +156,16 @@ gst_data_repo_sink_class_init (GstDataRepoSinkClass * klass)
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
           GST_PARAM_MUTABLE_READY));
 
+  g_object_class_install_property (gobject_class, PROP_BINARY_INDEX,
+      g_param_spec_boolean ("binary-index", "Binary index",
+          "If the value is true, the sample offsets and tensor sizes of "
+          "flexible or sparse tensors are written to the binary index file "
+          "(location + '.idx') instead of the JSON file. The previous releases "
+          "of datareposrc cannot read the binary index",
+          DEFAULT_BINARY_INDEX,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
   gst_element_class_set_static_metadata (gstelement_class,
       "NNStreamer MLOps Data Repository Sink",
       "Sink/File",
@@ -187,6 +207,10 @@ gst_data_repo_sink_init (GstDataRepoSink * sink)
   sink->sample_offset_array = json_array_new ();
   sink->tensor_size_array = json_array_new ();
   sink->tensor_count_array = json_array_new ();
+  sink->index_samples =
+      g_array_new (FALSE, FALSE, sizeof (GstDataRepoIndexSample));
+  sink->index_tensor_sizes = g_array_new (FALSE, FALSE, sizeof (guint64));
+  sink->binary_index = DEFAULT_BINARY_INDEX;
 }
 
 /**
@@ -215,6 +239,8 @@ gst_data_repo_sink_finalize (GObject * object)
     json_array_unref (sink->tensor_size_array);
   if (sink->tensor_count_array)
     json_array_unref (sink->tensor_count_array);
+  g_array_free (sink->index_samples, TRUE);
+  g_array_free (sink->index_tensor_sizes, TRUE);
   if (sink->json_object) {
     json_object_unref (sink->json_object);
     sink->json_object = NULL;
@@ -240,6 +266,9 @@ gst_data_repo_sink_set_property (GObject * object, guint prop_id,
       sink->json_filename = g_value_dup_string (value);
       GST_INFO_OBJECT (sink, "JSON filename: %s", sink->json_filename);
       break;
+    case PROP_BINARY_INDEX:
+      sink->binary_index = g_value_get_boolean (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -264,6 +293,9 @@ gst_data_repo_sink_get_property (GObject * object, guint prop_id,
     case PROP_JSON:
       g_value_set_string (value, sink->json_filename);
       break;
+    case PROP_BINARY_INDEX:
+      g_value_set_boolean (value, sink->binary_index);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -364,19 +396,31 @@ gst_data_repo_sink_write_flexible_or_sparse_tensors (GstDataRepoSink * sink,
       goto error;
     }
 
-    json_array_add_int_element (sink->tensor_size_array, tensor_size);
+    if (sink->binary_index) {
+      guint64 size_le = GUINT64_TO_LE (tensor_size);
+      g_array_append_val (sink->index_tensor_sizes, size_le);
+    } else {
+      json_array_add_int_element (sink->tensor_size_array, tensor_size);
+    }
     total_write += write_size;
 
     gst_memory_unmap (mem, &info);
     gst_memory_unref (mem);
   }
 
-  json_array_add_int_element (sink->sample_offset_array, sink->fd_offset);
-  sink->fd_offset += total_write;
-
   GST_LOG_OBJECT (sink, "cumulative_tensors: %u", sink->cumulative_tensors);
-  json_array_add_int_element (sink->tensor_count_array,
-      sink->cumulative_tensors);
+  if (sink->binary_index) {
+    GstDataRepoIndexSample record;
+
+    record.offset = GUINT64_TO_LE (sink->fd_offset);
+    record.first_tensor = GUINT64_TO_LE (sink->cumulative_tensors);
+    g_array_append_val (sink->index_samples, record);
+  } else {
+    json_array_add_int_element (sink->sample_offset_array, sink->fd_offset);
+    json_array_add_int_element (sink->tensor_count_array,
+        sink->cumulative_tensors);
+  }
+  sink->fd_offset += total_write;
   sink->cumulative_tensors += num_tensors;
 
   sink->total_samples++;
@@ -710,6 +754,50 @@ __write_json (JsonObject * object, const gchar * filename)
   return ret;
 }
 
+/**
+ * @brief Write the binary sample index of flexible or sparse tensors
+ */
+static gboolean
+gst_data_repo_sink_write_index_file (GstDataRepoSink * sink)
+{
+  g_autofree gchar *filename = NULL;
+  GstDataRepoIndexHeader header;
+  gboolean ret;
+  FILE *fp;
+
+  g_return_val_if_fail (sink->filename != NULL, FALSE);
+
+  filename = gst_data_repo_get_index_filename (sink->filename);
+
+  memcpy (header.magic, GST_DATA_REPO_INDEX_MAGIC, sizeof (header.magic));
+  header.version = GUINT32_TO_LE (GST_DATA_REPO_INDEX_VERSION);
+  header.num_samples = GUINT64_TO_LE (sink->index_samples->len);
+  header.num_tensors = GUINT64_TO_LE (sink->index_tensor_sizes->len);
+
+  fp = g_fopen (filename, "wb");
+  if (!fp) {
+    GST_ERROR_OBJECT (sink, "Failed to open the sample index %s: %s",
+        filename, g_strerror (errno));
+    return FALSE;
+  }
+
+  ret = (fwrite (&header, sizeof (header), 1, fp) == 1);
+  if (ret && sink->index_samples->len > 0)
+    ret = (fwrite (sink->index_samples->data, sizeof (GstDataRepoIndexSample),
+            sink->index_samples->len, fp) == sink->index_samples->len);
+  if (ret && sink->index_tensor_sizes->len > 0)
+    ret = (fwrite (sink->index_tensor_sizes->data, sizeof (guint64),
+            sink->index_tensor_sizes->len,
+            fp) == sink->index_tensor_sizes->len);
+  if (fclose (fp) != 0)
+    ret = FALSE;
+
+  if (!ret)
+    GST_ERROR_OBJECT (sink, "Failed to write the sample index %s", filename);
+
+  return ret;
+}
+
 /**
  * @brief write the meta information to a JSON file
  */
@@ -736,7 +824,12 @@ gst_data_repo_sink_write_json_meta_file (GstDataRepoSink * sink)
   json_object_set_int_member (sink->json_object, "total_samples",
       sink->total_samples);
 
-  if (sink->data_type == GST_DATA_REPO_DATA_TENSOR && !sink->is_static_tensors) {
+  if (sink->data_type == GST_DATA_REPO_DATA_TENSOR && !sink->is_static_tensors
+      && sink->binary_index) {
+    /* the sample offsets and tensor sizes are in the binary index */
+    ret = gst_data_repo_sink_write_index_file (sink);
+  } else if (sink->data_type == GST_DATA_REPO_DATA_TENSOR
+      && !sink->is_static_tensors) {
     json_object_set_array_member (sink->json_object, "sample_offset",
         sink->sample_offset_array);
     json_object_set_array_member (sink->json_object, "tensor_size",
@@ -751,7 +844,8 @@ gst_data_repo_sink_write_json_meta_file (GstDataRepoSink * sink)
     json_object_set_int_member (sink->json_object, "sample_size",
         sink->sample_size);
   }
-  ret = __write_json (sink->json_object, sink->json_filename);
+  if (ret)
+    ret = __write_json (sink->json_object, sink->json_filename);
   if (!ret) {
     GST_ERROR_OBJECT (sink, "Failed to write json meta file: %s",
         sink->json_filename);
@@ -47,6 +47,8 @@ struct _GstDataRepoSink
   JsonArray *tensor_size_array;    /**< size array of flexible tensor */
   JsonArray *tensor_count_array;  /**< array for the number of cumulative tensors */
   guint cumulative_tensors;    /**< the number of cumulated tensors */
+  GArray *index_samples;          /**< sample records of the binary index (GstDataRepoIndexSample) */
+  GArray *index_tensor_sizes;     /**< tensor size records of the binary index (guint64) */
 
   gboolean is_static_tensors;
   gint fd;                        /**< open file descriptor*/
@@ -58,6 +60,7 @@ struct _GstDataRepoSink
   /* property */
   gchar *filename;    /**< filename */
   gchar *json_filename; /**< "JSON file path to store the meta information */
+  gboolean binary_index;  /**< write the offsets and sizes of flexible or sparse tensors to the binary index instead of JSON */
 };
 
 /**
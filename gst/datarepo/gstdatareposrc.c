@@ -18,6 +18,9 @@
  * gst-launch-1.0 datareposrc location=audiofile json=audio.json ! fakesink
  * gst-launch-1.0 datareposrc location=videofile json=video.json ! fakesink
  * |]
+ * |[ Map the file without copying the samples, and read 8 samples ahead in the background
+ * gst-launch-1.0 datareposrc location=mnist.data json=mnist.json use-mmap=true prefetch=8 ! tensor_sink
+ * |]
  * |[ Unknown sample file(has not JSON) need to set caps and blocksize or set caps to tensors type without blocksize
  * gst-launch-1.0 datareposrc blocksize=3176 location=unknown.data start-sample-index=3 stop-sample-index=202 epochs=5 \
  * caps ="application/octet-stream" ! tensor_converter input-dim=1:1:784:1,1:1:10:1 input-type=float32,float32 ! fakesink
@@ -46,6 +49,7 @@
 #include <string.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <inttypes.h>
 #include "gstdatareposrc.h"
 
@@ -85,11 +89,16 @@ enum
   PROP_IS_SHUFFLE,
   PROP_TENSORS_SEQUENCE,
   PROP_CAPS,                    /* for setting caps of sample data directly */
+  PROP_USE_MMAP,
+  PROP_PREFETCH,
 };
 
 #define DEFAULT_INDEX 0
 #define DEFAULT_EPOCHS 1
 #define DEFAULT_IS_SHUFFLE TRUE
+#define DEFAULT_USE_MMAP FALSE
+#define DEFAULT_PREFETCH 0
+#define MAX_PREFETCH 1024
 
 static void gst_data_repo_src_finalize (GObject * object);
 static GstStateChangeReturn gst_data_repo_src_change_state (GstElement *
@@ -99,6 +108,8 @@ static void gst_data_repo_src_set_property (GObject * object, guint prop_id,
 static void gst_data_repo_src_get_property (GObject * object, guint prop_id,
     GValue * value, GParamSpec * pspec);
 static gboolean gst_data_repo_src_stop (GstBaseSrc * basesrc);
+static gboolean gst_data_repo_src_unlock (GstBaseSrc * basesrc);
+static gboolean gst_data_repo_src_unlock_stop (GstBaseSrc * basesrc);
 static GstCaps *gst_data_repo_src_get_caps (GstBaseSrc * basesrc,
     GstCaps * filter);
 static gboolean gst_data_repo_src_set_caps (GstBaseSrc * basesrc,
@@ -195,6 +206,23 @@ gst_data_repo_src_class_init (GstDataRepoSrcClass * klass)
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
           GST_PARAM_MUTABLE_READY));
 
+  g_object_class_install_property (gobject_class, PROP_USE_MMAP,
+      g_param_spec_boolean ("use-mmap", "Use mmap",
+          "If the value is true, the file is memory-mapped and the samples are "
+          "pushed without copying (read-only memories). Not used for image files",
+          DEFAULT_USE_MMAP,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_PREFETCH,
+      g_param_spec_uint ("prefetch", "Prefetch",
+          "The number of samples read ahead in a background thread, "
+          "in the (shuffled) order to be pushed. 0 to read each sample "
+          "in the streaming thread",
+          0, MAX_PREFETCH, DEFAULT_PREFETCH,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
   gobject_class->finalize = gst_data_repo_src_finalize;
   gstelement_class->change_state = gst_data_repo_src_change_state;
 
@@ -206,6 +234,9 @@ gst_data_repo_src_class_init (GstDataRepoSrcClass * klass)
   gst_element_class_add_static_pad_template (gstelement_class, &srctemplate);
 
   gstbasesrc_class->stop = GST_DEBUG_FUNCPTR (gst_data_repo_src_stop);
+  gstbasesrc_class->unlock = GST_DEBUG_FUNCPTR (gst_data_repo_src_unlock);
+  gstbasesrc_class->unlock_stop =
+      GST_DEBUG_FUNCPTR (gst_data_repo_src_unlock_stop);
   gstbasesrc_class->get_caps = GST_DEBUG_FUNCPTR (gst_data_repo_src_get_caps);
   gstbasesrc_class->set_caps = GST_DEBUG_FUNCPTR (gst_data_repo_src_set_caps);
   gstpushsrc_class->create = GST_DEBUG_FUNCPTR (gst_data_repo_src_create);
@@ -245,6 +276,11 @@ gst_data_repo_src_init (GstDataRepoSrc * src)
   src->tensor_size_array_len = 0;
   src->tensor_count_array = NULL;
   src->tensor_count_array_len = 0;
+  src->index_file = NULL;
+  src->index_samples = NULL;
+  src->index_tensor_sizes = NULL;
+  src->index_num_samples = 0;
+  src->index_num_tensors = 0;
   src->first_epoch_is_done = FALSE;
   src->is_shuffle = DEFAULT_IS_SHUFFLE;
   src->num_samples = 0;
@@ -257,6 +293,16 @@ gst_data_repo_src_init (GstDataRepoSrc * src)
   src->n_frame = 0;
   src->running_time = 0;
   src->parser = NULL;
+  src->use_mmap = DEFAULT_USE_MMAP;
+  src->mapped_mem = NULL;
+  src->prefetch = DEFAULT_PREFETCH;
+  src->prefetch_thread = NULL;
+  src->prefetch_queue = g_queue_new ();
+  src->prefetch_ret = GST_FLOW_OK;
+  src->prefetch_running = FALSE;
+  src->prefetch_flushing = FALSE;
+  g_mutex_init (&src->prefetch_lock);
+  g_cond_init (&src->prefetch_cond);
 
   /* Filling the buffer should be pending until set_caps() */
   gst_base_src_set_format (GST_BASE_SRC (src), GST_FORMAT_TIME);
@@ -284,12 +330,22 @@ gst_data_repo_src_finalize (GObject * object)
   if (src->parser)
     g_object_unref (src->parser);
 
+  if (src->index_file)
+    g_mapped_file_unref (src->index_file);
+
   if (src->shuffled_index_array)
     g_array_free (src->shuffled_index_array, TRUE);
 
   if (src->caps)
     gst_caps_replace (&src->caps, NULL);
 
+  if (src->mapped_mem)
+    gst_memory_unref (src->mapped_mem);
+
+  g_queue_free_full (src->prefetch_queue, (GDestroyNotify) gst_buffer_unref);
+  g_mutex_clear (&src->prefetch_lock);
+  g_cond_clear (&src->prefetch_cond);
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -467,6 +523,107 @@ gst_data_repo_src_epoch_is_done (GstDataRepoSrc * src)
   return TRUE;
 }
 
+/**
+ * @brief Function to read a region of the file into a memory.
+ *        If the file is mapped, the memory shares the mapped region without copying.
+ */
+static GstFlowReturn
+gst_data_repo_src_read_memory (GstDataRepoSrc * src, guint64 offset,
+    guint size, GstMemory ** memory)
+{
+  GstFlowReturn ret = GST_FLOW_OK;
+  guint to_read, byte_read;
+  int read_size;
+  guint8 *data;
+  GstMemory *mem;
+  GstMapInfo info;
+
+  if (src->mapped_mem) {
+    if (offset + size > src->mapped_mem->size) {
+      GST_DEBUG_OBJECT (src, "EOS, the region 0x%" G_GINT64_MODIFIER
+          "x (%u bytes) is out of the file", offset, size);
+      return GST_FLOW_EOS;
+    }
+
+    mem = gst_memory_share (src->mapped_mem, offset, size);
+
+    /* let the kernel read the pages of the sample in advance */
+    if (src->prefetch > 0) {
+      GstMapInfo mapped;
+      guintptr page_mask = (guintptr) sysconf (_SC_PAGESIZE) - 1;
+      guintptr start, end;
+
+      if (gst_memory_map (mem, &mapped, GST_MAP_READ)) {
+        start = (guintptr) mapped.data & ~page_mask;
+        end = (guintptr) mapped.data + mapped.size;
+        posix_madvise ((gpointer) start, end - start, POSIX_MADV_WILLNEED);
+        gst_memory_unmap (mem, &mapped);
+      }
+    }
+
+    src->fd_offset = offset + size;
+    src->read_position += size;
+    *memory = mem;
+    return GST_FLOW_OK;
+  }
+
+  mem = gst_allocator_alloc (NULL, size, NULL);
+
+  if (!gst_memory_map (mem, &info, GST_MAP_WRITE)) {
+    GST_ERROR_OBJECT (src, "Could not map GstMemory");
+    gst_memory_unref (mem);
+    return GST_FLOW_ERROR;
+  }
+
+  data = info.data;
+
+  byte_read = 0;
+  to_read = size;
+  src->fd_offset = lseek (src->fd, offset, SEEK_SET);
+
+  while (to_read > 0) {
+    GST_LOG_OBJECT (src,
+        "Reading %d bytes at offset 0x%" G_GINT64_MODIFIER "x (%d size)",
+        to_read, src->fd_offset + byte_read,
+        (guint) src->fd_offset + byte_read);
+    errno = 0;
+    read_size = read (src->fd, data + byte_read, to_read);
+    GST_LOG_OBJECT (src, "Read: %d", read_size);
+    if (read_size < 0) {
+      if (errno == EAGAIN || errno == EINTR)
+        continue;
+      GST_ELEMENT_ERROR (src, RESOURCE, READ, (NULL), GST_ERROR_SYSTEM);
+      ret = GST_FLOW_ERROR;
+      goto error;
+    }
+    /* files should eos if they read 0 and more was requested */
+    if (read_size == 0) {
+      /* .. but first we should return any remaining data */
+      if (byte_read > 0)
+        break;
+      GST_DEBUG ("EOS");
+      ret = GST_FLOW_EOS;
+      goto error;
+    }
+    to_read -= read_size;
+    byte_read += read_size;
+
+    src->read_position += read_size;
+    src->fd_offset += read_size;
+  }
+
+  gst_memory_unmap (mem, &info);
+  *memory = mem;
+
+  return GST_FLOW_OK;
+
+error:
+  gst_memory_unmap (mem, &info);
+  gst_memory_unref (mem);
+
+  return ret;
+}
+
 /**
  * @brief Function to read tensors
  */
@@ -476,11 +633,7 @@ gst_data_repo_src_read_tensors (GstDataRepoSrc * src, GstBuffer ** buffer)
   GstFlowReturn ret = GST_FLOW_OK;
   guint i = 0, seq_idx = 0;
   GstBuffer *buf;
-  guint to_read, byte_read;
-  int read_size;
-  guint8 *data;
   GstMemory *mem = NULL;
-  GstMapInfo info;
   guint shuffled_index = 0;
   guint64 sample_offset = 0;
   guint64 offset = 0;           /* offset from 0 */
@@ -517,13 +670,6 @@ gst_data_repo_src_read_tensors (GstDataRepoSrc * src, GstBuffer ** buffer)
 
   for (i = 0; i < src->tensors_seq_cnt; i++) {
     seq_idx = src->tensors_seq[i];
-    mem = gst_allocator_alloc (NULL, src->tensors_size[seq_idx], NULL);
-
-    if (!gst_memory_map (mem, &info, GST_MAP_WRITE)) {
-      GST_ERROR_OBJECT (src, "Could not map GstMemory[%d]", i);
-      ret = GST_FLOW_ERROR;
-      goto error;
-    }
 
     GST_INFO_OBJECT (src, "sequence index: %d", seq_idx);
     GST_INFO_OBJECT (src, "tensor_size[%d]: %d", seq_idx,
@@ -544,46 +690,12 @@ gst_data_repo_src_read_tensors (GstDataRepoSrc * src, GstBuffer ** buffer)
         -------------------------------------------------
       if user sets "tensor-sequence=2,1", datareposrc read offset 9528 then 9488.
     */
-
-    data = info.data;
-
-    byte_read = 0;
-    to_read = src->tensors_size[seq_idx];
     offset = sample_offset + src->tensors_offset[seq_idx];
-    src->fd_offset = lseek (src->fd, offset, SEEK_SET);
-
-    while (to_read > 0) {
-      GST_LOG_OBJECT (src,
-          "Reading %d bytes at offset 0x%" G_GINT64_MODIFIER "x (%d size)",
-          to_read, src->fd_offset + byte_read,
-          (guint) src->fd_offset + byte_read);
-      errno = 0;
-      read_size = read (src->fd, data + byte_read, to_read);
-      GST_LOG_OBJECT (src, "Read: %d", read_size);
-      if (read_size < 0) {
-        if (errno == EAGAIN || errno == EINTR)
-          continue;
-        GST_ELEMENT_ERROR (src, RESOURCE, READ, (NULL), GST_ERROR_SYSTEM);
-        ret = GST_FLOW_ERROR;
-        goto error;
-      }
-      /* files should eos if they read 0 and more was requested */
-      if (read_size == 0) {
-        /* .. but first we should return any remaining data */
-        if (byte_read > 0)
-          break;
-        GST_DEBUG ("EOS");
-        ret = GST_FLOW_EOS;
-        goto error;
-      }
-      to_read -= read_size;
-      byte_read += read_size;
-
-      src->read_position += read_size;
-      src->fd_offset += read_size;
-    }
+    ret = gst_data_repo_src_read_memory (src, offset,
+        src->tensors_size[seq_idx], &mem);
+    if (ret != GST_FLOW_OK)
+      goto error;
 
-    gst_memory_unmap (mem, &info);
     gst_buffer_append_memory (buf, mem);
   }
 
@@ -592,45 +704,68 @@ gst_data_repo_src_read_tensors (GstDataRepoSrc * src, GstBuffer ** buffer)
   return GST_FLOW_OK;
 
 error:
-  if (mem) {
-    gst_memory_unmap (mem, &info);
-    gst_memory_unref (mem);
-  }
-
   gst_buffer_unref (buf);
 
   return ret;
 }
 
 /**
- * @brief Function to get num_tensors from tensor_count_array
+ * @brief Function to get the offset and tensors of a sample, from the binary index or JSON arrays
  */
-static guint
-gst_data_repo_src_get_num_tensors (GstDataRepoSrc * src, guint shuffled_index)
+static gboolean
+gst_data_repo_src_get_sample_info (GstDataRepoSrc * src, guint sample_index,
+    guint64 * offset, guint64 * first_tensor, guint * num_tensors)
 {
-  guint num_tensors = 0;
-  guint cur_idx_tensor_cnt = 0;
-  guint next_idx_tensor_cnt = 0;
+  guint64 next_first_tensor;
 
-  g_return_val_if_fail (src != NULL, 0);
+  g_return_val_if_fail (src != NULL, FALSE);
 
-  cur_idx_tensor_cnt =
-      json_array_get_int_element (src->tensor_count_array, shuffled_index);
-  GST_DEBUG_OBJECT (src, "cur_idx_tensor_cnt:%u", cur_idx_tensor_cnt);
+  if (src->index_file) {
+    if (sample_index >= src->index_num_samples)
+      return FALSE;
 
-  if (shuffled_index + 1 == src->tensor_count_array_len) {
-    next_idx_tensor_cnt = src->tensor_size_array_len;
+    *offset = GUINT64_FROM_LE (src->index_samples[sample_index].offset);
+    *first_tensor =
+        GUINT64_FROM_LE (src->index_samples[sample_index].first_tensor);
+    if (sample_index + 1 == src->index_num_samples)
+      next_first_tensor = src->index_num_tensors;
+    else
+      next_first_tensor =
+          GUINT64_FROM_LE (src->index_samples[sample_index + 1].first_tensor);
+
+    if (*first_tensor > next_first_tensor
+        || next_first_tensor > src->index_num_tensors)
+      return FALSE;
   } else {
-    next_idx_tensor_cnt =
-        json_array_get_int_element (src->tensor_count_array,
-        shuffled_index + 1);
+    *offset =
+        json_array_get_int_element (src->sample_offset_array, sample_index);
+    *first_tensor =
+        json_array_get_int_element (src->tensor_count_array, sample_index);
+    if (sample_index + 1 == src->tensor_count_array_len)
+      next_first_tensor = src->tensor_size_array_len;
+    else
+      next_first_tensor =
+          json_array_get_int_element (src->tensor_count_array,
+          sample_index + 1);
   }
-  GST_DEBUG_OBJECT (src, "next_idx_tensor_cnt:%u", next_idx_tensor_cnt);
 
-  num_tensors = next_idx_tensor_cnt - cur_idx_tensor_cnt;
-  GST_DEBUG_OBJECT (src, "num_tensors:%u", num_tensors);
+  *num_tensors = next_first_tensor - *first_tensor;
+  GST_DEBUG_OBJECT (src, "first tensor: %" G_GUINT64_FORMAT
+      ", num_tensors: %u", *first_tensor, *num_tensors);
+
+  return TRUE;
+}
+
+/**
+ * @brief Function to get the size of a flexible or sparse tensor, from the binary index or JSON arrays
+ */
+static guint
+gst_data_repo_src_get_tensor_size (GstDataRepoSrc * src, guint64 tensor_index)
+{
+  if (src->index_file)
+    return (guint) GUINT64_FROM_LE (src->index_tensor_sizes[tensor_index]);
 
-  return num_tensors;
+  return json_array_get_int_element (src->tensor_size_array, tensor_index);
 }
 
 /**
@@ -643,16 +778,14 @@ gst_data_repo_src_read_flexible_or_sparse_tensors (GstDataRepoSrc * src,
   GstFlowReturn ret = GST_FLOW_OK;
   guint i;
   guint shuffled_index = 0;
-  gint64 sample_offset;
+  guint64 sample_offset;
   guint num_tensors = 0;
   GstBuffer *buf;
   GstMemory *mem;
   GstMapInfo info;
   GstTensorMetaInfo meta;
-  guint to_read, byte_read;
-  int read_size;
-  guint8 *data;
-  guint tensor_count;
+  gboolean valid;
+  guint64 tensor_count;
   guint tensor_size;
 
   g_return_val_if_fail (src->fd != 0, GST_FLOW_ERROR);
@@ -680,71 +813,42 @@ gst_data_repo_src_read_flexible_or_sparse_tensors (GstDataRepoSrc * src,
       shuffled_index);
 
   /* sample offset from 0 */
-  sample_offset =
-      json_array_get_int_element (src->sample_offset_array, shuffled_index);
+  if (!gst_data_repo_src_get_sample_info (src, shuffled_index, &sample_offset,
+          &tensor_count, &num_tensors)) {
+    GST_ELEMENT_ERROR (src, RESOURCE, READ,
+        ("Invalid sample index %u.", shuffled_index), (NULL));
+    return GST_FLOW_ERROR;
+  }
   GST_LOG_OBJECT (src, "sample offset 0x%" G_GINT64_MODIFIER "x (%d size)",
       sample_offset, (guint) sample_offset);
 
-  src->fd_offset = lseek (src->fd, sample_offset, SEEK_SET);
-
   buf = gst_buffer_new ();
 
-  tensor_count =
-      json_array_get_int_element (src->tensor_count_array, shuffled_index);
-  num_tensors = gst_data_repo_src_get_num_tensors (src, shuffled_index);
-
   for (i = 0; i < num_tensors; i++) {
-    tensor_size =
-        json_array_get_int_element (src->tensor_size_array, tensor_count + i);
-    mem = gst_allocator_alloc (NULL, tensor_size, NULL);
+    tensor_size = gst_data_repo_src_get_tensor_size (src, tensor_count + i);
 
-    if (!gst_memory_map (mem, &info, GST_MAP_WRITE)) {
+    ret = gst_data_repo_src_read_memory (src, sample_offset, tensor_size, &mem);
+    if (ret != GST_FLOW_OK)
+      goto error;
+    sample_offset += tensor_size;
+
+    /* check invalid flexible tensor */
+    if (!gst_memory_map (mem, &info, GST_MAP_READ)) {
       GST_ERROR_OBJECT (src, "Could not map GstMemory[%d]", i);
+      gst_memory_unref (mem);
       ret = GST_FLOW_ERROR;
       goto error;
     }
+    valid = gst_tensor_meta_info_parse_header (&meta, info.data);
+    gst_memory_unmap (mem, &info);
 
-    data = info.data;
-    byte_read = 0;
-    to_read = tensor_size;
-    while (to_read > 0) {
-      GST_LOG_OBJECT (src,
-          "Reading %d bytes at offset 0x%" G_GINT64_MODIFIER "x (%lld size)",
-          to_read, src->fd_offset + byte_read, (long long) src->fd_offset);
-      errno = 0;
-      read_size = read (src->fd, data + byte_read, to_read);
-      GST_LOG_OBJECT (src, "Read: %d", read_size);
-      if (read_size < 0) {
-        if (errno == EAGAIN || errno == EINTR)
-          continue;
-        GST_ELEMENT_ERROR (src, RESOURCE, READ, (NULL), GST_ERROR_SYSTEM);
-        ret = GST_FLOW_ERROR;
-        goto error;
-      }
-      /* files should eos if they read 0 and more was requested */
-      if (read_size == 0) {
-        /* .. but first we should return any remaining data */
-        if (byte_read > 0)
-          break;
-        GST_DEBUG ("EOS");
-        ret = GST_FLOW_EOS;
-        goto error;
-      }
-      to_read -= read_size;
-      byte_read += read_size;
-
-      src->read_position += read_size;
-      src->fd_offset += read_size;
-    }
-
-    /* check invalid flexible tensor */
-    if (!gst_tensor_meta_info_parse_header (&meta, info.data)) {
+    if (!valid) {
       GST_ERROR_OBJECT (src, "Invalid flexible tensors");
+      gst_memory_unref (mem);
       ret = GST_FLOW_ERROR;
       goto error;
     }
 
-    gst_memory_unmap (mem, &info);
     gst_buffer_append_memory (buf, mem);
   }
 
@@ -753,10 +857,6 @@ gst_data_repo_src_read_flexible_or_sparse_tensors (GstDataRepoSrc * src,
   return GST_FLOW_OK;
 
 error:
-  if (mem) {
-    gst_memory_unmap (mem, &info);
-    gst_memory_unref (mem);
-  }
   gst_buffer_unref (buf);
 
   return ret;
@@ -879,11 +979,7 @@ gst_data_repo_src_read_others (GstDataRepoSrc * src, GstBuffer ** buffer)
 {
   GstFlowReturn ret = GST_FLOW_OK;
   GstBuffer *buf;
-  guint to_read, byte_read;
-  int read_size;
-  guint8 *data;
   GstMemory *mem;
-  GstMapInfo info;
   guint shuffled_index = 0;
   guint64 offset = 0;
 
@@ -911,63 +1007,109 @@ gst_data_repo_src_read_others (GstDataRepoSrc * src, GstBuffer ** buffer)
   GST_LOG_OBJECT (src, "shuffled_index [%d] -> %d", src->array_index - 1,
       shuffled_index);
   offset = gst_data_repo_src_get_file_offset (src, shuffled_index);
-  src->fd_offset = lseek (src->fd, offset, SEEK_SET);
 
-  mem = gst_allocator_alloc (NULL, src->sample_size, NULL);
+  ret = gst_data_repo_src_read_memory (src, offset, src->sample_size, &mem);
+  if (ret != GST_FLOW_OK)
+    return ret;
 
-  if (!gst_memory_map (mem, &info, GST_MAP_WRITE)) {
-    GST_ERROR_OBJECT (src, "Could not map GstMemory");
-    return GST_FLOW_ERROR;
-  }
+  buf = gst_buffer_new ();
+  gst_buffer_append_memory (buf, mem);
 
-  data = info.data;
+  *buffer = buf;
+  return GST_FLOW_OK;
+}
 
-  byte_read = 0;
-  to_read = src->sample_size;
-  while (to_read > 0) {
-    GST_LOG_OBJECT (src, "Reading %d bytes at offset 0x%" G_GINT64_MODIFIER "x",
-        to_read, src->fd_offset + byte_read);
-    errno = 0;
-    read_size = read (src->fd, data + byte_read, to_read);
-    GST_LOG_OBJECT (src, "Read: %d", read_size);
-    if (read_size < 0) {
-      if (errno == EAGAIN || errno == EINTR)
-        continue;
-      GST_ELEMENT_ERROR (src, RESOURCE, READ, (NULL), GST_ERROR_SYSTEM);
-      ret = GST_FLOW_ERROR;
-      goto error;
-    }
-    /* files should eos if they read 0 and more was requested */
-    if (read_size == 0) {
-      /* .. but first we should return any remaining data */
-      if (byte_read > 0)
-        break;
-      GST_DEBUG ("EOS");
-      ret = GST_FLOW_EOS;
-      goto error;
-    }
-    to_read -= read_size;
-    byte_read += read_size;
+/**
+ * @brief Mapped region of the file, unmapped when the last sample memory is released.
+ */
+typedef struct
+{
+  gpointer data;
+  gsize size;
+} GstDataRepoSrcMapping;
 
-    src->read_position += read_size;
-    src->fd_offset += read_size;
+/**
+ * @brief Function to unmap the file, called when the memory wrapping the mapped file is freed.
+ */
+static void
+gst_data_repo_src_unmap_file (gpointer user_data)
+{
+  GstDataRepoSrcMapping *mapping = user_data;
+
+  munmap (mapping->data, mapping->size);
+  g_free (mapping);
+}
+
+/**
+ * @brief Function to map the opened file. If it fails, the samples are read with read().
+ */
+static void
+gst_data_repo_src_map_file (GstDataRepoSrc * src, gsize size)
+{
+  GstDataRepoSrcMapping *mapping;
+  gpointer data;
+
+  data = mmap (NULL, size, PROT_READ, MAP_PRIVATE, src->fd, 0);
+  if (data == MAP_FAILED) {
+    GST_WARNING_OBJECT (src, "Failed to map the file (%s), read() is used.",
+        g_strerror (errno));
+    return;
   }
 
-  gst_memory_unmap (mem, &info);
+  /* the kernel readahead is useless for the shuffled samples */
+  if (src->is_shuffle)
+    posix_madvise (data, size, POSIX_MADV_RANDOM);
 
-  buf = gst_buffer_new ();
-  gst_buffer_append_memory (buf, mem);
+  mapping = g_new (GstDataRepoSrcMapping, 1);
+  mapping->data = data;
+  mapping->size = size;
 
-  *buffer = buf;
-  return GST_FLOW_OK;
+  src->mapped_mem = gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY, data,
+      size, 0, size, mapping, gst_data_repo_src_unmap_file);
+  GST_INFO_OBJECT (src, "The file is mapped (%" G_GSIZE_FORMAT " bytes)", size);
+}
 
-error:
-  if (mem) {
-    gst_memory_unmap (mem, &info);
-    gst_memory_unref (mem);
+/**
+ * @brief Function to map the binary sample index of flexible or sparse tensors
+ */
+static gboolean
+gst_data_repo_src_load_index (GstDataRepoSrc * src)
+{
+  g_autofree gchar *filename = NULL;
+  GError *error = NULL;
+
+  filename = gst_data_repo_get_index_filename (src->filename);
+
+  if (src->index_file)
+    g_mapped_file_unref (src->index_file);
+
+  src->index_file = g_mapped_file_new (filename, FALSE, &error);
+  if (!src->index_file) {
+    GST_ELEMENT_ERROR (src, RESOURCE, OPEN_READ,
+        ("Could not open the sample index \"%s\".", filename),
+        ("%s", error ? error->message : "Unknown error"));
+    g_clear_error (&error);
+    return FALSE;
   }
 
-  return ret;
+  if (!gst_data_repo_parse_index ((const guint8 *)
+          g_mapped_file_get_contents (src->index_file),
+          g_mapped_file_get_length (src->index_file), &src->index_samples,
+          &src->index_num_samples, &src->index_tensor_sizes,
+          &src->index_num_tensors)
+      || src->index_num_samples != src->total_samples) {
+    GST_ELEMENT_ERROR (src, RESOURCE, READ,
+        ("Invalid sample index \"%s\".", filename), (NULL));
+    g_mapped_file_unref (src->index_file);
+    src->index_file = NULL;
+    return FALSE;
+  }
+
+  GST_INFO_OBJECT (src, "sample index %s: %" G_GUINT64_FORMAT " samples, %"
+      G_GUINT64_FORMAT " tensors", filename, src->index_num_samples,
+      src->index_num_tensors);
+
+  return TRUE;
 }
 
 /**
@@ -1041,6 +1183,15 @@ gst_data_repo_src_start (GstDataRepoSrc * src)
     src->fd_offset = lseek (src->fd, src->start_offset, SEEK_SET);
     GST_LOG_OBJECT (src, "Start file offset 0x%" G_GINT64_MODIFIER "x",
         src->fd_offset);
+
+    if (src->use_mmap)
+      gst_data_repo_src_map_file (src, stat_results.st_size);
+
+    /* JSON without the sample offsets refers to the binary index */
+    if (src->data_type == GST_DATA_REPO_DATA_TENSOR && !src->is_static_tensors
+        && src->sample_offset_array == NULL
+        && !gst_data_repo_src_load_index (src))
+      goto error_close;
   }
 
   return TRUE;
@@ -1131,6 +1282,138 @@ gst_data_repo_src_set_timestamp (GstDataRepoSrc * src, GstBuffer * buffer)
       GST_TIME_ARGS (GST_BUFFER_DURATION (buffer)));
 }
 
+/**
+ * @brief Function to read a sample according to the data type
+ */
+static GstFlowReturn
+gst_data_repo_src_read_sample (GstDataRepoSrc * src, GstBuffer ** buffer)
+{
+  switch (src->data_type) {
+    case GST_DATA_REPO_DATA_VIDEO:
+    case GST_DATA_REPO_DATA_AUDIO:
+    case GST_DATA_REPO_DATA_TEXT:
+    case GST_DATA_REPO_DATA_OCTET:
+      return gst_data_repo_src_read_others (src, buffer);
+    case GST_DATA_REPO_DATA_TENSOR:
+      if (src->is_static_tensors)
+        return gst_data_repo_src_read_tensors (src, buffer);
+      return gst_data_repo_src_read_flexible_or_sparse_tensors (src, buffer);
+    case GST_DATA_REPO_DATA_IMAGE:
+      return gst_data_repo_src_read_multi_images (src, buffer);
+    default:
+      return GST_FLOW_ERROR;
+  }
+}
+
+/**
+ * @brief The prefetch thread, reading the samples ahead until the queue is full
+ */
+static gpointer
+gst_data_repo_src_prefetch_loop (gpointer user_data)
+{
+  GstDataRepoSrc *src = GST_DATA_REPO_SRC (user_data);
+  GstFlowReturn ret = GST_FLOW_OK;
+  GstBuffer *buf;
+
+  g_mutex_lock (&src->prefetch_lock);
+  while (src->prefetch_running && ret == GST_FLOW_OK) {
+    if (g_queue_get_length (src->prefetch_queue) >= src->prefetch) {
+      g_cond_wait (&src->prefetch_cond, &src->prefetch_lock);
+      continue;
+    }
+
+    /* the sample is read without the lock, create () takes the buffers read before */
+    g_mutex_unlock (&src->prefetch_lock);
+    buf = NULL;
+    ret = gst_data_repo_src_read_sample (src, &buf);
+    g_mutex_lock (&src->prefetch_lock);
+
+    if (ret == GST_FLOW_OK)
+      g_queue_push_tail (src->prefetch_queue, buf);
+    else
+      src->prefetch_ret = ret;
+    g_cond_broadcast (&src->prefetch_cond);
+  }
+  g_mutex_unlock (&src->prefetch_lock);
+
+  return NULL;
+}
+
+/**
+ * @brief Function to start the prefetch thread
+ */
+static gboolean
+gst_data_repo_src_start_prefetch (GstDataRepoSrc * src)
+{
+  GError *error = NULL;
+
+  g_mutex_lock (&src->prefetch_lock);
+  src->prefetch_ret = GST_FLOW_OK;
+  src->prefetch_running = TRUE;
+  g_mutex_unlock (&src->prefetch_lock);
+
+  src->prefetch_thread = g_thread_try_new ("datareposrc-prefetch",
+      gst_data_repo_src_prefetch_loop, src, &error);
+  if (!src->prefetch_thread) {
+    GST_ELEMENT_ERROR (src, RESOURCE, FAILED,
+        ("Failed to create the prefetch thread."), ("%s", error->message));
+    g_error_free (error);
+    src->prefetch_running = FALSE;
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Function to stop the prefetch thread and drop the samples read ahead
+ */
+static void
+gst_data_repo_src_stop_prefetch (GstDataRepoSrc * src)
+{
+  if (!src->prefetch_thread)
+    return;
+
+  g_mutex_lock (&src->prefetch_lock);
+  src->prefetch_running = FALSE;
+  g_cond_broadcast (&src->prefetch_cond);
+  g_mutex_unlock (&src->prefetch_lock);
+
+  g_thread_join (src->prefetch_thread);
+  src->prefetch_thread = NULL;
+
+  /* g_queue_clear_full() requires GLib 2.60 */
+  g_queue_foreach (src->prefetch_queue, (GFunc) gst_buffer_unref, NULL);
+  g_queue_clear (src->prefetch_queue);
+}
+
+/**
+ * @brief Function to get the sample read ahead by the prefetch thread
+ */
+static GstFlowReturn
+gst_data_repo_src_pop_prefetched (GstDataRepoSrc * src, GstBuffer ** buffer)
+{
+  GstFlowReturn ret;
+
+  g_mutex_lock (&src->prefetch_lock);
+  while (g_queue_is_empty (src->prefetch_queue) &&
+      src->prefetch_ret == GST_FLOW_OK && !src->prefetch_flushing)
+    g_cond_wait (&src->prefetch_cond, &src->prefetch_lock);
+
+  if (src->prefetch_flushing) {
+    ret = GST_FLOW_FLUSHING;
+  } else if (!g_queue_is_empty (src->prefetch_queue)) {
+    *buffer = g_queue_pop_head (src->prefetch_queue);
+    g_cond_broadcast (&src->prefetch_cond);
+    ret = GST_FLOW_OK;
+  } else {
+    ret = src->prefetch_ret;
+  }
+  g_mutex_unlock (&src->prefetch_lock);
+
+  return ret;
+}
+
 /**
  * @brief Function to create a buffer
  */
@@ -1150,24 +1433,13 @@ gst_data_repo_src_create (GstPushSrc * pushsrc, GstBuffer ** buffer)
     src->is_start = TRUE;
   }
 
-  switch (src->data_type) {
-    case GST_DATA_REPO_DATA_VIDEO:
-    case GST_DATA_REPO_DATA_AUDIO:
-    case GST_DATA_REPO_DATA_TEXT:
-    case GST_DATA_REPO_DATA_OCTET:
-      ret = gst_data_repo_src_read_others (src, buffer);
-      break;
-    case GST_DATA_REPO_DATA_TENSOR:
-      if (src->is_static_tensors)
-        ret = gst_data_repo_src_read_tensors (src, buffer);
-      else
-        ret = gst_data_repo_src_read_flexible_or_sparse_tensors (src, buffer);
-      break;
-    case GST_DATA_REPO_DATA_IMAGE:
-      ret = gst_data_repo_src_read_multi_images (src, buffer);
-      break;
-    default:
+  if (src->prefetch > 0) {
+    if (!src->prefetch_thread && !gst_data_repo_src_start_prefetch (src))
       return GST_FLOW_ERROR;
+
+    ret = gst_data_repo_src_pop_prefetched (src, buffer);
+  } else {
+    ret = gst_data_repo_src_read_sample (src, buffer);
   }
 
   if (ret != GST_FLOW_OK)
@@ -1187,6 +1459,19 @@ gst_data_repo_src_stop (GstBaseSrc * basesrc)
 {
   GstDataRepoSrc *src = GST_DATA_REPO_SRC (basesrc);
 
+  gst_data_repo_src_stop_prefetch (src);
+
+  if (src->index_file) {
+    g_mapped_file_unref (src->index_file);
+    src->index_file = NULL;
+  }
+
+  /* the mapping is released when the pushed samples are freed */
+  if (src->mapped_mem) {
+    gst_memory_unref (src->mapped_mem);
+    src->mapped_mem = NULL;
+  }
+
   /* close the file */
   g_close (src->fd, NULL);
   src->fd = 0;
@@ -1194,6 +1479,37 @@ gst_data_repo_src_stop (GstBaseSrc * basesrc)
   return TRUE;
 }
 
+/**
+ * @brief Unblock create () waiting for the prefetch thread
+ */
+static gboolean
+gst_data_repo_src_unlock (GstBaseSrc * basesrc)
+{
+  GstDataRepoSrc *src = GST_DATA_REPO_SRC (basesrc);
+
+  g_mutex_lock (&src->prefetch_lock);
+  src->prefetch_flushing = TRUE;
+  g_cond_broadcast (&src->prefetch_cond);
+  g_mutex_unlock (&src->prefetch_lock);
+
+  return TRUE;
+}
+
+/**
+ * @brief Clear the unlock state of create ()
+ */
+static gboolean
+gst_data_repo_src_unlock_stop (GstBaseSrc * basesrc)
+{
+  GstDataRepoSrc *src = GST_DATA_REPO_SRC (basesrc);
+
+  g_mutex_lock (&src->prefetch_lock);
+  src->prefetch_flushing = FALSE;
+  g_mutex_unlock (&src->prefetch_lock);
+
+  return TRUE;
+}
+
 /**
  * @brief Get caps with tensors_sequence applied
  */
@@ -1505,11 +1821,16 @@ gst_data_repo_src_read_json_file (GstDataRepoSrc * src)
     GST_INFO_OBJECT (src, "sample_size: %d", src->sample_size);
   }
 
-  if (src->data_type == GST_DATA_REPO_DATA_TENSOR && !src->is_static_tensors) {
-    if (!json_object_has_member (object, "sample_offset")) {
-      GST_ERROR_OBJECT (src, "There is no sample_offset field: %s", contents);
-      goto error;
-    }
+  src->sample_offset_array = NULL;
+  src->tensor_size_array = NULL;
+  src->tensor_count_array = NULL;
+
+  if (src->data_type == GST_DATA_REPO_DATA_TENSOR && !src->is_static_tensors &&
+      !json_object_has_member (object, "sample_offset")) {
+    /* written with binary-index, mapped when the data file is opened */
+    GST_INFO_OBJECT (src, "The sample offsets are in the binary index.");
+  } else if (src->data_type == GST_DATA_REPO_DATA_TENSOR
+      && !src->is_static_tensors) {
     src->sample_offset_array =
         json_object_get_array_member (object, "sample_offset");
     src->sample_offset_array_len =
@@ -1627,6 +1948,12 @@ gst_data_repo_src_set_property (GObject * object, guint prop_id,
           src->need_changed_caps = TRUE;
       }
       break;
+    case PROP_USE_MMAP:
+      src->use_mmap = g_value_get_boolean (value);
+      break;
+    case PROP_PREFETCH:
+      src->prefetch = g_value_get_uint (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1671,6 +1998,12 @@ gst_data_repo_src_get_property (GObject * object, guint prop_id, GValue * value,
     case PROP_CAPS:
       gst_value_set_caps (value, src->caps);
       break;
+    case PROP_USE_MMAP:
+      g_value_set_boolean (value, src->use_mmap);
+      break;
+    case PROP_PREFETCH:
+      g_value_set_uint (value, src->prefetch);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -72,6 +72,8 @@ struct _GstDataRepoSrc {
   guint stop_sample_index;      /**< stop index of sample to read, in case of image, the stoppting index of the numbered files */
   guint epochs;                 /**< repetition of range of files or samples to read */
   gboolean is_shuffle;          /**< shuffle the sample index */
+  gboolean use_mmap;            /**< map the file and wrap the sample regions without copying */
+  guint prefetch;               /**< the number of samples read ahead in the background thread, 0 to read in the streaming thread */
 
   GArray *shuffled_index_array; /**< shuffled sample index array */
   guint array_index;            /**< element index of shuffled_index_array */
@@ -89,6 +91,23 @@ struct _GstDataRepoSrc {
   guint sample_offset_array_len;
   guint tensor_size_array_len;
   guint tensor_count_array_len;
+  GMappedFile *index_file;          /**< binary sample index, used if JSON does not have the arrays above */
+  const GstDataRepoIndexSample *index_samples; /**< sample records in index_file */
+  const guint64 *index_tensor_sizes; /**< tensor size records in index_file */
+  guint64 index_num_samples;        /**< the number of sample records */
+  guint64 index_num_tensors;        /**< the number of tensor size records */
+
+  /* mmap */
+  GstMemory *mapped_mem;        /**< memory wrapping the mapped file, the sample memories share it */
+
+  /* prefetch */
+  GThread *prefetch_thread;     /**< thread reading the samples ahead */
+  GQueue *prefetch_queue;       /**< buffers read ahead, up to 'prefetch' */
+  GstFlowReturn prefetch_ret;   /**< the last result of the prefetch thread, returned after the queue is drained */
+  gboolean prefetch_running;    /**< TRUE until the prefetch thread is asked to stop */
+  gboolean prefetch_flushing;   /**< TRUE while create () should not wait for the prefetch thread */
+  GMutex prefetch_lock;         /**< lock for the prefetch queue */
+  GCond prefetch_cond;          /**< signalled when a buffer is pushed or popped */
 
   GstClockTime running_time;    /**< one frame running time */
   gint rate_n, rate_d;
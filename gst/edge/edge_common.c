@@ -15,6 +15,7 @@
 #endif
 
 #include "edge_common.h"
+#include "../nnstreamer/nnstreamer_log.h"
 
 /**
  * @brief register GEnumValue array for edge protocol property handling
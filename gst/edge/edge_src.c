@@ -15,6 +15,7 @@
 #endif
 
 #include "edge_src.h"
+#include "../nnstreamer/nnstreamer_edge_data.h"
 
 GST_DEBUG_CATEGORY_STATIC (gst_edgesrc_debug);
 #define GST_CAT_DEFAULT gst_edgesrc_debug
@@ -348,8 +349,6 @@ gst_edgesrc_create (GstBaseSrc * basesrc, guint64 offset, guint size,
 
   nns_edge_data_h data_h;
   GstBuffer *buffer = NULL;
-  guint i, num_data;
-  int ret;
 
   UNUSED (offset);
   UNUSED (size);
@@ -361,30 +360,10 @@ gst_edgesrc_create (GstBaseSrc * basesrc, guint64 offset, guint size,
     goto done;
   }
 
-  ret = nns_edge_data_get_count (data_h, &num_data);
-  if (ret != NNS_EDGE_ERROR_NONE || num_data == 0) {
-    nns_loge ("Failed to get the number of memories of the edge data.");
-    goto done;
-  }
-
-  buffer = gst_buffer_new ();
-  for (i = 0; i < num_data; i++) {
-    void *data = NULL;
-    nns_size_t data_len = 0;
-    gpointer new_data;
-
-    nns_edge_data_get (data_h, i, &data, &data_len);
-    new_data = _g_memdup (data, data_len);
-
-    gst_buffer_append_memory (buffer,
-        gst_memory_new_wrapped (0, new_data, data_len, 0, data_len, new_data,
-            g_free));
-  }
+  /* The buffer takes the received memories without copying. */
+  buffer = gst_edge_data_to_buffer (data_h);
 
 done:
-  if (data_h)
-    nns_edge_data_destroy (data_h);
-
   if (buffer == NULL) {
     nns_loge ("Failed to get buffer to push to the edgesrc.");
     return GST_FLOW_ERROR;
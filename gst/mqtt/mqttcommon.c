@@ -0,0 +1,497 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ */
+/**
+ * @file    mqttcommon.c
+ * @date    16 Oct 2026
+ * @brief   Encoder and decoder of the compact message header for GStreamer MQTT plugins
+ * @see     https://github.com/nnstreamer/nnstreamer
+ * @bug     No known bugs except for NYI items
+ *
+ * Layout of the compact header (multi-byte integers are unsigned LEB128
+ * varints, signed ones are zigzag-encoded before):
+ *   'N' 'M' 'Q' version flags caps_hash(4, LE)
+ *   num_mems size_mems[num_mems]
+ *   base_time_epoch (signed) sent_time_epoch - base_time_epoch (signed)
+ *   [pts] [dts] [duration]        (only if the corresponding flag is set)
+ *   [caps_len caps_str]           (only if GST_MQTT_HDR_FLAG_CAPS is set)
+ * With GST_MQTT_HDR_FLAG_AGGREGATED, a message carries several buffers:
+ *   'N' 'M' 'Q' version flags caps_hash(4, LE)
+ *   num_buffers base_time_epoch sent_time_epoch - base_time_epoch
+ *   for each buffer: time_flags num_mems size_mems[num_mems] [pts] [dts] [duration]
+ *   [caps_len caps_str]
+ * and the memories of all buffers follow the header in order.
+ * The legacy header starts with num_mems (<= GST_MQTT_MAX_NUM_MEMS), so the
+ * first byte of the two formats never collides.
+ */
+
+#include <string.h>
+
+#include <gst/gst.h>
+
+#include "mqttcommon.h"
+
+static const guint8 COMPACT_HDR_MAGIC[] = { 'N', 'M', 'Q' };
+
+/**
+ * @brief Append an unsigned varint. Return the next position, NULL if there is no room.
+ */
+static guint8 *
+_put_varint (guint8 * pos, const guint8 * end, guint64 val)
+{
+  do {
+    if (pos >= end)
+      return NULL;
+
+    *pos = val & 0x7f;
+    val >>= 7;
+    if (val)
+      *pos |= 0x80;
+    pos++;
+  } while (val);
+
+  return pos;
+}
+
+/**
+ * @brief Read an unsigned varint. Return the next position, NULL if the data is truncated or malformed.
+ */
+static const guint8 *
+_get_varint (const guint8 * pos, const guint8 * end, guint64 * val)
+{
+  guint shift = 0;
+
+  *val = 0;
+  while (pos < end && shift < 64) {
+    guint8 byte = *pos++;
+
+    *val |= ((guint64) (byte & 0x7f)) << shift;
+    if (!(byte & 0x80))
+      return pos;
+    shift += 7;
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Zigzag-encode a signed value, small magnitudes result in short varints.
+ */
+static inline guint64
+_zigzag_encode (gint64 val)
+{
+  return ((guint64) val << 1) ^ (guint64) (val >> 63);
+}
+
+/**
+ * @brief Decode a zigzag-encoded value.
+ */
+static inline gint64
+_zigzag_decode (guint64 val)
+{
+  return (gint64) ((val >> 1) ^ (~(val & 1) + 1));
+}
+
+/**
+ * @brief Get the hash of the caps string (32-bit FNV-1a), identical on every host.
+ */
+guint32
+gst_mqtt_caps_hash (const gchar * caps_str)
+{
+  guint32 hash = 2166136261U;
+
+  if (!caps_str)
+    return 0;
+
+  while (*caps_str) {
+    hash ^= (guint8) * caps_str++;
+    hash *= 16777619U;
+  }
+
+  return hash;
+}
+
+/**
+ * @brief Check whether the message starts with the compact header.
+ */
+gboolean
+gst_mqtt_is_compact_hdr (const guint8 * data, const gsize size)
+{
+  return (data && size >= GST_MQTT_LEN_COMPACT_HDR_FIXED &&
+      memcmp (data, COMPACT_HDR_MAGIC, sizeof (COMPACT_HDR_MAGIC)) == 0);
+}
+
+/**
+ * @brief Get the flags of the timestamps which are valid.
+ */
+static guint8
+_get_time_flags (const GstMQTTBufferInfo * info)
+{
+  guint8 flags = 0;
+
+  if (GST_CLOCK_TIME_IS_VALID (info->pts))
+    flags |= GST_MQTT_HDR_FLAG_PTS;
+  if (GST_CLOCK_TIME_IS_VALID (info->dts))
+    flags |= GST_MQTT_HDR_FLAG_DTS;
+  if (GST_CLOCK_TIME_IS_VALID (info->duration))
+    flags |= GST_MQTT_HDR_FLAG_DURATION;
+
+  return flags;
+}
+
+/**
+ * @brief Append the sizes of the memories.
+ */
+static guint8 *
+_put_mems (guint8 * pos, const guint8 * end, const GstMQTTBufferInfo * info)
+{
+  guint i;
+
+  if (info->num_mems > GST_MQTT_MAX_NUM_MEMS)
+    return NULL;
+
+  pos = _put_varint (pos, end, info->num_mems);
+  for (i = 0; pos && i < info->num_mems; i++)
+    pos = _put_varint (pos, end, info->size_mems[i]);
+
+  return pos;
+}
+
+/**
+ * @brief Read the sizes of the memories.
+ */
+static const guint8 *
+_get_mems (const guint8 * pos, const guint8 * end, GstMQTTBufferInfo * info)
+{
+  guint64 val;
+  guint i;
+
+  pos = _get_varint (pos, end, &val);
+  if (!pos || val > GST_MQTT_MAX_NUM_MEMS)
+    return NULL;
+  info->num_mems = (guint) val;
+
+  for (i = 0; i < info->num_mems; i++) {
+    pos = _get_varint (pos, end, &val);
+    if (!pos || val > G_MAXSIZE)
+      return NULL;
+    info->size_mems[i] = (gsize) val;
+  }
+
+  return pos;
+}
+
+/**
+ * @brief Append the timestamps given in the flags.
+ */
+static guint8 *
+_put_times (guint8 * pos, const guint8 * end, const GstMQTTBufferInfo * info,
+    const guint8 flags)
+{
+  if (pos && (flags & GST_MQTT_HDR_FLAG_PTS))
+    pos = _put_varint (pos, end, info->pts);
+  if (pos && (flags & GST_MQTT_HDR_FLAG_DTS))
+    pos = _put_varint (pos, end, info->dts);
+  if (pos && (flags & GST_MQTT_HDR_FLAG_DURATION))
+    pos = _put_varint (pos, end, info->duration);
+
+  return pos;
+}
+
+/**
+ * @brief Read the timestamps given in the flags, the others are invalid.
+ */
+static const guint8 *
+_get_times (const guint8 * pos, const guint8 * end, GstMQTTBufferInfo * info,
+    const guint8 flags)
+{
+  guint64 val;
+
+  info->pts = info->dts = info->duration = GST_CLOCK_TIME_NONE;
+
+  if (pos && (flags & GST_MQTT_HDR_FLAG_PTS)) {
+    if ((pos = _get_varint (pos, end, &val)))
+      info->pts = val;
+  }
+  if (pos && (flags & GST_MQTT_HDR_FLAG_DTS)) {
+    if ((pos = _get_varint (pos, end, &val)))
+      info->dts = val;
+  }
+  if (pos && (flags & GST_MQTT_HDR_FLAG_DURATION)) {
+    if ((pos = _get_varint (pos, end, &val)))
+      info->duration = val;
+  }
+
+  return pos;
+}
+
+/**
+ * @brief Append the fixed part (magic, version, flags and caps hash).
+ */
+static guint8 *
+_put_fixed (guint8 * pos, const guint8 * end, const guint8 flags,
+    const guint32 caps_hash)
+{
+  guint i;
+
+  if (end - pos < GST_MQTT_LEN_COMPACT_HDR_FIXED)
+    return NULL;
+
+  memcpy (pos, COMPACT_HDR_MAGIC, sizeof (COMPACT_HDR_MAGIC));
+  pos += sizeof (COMPACT_HDR_MAGIC);
+  *pos++ = GST_MQTT_COMPACT_HDR_VERSION;
+  *pos++ = flags;
+  for (i = 0; i < 4; i++)
+    *pos++ = (caps_hash >> (8 * i)) & 0xff;
+
+  return pos;
+}
+
+/**
+ * @brief Append the base time and the sent time of the message.
+ */
+static guint8 *
+_put_epochs (guint8 * pos, const guint8 * end, const GstMQTTMessageHdr * hdr)
+{
+  if (pos)
+    pos = _put_varint (pos, end, _zigzag_encode (hdr->base_time_epoch));
+  if (pos)
+    pos = _put_varint (pos, end,
+        _zigzag_encode ((gint64) ((guint64) hdr->sent_time_epoch -
+                (guint64) hdr->base_time_epoch)));
+
+  return pos;
+}
+
+/**
+ * @brief Read the base time and the sent time of the message.
+ */
+static const guint8 *
+_get_epochs (const guint8 * pos, const guint8 * end, GstMQTTMessageHdr * hdr)
+{
+  guint64 val;
+
+  if (!pos || !(pos = _get_varint (pos, end, &val)))
+    return NULL;
+  hdr->base_time_epoch = _zigzag_decode (val);
+
+  if (!(pos = _get_varint (pos, end, &val)))
+    return NULL;
+  hdr->sent_time_epoch = (gint64) ((guint64) hdr->base_time_epoch +
+      (guint64) _zigzag_decode (val));
+
+  return pos;
+}
+
+/**
+ * @brief Append the caps string at the end of the header.
+ */
+static guint8 *
+_put_caps (guint8 * pos, const guint8 * end, const GstMQTTMessageHdr * hdr)
+{
+  gsize caps_len = strnlen (hdr->gst_caps_str, GST_MQTT_MAX_LEN_GST_CAPS_STR);
+
+  if (pos)
+    pos = _put_varint (pos, end, caps_len);
+  if (!pos || (gsize) (end - pos) < caps_len)
+    return NULL;
+
+  memcpy (pos, hdr->gst_caps_str, caps_len);
+  return pos + caps_len;
+}
+
+/**
+ * @brief Read the caps string at the end of the header.
+ */
+static const guint8 *
+_get_caps (const guint8 * pos, const guint8 * end, GstMQTTMessageHdr * hdr)
+{
+  guint64 val;
+
+  if (!pos || !(pos = _get_varint (pos, end, &val)))
+    return NULL;
+  if (val >= GST_MQTT_MAX_LEN_GST_CAPS_STR || val > (guint64) (end - pos))
+    return NULL;
+
+  memcpy (hdr->gst_caps_str, pos, (gsize) val);
+  hdr->gst_caps_str[val] = '\0';
+  return pos + val;
+}
+
+/**
+ * @brief Encode the header in the compact format.
+ */
+gsize
+gst_mqtt_compact_hdr_encode (const GstMQTTMessageHdr * hdr,
+    const guint32 caps_hash, const gboolean with_caps, guint8 * out,
+    const gsize size)
+{
+  GstMQTTBufferInfo info;
+  guint8 flags;
+  guint8 *pos;
+
+  g_return_val_if_fail (hdr != NULL, 0);
+  g_return_val_if_fail (out != NULL, 0);
+  g_return_val_if_fail (hdr->num_mems <= GST_MQTT_MAX_NUM_MEMS, 0);
+
+  info.num_mems = hdr->num_mems;
+  memcpy (info.size_mems, hdr->size_mems, sizeof (info.size_mems));
+  info.pts = hdr->pts;
+  info.dts = hdr->dts;
+  info.duration = hdr->duration;
+
+  flags = _get_time_flags (&info);
+  if (with_caps)
+    flags |= GST_MQTT_HDR_FLAG_CAPS;
+
+  pos = _put_fixed (out, out + size, flags, caps_hash);
+  if (pos)
+    pos = _put_mems (pos, out + size, &info);
+  pos = _put_epochs (pos, out + size, hdr);
+  pos = _put_times (pos, out + size, &info, flags);
+  if (pos && with_caps)
+    pos = _put_caps (pos, out + size, hdr);
+
+  return pos ? (gsize) (pos - out) : 0;
+}
+
+/**
+ * @brief Encode the header of the aggregated message in the compact format.
+ */
+gsize
+gst_mqtt_compact_hdr_encode_aggregated (const GstMQTTMessageHdr * hdr,
+    const GstMQTTBufferInfo * infos, const guint num_infos,
+    const guint32 caps_hash, const gboolean with_caps, guint8 * out,
+    const gsize size)
+{
+  const guint8 *end = out + size;
+  guint8 flags = GST_MQTT_HDR_FLAG_AGGREGATED;
+  guint8 *pos;
+  guint i;
+
+  g_return_val_if_fail (hdr != NULL, 0);
+  g_return_val_if_fail (infos != NULL, 0);
+  g_return_val_if_fail (out != NULL, 0);
+  g_return_val_if_fail (num_infos > 0, 0);
+  g_return_val_if_fail (num_infos <= GST_MQTT_MAX_AGGREGATED_BUFFERS, 0);
+
+  if (with_caps)
+    flags |= GST_MQTT_HDR_FLAG_CAPS;
+
+  pos = _put_fixed (out, end, flags, caps_hash);
+  if (pos)
+    pos = _put_varint (pos, end, num_infos);
+  pos = _put_epochs (pos, end, hdr);
+
+  for (i = 0; pos && i < num_infos; i++) {
+    guint8 time_flags = _get_time_flags (&infos[i]);
+
+    if (pos >= end)
+      return 0;
+    *pos++ = time_flags;
+    pos = _put_mems (pos, end, &infos[i]);
+    pos = _put_times (pos, end, &infos[i], time_flags);
+  }
+
+  if (pos && with_caps)
+    pos = _put_caps (pos, end, hdr);
+
+  return pos ? (gsize) (pos - out) : 0;
+}
+
+/**
+ * @brief Decode the compact header, both of the single and the aggregated message.
+ */
+gsize
+gst_mqtt_compact_hdr_decode_aggregated (const guint8 * data, const gsize size,
+    GstMQTTMessageHdr * hdr, GstMQTTBufferInfo * infos, guint * num_infos,
+    guint32 * caps_hash, gboolean * with_caps)
+{
+  const guint8 *end = data + size;
+  const guint8 *pos;
+  guint64 val;
+  guint8 flags;
+  guint i;
+
+  g_return_val_if_fail (hdr != NULL, 0);
+  g_return_val_if_fail (infos != NULL, 0);
+  g_return_val_if_fail (num_infos != NULL, 0);
+  g_return_val_if_fail (caps_hash != NULL, 0);
+  g_return_val_if_fail (with_caps != NULL, 0);
+
+  if (!gst_mqtt_is_compact_hdr (data, size))
+    return 0;
+
+  if (data[3] != GST_MQTT_COMPACT_HDR_VERSION)
+    return 0;
+
+  memset (hdr, 0, sizeof (*hdr));
+  hdr->pts = hdr->dts = hdr->duration = GST_CLOCK_TIME_NONE;
+
+  flags = data[4];
+  *caps_hash = (guint32) data[5] | ((guint32) data[6] << 8) |
+      ((guint32) data[7] << 16) | ((guint32) data[8] << 24);
+  *with_caps = (flags & GST_MQTT_HDR_FLAG_CAPS) != 0;
+  pos = data + GST_MQTT_LEN_COMPACT_HDR_FIXED;
+
+  if (flags & GST_MQTT_HDR_FLAG_AGGREGATED) {
+    pos = _get_varint (pos, end, &val);
+    if (!pos || val == 0 || val > GST_MQTT_MAX_AGGREGATED_BUFFERS)
+      return 0;
+    *num_infos = (guint) val;
+
+    pos = _get_epochs (pos, end, hdr);
+    for (i = 0; pos && i < *num_infos; i++) {
+      guint8 time_flags;
+
+      if (pos >= end)
+        return 0;
+      time_flags = *pos++;
+      pos = _get_mems (pos, end, &infos[i]);
+      pos = _get_times (pos, end, &infos[i], time_flags);
+    }
+  } else {
+    *num_infos = 1;
+    pos = _get_mems (pos, end, &infos[0]);
+    pos = _get_epochs (pos, end, hdr);
+    pos = _get_times (pos, end, &infos[0], flags);
+  }
+
+  if (pos && *with_caps)
+    pos = _get_caps (pos, end, hdr);
+
+  return pos ? (gsize) (pos - data) : 0;
+}
+
+/**
+ * @brief Decode the compact header.
+ */
+gsize
+gst_mqtt_compact_hdr_decode (const guint8 * data, const gsize size,
+    GstMQTTMessageHdr * hdr, guint32 * caps_hash, gboolean * with_caps)
+{
+  GstMQTTBufferInfo info;
+  guint num_infos;
+  gsize len;
+
+  g_return_val_if_fail (hdr != NULL, 0);
+
+  /* the aggregated message should be decoded with the array of buffer info */
+  if (gst_mqtt_is_compact_hdr (data, size) &&
+      (data[4] & GST_MQTT_HDR_FLAG_AGGREGATED))
+    return 0;
+
+  len = gst_mqtt_compact_hdr_decode_aggregated (data, size, hdr, &info,
+      &num_infos, caps_hash, with_caps);
+  if (len == 0)
+    return 0;
+
+  hdr->num_mems = info.num_mems;
+  memcpy (hdr->size_mems, info.size_mems, sizeof (hdr->size_mems));
+  hdr->pts = info.pts;
+  hdr->dts = info.dts;
+  hdr->duration = info.duration;
+
+  return len;
+}
@@ -39,6 +39,34 @@
 
 #define DEFAULT_MQTT_CONN_TIMEOUT_SEC 5
 
+/**
+ * @brief The compact message header (see mqttcommon.c for the layout).
+ *        GST_MQTT_LEN_COMPACT_HDR_FIXED is the length of magic, version,
+ *        flags and caps hash. The encoded header is always shorter than
+ *        GST_MQTT_LEN_MSG_HDR.
+ */
+#define GST_MQTT_COMPACT_HDR_VERSION    1
+#define GST_MQTT_LEN_COMPACT_HDR_FIXED  9
+#define GST_MQTT_HDR_FLAG_CAPS          (1 << 0)
+#define GST_MQTT_HDR_FLAG_PTS           (1 << 1)
+#define GST_MQTT_HDR_FLAG_DTS           (1 << 2)
+#define GST_MQTT_HDR_FLAG_DURATION      (1 << 3)
+#define GST_MQTT_HDR_FLAG_AGGREGATED    (1 << 4)
+
+/**
+ * @brief The max number of buffers in an aggregated message, and the max
+ *        length of the header for each buffer (time flags, memory sizes and
+ *        timestamps as varints).
+ */
+#define GST_MQTT_MAX_AGGREGATED_BUFFERS 256
+#define GST_MQTT_MAX_LEN_BUF_INFO       (1 + 10 * (1 + GST_MQTT_MAX_NUM_MEMS + 3))
+
+/**
+ * @brief The suffix of the topic where mqttsink publishes the retained caps
+ *        message (the compact header without memories).
+ */
+#define GST_MQTT_CAPS_TOPIC_SUFFIX "/caps"
+
 /**
  * @brief Defined a custom data type, GstMQTTMessageHdr
  *
@@ -62,6 +90,17 @@ typedef struct _GstMQTTMessageHdr {
   };
 } GstMQTTMessageHdr;
 
+/**
+ * @brief The memories and timestamps of each buffer in the aggregated message.
+ */
+typedef struct _GstMQTTBufferInfo {
+  guint num_mems;
+  gsize size_mems[GST_MQTT_MAX_NUM_MEMS];
+  GstClockTime duration;
+  GstClockTime dts;
+  GstClockTime pts;
+} GstMQTTBufferInfo;
+
 typedef int64_t (*mqtt_get_unix_epoch)(uint32_t, char **, uint16_t *);
 
 /**
@@ -77,4 +116,87 @@ static inline int64_t default_mqtt_get_unix_epoch (uint32_t hnum, char **hnames,
   return g_get_real_time ();
 }
 
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+/**
+ * @brief Get the hash of the caps string, which is used to identify the caps in the compact header.
+ * @param[in] caps_str The caps string
+ * @return 32-bit hash value (0 if caps_str is NULL)
+ */
+guint32
+gst_mqtt_caps_hash (const gchar * caps_str);
+
+/**
+ * @brief Check whether the message starts with the compact header.
+ * @param[in] data The received message
+ * @param[in] size The size of the received message
+ * @return TRUE if the message has the compact header
+ */
+gboolean
+gst_mqtt_is_compact_hdr (const guint8 * data, const gsize size);
+
+/**
+ * @brief Encode the message header in the compact format.
+ * @param[in] hdr The message header (gst_caps_str is used only if with_caps is TRUE)
+ * @param[in] caps_hash The hash of the caps string
+ * @param[in] with_caps TRUE to put the caps string in the header
+ * @param[out] out The buffer to write the header
+ * @param[in] size The size of the buffer
+ * @return The length of the encoded header, 0 on error
+ */
+gsize
+gst_mqtt_compact_hdr_encode (const GstMQTTMessageHdr * hdr,
+    const guint32 caps_hash, const gboolean with_caps, guint8 * out,
+    const gsize size);
+
+/**
+ * @brief Decode the compact header of the received message.
+ * @param[in] data The received message
+ * @param[in] size The size of the received message
+ * @param[out] hdr The decoded header. gst_caps_str is filled only if with_caps is TRUE
+ * @param[out] caps_hash The hash of the caps string
+ * @param[out] with_caps TRUE if the header carries the caps string
+ * @return The length of the compact header (the offset of the first memory), 0 on error
+ */
+gsize
+gst_mqtt_compact_hdr_decode (const guint8 * data, const gsize size,
+    GstMQTTMessageHdr * hdr, guint32 * caps_hash, gboolean * with_caps);
+
+/**
+ * @brief Encode the header of the message aggregating several buffers.
+ * @param[in] hdr The message header (base and sent time, and gst_caps_str if with_caps is TRUE)
+ * @param[in] infos The memories and timestamps of each buffer
+ * @param[in] num_infos The number of buffers (up to GST_MQTT_MAX_AGGREGATED_BUFFERS)
+ * @param[in] caps_hash The hash of the caps string
+ * @param[in] with_caps TRUE to put the caps string in the header
+ * @param[out] out The buffer to write the header
+ * @param[in] size The size of the buffer
+ * @return The length of the encoded header, 0 on error
+ */
+gsize
+gst_mqtt_compact_hdr_encode_aggregated (const GstMQTTMessageHdr * hdr,
+    const GstMQTTBufferInfo * infos, const guint num_infos,
+    const guint32 caps_hash, const gboolean with_caps, guint8 * out,
+    const gsize size);
+
+/**
+ * @brief Decode the compact header of the received message, either single or aggregated.
+ * @param[in] data The received message
+ * @param[in] size The size of the received message
+ * @param[out] hdr The base and sent time. gst_caps_str is filled only if with_caps is TRUE
+ * @param[out] infos The memories and timestamps of each buffer, should have room for GST_MQTT_MAX_AGGREGATED_BUFFERS
+ * @param[out] num_infos The number of buffers in the message
+ * @param[out] caps_hash The hash of the caps string
+ * @param[out] with_caps TRUE if the header carries the caps string
+ * @return The length of the compact header (the offset of the first memory), 0 on error
+ */
+gsize
+gst_mqtt_compact_hdr_decode_aggregated (const guint8 * data, const gsize size,
+    GstMQTTMessageHdr * hdr, GstMQTTBufferInfo * infos, guint * num_infos,
+    guint32 * caps_hash, gboolean * with_caps);
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
 #endif /* !__GST_MQTT_COMMON_H__ */
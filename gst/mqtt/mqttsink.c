@@ -58,6 +58,10 @@ enum
   PROP_MQTT_QOS,
   PROP_MQTT_NTP_SYNC,
   PROP_MQTT_NTP_SRVS,
+  PROP_COMPACT_HEADER,
+  PROP_AGGREGATE_BUFFERS,
+  PROP_AGGREGATE_BYTES,
+  PROP_AGGREGATE_DELAY,
 
   PROP_LAST
 };
@@ -75,6 +79,10 @@ enum
   DEFAULT_MAX_MSG_BUF_SIZE = 0, /* Buffer size is not fixed */
   DEFAULT_MQTT_QOS = 0,         /* fire and forget */
   DEFAULT_MQTT_NTP_SYNC = FALSE,
+  DEFAULT_COMPACT_HEADER = FALSE,
+  DEFAULT_AGGREGATE_BUFFERS = 1,        /* publish each buffer */
+  DEFAULT_AGGREGATE_BYTES = 0,  /* follow max-buffer-size */
+  DEFAULT_AGGREGATE_DELAY = 10, /* 10 msec */
   MAX_LEN_PROP_NTP_SRVS = 4096,
 };
 
@@ -146,6 +154,20 @@ static void gst_mqtt_sink_set_mqtt_ntp_sync (GstMqttSink * self,
 static gchar *gst_mqtt_sink_get_mqtt_ntp_srvs (GstMqttSink * self);
 static void gst_mqtt_sink_set_mqtt_ntp_srvs (GstMqttSink * self,
     const gchar * pairs);
+static gboolean gst_mqtt_sink_get_compact_header (GstMqttSink * self);
+static void gst_mqtt_sink_set_compact_header (GstMqttSink * self,
+    const gboolean flag);
+static guint gst_mqtt_sink_get_aggregate_buffers (GstMqttSink * self);
+static void gst_mqtt_sink_set_aggregate_buffers (GstMqttSink * self,
+    const guint num);
+static gsize gst_mqtt_sink_get_aggregate_bytes (GstMqttSink * self);
+static void gst_mqtt_sink_set_aggregate_bytes (GstMqttSink * self,
+    const gsize size);
+static guint gst_mqtt_sink_get_aggregate_delay (GstMqttSink * self);
+static void gst_mqtt_sink_set_aggregate_delay (GstMqttSink * self,
+    const guint delay);
+
+static void _mqtt_sink_discard_pending (GstMqttSink * self);
 
 static void cb_mqtt_on_connect (void *context,
     MQTTAsync_successData * response);
@@ -196,6 +218,15 @@ gst_mqtt_sink_init (GstMqttSink * self)
   memset (&self->mqtt_msg_hdr, 0x0, sizeof (self->mqtt_msg_hdr));
   self->base_time_epoch = GST_CLOCK_TIME_NONE;
   self->in_caps = NULL;
+  self->caps_hash = 0;
+  self->caps_changed = FALSE;
+  self->mqtt_caps_topic = NULL;
+  self->agg_pending =
+      g_ptr_array_new_with_free_func ((GDestroyNotify) gst_buffer_unref);
+  self->agg_pending_size = 0;
+  self->agg_timer = NULL;
+  self->agg_flow = GST_FLOW_OK;
+  g_mutex_init (&self->agg_lock);
 
   /** init mqttsink properties */
   self->debug = DEFAULT_DEBUG;
@@ -216,6 +247,10 @@ gst_mqtt_sink_init (GstMqttSink * self)
   self->mqtt_ntp_num_srvs = 0;
   self->get_epoch_func = default_mqtt_get_unix_epoch;
   self->is_connected = FALSE;
+  self->compact_hdr = DEFAULT_COMPACT_HEADER;
+  self->aggregate_buffers = DEFAULT_AGGREGATE_BUFFERS;
+  self->aggregate_bytes = DEFAULT_AGGREGATE_BYTES;
+  self->aggregate_delay = DEFAULT_AGGREGATE_DELAY;
 
   /** init basesink properties */
   gst_base_sink_set_qos_enabled (basesink, DEFAULT_QOS);
@@ -318,6 +353,35 @@ gst_mqtt_sink_class_init (GstMqttSinkClass * klass)
           "\t\t\tsee also: https://www.eclipse.org/paho/files/mqttdoc/MQTTAsync/html/qos.html",
           0, 2, DEFAULT_MQTT_QOS, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  g_object_class_install_property (gobject_class, PROP_COMPACT_HEADER,
+      g_param_spec_boolean ("compact-header", "Compact Header",
+          "Prepend the compact header (varint sizes and timestamps, caps hash) "
+          "to each message. The caps are sent only when changed, and retained "
+          "in the topic '<pub-topic>" GST_MQTT_CAPS_TOPIC_SUFFIX "'. "
+          "The mqttsrc of older versions cannot parse it, so it is disabled by default",
+          DEFAULT_COMPACT_HEADER, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_AGGREGATE_BUFFERS,
+      g_param_spec_uint ("aggregate-buffers", "Aggregate Buffers",
+          "The maximum number of buffers packed into a message "
+          "(1 = publish each buffer). Valid only if compact-header is true",
+          1, GST_MQTT_MAX_AGGREGATED_BUFFERS, DEFAULT_AGGREGATE_BUFFERS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_AGGREGATE_BYTES,
+      g_param_spec_ulong ("aggregate-bytes", "Aggregate Bytes",
+          "The maximum total size in bytes of the buffers packed into a message "
+          "(0 = max-buffer-size, or no limit if it is 0)",
+          0, G_MAXULONG, DEFAULT_AGGREGATE_BYTES,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_AGGREGATE_DELAY,
+      g_param_spec_uint ("aggregate-delay", "Aggregate Delay",
+          "The maximum time (in milliseconds) that the first buffer waits for "
+          "the next ones before the message is published (0 = no timeout)",
+          0, G_MAXUINT, DEFAULT_AGGREGATE_DELAY,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gstelement_class->change_state = gst_mqtt_sink_change_state;
 
   gstbasesink_class->start = GST_DEBUG_FUNCPTR (gst_mqtt_sink_start);
@@ -386,6 +450,18 @@ gst_mqtt_sink_set_property (GObject * object, guint prop_id,
     case PROP_MQTT_NTP_SRVS:
       gst_mqtt_sink_set_mqtt_ntp_srvs (self, g_value_get_string (value));
       break;
+    case PROP_COMPACT_HEADER:
+      gst_mqtt_sink_set_compact_header (self, g_value_get_boolean (value));
+      break;
+    case PROP_AGGREGATE_BUFFERS:
+      gst_mqtt_sink_set_aggregate_buffers (self, g_value_get_uint (value));
+      break;
+    case PROP_AGGREGATE_BYTES:
+      gst_mqtt_sink_set_aggregate_bytes (self, g_value_get_ulong (value));
+      break;
+    case PROP_AGGREGATE_DELAY:
+      gst_mqtt_sink_set_aggregate_delay (self, g_value_get_uint (value));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -441,6 +517,18 @@ gst_mqtt_sink_get_property (GObject * object, guint prop_id,
     case PROP_MQTT_NTP_SRVS:
       g_value_set_string (value, gst_mqtt_sink_get_mqtt_ntp_srvs (self));
       break;
+    case PROP_COMPACT_HEADER:
+      g_value_set_boolean (value, gst_mqtt_sink_get_compact_header (self));
+      break;
+    case PROP_AGGREGATE_BUFFERS:
+      g_value_set_uint (value, gst_mqtt_sink_get_aggregate_buffers (self));
+      break;
+    case PROP_AGGREGATE_BYTES:
+      g_value_set_ulong (value, gst_mqtt_sink_get_aggregate_bytes (self));
+      break;
+    case PROP_AGGREGATE_DELAY:
+      g_value_set_uint (value, gst_mqtt_sink_get_aggregate_delay (self));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -469,6 +557,10 @@ gst_mqtt_sink_class_finalize (GObject * object)
   self->mqtt_msg_buf = NULL;
   g_free (self->mqtt_topic);
   self->mqtt_topic = NULL;
+  g_free (self->mqtt_caps_topic);
+  self->mqtt_caps_topic = NULL;
+  g_ptr_array_free (self->agg_pending, TRUE);
+  self->agg_pending = NULL;
   gst_caps_replace (&self->in_caps, NULL);
   g_free (self->mqtt_ntp_srvs);
   self->mqtt_ntp_srvs = NULL;
@@ -481,6 +573,7 @@ gst_mqtt_sink_class_finalize (GObject * object)
   if (self->err)
     g_error_free (self->err);
   g_mutex_clear (&self->mqtt_sink_mutex);
+  g_mutex_clear (&self->agg_lock);
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -570,6 +663,11 @@ gst_mqtt_sink_start (GstBaseSink * basesink)
         self->mqtt_client_id);
   }
 
+  g_free (self->mqtt_caps_topic);
+  self->mqtt_caps_topic = g_strconcat (self->mqtt_topic,
+      GST_MQTT_CAPS_TOPIC_SUFFIX, NULL);
+  self->agg_flow = GST_FLOW_OK;
+
   /**
    * @todo Support other persistence mechanisms
    *    MQTTCLIENT_PERSISTENCE_NONE: A memory-based persistence mechanism
@@ -631,6 +729,7 @@ gst_mqtt_sink_stop (GstBaseSink * basesink)
   disconn_opts.onFailure = cb_mqtt_on_disconnect_failure;
   disconn_opts.context = self;
 
+  _mqtt_sink_discard_pending (self);
   g_atomic_int_set (&self->mqtt_sink_state, SINK_RENDER_STOPPED);
   while (MQTTAsync_isConnected (self->mqtt_client_handle)) {
     gint64 end_time = g_get_monotonic_time () + DEFAULT_MQTT_DISCONNECT_TIMEOUT;
@@ -744,6 +843,239 @@ _mqtt_set_msg_buf_hdr (GstBuffer * gst_buf, GstMQTTMessageHdr * hdr)
   return ret;
 }
 
+/**
+ * @brief Publish the caps as a retained message, so that the subscriber
+ *        joining later can find the caps of the compact header.
+ */
+static gboolean
+_mqtt_publish_caps (GstMqttSink * self)
+{
+  GstMQTTMessageHdr caps_hdr;
+  guint8 msg[GST_MQTT_LEN_MSG_HDR];
+  gsize len;
+
+  if (self->mqtt_msg_hdr.gst_caps_str[0] == '\0')
+    return TRUE;
+
+  memcpy (&caps_hdr, &self->mqtt_msg_hdr, sizeof (caps_hdr));
+  caps_hdr.num_mems = 0;
+
+  len = gst_mqtt_compact_hdr_encode (&caps_hdr, self->caps_hash, TRUE, msg,
+      sizeof (msg));
+  if (len == 0)
+    return FALSE;
+
+  return (MQTTAsync_send (self->mqtt_client_handle, self->mqtt_caps_topic,
+          len, msg, self->mqtt_qos, 1,
+          &self->mqtt_respn_opts) == MQTTASYNC_SUCCESS);
+}
+
+/**
+ * @brief Make the message buffer hold at least the given size.
+ *        The buffer only grows, and it is allocated for max-buffer-size at once if the property is given.
+ */
+static gboolean
+_mqtt_reserve_msg_buf (GstMqttSink * self, const gsize size)
+{
+  gsize new_size;
+
+  if (self->mqtt_msg_buf && self->mqtt_msg_buf_size >= size)
+    return TRUE;
+
+  new_size = size;
+  if (self->max_msg_buf_size != 0)
+    new_size = MAX (new_size, self->max_msg_buf_size + GST_MQTT_LEN_MSG_HDR);
+
+  g_free (self->mqtt_msg_buf);
+  self->mqtt_msg_buf = g_try_malloc (new_size);
+  self->mqtt_msg_buf_size = self->mqtt_msg_buf ? new_size : 0;
+
+  return (self->mqtt_msg_buf != NULL);
+}
+
+/**
+ * @brief Check whether the incoming buffers are packed into an aggregated message.
+ */
+static inline gboolean
+_mqtt_sink_is_aggregating (GstMqttSink * self)
+{
+  return self->compact_hdr && self->aggregate_buffers > 1;
+}
+
+/**
+ * @brief Get the max total size of the buffers in an aggregated message. 0 for no limit.
+ */
+static inline gsize
+_mqtt_sink_get_aggregate_limit (GstMqttSink * self)
+{
+  return (self->aggregate_bytes > 0) ?
+      self->aggregate_bytes : self->max_msg_buf_size;
+}
+
+/**
+ * @brief Cancel the timer of the pending buffers. Caller should hold agg_lock.
+ */
+static void
+_mqtt_sink_cancel_aggregate_timer (GstMqttSink * self)
+{
+  if (self->agg_timer) {
+    gst_clock_id_unschedule (self->agg_timer);
+    gst_clock_id_unref (self->agg_timer);
+    self->agg_timer = NULL;
+  }
+}
+
+/**
+ * @brief Drop the pending buffers without publishing them.
+ */
+static void
+_mqtt_sink_discard_pending (GstMqttSink * self)
+{
+  g_mutex_lock (&self->agg_lock);
+  _mqtt_sink_cancel_aggregate_timer (self);
+  g_ptr_array_set_size (self->agg_pending, 0);
+  self->agg_pending_size = 0;
+  g_mutex_unlock (&self->agg_lock);
+}
+
+/**
+ * @brief Publish the pending buffers in an aggregated message. Caller should hold agg_lock.
+ */
+static GstFlowReturn
+_mqtt_sink_publish_pending (GstMqttSink * self)
+{
+  const guint num_bufs = self->agg_pending->len;
+  GstFlowReturn ret = GST_FLOW_ERROR;
+  GstMQTTBufferInfo *infos;
+  gsize hdr_max, hdr_len, offset;
+  GstBuffer *buf;
+  guint i, j;
+
+  _mqtt_sink_cancel_aggregate_timer (self);
+  if (num_bufs == 0)
+    return GST_FLOW_OK;
+
+  infos = g_new0 (GstMQTTBufferInfo, num_bufs);
+  for (i = 0; i < num_bufs; i++) {
+    buf = g_ptr_array_index (self->agg_pending, i);
+
+    infos[i].num_mems = gst_buffer_n_memory (buf);
+    if (infos[i].num_mems > GST_MQTT_MAX_NUM_MEMS)
+      goto done;
+
+    for (j = 0; j < infos[i].num_mems; j++)
+      infos[i].size_mems[j] = gst_buffer_peek_memory (buf, j)->size;
+
+    infos[i].pts = GST_BUFFER_PTS (buf);
+    infos[i].dts = GST_BUFFER_DTS (buf);
+    infos[i].duration = GST_BUFFER_DURATION (buf);
+  }
+
+  /** The epochs of the message are taken from the first buffer */
+  buf = g_ptr_array_index (self->agg_pending, 0);
+  _put_timestamp_to_msg_buf_hdr (self, buf, &self->mqtt_msg_hdr);
+
+  hdr_max = GST_MQTT_LEN_MSG_HDR + num_bufs * GST_MQTT_MAX_LEN_BUF_INFO;
+  if (!_mqtt_reserve_msg_buf (self, hdr_max + self->agg_pending_size))
+    goto done;
+
+  if (self->caps_changed && !_mqtt_publish_caps (self))
+    goto done;
+
+  hdr_len = gst_mqtt_compact_hdr_encode_aggregated (&self->mqtt_msg_hdr,
+      infos, num_bufs, self->caps_hash, self->caps_changed,
+      self->mqtt_msg_buf, hdr_max);
+  if (hdr_len == 0)
+    goto done;
+
+  offset = hdr_len;
+  for (i = 0; i < num_bufs; i++) {
+    buf = g_ptr_array_index (self->agg_pending, i);
+    offset += gst_buffer_extract (buf, 0, self->mqtt_msg_buf + offset,
+        gst_buffer_get_size (buf));
+  }
+
+  if (MQTTAsync_send (self->mqtt_client_handle, self->mqtt_topic, offset,
+          self->mqtt_msg_buf, self->mqtt_qos, 1,
+          &self->mqtt_respn_opts) == MQTTASYNC_SUCCESS) {
+    self->caps_changed = FALSE;
+    ret = GST_FLOW_OK;
+  }
+
+done:
+  g_free (infos);
+  g_ptr_array_set_size (self->agg_pending, 0);
+  self->agg_pending_size = 0;
+  return ret;
+}
+
+/**
+ * @brief The callback of the aggregate-delay timer, publishing the pending buffers.
+ */
+static gboolean
+_mqtt_sink_aggregate_timeout (GstClock * clock, GstClockTime time,
+    GstClockID id, gpointer user_data)
+{
+  GstMqttSink *self = GST_MQTT_SINK (user_data);
+  GstFlowReturn ret;
+
+  UNUSED (clock);
+  UNUSED (time);
+
+  g_mutex_lock (&self->agg_lock);
+  /** The timer may have been replaced while this callback waits for the lock */
+  if (id == self->agg_timer) {
+    ret = _mqtt_sink_publish_pending (self);
+    if (ret != GST_FLOW_OK)
+      self->agg_flow = ret;
+  }
+  g_mutex_unlock (&self->agg_lock);
+
+  return TRUE;
+}
+
+/**
+ * @brief Add the buffer to the pending ones, and publish them if any of the aggregate limits is reached.
+ */
+static GstFlowReturn
+_mqtt_sink_aggregate (GstMqttSink * self, GstBuffer * in_buf)
+{
+  const gsize in_buf_size = gst_buffer_get_size (in_buf);
+  const gsize limit = _mqtt_sink_get_aggregate_limit (self);
+  GstFlowReturn ret;
+
+  g_mutex_lock (&self->agg_lock);
+  ret = self->agg_flow;
+  if (ret != GST_FLOW_OK)
+    goto done;
+
+  if (limit > 0 && self->agg_pending_size + in_buf_size > limit) {
+    ret = _mqtt_sink_publish_pending (self);
+    if (ret != GST_FLOW_OK)
+      goto done;
+  }
+
+  g_ptr_array_add (self->agg_pending, gst_buffer_ref (in_buf));
+  self->agg_pending_size += in_buf_size;
+
+  if (self->agg_pending->len >= self->aggregate_buffers) {
+    ret = _mqtt_sink_publish_pending (self);
+  } else if (self->agg_pending->len == 1 && self->aggregate_delay > 0) {
+    GstClock *clock = gst_system_clock_obtain ();
+
+    self->agg_timer = gst_clock_new_single_shot_id (clock,
+        gst_clock_get_time (clock) + self->aggregate_delay * GST_MSECOND);
+    if (gst_clock_id_wait_async (self->agg_timer,
+            _mqtt_sink_aggregate_timeout, self, NULL) != GST_CLOCK_OK)
+      ret = _mqtt_sink_publish_pending (self);
+    gst_object_unref (clock);
+  }
+
+done:
+  g_mutex_unlock (&self->agg_lock);
+  return ret;
+}
+
 /**
  * @brief The callback to process each buffer receiving on the sink pad
  */
@@ -751,7 +1083,6 @@ static GstFlowReturn
 gst_mqtt_sink_render (GstBaseSink * basesink, GstBuffer * in_buf)
 {
   const gsize in_buf_size = gst_buffer_get_size (in_buf);
-  static gboolean is_static_sized_buf = FALSE;
   GstMqttSink *self = GST_MQTT_SINK (basesink);
   GstFlowReturn ret = GST_FLOW_ERROR;
   mqtt_sink_state_t cur_state;
@@ -759,6 +1090,7 @@ gst_mqtt_sink_render (GstBaseSink * basesink, GstBuffer * in_buf)
   GstMapInfo in_buf_map;
   gint mqtt_rc;
   guint8 *msg_pub;
+  gsize hdr_len;
 
   while ((cur_state =
           g_atomic_int_get (&self->mqtt_sink_state)) != MQTT_CONNECTED) {
@@ -797,67 +1129,71 @@ gst_mqtt_sink_render (GstBaseSink * basesink, GstBuffer * in_buf)
     self->num_buffers -= 1;
   }
 
-  if ((!is_static_sized_buf) && (self->mqtt_msg_buf) &&
-      (self->mqtt_msg_buf_size != 0) &&
-      (self->mqtt_msg_buf_size < in_buf_size + GST_MQTT_LEN_MSG_HDR)) {
-    g_free (self->mqtt_msg_buf);
-    self->mqtt_msg_buf = NULL;
-    self->mqtt_msg_buf_size = 0;
-  }
-
-  /** Allocate a message buffer */
-  if ((!self->mqtt_msg_buf) && (self->mqtt_msg_buf_size == 0)) {
-    if (self->max_msg_buf_size == 0) {
-      self->mqtt_msg_buf_size = in_buf_size + GST_MQTT_LEN_MSG_HDR;
-    } else {
-      if (self->max_msg_buf_size < in_buf_size) {
-        g_printerr ("%s: The given size for a message buffer is too small: "
-            "given (%" G_GSIZE_FORMAT " bytes) vs. incoming (%" G_GSIZE_FORMAT
-            " bytes)\n", TAG_ERR_MQTTSINK, self->max_msg_buf_size, in_buf_size);
-        ret = GST_FLOW_ERROR;
-        goto ret_with;
-      }
-      self->mqtt_msg_buf_size = self->max_msg_buf_size + GST_MQTT_LEN_MSG_HDR;
-      is_static_sized_buf = TRUE;
-    }
-
-    self->mqtt_msg_buf = g_try_malloc0 (self->mqtt_msg_buf_size);
+  if (self->max_msg_buf_size != 0 && self->max_msg_buf_size < in_buf_size) {
+    g_printerr ("%s: The given size for a message buffer is too small: "
+        "given (%" G_GSIZE_FORMAT " bytes) vs. incoming (%" G_GSIZE_FORMAT
+        " bytes)\n", TAG_ERR_MQTTSINK, self->max_msg_buf_size, in_buf_size);
+    ret = GST_FLOW_ERROR;
+    goto ret_with;
   }
 
-  if (!_mqtt_set_msg_buf_hdr (in_buf, &self->mqtt_msg_hdr)) {
-    ret = GST_FLOW_ERROR;
+  if (_mqtt_sink_is_aggregating (self)) {
+    ret = _mqtt_sink_aggregate (self, in_buf);
     goto ret_with;
   }
 
+  /**
+   * The message buffer and the header are shared with the aggregate-delay timer.
+   * Publish the buffers still pending (e.g., aggregate-buffers is changed to 1) before this one.
+   */
+  g_mutex_lock (&self->agg_lock);
+  ret = self->agg_flow;
+  if (ret == GST_FLOW_OK)
+    ret = _mqtt_sink_publish_pending (self);
+  if (ret != GST_FLOW_OK)
+    goto ret_unlock;
+
+  ret = GST_FLOW_ERROR;
+  if (!_mqtt_reserve_msg_buf (self, in_buf_size + GST_MQTT_LEN_MSG_HDR))
+    goto ret_unlock;
+
+  if (!_mqtt_set_msg_buf_hdr (in_buf, &self->mqtt_msg_hdr))
+    goto ret_unlock;
+
   msg_pub = self->mqtt_msg_buf;
-  if (!msg_pub) {
-    self->mqtt_msg_buf_size = 0;
-    ret = GST_FLOW_ERROR;
-    goto ret_with;
+  _put_timestamp_to_msg_buf_hdr (self, in_buf, &self->mqtt_msg_hdr);
+
+  if (self->compact_hdr) {
+    if (self->caps_changed && !_mqtt_publish_caps (self))
+      goto ret_unlock;
+
+    hdr_len = gst_mqtt_compact_hdr_encode (&self->mqtt_msg_hdr,
+        self->caps_hash, self->caps_changed, msg_pub,
+        self->mqtt_msg_buf_size - in_buf_size);
+    if (hdr_len == 0)
+      goto ret_unlock;
+  } else {
+    memcpy (msg_pub, &self->mqtt_msg_hdr, sizeof (self->mqtt_msg_hdr));
+    hdr_len = GST_MQTT_LEN_MSG_HDR;
   }
-  memcpy (msg_pub, &self->mqtt_msg_hdr, sizeof (self->mqtt_msg_hdr));
-  _put_timestamp_to_msg_buf_hdr (self, in_buf, (GstMQTTMessageHdr *) msg_pub);
 
   in_buf_mem = gst_buffer_get_all_memory (in_buf);
-  if (!in_buf_mem) {
-    ret = GST_FLOW_ERROR;
-    goto ret_with;
-  }
+  if (!in_buf_mem)
+    goto ret_unlock;
 
-  if (!gst_memory_map (in_buf_mem, &in_buf_map, GST_MAP_READ)) {
-    ret = GST_FLOW_ERROR;
+  if (!gst_memory_map (in_buf_mem, &in_buf_map, GST_MAP_READ))
     goto ret_unref_in_buf_mem;
-  }
 
   ret = GST_FLOW_OK;
 
-  memcpy (&msg_pub[sizeof (self->mqtt_msg_hdr)], in_buf_map.data,
-      in_buf_map.size);
+  memcpy (&msg_pub[hdr_len], in_buf_map.data, in_buf_map.size);
   mqtt_rc = MQTTAsync_send (self->mqtt_client_handle, self->mqtt_topic,
-      GST_MQTT_LEN_MSG_HDR + in_buf_map.size, self->mqtt_msg_buf,
+      hdr_len + in_buf_map.size, self->mqtt_msg_buf,
       self->mqtt_qos, 1, &self->mqtt_respn_opts);
   if (mqtt_rc != MQTTASYNC_SUCCESS) {
     ret = GST_FLOW_ERROR;
+  } else if (self->compact_hdr) {
+    self->caps_changed = FALSE;
   }
 
   gst_memory_unmap (in_buf_mem, &in_buf_map);
@@ -865,6 +1201,9 @@ gst_mqtt_sink_render (GstBaseSink * basesink, GstBuffer * in_buf)
 ret_unref_in_buf_mem:
   gst_memory_unref (in_buf_mem);
 
+ret_unlock:
+  g_mutex_unlock (&self->agg_lock);
+
 ret_with:
   return ret;
 }
@@ -899,20 +1238,49 @@ gst_mqtt_sink_event (GstBaseSink * basesink, GstEvent * event)
 {
   GstMqttSink *self = GST_MQTT_SINK (basesink);
   GstEventType type = GST_EVENT_TYPE (event);
+  gboolean publish_failed = FALSE;
   gboolean ret = FALSE;
 
   switch (type) {
+    case GST_EVENT_FLUSH_START:
+      _mqtt_sink_discard_pending (self);
+      break;
+    case GST_EVENT_FLUSH_STOP:
+      g_mutex_lock (&self->agg_lock);
+      self->agg_flow = GST_FLOW_OK;
+      g_mutex_unlock (&self->agg_lock);
+      break;
     case GST_EVENT_EOS:
+    {
+      GstFlowReturn flow;
+
+      /** Publish the buffers waiting for the aggregate limits */
+      g_mutex_lock (&self->agg_lock);
+      flow = _mqtt_sink_publish_pending (self);
+      if (flow == GST_FLOW_OK)
+        flow = self->agg_flow;
+      g_mutex_unlock (&self->agg_lock);
+
+      if (flow != GST_FLOW_OK) {
+        GST_ELEMENT_ERROR (self, RESOURCE, WRITE,
+            ("Failed to publish the aggregated message: %s",
+                gst_flow_get_name (flow)), (NULL));
+        publish_failed = TRUE;
+      }
+
       g_atomic_int_set (&self->mqtt_sink_state, SINK_RENDER_EOS);
       g_mutex_lock (&self->mqtt_sink_mutex);
       g_cond_broadcast (&self->mqtt_sink_gcond);
       g_mutex_unlock (&self->mqtt_sink_mutex);
       break;
+    }
     default:
       break;
   }
 
   ret = GST_BASE_SINK_CLASS (parent_class)->event (basesink, event);
+  if (publish_failed)
+    ret = FALSE;
 
   return ret;
 }
@@ -945,6 +1313,10 @@ gst_mqtt_sink_set_caps (GstBaseSink * basesink, GstCaps * caps)
       ret = FALSE;
     }
 
+    /* the compact header carries the caps with the next message only */
+    self->caps_hash = gst_mqtt_caps_hash (self->mqtt_msg_hdr.gst_caps_str);
+    self->caps_changed = TRUE;
+
     g_free (caps_str);
   }
 
@@ -1257,6 +1629,80 @@ err_free_pair_arrs:
   return;
 }
 
+/**
+ * @brief Getter for the 'compact-header' property.
+ */
+static gboolean
+gst_mqtt_sink_get_compact_header (GstMqttSink * self)
+{
+  return self->compact_hdr;
+}
+
+/**
+ * @brief Setter for the 'compact-header' property.
+ */
+static void
+gst_mqtt_sink_set_compact_header (GstMqttSink * self, const gboolean flag)
+{
+  self->compact_hdr = flag;
+  /* send the caps again, the receiver may not have seen the compact header yet */
+  self->caps_changed = TRUE;
+}
+
+/**
+ * @brief Getter for the 'aggregate-buffers' property.
+ */
+static guint
+gst_mqtt_sink_get_aggregate_buffers (GstMqttSink * self)
+{
+  return self->aggregate_buffers;
+}
+
+/**
+ * @brief Setter for the 'aggregate-buffers' property.
+ */
+static void
+gst_mqtt_sink_set_aggregate_buffers (GstMqttSink * self, const guint num)
+{
+  self->aggregate_buffers = num;
+}
+
+/**
+ * @brief Getter for the 'aggregate-bytes' property.
+ */
+static gsize
+gst_mqtt_sink_get_aggregate_bytes (GstMqttSink * self)
+{
+  return self->aggregate_bytes;
+}
+
+/**
+ * @brief Setter for the 'aggregate-bytes' property.
+ */
+static void
+gst_mqtt_sink_set_aggregate_bytes (GstMqttSink * self, const gsize size)
+{
+  self->aggregate_bytes = size;
+}
+
+/**
+ * @brief Getter for the 'aggregate-delay' property.
+ */
+static guint
+gst_mqtt_sink_get_aggregate_delay (GstMqttSink * self)
+{
+  return self->aggregate_delay;
+}
+
+/**
+ * @brief Setter for the 'aggregate-delay' property.
+ */
+static void
+gst_mqtt_sink_set_aggregate_delay (GstMqttSink * self, const guint delay)
+{
+  self->aggregate_delay = delay;
+}
+
 /** Callback function definitions */
 /**
  * @brief A callback function corresponding to MQTTAsync_connectOptions's
@@ -88,6 +88,20 @@ struct _GstMqttSink {
   gpointer mqtt_msg_buf;
   gsize mqtt_msg_buf_size;
 
+  gboolean compact_hdr;       /**< TRUE to send the compact header, FALSE for the legacy header (property) */
+  guint32 caps_hash;          /**< hash of the caps string in mqtt_msg_hdr */
+  gboolean caps_changed;      /**< TRUE if the caps should be sent with the next message */
+  gchar *mqtt_caps_topic;     /**< topic of the retained caps message */
+
+  guint aggregate_buffers;    /**< max number of buffers in a message (property). 1 to publish each buffer */
+  gsize aggregate_bytes;      /**< max total size of the buffers in a message (property). 0 to follow max-buffer-size */
+  guint aggregate_delay;      /**< max delay (ms) of the first buffer in a message (property). 0 for no timeout */
+  GPtrArray *agg_pending;     /**< buffers to be published in the next aggregated message */
+  gsize agg_pending_size;     /**< total size of the pending buffers */
+  GstClockID agg_timer;       /**< timer to publish the pending buffers after aggregate-delay */
+  GstFlowReturn agg_flow;     /**< result of publishing the pending buffers from the timer */
+  GMutex agg_lock;            /**< lock for the pending buffers */
+
   MQTTAsync mqtt_client_handle;
   MQTTAsync_connectOptions mqtt_conn_opts;
   MQTTAsync_responseOptions mqtt_respn_opts;
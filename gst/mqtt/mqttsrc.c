@@ -64,6 +64,7 @@ enum
   DEFAULT_MQTT_SUB_TIMEOUT = 10000000,  /* 10 seconds */
   DEFAULT_MQTT_SUB_TIMEOUT_MIN = 1000000,       /* 1 seconds */
   DEFAULT_MQTT_QOS = 2,         /* Once and one only */
+  MAX_CACHED_CAPS = 16,
 };
 
 static guint8 src_client_id = 0;
@@ -139,11 +140,15 @@ static void cb_mqtt_on_unsubscribe (void *context,
     MQTTAsync_successData * response);
 static void cb_mqtt_on_unsubscribe_failure (void *context,
     MQTTAsync_failureData * response);
+static void cb_mqtt_on_caps_topic_done (void *context,
+    MQTTAsync_successData * response);
+static void cb_mqtt_on_caps_topic_failure (void *context,
+    MQTTAsync_failureData * response);
 
 static void cb_memory_wrapped_destroy (void *p);
 
-static GstMQTTMessageHdr *_extract_mqtt_msg_hdr_from (GstMemory * mem,
-    GstMemory ** hdr_mem, GstMapInfo * hdr_map_info);
+static gsize _extract_mqtt_msg_hdr_from (GstMqttSrc * self, GstMemory * mem,
+    GstMQTTMessageHdr * hdr, guint * num_infos, GstCaps ** caps);
 static void _put_timestamp_on_gst_buf (GstMqttSrc * self,
     GstMQTTMessageHdr * hdr, GstBuffer * buf);
 static gboolean _subscribe (GstMqttSrc * self);
@@ -210,6 +215,9 @@ gst_mqtt_src_init (GstMqttSrc * self)
   g_mutex_unlock (&self->mqtt_src_mutex);
   self->base_time_epoch = GST_CLOCK_TIME_NONE;
   self->caps = NULL;
+  self->caps_cache = g_hash_table_new_full (g_direct_hash, g_direct_equal,
+      NULL, (GDestroyNotify) gst_caps_unref);
+  self->buf_infos = g_new0 (GstMQTTBufferInfo, GST_MQTT_MAX_AGGREGATED_BUFFERS);
   self->num_dumped = 0;
 
   gst_base_src_set_live (basesrc, self->is_live);
@@ -420,6 +428,8 @@ gst_mqtt_src_class_finalize (GObject * object)
   g_free (self->mqtt_host_port);
   g_free (self->mqtt_topic);
   gst_caps_replace (&self->caps, NULL);
+  g_clear_pointer (&self->caps_cache, g_hash_table_destroy);
+  g_clear_pointer (&self->buf_infos, g_free);
 
   if (self->err)
     g_error_free (self->err);
@@ -1089,16 +1099,16 @@ cb_mqtt_on_message_arrived (void *context, char *topic_name, int topic_len,
 {
   const int size = message->payloadlen;
   guint8 *data = message->payload;
-  GstMQTTMessageHdr *mqtt_msg_hdr;
-  GstMapInfo hdr_map_info;
+  GstMQTTMessageHdr mqtt_msg_hdr;
   GstMemory *received_mem;
-  GstMemory *hdr_mem;
+  GstCaps *recv_caps = NULL;
   GstBuffer *buffer;
   GstBaseSrc *basesrc;
   GstMqttSrc *self;
   GstClock *clock;
   gsize offset;
-  guint i;
+  guint num_infos;
+  guint i, j;
   UNUSED (topic_name);
   UNUSED (topic_len);
 
@@ -1124,9 +1134,9 @@ cb_mqtt_on_message_arrived (void *context, char *topic_name, int topic_len,
     return TRUE;
   }
 
-  mqtt_msg_hdr = _extract_mqtt_msg_hdr_from (received_mem, &hdr_mem,
-      &hdr_map_info);
-  if (!mqtt_msg_hdr) {
+  offset = _extract_mqtt_msg_hdr_from (self, received_mem, &mqtt_msg_hdr,
+      &num_infos, &recv_caps);
+  if (offset == 0) {
     if (!self->err) {
       self->err = g_error_new (self->gquark_err_tag, ENODATA,
           "%s: failed to extract header information from received message: %s",
@@ -1135,31 +1145,24 @@ cb_mqtt_on_message_arrived (void *context, char *topic_name, int topic_len,
     goto ret_unref_received_mem;
   }
 
-  if (!self->caps) {
-    self->caps = gst_caps_from_string (mqtt_msg_hdr->gst_caps_str);
-    gst_mqtt_src_renegotiate (basesrc);
-  } else {
-    GstCaps *recv_caps = gst_caps_from_string (mqtt_msg_hdr->gst_caps_str);
-
-    if (recv_caps && !gst_caps_is_equal (self->caps, recv_caps)) {
-      gst_caps_replace (&self->caps, recv_caps);
-      gst_mqtt_src_renegotiate (basesrc);
-    } else {
-      gst_caps_replace (&recv_caps, NULL);
-    }
+  /* The caps message (compact header without memories) only updates the cache. */
+  if (num_infos == 1 && self->buf_infos[0].num_mems == 0 &&
+      gst_mqtt_is_compact_hdr (data, size)) {
+    gst_caps_replace (&recv_caps, NULL);
+    goto ret_unref_received_mem;
   }
 
-  buffer = gst_buffer_new ();
-  offset = GST_MQTT_LEN_MSG_HDR;
-  for (i = 0; i < mqtt_msg_hdr->num_mems; ++i) {
-    GstMemory *each_memory;
-    int each_size;
+  if (!recv_caps) {
+    GST_WARNING_OBJECT (self,
+        "Dropped the message, the caps of the message are not received yet.");
+    goto ret_unref_received_mem;
+  }
 
-    each_size = mqtt_msg_hdr->size_mems[i];
-    each_memory = gst_memory_share (received_mem, offset, each_size);
-    gst_buffer_append_memory (buffer, each_memory);
-    offset += each_size;
+  if (!self->caps || !gst_caps_is_equal (self->caps, recv_caps)) {
+    gst_caps_replace (&self->caps, recv_caps);
+    gst_mqtt_src_renegotiate (basesrc);
   }
+  gst_caps_unref (recv_caps);
 
   /** Timestamp synchronization */
   if (self->debug) {
@@ -1175,11 +1178,28 @@ cb_mqtt_on_message_arrived (void *context, char *topic_name, int topic_len,
       gst_object_unref (clock);
     }
   }
-  _put_timestamp_on_gst_buf (self, mqtt_msg_hdr, buffer);
-  g_async_queue_push (self->aqueue, buffer);
 
-  gst_memory_unmap (hdr_mem, &hdr_map_info);
-  gst_memory_unref (hdr_mem);
+  /** An aggregated message is split into the buffers packed by mqttsink */
+  for (i = 0; i < num_infos; ++i) {
+    const GstMQTTBufferInfo *info = &self->buf_infos[i];
+
+    buffer = gst_buffer_new ();
+    for (j = 0; j < info->num_mems; ++j) {
+      GstMemory *each_memory;
+      gsize each_size;
+
+      each_size = info->size_mems[j];
+      each_memory = gst_memory_share (received_mem, offset, each_size);
+      gst_buffer_append_memory (buffer, each_memory);
+      offset += each_size;
+    }
+
+    mqtt_msg_hdr.pts = info->pts;
+    mqtt_msg_hdr.dts = info->dts;
+    mqtt_msg_hdr.duration = info->duration;
+    _put_timestamp_on_gst_buf (self, &mqtt_msg_hdr, buffer);
+    g_async_queue_push (self->aqueue, buffer);
+  }
 
 ret_unref_received_mem:
   gst_memory_unref (received_mem);
@@ -1316,6 +1336,33 @@ cb_mqtt_on_unsubscribe_failure (void *context, MQTTAsync_failureData * response)
   g_mutex_unlock (&self->mqtt_src_mutex);
 }
 
+/**
+ * @brief MQTTAsync_responseOptions's onSuccess callback for (un)subscribing the caps topic
+ */
+static void
+cb_mqtt_on_caps_topic_done (void *context, MQTTAsync_successData * response)
+{
+  GstMqttSrc *self = GST_MQTT_SRC (context);
+  UNUSED (response);
+
+  GST_DEBUG_OBJECT (self, "The request for the caps topic of %s is done.",
+      self->mqtt_topic);
+}
+
+/**
+ * @brief MQTTAsync_responseOptions's onFailure callback for (un)subscribing the caps topic
+ */
+static void
+cb_mqtt_on_caps_topic_failure (void *context, MQTTAsync_failureData * response)
+{
+  GstMqttSrc *self = GST_MQTT_SRC (context);
+
+  GST_WARNING_OBJECT (self,
+      "The request for the caps topic of %s failed (%d), "
+      "the caps are found only in the messages.", self->mqtt_topic,
+      response->code);
+}
+
 /**
  * @brief A helper function to properly invoke MQTTAsync_subscribe ()
  */
@@ -1333,6 +1380,21 @@ _subscribe (GstMqttSrc * self)
       self->mqtt_topic, self->mqtt_qos, &opts);
   if (mqttasync_ret != MQTTASYNC_SUCCESS)
     return FALSE;
+
+  /* the retained caps of the compact header, not fatal if it fails */
+  if (!g_str_has_suffix (self->mqtt_topic, "#")) {
+    gchar *caps_topic = g_strconcat (self->mqtt_topic,
+        GST_MQTT_CAPS_TOPIC_SUFFIX, NULL);
+
+    opts.onSuccess = cb_mqtt_on_caps_topic_done;
+    opts.onFailure = cb_mqtt_on_caps_topic_failure;
+    if (MQTTAsync_subscribe (self->mqtt_client_handle, caps_topic,
+            self->mqtt_qos, &opts) != MQTTASYNC_SUCCESS) {
+      GST_WARNING_OBJECT (self, "Failed to subscribe to %s", caps_topic);
+    }
+    g_free (caps_topic);
+  }
+
   return TRUE;
 }
 
@@ -1345,6 +1407,17 @@ _unsubscribe (GstMqttSrc * self)
   MQTTAsync_responseOptions opts = self->mqtt_respn_opts;
   int mqttasync_ret;
 
+  if (!g_str_has_suffix (self->mqtt_topic, "#")) {
+    MQTTAsync_responseOptions caps_opts = self->mqtt_respn_opts;
+    gchar *caps_topic = g_strconcat (self->mqtt_topic,
+        GST_MQTT_CAPS_TOPIC_SUFFIX, NULL);
+
+    caps_opts.onSuccess = cb_mqtt_on_caps_topic_done;
+    caps_opts.onFailure = cb_mqtt_on_caps_topic_failure;
+    MQTTAsync_unsubscribe (self->mqtt_client_handle, caps_topic, &caps_opts);
+    g_free (caps_topic);
+  }
+
   opts.onSuccess = cb_mqtt_on_unsubscribe;
   opts.onFailure = cb_mqtt_on_unsubscribe_failure;
 
@@ -1355,22 +1428,92 @@ _unsubscribe (GstMqttSrc * self)
   return TRUE;
 }
 
+/**
+ * @brief A utility function to get the caps by the hash of the caps string.
+ *        The caps string is parsed only if the hash is not in the cache.
+ * @return The caps (should be unreferenced), NULL if unknown
+ */
+static GstCaps *
+_get_caps_by_hash (GstMqttSrc * self, const guint32 hash,
+    const gchar * caps_str)
+{
+  gpointer key = GUINT_TO_POINTER (hash);
+  GstCaps *caps = g_hash_table_lookup (self->caps_cache, key);
+
+  if (!caps && caps_str) {
+    caps = gst_caps_from_string (caps_str);
+    if (!caps)
+      return NULL;
+
+    if (g_hash_table_size (self->caps_cache) >= MAX_CACHED_CAPS)
+      g_hash_table_remove_all (self->caps_cache);
+    g_hash_table_insert (self->caps_cache, key, caps);
+  }
+
+  return caps ? gst_caps_ref (caps) : NULL;
+}
+
 /**
  * @brief A utility function to extract header information from a received message
+ * @return The offset of the first memory in the message, 0 on error. The memories and timestamps of each buffer are stored in buf_infos.
  */
-static GstMQTTMessageHdr *
-_extract_mqtt_msg_hdr_from (GstMemory * mem, GstMemory ** hdr_mem,
-    GstMapInfo * hdr_map_info)
+static gsize
+_extract_mqtt_msg_hdr_from (GstMqttSrc * self, GstMemory * mem,
+    GstMQTTMessageHdr * hdr, guint * num_infos, GstCaps ** caps)
 {
-  *hdr_mem = gst_memory_share (mem, 0, GST_MQTT_LEN_MSG_HDR);
-  g_return_val_if_fail (*hdr_mem != NULL, NULL);
+  GstMQTTBufferInfo *infos = self->buf_infos;
+  GstMapInfo map;
+  gsize hdr_len = 0;
+  gsize total;
+  guint32 hash;
+  gboolean with_caps;
+  guint i, j;
+
+  if (!gst_memory_map (mem, &map, GST_MAP_READ))
+    return 0;
+
+  *num_infos = 0;
+  if (gst_mqtt_is_compact_hdr (map.data, map.size)) {
+    hdr_len = gst_mqtt_compact_hdr_decode_aggregated (map.data, map.size, hdr,
+        infos, num_infos, &hash, &with_caps);
+    if (hdr_len > 0) {
+      /* inline caps always replace the cached one */
+      if (with_caps)
+        g_hash_table_remove (self->caps_cache, GUINT_TO_POINTER (hash));
+      *caps = _get_caps_by_hash (self, hash,
+          with_caps ? hdr->gst_caps_str : NULL);
+    }
+  } else if (map.size >= GST_MQTT_LEN_MSG_HDR) {
+    memcpy (hdr, map.data, GST_MQTT_LEN_MSG_HDR);
+    hdr->gst_caps_str[GST_MQTT_MAX_LEN_GST_CAPS_STR - 1] = '\0';
+    if (hdr->num_mems <= GST_MQTT_MAX_NUM_MEMS) {
+      hdr_len = GST_MQTT_LEN_MSG_HDR;
+      *num_infos = 1;
+      infos[0].num_mems = hdr->num_mems;
+      memcpy (infos[0].size_mems, hdr->size_mems, sizeof (hdr->size_mems));
+      infos[0].pts = hdr->pts;
+      infos[0].dts = hdr->dts;
+      infos[0].duration = hdr->duration;
+      *caps = _get_caps_by_hash (self,
+          gst_mqtt_caps_hash (hdr->gst_caps_str), hdr->gst_caps_str);
+    }
+  }
 
-  if (!gst_memory_map (*hdr_mem, hdr_map_info, GST_MAP_READ)) {
-    gst_memory_unref (*hdr_mem);
-    return NULL;
+  /* the memories should be in the message */
+  total = hdr_len;
+  for (i = 0; hdr_len > 0 && i < *num_infos; i++) {
+    for (j = 0; j < infos[i].num_mems; j++) {
+      if (infos[i].size_mems[j] > map.size - total) {
+        gst_caps_replace (caps, NULL);
+        hdr_len = 0;
+        break;
+      }
+      total += infos[i].size_mems[j];
+    }
   }
 
-  return (GstMQTTMessageHdr *) hdr_map_info->data;
+  gst_memory_unmap (mem, &map);
+  return hdr_len;
 }
 
 /**
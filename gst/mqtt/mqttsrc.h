@@ -65,6 +65,8 @@ struct _GstMqttSrc {
   GCond mqtt_src_gcond;
   gboolean is_connected;
   gboolean is_subscribed;
+  GHashTable *caps_cache;     /**< received caps by the hash of the caps string */
+  GstMQTTBufferInfo *buf_infos; /**< buffers in the received message, room for GST_MQTT_MAX_AGGREGATED_BUFFERS */
 
   MQTTAsync mqtt_client_handle;
   MQTTAsync_connectOptions mqtt_conn_opts;
@@ -100,6 +100,11 @@ enum
  */
 #define DEFAULT_CONCAT TRUE
 
+/**
+ * @brief The number of output frames the storage of sliding window can hold.
+ */
+#define WINDOW_CAPACITY_SCALE (4U)
+
 /**
  * @brief Template caps string for pads.
  */
@@ -143,6 +148,7 @@ gst_tensor_aggregator_change_state (GstElement * element,
     GstStateChange transition);
 
 static void gst_tensor_aggregator_reset (GstTensorAggregator * self);
+static void gst_tensor_aggregator_window_free (gpointer data);
 static GstCaps *gst_tensor_aggregator_query_caps (GstTensorAggregator * self,
     GstPad * pad, GstCaps * filter);
 static gboolean gst_tensor_aggregator_parse_caps (GstTensorAggregator * self,
@@ -284,6 +290,8 @@ gst_tensor_aggregator_init (GstTensorAggregator * self)
   gst_tensors_config_init (&self->out_config);
 
   self->adapter_table = gst_tensor_aggregation_init ();
+  self->window_table = g_hash_table_new_full (g_direct_hash, g_direct_equal,
+      NULL, gst_tensor_aggregator_window_free);
   gst_tensor_aggregator_reset (self);
 }
 
@@ -302,6 +310,7 @@ gst_tensor_aggregator_finalize (GObject * object)
   gst_tensors_config_free (&self->in_config);
   gst_tensors_config_free (&self->out_config);
   g_hash_table_destroy (self->adapter_table);
+  g_hash_table_destroy (self->window_table);
 
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
@@ -799,26 +808,39 @@ gst_tensor_aggregator_concat (GstTensorAggregator * self, GstBuffer * outbuf,
 }
 
 /**
- * @brief Push the buffer to source pad. (Concatenate the buffer if needed)
+ * @brief Get tensor info for one frame, and check the size of frame.
  */
-static GstFlowReturn
-gst_tensor_aggregator_push (GstTensorAggregator * self, GstBuffer * outbuf,
-    gsize frame_size)
+static gboolean
+gst_tensor_aggregator_get_frame_info (GstTensorAggregator * self,
+    gsize frame_size, GstTensorInfo * info)
 {
-  GstTensorInfo info;
-
   /** tensor info for one frame */
-  info = self->out_config.info.info[0];
+  *info = self->out_config.info.info[0];
   g_assert (self->frames_dim < NNS_TENSOR_RANK_LIMIT);
-  info.dimension[self->frames_dim] /= self->frames_out;
+  info->dimension[self->frames_dim] /= self->frames_out;
 
-  if (frame_size != gst_tensor_info_get_size (&info) || frame_size == 0U) {
+  if (frame_size != gst_tensor_info_get_size (info) || frame_size == 0U) {
     ml_logf
         ("Invalid output capability of tensor_aggregator. Frame size = %"
         G_GSIZE_FORMAT "\n", frame_size);
-    return GST_FLOW_ERROR;
+    return FALSE;
   }
 
+  return TRUE;
+}
+
+/**
+ * @brief Push the buffer to source pad. (Concatenate the buffer if needed)
+ */
+static GstFlowReturn
+gst_tensor_aggregator_push (GstTensorAggregator * self, GstBuffer * outbuf,
+    gsize frame_size)
+{
+  GstTensorInfo info;
+
+  if (!gst_tensor_aggregator_get_frame_info (self, frame_size, &info))
+    return GST_FLOW_ERROR;
+
   if (gst_tensor_aggregator_check_concat_axis (self, &info)) {
     /** change data in buffer with given axis */
     if (!gst_tensor_aggregator_concat (self, outbuf, &info))
@@ -828,6 +850,347 @@ gst_tensor_aggregator_push (GstTensorAggregator * self, GstBuffer * outbuf,
   return gst_pad_push (self->srcpad, outbuf);
 }
 
+/**
+ * @brief Storage of the sliding window, shared with the outgoing buffers.
+ */
+typedef struct
+{
+  gint refcount; /**< the window and each outgoing buffer hold a reference */
+  guint8 *data; /**< frames in the output layout */
+  gsize size; /**< size of data */
+} tensor_aggregator_storage_s;
+
+/**
+ * @brief Sliding window of the incoming frames (frames-flush < frames-out).
+ *
+ * The frames are written once into the storage, in the layout of output buffer.
+ * Each frame is divided into the blocks to be concatenated (see gst_tensor_aggregator_concat()),
+ * and the block of a frame is placed at (block index * capacity + frame index) in the storage.
+ * Then the frames in a window are contiguous for each block, the outgoing buffer
+ * is a view of the storage without concatenation, or a copy of each block.
+ */
+typedef struct
+{
+  tensor_aggregator_storage_s *storage; /**< frames */
+  GstClockTime *pts; /**< timestamp of each frame */
+  GstClockTime *dts; /**< decoding timestamp of each frame */
+  guint capacity; /**< max number of frames in the storage */
+  guint start; /**< index of the first frame in the window */
+  guint end; /**< index to write the next frame */
+  guint num_blocks; /**< number of blocks in a frame */
+  gsize block_size; /**< size of a block */
+  GstClockTime last_pts; /**< last valid timestamp of incoming buffer */
+  GstClockTime last_dts; /**< last valid decoding timestamp of incoming buffer */
+  guint64 pts_dist; /**< number of frames since last_pts */
+  guint64 dts_dist; /**< number of frames since last_dts */
+} tensor_aggregator_window_s;
+
+/**
+ * @brief Internal function to allocate the storage of sliding window.
+ */
+static tensor_aggregator_storage_s *
+gst_tensor_aggregator_storage_new (gsize size)
+{
+  tensor_aggregator_storage_s *storage;
+
+  storage = g_new0 (tensor_aggregator_storage_s, 1);
+  storage->refcount = 1;
+  storage->data = (guint8 *) g_malloc (size);
+  storage->size = size;
+
+  return storage;
+}
+
+/**
+ * @brief Internal function to increase the reference count of storage.
+ */
+static gpointer
+gst_tensor_aggregator_storage_ref (tensor_aggregator_storage_s * storage)
+{
+  g_atomic_int_inc (&storage->refcount);
+  return storage;
+}
+
+/**
+ * @brief Internal function to decrease the reference count of storage, and free it if unused.
+ */
+static void
+gst_tensor_aggregator_storage_unref (gpointer data)
+{
+  tensor_aggregator_storage_s *storage = (tensor_aggregator_storage_s *) data;
+
+  if (g_atomic_int_dec_and_test (&storage->refcount)) {
+    g_free (storage->data);
+    g_free (storage);
+  }
+}
+
+/**
+ * @brief Internal function to free the sliding window.
+ */
+static void
+gst_tensor_aggregator_window_free (gpointer data)
+{
+  tensor_aggregator_window_s *window = (tensor_aggregator_window_s *) data;
+
+  if (window) {
+    gst_tensor_aggregator_storage_unref (window->storage);
+    g_free (window->pts);
+    g_free (window->dts);
+    g_free (window);
+  }
+}
+
+/**
+ * @brief Internal function to get the sliding window for incoming buffer.
+ */
+static tensor_aggregator_window_s *
+gst_tensor_aggregator_get_window (GstTensorAggregator * self, GstBuffer * buf,
+    gsize frame_size)
+{
+  tensor_aggregator_window_s *window;
+  GstTensorInfo info;
+  GstMetaQuery *meta;
+  guint32 key = 0;
+  guint f;
+
+  meta = gst_buffer_get_meta_query (buf);
+  if (meta)
+    key = meta->client_id;
+
+  window = (tensor_aggregator_window_s *) g_hash_table_lookup (self->window_table,
+      GUINT_TO_POINTER (key));
+  if (window)
+    return window;
+
+  if (!gst_tensor_aggregator_get_frame_info (self, frame_size, &info))
+    return NULL;
+
+  window = g_new0 (tensor_aggregator_window_s, 1);
+  window->num_blocks = 1;
+  window->block_size = frame_size;
+
+  if (gst_tensor_aggregator_check_concat_axis (self, &info)) {
+    window->block_size = gst_tensor_get_element_size (info.type);
+    for (f = 0; f <= self->frames_dim; f++)
+      window->block_size *= info.dimension[f];
+
+    window->num_blocks = frame_size / window->block_size;
+  }
+
+  window->capacity = self->frames_out * WINDOW_CAPACITY_SCALE;
+  window->storage = gst_tensor_aggregator_storage_new (frame_size *
+      window->capacity);
+  window->pts = g_new (GstClockTime, window->capacity);
+  window->dts = g_new (GstClockTime, window->capacity);
+  window->last_pts = window->last_dts = GST_CLOCK_TIME_NONE;
+
+  g_hash_table_insert (self->window_table, GUINT_TO_POINTER (key), window);
+  return window;
+}
+
+/**
+ * @brief Internal function to move the frames in the window to the head of storage.
+ * If the outgoing buffers still refer the storage, the frames are moved to new storage.
+ */
+static void
+gst_tensor_aggregator_window_compact (tensor_aggregator_window_s * window)
+{
+  tensor_aggregator_storage_s *storage = window->storage;
+  const gsize block_size = window->block_size;
+  guint capacity = window->capacity;
+  guint b, remained;
+
+  remained = window->end - window->start;
+
+  /* The frames are not pushed (e.g., flow error), increase the storage. */
+  if (remained * 2 > capacity)
+    capacity *= 2;
+
+  if (capacity != window->capacity ||
+      g_atomic_int_get (&storage->refcount) > 1) {
+    storage = gst_tensor_aggregator_storage_new (window->num_blocks *
+        block_size * capacity);
+
+    for (b = 0; b < window->num_blocks; b++) {
+      memcpy (storage->data + b * capacity * block_size,
+          window->storage->data + (b * window->capacity +
+              window->start) * block_size, remained * block_size);
+    }
+
+    gst_tensor_aggregator_storage_unref (window->storage);
+    window->storage = storage;
+  } else {
+    for (b = 0; b < window->num_blocks; b++) {
+      memmove (storage->data + b * capacity * block_size,
+          storage->data + (b * capacity + window->start) * block_size,
+          remained * block_size);
+    }
+  }
+
+  memmove (window->pts, window->pts + window->start,
+      remained * sizeof (GstClockTime));
+  memmove (window->dts, window->dts + window->start,
+      remained * sizeof (GstClockTime));
+  window->pts = g_renew (GstClockTime, window->pts, capacity);
+  window->dts = g_renew (GstClockTime, window->dts, capacity);
+
+  window->capacity = capacity;
+  window->start = 0;
+  window->end = remained;
+}
+
+/**
+ * @brief Internal function to get the outgoing buffer from the sliding window.
+ */
+static GstBuffer *
+gst_tensor_aggregator_window_get_buffer (GstTensorAggregator * self,
+    tensor_aggregator_window_s * window)
+{
+  tensor_aggregator_storage_s *storage = window->storage;
+  const gsize block_size = window->block_size;
+  const gsize out_size = block_size * self->frames_out;
+  GstBuffer *outbuf;
+  GstMemory *mem;
+  GstMapInfo map;
+  guint b;
+
+  if (window->num_blocks == 1) {
+    /* The frames are contiguous, share the storage without copy. */
+    mem = gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY, storage->data,
+        storage->size, window->start * block_size, out_size,
+        gst_tensor_aggregator_storage_ref (storage),
+        gst_tensor_aggregator_storage_unref);
+
+    outbuf = gst_buffer_new ();
+    gst_buffer_append_memory (outbuf, mem);
+    return outbuf;
+  }
+
+  outbuf = gst_buffer_new_and_alloc (out_size * window->num_blocks);
+  if (!gst_buffer_map (outbuf, &map, GST_MAP_WRITE)) {
+    ml_logf ("Failed to map destination buffer with tensor_aggregator.\n");
+    gst_buffer_unref (outbuf);
+    return NULL;
+  }
+
+  for (b = 0; b < window->num_blocks; b++) {
+    nns_memcpy (map.data + b * out_size,
+        storage->data + (b * window->capacity + window->start) * block_size,
+        out_size);
+  }
+
+  gst_buffer_unmap (outbuf, &map);
+  return outbuf;
+}
+
+/**
+ * @brief Chain function's private routine to aggregate the frames with sliding window.
+ */
+static GstFlowReturn
+gst_tensor_aggregator_chain_window (GstTensorAggregator * self, GstBuffer * buf,
+    gsize frame_size)
+{
+  tensor_aggregator_window_s *window;
+  GstFlowReturn ret = GST_FLOW_OK;
+  GstMapInfo map;
+  GstClockTime duration, pts, dts;
+  guint i, b;
+  gint fn, fd;
+
+  window = gst_tensor_aggregator_get_window (self, buf, frame_size);
+  if (!window || frame_size != window->block_size * window->num_blocks) {
+    ml_logf
+        ("Invalid output capability of tensor_aggregator. Frame size = %"
+        G_GSIZE_FORMAT "\n", frame_size);
+    gst_buffer_unref (buf);
+    return GST_FLOW_ERROR;
+  }
+
+  if (!gst_buffer_map (buf, &map, GST_MAP_READ)) {
+    ml_logf ("Failed to map source buffer with tensor_aggregator.\n");
+    gst_buffer_unref (buf);
+    return GST_FLOW_ERROR;
+  }
+
+  duration = GST_BUFFER_DURATION (buf);
+  if (GST_CLOCK_TIME_IS_VALID (duration)) {
+    /** supposed same duration for incoming buffer */
+    duration = gst_util_uint64_scale_int (duration, self->frames_out,
+        self->frames_in);
+  }
+
+  if (GST_BUFFER_PTS_IS_VALID (buf)) {
+    window->last_pts = GST_BUFFER_PTS (buf);
+    window->pts_dist = 0;
+  }
+
+  if (GST_BUFFER_DTS_IS_VALID (buf)) {
+    window->last_dts = GST_BUFFER_DTS (buf);
+    window->dts_dist = 0;
+  }
+
+  fn = self->in_config.rate_n;
+  fd = self->in_config.rate_d;
+
+  for (i = 0; i < self->frames_in; i++) {
+    if (window->end == window->capacity)
+      gst_tensor_aggregator_window_compact (window);
+
+    for (b = 0; b < window->num_blocks; b++) {
+      nns_memcpy (window->storage->data +
+          (b * window->capacity + window->end) * window->block_size,
+          map.data + i * frame_size + b * window->block_size,
+          window->block_size);
+    }
+
+    /**
+     * Update timestamp, same as the adapter does.
+     * If frames-in is larger then frames-out, the same timestamp (pts and dts) would be returned.
+     */
+    pts = window->last_pts;
+    dts = window->last_dts;
+
+    if (self->frames_in > 1 && fn > 0 && fd > 0) {
+      if (GST_CLOCK_TIME_IS_VALID (pts))
+        pts += gst_util_uint64_scale_int (window->pts_dist * fd, GST_SECOND, fn);
+
+      if (GST_CLOCK_TIME_IS_VALID (dts))
+        dts += gst_util_uint64_scale_int (window->dts_dist * fd, GST_SECOND, fn);
+    }
+
+    window->pts[window->end] = pts;
+    window->dts[window->end] = dts;
+    window->pts_dist++;
+    window->dts_dist++;
+    window->end++;
+
+    while (window->end - window->start >= self->frames_out &&
+        ret == GST_FLOW_OK) {
+      GstBuffer *outbuf;
+
+      outbuf = gst_tensor_aggregator_window_get_buffer (self, window);
+      if (!outbuf) {
+        ret = GST_FLOW_ERROR;
+        break;
+      }
+
+      /** copy meta (e.g., client id) and set timestamp */
+      gst_buffer_copy_into (outbuf, buf, GST_BUFFER_COPY_META, 0, -1);
+      GST_BUFFER_PTS (outbuf) = window->pts[window->start];
+      GST_BUFFER_DTS (outbuf) = window->dts[window->start];
+      GST_BUFFER_DURATION (outbuf) = duration;
+
+      window->start += self->frames_flush;
+      ret = gst_pad_push (self->srcpad, outbuf);
+    }
+  }
+
+  gst_buffer_unmap (buf, &map);
+  gst_buffer_unref (buf);
+  return ret;
+}
+
 /**
  * @brief Chain function, this function does the actual processing.
  */
@@ -858,6 +1221,11 @@ gst_tensor_aggregator_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
     return gst_tensor_aggregator_push (self, buf, frame_size);
   }
 
+  if (frames_flush > 0 && frames_flush < frames_out) {
+    /** overlapped frames, each frame is copied once into the sliding window */
+    return gst_tensor_aggregator_chain_window (self, buf, frame_size);
+  }
+
   adapter = gst_tensor_aggregator_get_adapter (self, buf);
   g_assert (adapter != NULL);
 
@@ -981,6 +1349,7 @@ gst_tensor_aggregator_reset (GstTensorAggregator * self)
 {
   /* remove all buffers from adapter */
   gst_tensor_aggregation_clear_all (self->adapter_table);
+  g_hash_table_remove_all (self->window_table);
 }
 
 /**
@@ -1073,6 +1442,9 @@ gst_tensor_aggregator_parse_caps (GstTensorAggregator * self,
 
   _info->dimension[self->frames_dim] = per_frame * self->frames_out;
   self->out_config = config;
+
+  /* frame size may be changed, clear the sliding windows. */
+  g_hash_table_remove_all (self->window_table);
   self->tensor_configured = TRUE;
 
   silent_debug_config (self, &self->in_config, "in-tensor");
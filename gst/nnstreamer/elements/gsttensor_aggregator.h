@@ -64,6 +64,7 @@ struct _GstTensorAggregator
   guint frames_dim; /**< index of frames in tensor dimension */
 
   GHashTable *adapter_table; /**< adapt incoming tensor */
+  GHashTable *window_table; /**< sliding window of incoming frames (frames-flush < frames-out) */
 
   gboolean tensor_configured; /**< True if already successfully configured tensor metadata */
   GstTensorsConfig in_config; /**< input tensor info */
@@ -123,7 +123,11 @@ enum
   PROP_SET_TIMESTAMP,
   PROP_SUBPLUGINS,
   PROP_SILENT,
-  PROP_MODE
+  PROP_MODE,
+  PROP_OUTPUT_SIZE,
+  PROP_OUTPUT_FORMAT,
+  PROP_LETTERBOX,
+  PROP_NORMALIZE
 };
 
 /**
@@ -141,6 +145,11 @@ enum
  */
 #define DEFAULT_FRAMES_PER_TENSOR 1
 
+/**
+ * @brief Default output format of YUV frame.
+ */
+#define DEFAULT_OUTPUT_FORMAT "RGB"
+
 #define gst_tensor_converter_parent_class parent_class
 G_DEFINE_TYPE (GstTensorConverter, gst_tensor_converter, GST_TYPE_ELEMENT);
 
@@ -273,6 +282,50 @@ gst_tensor_converter_class_init (GstTensorConverterClass * klass)
           "Converter mode. e.g., mode=custom-code:<registered callback name>. For detail, refer to https://github.com/nnstreamer/nnstreamer/blob/main/gst/nnstreamer/elements/gsttensor_converter.md#custom-converter",
           "", G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstTensorConverter::output-size:
+   *
+   * The size of output tensor for YUV (NV12, I420 and YUY2) video stream, in the format of WIDTH:HEIGHT.
+   * The frame is resized with bilinear interpolation. If not set, the output has the same size as the input.
+   */
+  g_object_class_install_property (object_class, PROP_OUTPUT_SIZE,
+      g_param_spec_string ("output-size", "Output size",
+          "The size of output tensor for YUV video stream (WIDTH:HEIGHT)", "",
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTensorConverter::output-format:
+   *
+   * The color of output tensor for YUV (NV12, I420 and YUY2) video stream. (RGB, BGR or GRAY8)
+   */
+  g_object_class_install_property (object_class, PROP_OUTPUT_FORMAT,
+      g_param_spec_string ("output-format", "Output format",
+          "The color of output tensor for YUV video stream (RGB, BGR or GRAY8)",
+          DEFAULT_OUTPUT_FORMAT, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTensorConverter::letterbox:
+   *
+   * The flag to keep the aspect ratio when resizing YUV video stream.
+   * The rest of the output is filled with black.
+   */
+  g_object_class_install_property (object_class, PROP_LETTERBOX,
+      g_param_spec_boolean ("letterbox", "Letterbox",
+          "The flag to keep the aspect ratio when resizing YUV video stream",
+          FALSE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTensorConverter::normalize:
+   *
+   * Mean and standard deviation to normalize YUV video stream, in the format of MEAN:STD.
+   * Each can be a value or comma-separated values for the channels (e.g., 123.675,116.28,103.53:58.395,57.12,57.375).
+   * If set, the output tensor is float32 of (value - mean) / std for each channel.
+   */
+  g_object_class_install_property (object_class, PROP_NORMALIZE,
+      g_param_spec_string ("normalize", "Normalize",
+          "Mean and standard deviation to normalize YUV video stream to float32 (MEAN:STD)",
+          "", G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   /* set src pad template */
   pad_caps =
       gst_caps_from_string (GST_TENSOR_CAP_DEFAULT ";"
@@ -358,7 +411,10 @@ gst_tensor_converter_init (GstTensorConverter * self)
   self->frames_per_tensor = DEFAULT_FRAMES_PER_TENSOR;
   self->in_media_type = _NNS_MEDIA_INVALID;
   self->frame_size = 0;
-  self->remove_padding = FALSE;
+  self->video_stride = 0;
+  memset (&self->video_option, 0, sizeof (tensor_converter_video_option_s));
+  self->video_option.color = TENSOR_CONVERTER_COLOR_RGB;
+  self->yuv = NULL;
   self->externalConverter = NULL;
   self->priv_data = NULL;
   self->mode = _CONVERTER_MODE_NONE;
@@ -389,6 +445,7 @@ gst_tensor_converter_finalize (GObject * object)
   gst_tensors_config_free (&self->tensors_config);
   gst_tensors_info_free (&self->tensors_info);
   g_hash_table_destroy (self->adapter_table);
+  tensor_converter_yuv_free (self->yuv);
 
   g_free (self->mode_option);
   g_free (self->ext_fw);
@@ -497,6 +554,60 @@ gst_tensor_converter_set_property (GObject * object, guint prop_id,
 
       break;
     }
+    case PROP_OUTPUT_SIZE:
+    {
+      guint64 width = 0, height = 0;
+      gchar **strv;
+
+      value_str = g_value_get_string (value);
+      strv = g_strsplit (value_str ? value_str : "", ":", -1);
+
+      if (g_strv_length (strv) == 2) {
+        width = g_ascii_strtoull (strv[0], NULL, 10);
+        height = g_ascii_strtoull (strv[1], NULL, 10);
+      }
+
+      if (width > 0 && height > 0 && width <= G_MAXINT && height <= G_MAXINT) {
+        self->video_option.width = (guint) width;
+        self->video_option.height = (guint) height;
+      } else {
+        if (value_str && *value_str != '\0')
+          nns_logw ("%s is invalid output size, use WIDTH:HEIGHT.", value_str);
+        self->video_option.width = self->video_option.height = 0;
+      }
+
+      g_strfreev (strv);
+      silent_debug (self, "Set output size = %u:%u", self->video_option.width,
+          self->video_option.height);
+      break;
+    }
+    case PROP_OUTPUT_FORMAT:
+    {
+      tensor_converter_color_e color;
+
+      value_str = g_value_get_string (value);
+      color = tensor_converter_yuv_get_color (value_str);
+
+      if (color == TENSOR_CONVERTER_COLOR_UNKNOWN) {
+        nns_logw ("%s is invalid output format, use RGB, BGR or GRAY8.",
+            GST_STR_NULL (value_str));
+      } else {
+        self->video_option.color = color;
+      }
+      break;
+    }
+    case PROP_LETTERBOX:
+      self->video_option.letterbox = g_value_get_boolean (value);
+      silent_debug (self, "Set letterbox = %d", self->video_option.letterbox);
+      break;
+    case PROP_NORMALIZE:
+      value_str = g_value_get_string (value);
+
+      if (!tensor_converter_yuv_parse_normalize (value_str,
+              &self->video_option)) {
+        nns_logw ("%s is invalid normalization, use MEAN:STD.", value_str);
+      }
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -569,6 +680,36 @@ gst_tensor_converter_get_property (GObject * object, guint prop_id,
       g_value_take_string (value, mode_str);
       break;
     }
+    case PROP_OUTPUT_SIZE:
+      if (self->video_option.width > 0 && self->video_option.height > 0) {
+        g_value_take_string (value, g_strdup_printf ("%u:%u",
+                self->video_option.width, self->video_option.height));
+      } else {
+        g_value_set_string (value, "");
+      }
+      break;
+    case PROP_OUTPUT_FORMAT:
+    {
+      const gchar *colors[] = { "RGB", "BGR", "GRAY8" };
+
+      g_value_set_string (value, colors[self->video_option.color]);
+      break;
+    }
+    case PROP_LETTERBOX:
+      g_value_set_boolean (value, self->video_option.letterbox);
+      break;
+    case PROP_NORMALIZE:
+      if (self->video_option.normalize) {
+        const gfloat *m = self->video_option.mean;
+        const gfloat *d = self->video_option.std;
+
+        g_value_take_string (value,
+            g_strdup_printf ("%g,%g,%g:%g,%g,%g", m[0], m[1], m[2], d[0], d[1],
+                d[2]));
+      } else {
+        g_value_set_string (value, "");
+      }
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -688,6 +829,16 @@ gst_tensor_converter_sink_query (GstPad * pad, GstObject * parent,
       gst_query_set_accept_caps_result (query, res);
       return TRUE;
     }
+    case GST_QUERY_ALLOCATION:
+      /**
+       * The converter does not forward the buffer of video stream.
+       * With video meta, upstream can push the frame with padded rows and the converter removes the padding.
+       */
+      if (self->in_media_type == _NNS_VIDEO && !self->yuv) {
+        gst_tensor_converter_add_video_meta (query);
+        return TRUE;
+      }
+      break;
     default:
       break;
   }
@@ -920,6 +1071,50 @@ _gst_tensor_converter_chain_flex_tensor (GstTensorConverter * self,
   return buffer;
 }
 
+/**
+ * @brief Chain function's private routine to remove the padding of rows in video frame
+ * @todo Tensors do not carry the row stride. Add a stride-aware tensor meta to pass the padded frame to the consumers accepting strides.
+ */
+static GstBuffer *
+_gst_tensor_converter_chain_video_repack (GstBuffer * buf, gsize offset,
+    gsize stride, gsize row_size, guint height)
+{
+  GstBuffer *outbuf;
+  GstMapInfo src_info, dest_info;
+  guint h;
+
+  if (!gst_buffer_map (buf, &src_info, GST_MAP_READ)) {
+    ml_logf
+        ("tensor_converter: Cannot map src buffer at tensor_converter/video. The incoming buffer (GstBuffer) for the sinkpad of tensor_converter cannot be mapped for reading.\n");
+    return NULL;
+  }
+
+  outbuf = gst_buffer_new_and_alloc (row_size * height);
+  if (!gst_buffer_map (outbuf, &dest_info, GST_MAP_WRITE)) {
+    ml_logf
+        ("tensor_converter: Cannot map dest buffer at tensor_converter/video. The outgoing buffer (GstBuffer) for the srcpad of tensor_converter cannot be mapped for writing.\n");
+    gst_buffer_unmap (buf, &src_info);
+    gst_buffer_unref (outbuf);  /* the new buffer is wasted. */
+    return NULL;
+  }
+
+  /**
+   * Refer: https://gstreamer.freedesktop.org/documentation/design/mediatype-video-raw.html
+   * All rows are overwritten, so the new buffer is not cleared.
+   */
+  for (h = 0; h < height; h++) {
+    memcpy (dest_info.data + h * row_size, src_info.data + offset + h * stride,
+        row_size);
+  }
+
+  gst_buffer_unmap (buf, &src_info);
+  gst_buffer_unmap (outbuf, &dest_info);
+
+  /** copy timestamps */
+  gst_buffer_copy_into (outbuf, buf, GST_BUFFER_COPY_METADATA, 0, -1);
+  return outbuf;
+}
+
 /** @brief Chain function's private routine to push buffer into src pad */
 static GstFlowReturn
 _gst_tensor_converter_chain_push (GstTensorConverter * self, GstBuffer * buf)
@@ -1056,14 +1251,16 @@ gst_tensor_converter_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
       /** type * colorspace * width * height */
       frame_size = type * color * width * height;
 
-      /** supposed 1 frame in buffer */
-      g_assert ((buf_size / self->frame_size) == 1);
-
-      if (self->remove_padding) {
+      if (self->yuv) {
         GstMapInfo src_info, dest_info;
-        guint d0, d1;
-        unsigned int src_idx = 0, dest_idx = 0;
-        size_t size, offset;
+
+        /** supposed 1 frame in buffer */
+        if (buf_size < self->frame_size) {
+          ml_loge
+              ("tensor_converter: The incoming YUV frame (size %zu) is smaller than the frame size %zu of the caps.\n",
+              buf_size, self->frame_size);
+          goto error;
+        }
 
         if (!gst_buffer_map (buf, &src_info, GST_MAP_READ)) {
           ml_logf
@@ -1072,7 +1269,6 @@ gst_tensor_converter_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
         }
 
         inbuf = gst_buffer_new_and_alloc (frame_size);
-        gst_buffer_memset (inbuf, 0, 0, frame_size);
         if (!gst_buffer_map (inbuf, &dest_info, GST_MAP_WRITE)) {
           ml_logf
               ("tensor_converter: Cannot map dest buffer at tensor_converter/video. The outgoing buffer (GstBuffer) for the srcpad of tensor_converter cannot be mapped for writing.\n");
@@ -1081,29 +1277,44 @@ gst_tensor_converter_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
           goto error;
         }
 
-        /**
-         * Refer: https://gstreamer.freedesktop.org/documentation/design/mediatype-video-raw.html
-         */
-        size = offset = type * color * width;
-
-        g_assert (offset % 4); /** Internal logic error! */
-        if (offset % 4) {
-          offset += 4 - (offset % 4);
-        }
-
-        for (d0 = 0; d0 < frames_in; d0++) {
-          for (d1 = 0; d1 < height; d1++) {
-            memcpy (dest_info.data + dest_idx, src_info.data + src_idx, size);
-            dest_idx += size;
-            src_idx += offset;
-          }
-        }
+        /* color-convert, resize and normalize in a single pass */
+        tensor_converter_yuv_process (self->yuv, src_info.data, dest_info.data);
 
         gst_buffer_unmap (buf, &src_info);
         gst_buffer_unmap (inbuf, &dest_info);
 
         /** copy timestamps */
         gst_buffer_copy_into (inbuf, buf, GST_BUFFER_COPY_METADATA, 0, -1);
+      } else {
+        gsize offset = 0, row_size;
+        gint stride = self->video_stride;
+
+        /* The layout of frame may differ from caps if the buffer has video meta. */
+        gst_tensor_converter_get_video_meta (buf, &offset, &stride);
+        row_size = type * color * width;
+
+        /** supposed 1 frame in buffer */
+        if (stride < 0 || (gsize) stride < row_size ||
+            offset + (gsize) stride * (height - 1) + row_size > buf_size) {
+          ml_loge
+              ("tensor_converter: The incoming video frame (size %zu, offset %zu, stride %d) is smaller than the frame of %u rows with %zu bytes.\n",
+              buf_size, offset, stride, height, row_size);
+          goto error;
+        }
+
+        if ((gsize) stride == row_size) {
+          /* Rows are not padded, share the memory without copy. */
+          if (offset != 0 || buf_size != frame_size) {
+            inbuf = gst_buffer_copy_region (buf,
+                GST_BUFFER_COPY_METADATA | GST_BUFFER_COPY_MEMORY, offset,
+                frame_size);
+          }
+        } else {
+          inbuf = _gst_tensor_converter_chain_video_repack (buf, offset,
+              stride, row_size, height);
+          if (inbuf == NULL)
+            goto error;
+        }
       }
       break;
     }
@@ -1383,33 +1594,6 @@ gst_tensor_converter_get_format_list (GValue * list, ...)
   va_end (args);
 }
 
-/**
- * @brief Determine if we need zero-padding
- * @return TRUE if we need to add (or remove) stride per row from the stream data.
- */
-static gboolean
-gst_tensor_converter_video_stride (GstVideoFormat format, gint width)
-{
-  /**
-   * @todo The actual list is much longer, fill them.
-   * (read https://gstreamer.freedesktop.org/documentation/design/mediatype-video-raw.html)
-   */
-  switch (format) {
-    case GST_VIDEO_FORMAT_GRAY8:
-    case GST_VIDEO_FORMAT_RGB:
-    case GST_VIDEO_FORMAT_BGR:
-    case GST_VIDEO_FORMAT_I420:
-      if (width % 4) {
-        return TRUE;
-      }
-      break;
-    default:
-      break;
-  }
-
-  return FALSE;
-}
-
 /**
  * @brief Set the tensors config structure from video info (internal static function)
  * @param self this pointer to GstTensorConverter
@@ -1459,6 +1643,10 @@ gst_tensor_converter_parse_video (GstTensorConverter * self,
 
   config->info.num_tensors = 1;
 
+  tensor_converter_yuv_free (self->yuv);
+  self->yuv = NULL;
+  self->video_stride = GST_VIDEO_INFO_PLANE_STRIDE (&vinfo, 0);
+
   /* [color-space][width][height][frames] */
   switch (format) {
     case GST_VIDEO_FORMAT_GRAY8:
@@ -1486,13 +1674,44 @@ gst_tensor_converter_parse_video (GstTensorConverter * self,
       config->info.info[0].type = _NNS_UINT8;
       config->info.info[0].dimension[0] = 4;
       break;
+    case GST_VIDEO_FORMAT_NV12:
+    case GST_VIDEO_FORMAT_I420:
+    case GST_VIDEO_FORMAT_YUY2:
+    {
+      tensor_converter_yuv_layout_s layout;
+
+      if (gst_tensor_converter_get_yuv_layout (&vinfo, &layout))
+        self->yuv = tensor_converter_yuv_new (&layout, &self->video_option);
+
+      if (!self->yuv) {
+        GST_ERROR_OBJECT (self,
+            "Failed to prepare the conversion of video format \"%s\" (%dx%d).",
+            GST_STR_NULL (gst_video_format_to_string (format)), width, height);
+        return FALSE;
+      }
+
+      /* YUV frame is converted to RGB, BGR or GRAY8 with the size of output. */
+      config->info.info[0].type =
+          self->yuv->to_float ? _NNS_FLOAT32 : _NNS_UINT8;
+      config->info.info[0].dimension[0] = self->yuv->channels;
+      width = self->yuv->out_width;
+      height = self->yuv->out_height;
+      break;
+    }
     default:
       GST_WARNING_OBJECT (self,
-          "The given video caps with format \"%s\" is not supported. Please use GRAY8, GRAY16_LE, GRAY16_BE, RGB, BGR, RGBx, BGRx, xRGB, xBGR, RGBA, BGRA, ARGB, or ABGR.\n",
+          "The given video caps with format \"%s\" is not supported. Please use GRAY8, GRAY16_LE, GRAY16_BE, RGB, BGR, RGBx, BGRx, xRGB, xBGR, RGBA, BGRA, ARGB, ABGR, NV12, I420, or YUY2.\n",
           GST_STR_NULL (gst_video_format_to_string (format)));
       break;
   }
 
+  if (!self->yuv && (self->video_option.width > 0 ||
+          self->video_option.normalize || self->video_option.letterbox)) {
+    GST_WARNING_OBJECT (self,
+        "The properties output-size, letterbox and normalize are applied to YUV (NV12, I420 and YUY2) video stream only, ignored for the format \"%s\".",
+        GST_STR_NULL (gst_video_format_to_string (format)));
+  }
+
   config->info.info[0].dimension[1] = width;
   config->info.info[0].dimension[2] = height;
 
@@ -1505,14 +1724,16 @@ gst_tensor_converter_parse_video (GstTensorConverter * self,
   config->rate_d = GST_VIDEO_INFO_FPS_D (&vinfo);
 
   /**
-   * Emit Warning if RSTRIDE = RU4 (3BPP) && Width % 4 > 0
-   * @todo Add more conditions!
+   * Emit Warning if the rows are padded. (e.g., RSTRIDE = RU4 (3BPP) && Width % 4 > 0)
+   * The padding is removed with a copy of each frame, unless upstream pushes the frame without padding with video meta.
    */
-  if (gst_tensor_converter_video_stride (format, width)) {
-    self->remove_padding = TRUE;
-    silent_debug (self, "Set flag to remove padding, width = %d", width);
+  if (!self->yuv && config->info.info[0].type != _NNS_END &&
+      (gsize) self->video_stride !=
+      gst_tensor_get_element_size (config->info.info[0].type) *
+      config->info.info[0].dimension[0] * width) {
+    silent_debug (self, "Set flag to remove padding, width = %d, stride = %d",
+        width, self->video_stride);
 
-    /** @todo need rewrite. */
     GST_WARNING_OBJECT (self,
         "\nYOUR STREAM CONFIGURATION INCURS PERFORMANCE DETERIORATION!\n"
         "Please use 4 x n as image width for inputs; the width of your input is %d.\n",
@@ -1949,16 +2170,45 @@ gst_tensor_converter_get_possible_media_caps (GstTensorConverter * self)
           if (is_video_supported (self)) {
             GValue supported_formats = G_VALUE_INIT;
             gint colorspace, width, height;
+            gboolean yuv_out, yuv_only;
 
             colorspace = config.info.info[0].dimension[0];
+
+            /* YUV stream is converted to the color of output-format. */
+            if (self->video_option.color == TENSOR_CONVERTER_COLOR_GRAY8)
+              yuv_out = (colorspace == 1);
+            else
+              yuv_out = (colorspace == 3);
+
+            /* Only YUV stream is resized and normalized. */
+            yuv_only = yuv_out && (self->video_option.width > 0 ||
+                self->video_option.normalize);
+
             switch (colorspace) {
               case 1:
-                gst_tensor_converter_get_format_list (&supported_formats,
-                    "GRAY8", "GRAY16_BE", "GRAY16_LE", NULL);
+                if (yuv_only) {
+                  gst_tensor_converter_get_format_list (&supported_formats,
+                      "NV12", "I420", "YUY2", NULL);
+                } else if (yuv_out) {
+                  gst_tensor_converter_get_format_list (&supported_formats,
+                      "GRAY8", "GRAY16_BE", "GRAY16_LE", "NV12", "I420",
+                      "YUY2", NULL);
+                } else {
+                  gst_tensor_converter_get_format_list (&supported_formats,
+                      "GRAY8", "GRAY16_BE", "GRAY16_LE", NULL);
+                }
                 break;
               case 3:
-                gst_tensor_converter_get_format_list (&supported_formats,
-                    "RGB", "BGR", NULL);
+                if (yuv_only) {
+                  gst_tensor_converter_get_format_list (&supported_formats,
+                      "NV12", "I420", "YUY2", NULL);
+                } else if (yuv_out) {
+                  gst_tensor_converter_get_format_list (&supported_formats,
+                      "RGB", "BGR", "NV12", "I420", "YUY2", NULL);
+                } else {
+                  gst_tensor_converter_get_format_list (&supported_formats,
+                      "RGB", "BGR", NULL);
+                }
                 break;
               case 4:
                 gst_tensor_converter_get_format_list (&supported_formats,
@@ -1976,12 +2226,15 @@ gst_tensor_converter_get_possible_media_caps (GstTensorConverter * self)
             }
             g_value_unset (&supported_formats);
 
-            if ((width = config.info.info[0].dimension[1]) > 0) {
-              gst_structure_set (st, "width", G_TYPE_INT, width, NULL);
-            }
+            /* The size of input is not limited if the output is resized. */
+            if (!(yuv_only && self->video_option.width > 0)) {
+              if ((width = config.info.info[0].dimension[1]) > 0) {
+                gst_structure_set (st, "width", G_TYPE_INT, width, NULL);
+              }
 
-            if ((height = config.info.info[0].dimension[2]) > 0) {
-              gst_structure_set (st, "height", G_TYPE_INT, height, NULL);
+              if ((height = config.info.info[0].dimension[2]) > 0) {
+                gst_structure_set (st, "height", G_TYPE_INT, height, NULL);
+              }
             }
 
             if (config.rate_n >= 0 && config.rate_d > 0) {
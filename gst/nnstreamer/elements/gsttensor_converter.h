@@ -23,8 +23,9 @@
  *                Be careful: this filter assumes that the user has attached
  *               other GST converters as a preprocessor for this filter so that
  *               the incoming buffer is nicely aligned in the array of
- *               uint8[height][width][RGB]. Note that if rstride=RU4, you need
- *               to add the case in "remove_stride_padding_per_row".
+ *               uint8[height][width][RGB]. If the rows of the incoming video
+ *               frame are padded (e.g., rstride=RU4), the padding is removed
+ *               with the row stride of caps or video meta.
  *
  * @see		https://github.com/nnstreamer/nnstreamer
  * @author	MyungJoo Ham <myungjoo.ham@samsung.com>
@@ -38,6 +39,7 @@
 #include <tensor_common.h>
 #include "nnstreamer_plugin_api_converter.h"
 #include "tensor_converter_custom.h"
+#include "gsttensor_converter_yuv.h"
 
 G_BEGIN_DECLS
 
@@ -91,7 +93,9 @@ struct _GstTensorConverter
   const NNStreamerExternalConverter *externalConverter;
 
   gsize frame_size; /**< size of one frame */
-  gboolean remove_padding; /**< If true, zero-padding must be removed */
+  gint video_stride; /**< row stride of the incoming video frame given by caps */
+  tensor_converter_video_option_s video_option; /**< options to convert YUV frame */
+  tensor_converter_yuv_s *yuv; /**< data to convert YUV frame, NULL if the input is not YUV */
   gboolean tensors_configured; /**< True if already successfully configured tensors metadata */
   GstTensorsConfig tensors_config; /**< output tensors info */
 
@@ -21,16 +21,95 @@
 #endif
 
 #include <gst/video/video-info.h>
+#include <gst/video/gstvideometa.h>
+#include "gsttensor_converter_yuv.h"
 
 /**
  * @brief Caps string for supported video format
  */
 #define VIDEO_CAPS_STR \
-    GST_VIDEO_CAPS_MAKE ("{ RGB, BGR, RGBx, BGRx, xRGB, xBGR, RGBA, BGRA, ARGB, ABGR, GRAY8, GRAY16_BE, GRAY16_LE }") \
+    GST_VIDEO_CAPS_MAKE ("{ RGB, BGR, RGBx, BGRx, xRGB, xBGR, RGBA, BGRA, ARGB, ABGR, GRAY8, GRAY16_BE, GRAY16_LE, NV12, I420, YUY2 }") \
     ", interlace-mode = (string) progressive"
 
 #define append_video_caps_template(caps) \
     gst_caps_append (caps, gst_caps_from_string (VIDEO_CAPS_STR))
 
 #define is_video_supported(...) TRUE
+
+/**
+ * @brief Add video meta in allocation query, to receive the frame with padded rows.
+ */
+#define gst_tensor_converter_add_video_meta(query) \
+    gst_query_add_allocation_meta ((query), GST_VIDEO_META_API_TYPE, NULL)
+
+/**
+ * @brief Get the offset and row stride of the first plane if the buffer has video meta.
+ */
+static inline void
+gst_tensor_converter_get_video_meta (GstBuffer * buf, gsize * offset,
+    gint * stride)
+{
+  GstVideoMeta *meta = gst_buffer_get_video_meta (buf);
+
+  if (meta) {
+    *offset = meta->offset[0];
+    *stride = meta->stride[0];
+  }
+}
+
+/**
+ * @brief Get the layout and colorimetry of YUV frame from video info.
+ * @return TRUE if the format is YUV (NV12, I420 or YUY2).
+ */
+static inline gboolean
+gst_tensor_converter_get_yuv_layout (const GstVideoInfo * vinfo,
+    tensor_converter_yuv_layout_s * layout)
+{
+  guint width = GST_VIDEO_INFO_WIDTH (vinfo);
+  guint height = GST_VIDEO_INFO_HEIGHT (vinfo);
+  guint cw = (width + 1) / 2;
+  guint chroma_h = (height + 1) / 2;
+  guint i;
+
+  /* plane index, offset in the plane, pixel stride, width and height of Y, U and V */
+  const guint nv12[3][5] = { {0, 0, 1, width, height}, {1, 0, 2, cw, chroma_h}, {1, 1, 2, cw, chroma_h} };
+  const guint i420[3][5] = { {0, 0, 1, width, height}, {1, 0, 1, cw, chroma_h}, {2, 0, 1, cw, chroma_h} };
+  const guint yuy2[3][5] = { {0, 0, 2, width, height}, {0, 1, 4, cw, height}, {0, 3, 4, cw, height} };
+  const guint (*comp)[5];
+
+  switch (GST_VIDEO_INFO_FORMAT (vinfo)) {
+    case GST_VIDEO_FORMAT_NV12:
+      comp = nv12;
+      break;
+    case GST_VIDEO_FORMAT_I420:
+      comp = i420;
+      break;
+    case GST_VIDEO_FORMAT_YUY2:
+      comp = yuy2;
+      break;
+    default:
+      return FALSE;
+  }
+
+  for (i = 0; i < 3; i++) {
+    layout->comp[i].offset = GST_VIDEO_INFO_PLANE_OFFSET (vinfo, comp[i][0]) + comp[i][1];
+    layout->comp[i].stride = GST_VIDEO_INFO_PLANE_STRIDE (vinfo, comp[i][0]);
+    layout->comp[i].pstride = comp[i][2];
+    layout->comp[i].width = comp[i][3];
+    layout->comp[i].height = comp[i][4];
+  }
+
+  layout->width = width;
+  layout->height = height;
+  layout->full_range = (GST_VIDEO_INFO_COLORIMETRY (vinfo).range == GST_VIDEO_COLOR_RANGE_0_255);
+
+  /* BT.601 if the matrix is unknown */
+  if (!gst_video_color_matrix_get_Kr_Kb (GST_VIDEO_INFO_COLORIMETRY (vinfo).matrix,
+          &layout->kr, &layout->kb)) {
+    layout->kr = 0.299;
+    layout->kb = 0.114;
+  }
+
+  return TRUE;
+}
 #endif /* __GST_TENSOR_CONVERTER_MEDIA_INFO_VIDEO_H__ */
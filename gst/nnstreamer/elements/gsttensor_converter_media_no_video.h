@@ -40,7 +40,9 @@ typedef enum {
   GST_VIDEO_FORMAT_ABGR,
   GST_VIDEO_FORMAT_I420,
   GST_VIDEO_FORMAT_GRAY16_BE,
-  GST_VIDEO_FORMAT_GRAY16_LE
+  GST_VIDEO_FORMAT_GRAY16_LE,
+  GST_VIDEO_FORMAT_NV12,
+  GST_VIDEO_FORMAT_YUY2
 } GstVideoFormat;
 
 #define gst_video_info_init(i) memset (i, 0, sizeof (GstVideoInfo))
@@ -53,5 +55,11 @@ typedef enum {
 #define GST_VIDEO_INFO_SIZE(...) 0
 #define GST_VIDEO_INFO_FPS_N(...) 0
 #define GST_VIDEO_INFO_FPS_D(...) 1
+#define GST_VIDEO_INFO_PLANE_STRIDE(...) 0
+
+#define gst_tensor_converter_add_video_meta(query) ((void) (query))
+#define gst_tensor_converter_get_video_meta(...)
+
+#define gst_tensor_converter_get_yuv_layout(vinfo,layout) ((void) (vinfo), (void) (layout), FALSE)
 
 #endif /* __GST_TENSOR_CONVERTER_MEDIA_NO_VIDEO_H__ */
@@ -0,0 +1,454 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * GStreamer / NNStreamer tensor_converter YUV support
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ */
+/**
+ * @file	gsttensor_converter_yuv.c
+ * @date	16 Oct 2026
+ * @brief	Convert YUV frame to RGB (or GRAY) tensor with resize and normalization in a single pass
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @bug		No known bugs except for NYI items
+ */
+
+#include <string.h>
+#include <nnstreamer_log.h>
+#include "gsttensor_converter_yuv.h"
+
+/**
+ * @brief Number of float row buffers. (2 rows for each of Y, U and V, and 3 output channels)
+ */
+#define YUV_NUM_ROWS (9U)
+
+/**
+ * @brief Internal function to fill the resampling table.
+ * The centers of the samples are aligned, and the samples in the edge are repeated.
+ * @param t The table to be filled.
+ * @param out_size The number of output samples.
+ * @param samples The number of samples of the component.
+ * @param step The offset between the adjacent samples.
+ */
+static void
+_yuv_table_init (tensor_converter_yuv_table_s * t, guint out_size,
+    guint samples, guint step)
+{
+  guint i, i0, i1;
+  gdouble s;
+
+  t->idx0 = g_new (guint, out_size);
+  t->idx1 = g_new (guint, out_size);
+  t->frac = g_new (gfloat, out_size);
+
+  for (i = 0; i < out_size; i++) {
+    s = (i + 0.5) * samples / out_size - 0.5;
+    s = CLAMP (s, 0.0, (gdouble) (samples - 1));
+
+    i0 = (guint) s;
+    i1 = MIN (i0 + 1, samples - 1);
+
+    t->idx0[i] = i0 * step;
+    t->idx1[i] = i1 * step;
+    t->frac[i] = (gfloat) (s - i0);
+  }
+}
+
+/**
+ * @brief Internal function to free the resampling table.
+ */
+static void
+_yuv_table_free (tensor_converter_yuv_table_s * t)
+{
+  g_free (t->idx0);
+  g_free (t->idx1);
+  g_free (t->frac);
+  memset (t, 0, sizeof (tensor_converter_yuv_table_s));
+}
+
+/**
+ * @brief Prepare the conversion of YUV frames with given layout and options.
+ * @return Newly allocated data, NULL if failed. Free it with tensor_converter_yuv_free().
+ */
+tensor_converter_yuv_s *
+tensor_converter_yuv_new (const tensor_converter_yuv_layout_s * layout,
+    const tensor_converter_video_option_s * option)
+{
+  tensor_converter_yuv_s *yuv;
+  gdouble kr, kb, kg;
+  guint i;
+
+  g_return_val_if_fail (layout != NULL, NULL);
+  g_return_val_if_fail (option != NULL, NULL);
+
+  if (layout->width == 0 || layout->height == 0) {
+    nns_loge ("Invalid size of YUV frame (%ux%u).", layout->width,
+        layout->height);
+    return NULL;
+  }
+
+  for (i = 0; i < 3; i++) {
+    if (layout->comp[i].width == 0 || layout->comp[i].height == 0) {
+      nns_loge ("Invalid layout of YUV frame, component %u is empty.", i);
+      return NULL;
+    }
+  }
+
+  if (option->color >= TENSOR_CONVERTER_COLOR_UNKNOWN) {
+    nns_loge ("Invalid output color of YUV frame.");
+    return NULL;
+  }
+
+  yuv = g_new0 (tensor_converter_yuv_s, 1);
+  yuv->layout = *layout;
+  yuv->out_width = (option->width > 0) ? option->width : layout->width;
+  yuv->out_height = (option->height > 0) ? option->height : layout->height;
+  yuv->channels = (option->color == TENSOR_CONVERTER_COLOR_GRAY8) ? 1 : 3;
+  yuv->swap_rb = (option->color == TENSOR_CONVERTER_COLOR_BGR);
+  yuv->to_float = option->normalize;
+
+  if (option->letterbox) {
+    gdouble sx = (gdouble) yuv->out_width / layout->width;
+    gdouble sy = (gdouble) yuv->out_height / layout->height;
+    gdouble scale = MIN (sx, sy);
+
+    yuv->content_w = (guint) (layout->width * scale + 0.5);
+    yuv->content_h = (guint) (layout->height * scale + 0.5);
+    yuv->content_w = CLAMP (yuv->content_w, 1U, yuv->out_width);
+    yuv->content_h = CLAMP (yuv->content_h, 1U, yuv->out_height);
+    yuv->content_x = (yuv->out_width - yuv->content_w) / 2;
+    yuv->content_y = (yuv->out_height - yuv->content_h) / 2;
+  } else {
+    yuv->content_w = yuv->out_width;
+    yuv->content_h = yuv->out_height;
+  }
+
+  _yuv_table_init (&yuv->luma_x, yuv->content_w, layout->comp[0].width,
+      layout->comp[0].pstride);
+  _yuv_table_init (&yuv->luma_y, yuv->content_h, layout->comp[0].height, 1);
+  _yuv_table_init (&yuv->chroma_x, yuv->content_w, layout->comp[1].width,
+      layout->comp[1].pstride);
+  _yuv_table_init (&yuv->chroma_y, yuv->content_h, layout->comp[1].height, 1);
+
+  /* Y'CbCr to R'G'B' with the luma coefficients of the colorimetry */
+  kr = layout->kr;
+  kb = layout->kb;
+  kg = 1.0 - kr - kb;
+
+  yuv->rv = (gfloat) (2.0 * (1.0 - kr));
+  yuv->bu = (gfloat) (2.0 * (1.0 - kb));
+  yuv->gu = (gfloat) (2.0 * kb * (1.0 - kb) / kg);
+  yuv->gv = (gfloat) (2.0 * kr * (1.0 - kr) / kg);
+
+  if (layout->full_range) {
+    yuv->y_off = 0.f;
+    yuv->y_scale = 1.f;
+    yuv->c_scale = 1.f;
+  } else {
+    yuv->y_off = 16.f;
+    yuv->y_scale = 255.f / 219.f;
+    yuv->c_scale = 255.f / 224.f;
+  }
+
+  for (i = 0; i < 3; i++) {
+    if (yuv->to_float) {
+      yuv->scale[i] = 1.f / option->std[i];
+      yuv->bias[i] = -option->mean[i] / option->std[i];
+    } else {
+      yuv->scale[i] = 1.f;
+      yuv->bias[i] = 0.f;
+    }
+  }
+
+  yuv->rows = g_new (gfloat, (gsize) YUV_NUM_ROWS * yuv->content_w);
+  return yuv;
+}
+
+/**
+ * @brief Free the data to convert YUV frames.
+ */
+void
+tensor_converter_yuv_free (tensor_converter_yuv_s * yuv)
+{
+  if (!yuv)
+    return;
+
+  _yuv_table_free (&yuv->luma_x);
+  _yuv_table_free (&yuv->luma_y);
+  _yuv_table_free (&yuv->chroma_x);
+  _yuv_table_free (&yuv->chroma_y);
+  g_free (yuv->rows);
+  g_free (yuv);
+}
+
+/**
+ * @brief Get the size of output frame.
+ */
+gsize
+tensor_converter_yuv_get_size (const tensor_converter_yuv_s * yuv)
+{
+  g_return_val_if_fail (yuv != NULL, 0);
+
+  return (gsize) yuv->out_width * yuv->out_height * yuv->channels *
+      (yuv->to_float ? sizeof (gfloat) : sizeof (guint8));
+}
+
+/**
+ * @brief Internal function to resample a row of the component horizontally.
+ */
+static inline void
+_yuv_resample_row (const guint8 * src, const tensor_converter_yuv_table_s * t,
+    guint num, gfloat * dst)
+{
+  guint i;
+
+  for (i = 0; i < num; i++) {
+    gfloat a = src[t->idx0[i]];
+    gfloat b = src[t->idx1[i]];
+
+    dst[i] = a + t->frac[i] * (b - a);
+  }
+}
+
+/**
+ * @brief Internal function to fill the pixels in the letterbox with black.
+ */
+static void
+_yuv_fill_black (const tensor_converter_yuv_s * yuv, guint8 * out,
+    guint pixels)
+{
+  guint i, c;
+
+  if (pixels == 0)
+    return;
+
+  if (yuv->to_float) {
+    gfloat *dst = (gfloat *) out;
+
+    for (i = 0; i < pixels; i++) {
+      for (c = 0; c < yuv->channels; c++)
+        dst[i * yuv->channels + c] = yuv->bias[c];
+    }
+  } else {
+    memset (out, 0, (gsize) pixels * yuv->channels);
+  }
+}
+
+/**
+ * @brief Internal function to convert a row of the converted image.
+ * @param row The row index in the converted image.
+ * @param out The first pixel of the converted image in the output row.
+ */
+static void
+_yuv_process_row (tensor_converter_yuv_s * yuv, const guint8 * frame,
+    guint row, guint8 * out)
+{
+  const tensor_converter_yuv_layout_s *l = &yuv->layout;
+  const guint w = yuv->content_w;
+  const guint ch = yuv->channels;
+  gfloat *y0 = yuv->rows;
+  gfloat *y1 = y0 + w;
+  gfloat *u0 = y1 + w;
+  gfloat *u1 = u0 + w;
+  gfloat *v0 = u1 + w;
+  gfloat *v1 = v0 + w;
+  gfloat *p[3];
+  gfloat fy, cfy;
+  guint i, c;
+
+  p[0] = v1 + w;
+  p[1] = p[0] + w;
+  p[2] = p[1] + w;
+
+  /* resample the source rows horizontally */
+  fy = yuv->luma_y.frac[row];
+  _yuv_resample_row (frame + l->comp[0].offset +
+      (gsize) l->comp[0].stride * yuv->luma_y.idx0[row], &yuv->luma_x, w, y0);
+  _yuv_resample_row (frame + l->comp[0].offset +
+      (gsize) l->comp[0].stride * yuv->luma_y.idx1[row], &yuv->luma_x, w, y1);
+
+  if (ch == 1) {
+    for (i = 0; i < w; i++) {
+      gfloat y = (y0[i] + fy * (y1[i] - y0[i]) - yuv->y_off) * yuv->y_scale;
+
+      p[0][i] = CLAMP (y, 0.f, 255.f);
+    }
+  } else {
+    gfloat *r = yuv->swap_rb ? p[2] : p[0];
+    gfloat *g = p[1];
+    gfloat *b = yuv->swap_rb ? p[0] : p[2];
+
+    cfy = yuv->chroma_y.frac[row];
+    _yuv_resample_row (frame + l->comp[1].offset +
+        (gsize) l->comp[1].stride * yuv->chroma_y.idx0[row], &yuv->chroma_x,
+        w, u0);
+    _yuv_resample_row (frame + l->comp[1].offset +
+        (gsize) l->comp[1].stride * yuv->chroma_y.idx1[row], &yuv->chroma_x,
+        w, u1);
+    _yuv_resample_row (frame + l->comp[2].offset +
+        (gsize) l->comp[2].stride * yuv->chroma_y.idx0[row], &yuv->chroma_x,
+        w, v0);
+    _yuv_resample_row (frame + l->comp[2].offset +
+        (gsize) l->comp[2].stride * yuv->chroma_y.idx1[row], &yuv->chroma_x,
+        w, v1);
+
+    /* blend vertically and convert, the loop has no branch to be vectorized */
+    for (i = 0; i < w; i++) {
+      gfloat y = (y0[i] + fy * (y1[i] - y0[i]) - yuv->y_off) * yuv->y_scale;
+      gfloat u = (u0[i] + cfy * (u1[i] - u0[i]) - 128.f) * yuv->c_scale;
+      gfloat v = (v0[i] + cfy * (v1[i] - v0[i]) - 128.f) * yuv->c_scale;
+      gfloat vr = y + yuv->rv * v;
+      gfloat vg = y - yuv->gu * u - yuv->gv * v;
+      gfloat vb = y + yuv->bu * u;
+
+      r[i] = CLAMP (vr, 0.f, 255.f);
+      g[i] = CLAMP (vg, 0.f, 255.f);
+      b[i] = CLAMP (vb, 0.f, 255.f);
+    }
+  }
+
+  /* interleave the channels with normalization */
+  if (yuv->to_float) {
+    gfloat *dst = (gfloat *) out;
+
+    for (c = 0; c < ch; c++) {
+      const gfloat s = yuv->scale[c];
+      const gfloat o = yuv->bias[c];
+
+      for (i = 0; i < w; i++)
+        dst[i * ch + c] = p[c][i] * s + o;
+    }
+  } else {
+    for (c = 0; c < ch; c++) {
+      for (i = 0; i < w; i++)
+        out[i * ch + c] = (guint8) (p[c][i] + 0.5f);
+    }
+  }
+}
+
+/**
+ * @brief Convert a YUV frame to the tensor.
+ */
+void
+tensor_converter_yuv_process (tensor_converter_yuv_s * yuv,
+    const guint8 * frame, gpointer out)
+{
+  guint8 *dst = (guint8 *) out;
+  gsize pixel_size, row_size;
+  guint right, oy;
+
+  g_return_if_fail (yuv != NULL);
+  g_return_if_fail (frame != NULL);
+  g_return_if_fail (out != NULL);
+
+  pixel_size = (yuv->to_float ? sizeof (gfloat) : sizeof (guint8)) *
+      yuv->channels;
+  row_size = pixel_size * yuv->out_width;
+  right = yuv->out_width - yuv->content_x - yuv->content_w;
+
+  for (oy = 0; oy < yuv->out_height; oy++, dst += row_size) {
+    if (oy < yuv->content_y || oy >= yuv->content_y + yuv->content_h) {
+      _yuv_fill_black (yuv, dst, yuv->out_width);
+      continue;
+    }
+
+    _yuv_fill_black (yuv, dst, yuv->content_x);
+    _yuv_process_row (yuv, frame, oy - yuv->content_y,
+        dst + pixel_size * yuv->content_x);
+    _yuv_fill_black (yuv,
+        dst + pixel_size * (yuv->content_x + yuv->content_w), right);
+  }
+}
+
+/**
+ * @brief Parse the color string of the output tensor.
+ */
+tensor_converter_color_e
+tensor_converter_yuv_get_color (const gchar * str)
+{
+  if (!str)
+    return TENSOR_CONVERTER_COLOR_UNKNOWN;
+
+  if (g_ascii_strcasecmp (str, "RGB") == 0)
+    return TENSOR_CONVERTER_COLOR_RGB;
+  if (g_ascii_strcasecmp (str, "BGR") == 0)
+    return TENSOR_CONVERTER_COLOR_BGR;
+  if (g_ascii_strcasecmp (str, "GRAY8") == 0)
+    return TENSOR_CONVERTER_COLOR_GRAY8;
+
+  return TENSOR_CONVERTER_COLOR_UNKNOWN;
+}
+
+/**
+ * @brief Internal function to parse comma-separated values for the channels.
+ */
+static gboolean
+_yuv_parse_channel_values (const gchar * str, gfloat * values)
+{
+  gchar **strv;
+  guint i, num;
+  gboolean ret = TRUE;
+
+  strv = g_strsplit (str, ",", -1);
+  num = g_strv_length (strv);
+
+  if (num != 1 && num != 3) {
+    ret = FALSE;
+    goto done;
+  }
+
+  for (i = 0; i < 3; i++) {
+    const gchar *s = g_strstrip (strv[(num == 1) ? 0 : i]);
+    gchar *endptr = NULL;
+
+    values[i] = (gfloat) g_ascii_strtod (s, &endptr);
+    if (endptr == s || *endptr != '\0') {
+      ret = FALSE;
+      break;
+    }
+  }
+
+done:
+  g_strfreev (strv);
+  return ret;
+}
+
+/**
+ * @brief Parse the mean and std string ("MEAN:STD", each can be comma-separated values for the channels).
+ */
+gboolean
+tensor_converter_yuv_parse_normalize (const gchar * str,
+    tensor_converter_video_option_s * option)
+{
+  gchar **strv;
+  gfloat mean[3], std[3];
+  gboolean ret = FALSE;
+  guint i;
+
+  g_return_val_if_fail (option != NULL, FALSE);
+
+  if (!str || *str == '\0') {
+    option->normalize = FALSE;
+    return TRUE;
+  }
+
+  strv = g_strsplit (str, ":", -1);
+  if (g_strv_length (strv) != 2)
+    goto done;
+
+  if (!_yuv_parse_channel_values (strv[0], mean) ||
+      !_yuv_parse_channel_values (strv[1], std))
+    goto done;
+
+  for (i = 0; i < 3; i++) {
+    if (std[i] == 0.f)
+      goto done;
+  }
+
+  memcpy (option->mean, mean, sizeof (mean));
+  memcpy (option->std, std, sizeof (std));
+  option->normalize = TRUE;
+  ret = TRUE;
+
+done:
+  g_strfreev (strv);
+  return ret;
+}
@@ -0,0 +1,161 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * GStreamer / NNStreamer tensor_converter YUV support
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ */
+/**
+ * @file	gsttensor_converter_yuv.h
+ * @date	16 Oct 2026
+ * @brief	Convert YUV frame to RGB (or GRAY) tensor with resize and normalization in a single pass
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @bug		No known bugs except for NYI items
+ *
+ * The output is processed row by row. For each output row, the source rows
+ * of each component are resampled horizontally into small float buffers,
+ * then blended vertically, converted to RGB and normalized in contiguous
+ * loops, so the full-size RGB frame is never created.
+ */
+
+#ifndef __GST_TENSOR_CONVERTER_YUV_H__
+#define __GST_TENSOR_CONVERTER_YUV_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * @brief Color of the output tensor converted from YUV frame.
+ */
+typedef enum
+{
+  TENSOR_CONVERTER_COLOR_RGB = 0,
+  TENSOR_CONVERTER_COLOR_BGR,
+  TENSOR_CONVERTER_COLOR_GRAY8,
+  TENSOR_CONVERTER_COLOR_UNKNOWN
+} tensor_converter_color_e;
+
+/**
+ * @brief Options for the video frame to be converted to a tensor. (YUV input only)
+ */
+typedef struct
+{
+  guint width; /**< output width, 0 to keep the width of input */
+  guint height; /**< output height, 0 to keep the height of input */
+  tensor_converter_color_e color; /**< output color */
+  gboolean letterbox; /**< true to keep the aspect ratio and fill the rest with black */
+  gboolean normalize; /**< true to output float32 normalized with mean and std */
+  gfloat mean[3]; /**< mean of each output channel */
+  gfloat std[3]; /**< standard deviation of each output channel */
+} tensor_converter_video_option_s;
+
+/**
+ * @brief Layout of a component (Y, U or V) in the YUV frame.
+ */
+typedef struct
+{
+  gsize offset; /**< offset of the first sample in the frame */
+  gint stride; /**< bytes per row */
+  guint pstride; /**< bytes between the adjacent samples in a row */
+  guint width; /**< number of samples in a row */
+  guint height; /**< number of rows */
+} tensor_converter_yuv_comp_s;
+
+/**
+ * @brief Layout and colorimetry of the YUV frame.
+ */
+typedef struct
+{
+  tensor_converter_yuv_comp_s comp[3]; /**< Y, U and V */
+  guint width; /**< frame width */
+  guint height; /**< frame height */
+  gdouble kr; /**< luma coefficient of red */
+  gdouble kb; /**< luma coefficient of blue */
+  gboolean full_range; /**< true if the components use the full range (0-255) */
+} tensor_converter_yuv_layout_s;
+
+/**
+ * @brief Resampling table of a component in an axis.
+ */
+typedef struct
+{
+  guint *idx0; /**< offset of the first (left or top) sample */
+  guint *idx1; /**< offset of the second (right or bottom) sample */
+  gfloat *frac; /**< weight of the second sample */
+} tensor_converter_yuv_table_s;
+
+/**
+ * @brief Internal data to convert YUV frame.
+ */
+typedef struct
+{
+  tensor_converter_yuv_layout_s layout; /**< input frame */
+  guint out_width; /**< output width */
+  guint out_height; /**< output height */
+  guint channels; /**< output channels (3 for RGB and BGR, 1 for GRAY8) */
+  gboolean swap_rb; /**< true for BGR */
+  gboolean to_float; /**< true to output float32 */
+
+  guint content_x; /**< left of the converted image in the output (letterbox) */
+  guint content_y; /**< top of the converted image in the output (letterbox) */
+  guint content_w; /**< width of the converted image in the output */
+  guint content_h; /**< height of the converted image in the output */
+
+  tensor_converter_yuv_table_s luma_x; /**< horizontal table of Y */
+  tensor_converter_yuv_table_s luma_y; /**< vertical table of Y */
+  tensor_converter_yuv_table_s chroma_x; /**< horizontal table of U and V */
+  tensor_converter_yuv_table_s chroma_y; /**< vertical table of U and V */
+
+  gfloat y_off; /**< offset of Y (16 for limited range) */
+  gfloat y_scale; /**< scale of Y */
+  gfloat c_scale; /**< scale of U and V */
+  gfloat rv, gu, gv, bu; /**< coefficients of U and V for each color */
+  gfloat scale[3]; /**< 1 / std of each output channel */
+  gfloat bias[3]; /**< -mean / std of each output channel */
+
+  gfloat *rows; /**< row buffers */
+} tensor_converter_yuv_s;
+
+/**
+ * @brief Prepare the conversion of YUV frames with given layout and options.
+ * @return Newly allocated data, NULL if failed. Free it with tensor_converter_yuv_free().
+ */
+extern tensor_converter_yuv_s *
+tensor_converter_yuv_new (const tensor_converter_yuv_layout_s * layout, const tensor_converter_video_option_s * option);
+
+/**
+ * @brief Free the data to convert YUV frames.
+ */
+extern void
+tensor_converter_yuv_free (tensor_converter_yuv_s * yuv);
+
+/**
+ * @brief Get the size of output frame.
+ */
+extern gsize
+tensor_converter_yuv_get_size (const tensor_converter_yuv_s * yuv);
+
+/**
+ * @brief Convert a YUV frame to the tensor.
+ * @param yuv The data prepared with tensor_converter_yuv_new().
+ * @param frame The YUV frame.
+ * @param[out] out The output tensor, the caller should allocate it with tensor_converter_yuv_get_size().
+ */
+extern void
+tensor_converter_yuv_process (tensor_converter_yuv_s * yuv, const guint8 * frame, gpointer out);
+
+/**
+ * @brief Parse the color string of the output tensor.
+ */
+extern tensor_converter_color_e
+tensor_converter_yuv_get_color (const gchar * str);
+
+/**
+ * @brief Parse the mean and std string ("MEAN:STD", each can be comma-separated values for the channels).
+ * @return TRUE if the string is valid.
+ */
+extern gboolean
+tensor_converter_yuv_parse_normalize (const gchar * str, tensor_converter_video_option_s * option);
+
+G_END_DECLS
+
+#endif /* __GST_TENSOR_CONVERTER_YUV_H__ */
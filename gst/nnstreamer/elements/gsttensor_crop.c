@@ -20,9 +20,15 @@
  * The info pad has capability for flexible tensor stream (other/tensors-flexible), that can have a various buffer size for crop info.
  * Incoming buffer on info pad should be an array of crop info.
  * Note that NNStreamer supports maximum 16 (NNS_TENSOR_SIZE_LIMIT) memory blocks in a buffer.
- * So, when incoming buffer on info pad has more than 16 crop-info array, tensor_crop will ignore the data and output buffer will have 16 memory blocks.
+ * So, in crop mode, when incoming buffer on info pad has more than 16 crop-info array, tensor_crop will ignore the data and output buffer will have 16 memory blocks.
  *
  * The output is always in the format of other/tensors-flexible.
+ * In the default mode (mode=crop), each region is a tensor in the output buffer.
+ * If the region is contiguous in the raw tensor (full-width rows or a single row), the cropped tensor shares the raw data.
+ *
+ * With mode=roi-resize, tensor_crop resizes each region to roi-size (WIDTH:HEIGHT) with bilinear interpolation,
+ * and the output buffer has a single tensor (dimension ch:WIDTH:HEIGHT:number-of-regions) of the same type as the raw tensor.
+ * This mode handles all regions in the info buffer, so the batched regions can be passed to a second-stage model directly.
  *
  * <refsect2>
  * <title>Example launch line</title>
@@ -32,6 +38,12 @@
  *       t. ! queue ! crop.raw \
  *       t. ! queue ! (process raw video tensor and push buffer which includes crop info) ! crop.info
  * ]|
+ * |[
+ * gst-launch-1.0 tensor_crop name=crop mode=roi-resize roi-size=224:224 ! (batched regions 3:224:224:N) ... \
+ *     videotestsrc ! videoconvert ! video/x-raw,format=RGB ! tensor_converter ! tee name=t \
+ *       t. ! queue ! crop.raw \
+ *       t. ! queue ! (process raw video tensor and push buffer which includes crop info) ! crop.info
+ * ]|
  * </refsect2>
  */
 
@@ -62,9 +74,19 @@ typedef struct
 typedef struct
 {
   guint num;
-  tensor_region_s region[NNS_TENSOR_SIZE_LIMIT];
+  tensor_region_s *region;
 } tensor_crop_info_s;
 
+/**
+ * @brief Internal data structure of the resampling table in an axis (roi-resize mode).
+ */
+typedef struct
+{
+  guint *idx0; /**< offset of the first (left or top) sample */
+  guint *idx1; /**< offset of the second (right or bottom) sample */
+  gfloat *frac; /**< weight of the second sample */
+} tensor_crop_table_s;
+
 GST_DEBUG_CATEGORY_STATIC (gst_tensor_crop_debug);
 #define GST_CAT_DEFAULT gst_tensor_crop_debug
 
@@ -75,6 +97,8 @@ enum
 {
   PROP_0,
   PROP_LATENESS,
+  PROP_MODE,
+  PROP_ROI_SIZE,
   PROP_SILENT
 };
 
@@ -88,6 +112,16 @@ enum
  */
 #define DEFAULT_LATENESS (-1)
 
+/**
+ * @brief Default mode of tensor_crop.
+ */
+#define DEFAULT_MODE (TENSOR_CROP_MODE_CROP)
+
+/**
+ * @brief Get the type of tensor_crop mode.
+ */
+#define GST_TYPE_TENSOR_CROP_MODE (gst_tensor_crop_mode_get_type ())
+
 /**
  * @brief Template for sink pad (raw data).
  */
@@ -130,6 +164,30 @@ static gboolean gst_tensor_crop_sink_event (GstCollectPads * pads,
 static GstFlowReturn gst_tensor_crop_collected (GstCollectPads * pads,
     gpointer user_data);
 
+/**
+ * @brief Register the type of tensor_crop mode.
+ */
+static GType
+gst_tensor_crop_mode_get_type (void)
+{
+  static GType mode_type = 0;
+
+  if (mode_type == 0) {
+    static GEnumValue mode_types[] = {
+      {TENSOR_CROP_MODE_CROP, "Crop the regions into the separate tensors",
+          "crop"},
+      {TENSOR_CROP_MODE_ROI_RESIZE,
+            "Crop and resize the regions into a batched tensor (roi-size)",
+          "roi-resize"},
+      {0, NULL, NULL},
+    };
+
+    mode_type = g_enum_register_static ("tensor_crop_mode", mode_types);
+  }
+
+  return mode_type;
+}
+
 /**
  * @brief Initialize the tensor_crop's class.
  */
@@ -162,6 +220,28 @@ gst_tensor_crop_class_init (GstTensorCropClass * klass)
           -1, G_MAXINT, DEFAULT_LATENESS,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstTensorCrop::mode:
+   *
+   * The mode to crop the regions.
+   * 'crop' (default) outputs the cropped regions as the separate tensors.
+   * 'roi-resize' resizes the cropped regions to roi-size with bilinear interpolation and outputs a batched tensor.
+   */
+  g_object_class_install_property (object_class, PROP_MODE,
+      g_param_spec_enum ("mode", "Mode", "The mode to crop the regions",
+          GST_TYPE_TENSOR_CROP_MODE, DEFAULT_MODE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTensorCrop::roi-size:
+   *
+   * The size (WIDTH:HEIGHT) of the resized region in roi-resize mode.
+   */
+  g_object_class_install_property (object_class, PROP_ROI_SIZE,
+      g_param_spec_string ("roi-size", "ROI size",
+          "The size (WIDTH:HEIGHT) of the resized region in roi-resize mode",
+          "", G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   /**
    * GstTensorCrop::silent:
    *
@@ -254,6 +334,8 @@ gst_tensor_crop_init (GstTensorCrop * self)
 
   /* init properties */
   self->lateness = DEFAULT_LATENESS;
+  self->mode = DEFAULT_MODE;
+  self->roi_width = self->roi_height = 0;
   self->silent = DEFAULT_SILENT;
   self->send_stream_start = TRUE;
 }
@@ -278,6 +360,40 @@ gst_tensor_crop_finalize (GObject * object)
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
+/**
+ * @brief Internal function to parse the size (WIDTH:HEIGHT) of the resized region.
+ */
+static gboolean
+gst_tensor_crop_parse_roi_size (GstTensorCrop * self, const gchar * str)
+{
+  gchar **strv;
+  guint64 w, h;
+  gboolean ret = FALSE;
+
+  self->roi_width = self->roi_height = 0;
+
+  if (!str || str[0] == '\0')
+    return TRUE;
+
+  strv = g_strsplit (str, ":", -1);
+  if (g_strv_length (strv) == 2U) {
+    w = g_ascii_strtoull (strv[0], NULL, 10);
+    h = g_ascii_strtoull (strv[1], NULL, 10);
+
+    if (w > 0 && w <= G_MAXUINT16 && h > 0 && h <= G_MAXUINT16) {
+      self->roi_width = (guint) w;
+      self->roi_height = (guint) h;
+      ret = TRUE;
+    }
+  }
+  g_strfreev (strv);
+
+  if (!ret)
+    GST_ERROR_OBJECT (self, "Invalid roi-size '%s', it should be WIDTH:HEIGHT.",
+        str);
+  return ret;
+}
+
 /**
  * @brief Setter for tensor_crop properties.
  */
@@ -293,6 +409,12 @@ gst_tensor_crop_set_property (GObject * object, guint prop_id,
     case PROP_LATENESS:
       self->lateness = g_value_get_int (value);
       break;
+    case PROP_MODE:
+      self->mode = g_value_get_enum (value);
+      break;
+    case PROP_ROI_SIZE:
+      gst_tensor_crop_parse_roi_size (self, g_value_get_string (value));
+      break;
     case PROP_SILENT:
       self->silent = g_value_get_boolean (value);
       break;
@@ -317,6 +439,17 @@ gst_tensor_crop_get_property (GObject * object, guint prop_id,
     case PROP_LATENESS:
       g_value_set_int (value, self->lateness);
       break;
+    case PROP_MODE:
+      g_value_set_enum (value, self->mode);
+      break;
+    case PROP_ROI_SIZE:
+      if (self->roi_width > 0 && self->roi_height > 0) {
+        g_value_take_string (value, g_strdup_printf ("%u:%u", self->roi_width,
+                self->roi_height));
+      } else {
+        g_value_set_string (value, "");
+      }
+      break;
     case PROP_SILENT:
       g_value_set_boolean (value, self->silent);
       break;
@@ -436,6 +569,14 @@ gst_tensor_crop_negotiate (GstTensorCrop * self)
     return GST_FLOW_NOT_NEGOTIATED;
   }
 
+  if (self->mode == TENSOR_CROP_MODE_ROI_RESIZE &&
+      (self->roi_width == 0 || self->roi_height == 0)) {
+    GST_ERROR_OBJECT (self,
+        "The roi-size of tensor_crop '%s' is not given for roi-resize mode.",
+        GST_ELEMENT_NAME (self));
+    return GST_FLOW_NOT_NEGOTIATED;
+  }
+
   if (!gst_pad_has_current_caps (self->srcpad)) {
     GstCaps *caps;
     GstSegment segment;
@@ -589,7 +730,12 @@ gst_tensor_crop_get_crop_info (GstTensorCrop * self, GstBuffer * info,
   memset (cinfo, 0, sizeof (tensor_crop_info_s));
 
   cinfo->num = dsize / (esize * 4);
-  cinfo->num = MIN (cinfo->num, NNS_TENSOR_SIZE_LIMIT);
+
+  /* roi-resize mode outputs a batched tensor, no limit of the regions. */
+  if (self->mode == TENSOR_CROP_MODE_CROP)
+    cinfo->num = MIN (cinfo->num, NNS_TENSOR_SIZE_LIMIT);
+
+  cinfo->region = g_new0 (tensor_region_s, MAX (cinfo->num, 1U));
 
   for (i = 0; i < cinfo->num; i++) {
     pos = map.data + hsize + (esize * 4 * i);
@@ -609,6 +755,353 @@ done:
   return ret;
 }
 
+/**
+ * @brief Internal function to clamp the region in the raw tensor.
+ */
+static void
+gst_tensor_crop_clamp_region (const tensor_region_s * region, guint mw,
+    guint mh, tensor_region_s * clamped)
+{
+  clamped->x = MIN (region->x, mw);
+  clamped->y = MIN (region->y, mh);
+  /* do not add the size to the position, a large size overflows. */
+  clamped->w = MIN (region->w, mw - clamped->x);
+  clamped->h = MIN (region->h, mh - clamped->y);
+}
+
+/**
+ * @brief Internal function to crop the regions into the separate tensors.
+ * The contiguous region (full-width rows or a single row) shares the raw memory,
+ * then the data is copied at once, or not copied if the same header is reserved in front of it.
+ */
+static gboolean
+gst_tensor_crop_crop_regions (GstTensorCrop * self, GstBuffer * result,
+    GstMemory * mem, const guint8 * data, gsize data_offset,
+    GstTensorMetaInfo * meta, const GstTensorInfo * info,
+    const tensor_crop_info_s * cinfo)
+{
+  GstMemory *cropped, *shared;
+  GstMapInfo map;
+  tensor_region_s r;
+  gsize hsize, esize, row_size, stride, offset;
+  guint i, j, ch, mw, mh;
+  gboolean shareable;
+
+  ch = info->dimension[0];
+  mw = info->dimension[1];
+  mh = info->dimension[2];
+  esize = gst_tensor_get_element_size (info->type);
+  hsize = gst_tensor_meta_info_get_header_size (meta);
+  stride = esize * ch * mw;
+  shareable = !GST_MEMORY_FLAG_IS_SET (mem, GST_MEMORY_FLAG_NO_SHARE);
+
+  for (i = 0; i < cinfo->num; i++) {
+    gst_tensor_crop_clamp_region (&cinfo->region[i], mw, mh, &r);
+    g_assert (r.w > 0 && r.h > 0);
+
+    /* set header for flex tensor */
+    meta->dimension[1] = r.w;
+    meta->dimension[2] = r.h;
+    meta->dimension[3] = 1;
+
+    row_size = esize * ch * r.w;
+    offset = stride * r.y + esize * ch * r.x;
+
+    if (shareable && (r.w == mw || r.h == 1)) {
+      shared = gst_memory_share (mem, data_offset + offset, row_size * r.h);
+      cropped = gst_tensor_meta_info_append_header (meta, shared);
+      gst_memory_unref (shared);
+    } else {
+      cropped = gst_allocator_alloc (NULL, hsize + row_size * r.h, NULL);
+
+      if (gst_memory_map (cropped, &map, GST_MAP_WRITE)) {
+        gst_tensor_meta_info_update_header (meta, map.data);
+
+        for (j = 0; j < r.h; j++) {
+          memcpy (map.data + hsize + row_size * j,
+              data + offset + stride * j, row_size);
+        }
+
+        gst_memory_unmap (cropped, &map);
+      } else {
+        gst_memory_unref (cropped);
+        cropped = NULL;
+      }
+    }
+
+    if (!cropped) {
+      GST_ERROR_OBJECT (self, "Failed to crop the region %u.", i);
+      return FALSE;
+    }
+
+    gst_buffer_append_memory (result, cropped);
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Internal function to fill the resampling table.
+ * The sample positions are aligned with the pixel centers, same as tensor_converter.
+ */
+static void
+gst_tensor_crop_table_fill (tensor_crop_table_s * t, guint out_size,
+    guint samples, guint step)
+{
+  guint i, i0, i1;
+  gdouble s;
+
+  for (i = 0; i < out_size; i++) {
+    s = (i + 0.5) * samples / out_size - 0.5;
+    s = CLAMP (s, 0.0, (gdouble) (samples - 1));
+
+    i0 = (guint) s;
+    i1 = MIN (i0 + 1, samples - 1);
+
+    t->idx0[i] = i0 * step;
+    t->idx1[i] = i1 * step;
+    t->frac[i] = (gfloat) (s - i0);
+  }
+}
+
+/**
+ * @brief Macro to resample a row of the region horizontally into the float buffer.
+ */
+#define roi_resample_row(type,src,t,ch,w,out) do { \
+    const type *_s = (const type *) (src); \
+    guint _i, _c; \
+    for (_i = 0; _i < (w); _i++) { \
+      const type *_p0 = _s + (t)->idx0[_i]; \
+      const type *_p1 = _s + (t)->idx1[_i]; \
+      const gfloat _f = (t)->frac[_i]; \
+      gfloat *_o = (out) + _i * (ch); \
+      for (_c = 0; _c < (ch); _c++) { \
+        _o[_c] = (gfloat) _p0[_c] + ((gfloat) _p1[_c] - (gfloat) _p0[_c]) * _f; \
+      } \
+    } \
+  } while (0)
+
+/**
+ * @brief Macro to blend the resampled rows vertically and store the output row.
+ * The rounding offset (rnd) is added to the blended value (_v) before the type cast.
+ */
+#define roi_blend_row(type,rnd,top,bottom,fy,n,dst) do { \
+    type *_d = (type *) (dst); \
+    guint _i; \
+    for (_i = 0; _i < (n); _i++) { \
+      const gfloat _v = (top)[_i] + ((bottom)[_i] - (top)[_i]) * (fy); \
+      _d[_i] = (type) (_v + (rnd)); \
+    } \
+  } while (0)
+
+/**
+ * @brief Internal function to resample a row of the region horizontally.
+ */
+static void
+gst_tensor_crop_resample_row (tensor_type type, const guint8 * src,
+    const tensor_crop_table_s * t, guint ch, guint w, gfloat * out)
+{
+  switch (type) {
+    case _NNS_INT32:
+      roi_resample_row (gint32, src, t, ch, w, out);
+      break;
+    case _NNS_UINT32:
+      roi_resample_row (guint32, src, t, ch, w, out);
+      break;
+    case _NNS_INT16:
+      roi_resample_row (gint16, src, t, ch, w, out);
+      break;
+    case _NNS_UINT16:
+      roi_resample_row (guint16, src, t, ch, w, out);
+      break;
+    case _NNS_INT8:
+      roi_resample_row (gint8, src, t, ch, w, out);
+      break;
+    case _NNS_UINT8:
+      roi_resample_row (guint8, src, t, ch, w, out);
+      break;
+    case _NNS_FLOAT64:
+      roi_resample_row (gdouble, src, t, ch, w, out);
+      break;
+    case _NNS_FLOAT32:
+      roi_resample_row (gfloat, src, t, ch, w, out);
+      break;
+    case _NNS_INT64:
+      roi_resample_row (gint64, src, t, ch, w, out);
+      break;
+    case _NNS_UINT64:
+      roi_resample_row (guint64, src, t, ch, w, out);
+      break;
+    default:
+      g_assert_not_reached ();
+      break;
+  }
+}
+
+/**
+ * @brief Internal function to blend the resampled rows and store the output row.
+ */
+static void
+gst_tensor_crop_blend_row (tensor_type type, const gfloat * top,
+    const gfloat * bottom, gfloat fy, guint n, guint8 * dst)
+{
+  switch (type) {
+    case _NNS_INT32:
+      roi_blend_row (gint32, ((_v < 0.f) ? -0.5f : 0.5f), top, bottom, fy, n,
+          dst);
+      break;
+    case _NNS_UINT32:
+      roi_blend_row (guint32, 0.5f, top, bottom, fy, n, dst);
+      break;
+    case _NNS_INT16:
+      roi_blend_row (gint16, ((_v < 0.f) ? -0.5f : 0.5f), top, bottom, fy, n,
+          dst);
+      break;
+    case _NNS_UINT16:
+      roi_blend_row (guint16, 0.5f, top, bottom, fy, n, dst);
+      break;
+    case _NNS_INT8:
+      roi_blend_row (gint8, ((_v < 0.f) ? -0.5f : 0.5f), top, bottom, fy, n,
+          dst);
+      break;
+    case _NNS_UINT8:
+      roi_blend_row (guint8, 0.5f, top, bottom, fy, n, dst);
+      break;
+    case _NNS_FLOAT64:
+      roi_blend_row (gdouble, 0.f, top, bottom, fy, n, dst);
+      break;
+    case _NNS_FLOAT32:
+      roi_blend_row (gfloat, 0.f, top, bottom, fy, n, dst);
+      break;
+    case _NNS_INT64:
+      roi_blend_row (gint64, ((_v < 0.f) ? -0.5f : 0.5f), top, bottom, fy, n,
+          dst);
+      break;
+    case _NNS_UINT64:
+      roi_blend_row (guint64, 0.5f, top, bottom, fy, n, dst);
+      break;
+    default:
+      g_assert_not_reached ();
+      break;
+  }
+}
+
+/**
+ * @brief Internal function to crop and resize the regions into a batched tensor.
+ * Each output row blends two source rows resampled horizontally, and the source rows
+ * are reused for the next output row, so each row of the region is resampled once.
+ */
+static gboolean
+gst_tensor_crop_resize_regions (GstTensorCrop * self, GstBuffer * result,
+    const guint8 * data, GstTensorMetaInfo * meta, const GstTensorInfo * info,
+    const tensor_crop_info_s * cinfo)
+{
+  GstMemory *mem;
+  GstMapInfo map;
+  tensor_crop_table_s tx, ty;
+  tensor_region_s r;
+  gsize hsize, esize, stride, row_size, region_size;
+  guint i, j, ch, mw, mh, rw, rh, row_y[2];
+  gfloat *rows, *row[2], *tmp;
+  const guint8 *src;
+  guint8 *out;
+
+  /* no region, output buffer is empty. */
+  if (cinfo->num == 0)
+    return TRUE;
+
+  if (info->type == _NNS_FLOAT16) {
+    GST_ERROR_OBJECT (self, "The roi-resize mode does not support float16.");
+    return FALSE;
+  }
+
+  ch = info->dimension[0];
+  mw = info->dimension[1];
+  mh = info->dimension[2];
+  rw = self->roi_width;
+  rh = self->roi_height;
+  esize = gst_tensor_get_element_size (info->type);
+  stride = esize * ch * mw;
+  row_size = esize * ch * rw;
+  region_size = row_size * rh;
+
+  meta->dimension[1] = rw;
+  meta->dimension[2] = rh;
+  meta->dimension[3] = cinfo->num;
+  hsize = gst_tensor_meta_info_get_header_size (meta);
+
+  mem = gst_allocator_alloc (NULL, hsize + region_size * cinfo->num, NULL);
+  if (!gst_memory_map (mem, &map, GST_MAP_WRITE)) {
+    GST_ERROR_OBJECT (self, "Failed to map the output memory.");
+    gst_memory_unref (mem);
+    return FALSE;
+  }
+
+  gst_tensor_meta_info_update_header (meta, map.data);
+
+  tx.idx0 = g_new (guint, rw + rh);
+  tx.idx1 = g_new (guint, rw + rh);
+  tx.frac = g_new (gfloat, rw + rh);
+  ty.idx0 = tx.idx0 + rw;
+  ty.idx1 = tx.idx1 + rw;
+  ty.frac = tx.frac + rw;
+  rows = g_new (gfloat, 2 * ch * rw);
+
+  for (i = 0; i < cinfo->num; i++) {
+    out = map.data + hsize + region_size * i;
+
+    if (cinfo->region[i].x >= mw || cinfo->region[i].y >= mh ||
+        cinfo->region[i].w == 0 || cinfo->region[i].h == 0) {
+      /* empty region */
+      memset (out, 0, region_size);
+      continue;
+    }
+
+    gst_tensor_crop_clamp_region (&cinfo->region[i], mw, mh, &r);
+    gst_tensor_crop_table_fill (&tx, rw, r.w, ch);
+    gst_tensor_crop_table_fill (&ty, rh, r.h, 1);
+
+    src = data + stride * r.y + esize * ch * r.x;
+    row[0] = rows;
+    row[1] = rows + ch * rw;
+    row_y[0] = row_y[1] = G_MAXUINT;
+
+    for (j = 0; j < rh; j++) {
+      if (row_y[0] != ty.idx0[j]) {
+        if (row_y[1] == ty.idx0[j]) {
+          tmp = row[0];
+          row[0] = row[1];
+          row[1] = tmp;
+          row_y[1] = row_y[0];
+        } else {
+          gst_tensor_crop_resample_row (info->type,
+              src + stride * ty.idx0[j], &tx, ch, rw, row[0]);
+        }
+
+        row_y[0] = ty.idx0[j];
+      }
+
+      if (row_y[1] != ty.idx1[j]) {
+        gst_tensor_crop_resample_row (info->type,
+            src + stride * ty.idx1[j], &tx, ch, rw, row[1]);
+        row_y[1] = ty.idx1[j];
+      }
+
+      gst_tensor_crop_blend_row (info->type, row[0], row[1], ty.frac[j],
+          ch * rw, out + row_size * j);
+    }
+  }
+
+  g_free (rows);
+  g_free (tx.idx0);
+  g_free (tx.idx1);
+  g_free (tx.frac);
+
+  gst_memory_unmap (mem, &map);
+  gst_buffer_append_memory (result, mem);
+  return TRUE;
+}
+
 /**
  * @brief Internal function to crop incoming buffer.
  */
@@ -621,10 +1114,9 @@ gst_tensor_crop_do_cropping (GstTensorCrop * self, GstBuffer * raw,
   GstMapInfo map;
   GstTensorMetaInfo meta;
   GstTensorInfo info;
-  gboolean flexible;
-  gsize hsize, esize, dsize;
-  guint8 *cropped, *dpos, *desc, *src;
-  guint i, j, ch, mw, mh, _x, _y, _w, _h;
+  gboolean flexible, ret;
+  gsize hsize, dsize;
+  guint i;
 
   i = gst_buffer_n_memory (raw);
   g_assert (i > 0);
@@ -647,7 +1139,6 @@ gst_tensor_crop_do_cropping (GstTensorCrop * self, GstBuffer * raw,
 
   hsize = flexible ? gst_tensor_meta_info_get_header_size (&meta) : 0;
   dsize = gst_tensor_meta_info_get_data_size (&meta);
-  dpos = map.data + hsize;
   if ((hsize + dsize) != map.size) {
     GST_ERROR_OBJECT (self,
         "Raw buffer has invalid data size (received %zd, expected %zd).",
@@ -657,37 +1148,19 @@ gst_tensor_crop_do_cropping (GstTensorCrop * self, GstBuffer * raw,
 
   result = gst_buffer_new ();
 
-  /** @todo Add various mode to crop tensor. */
-  ch = info.dimension[0];
-  mw = info.dimension[1];
-  mh = info.dimension[2];
-  esize = gst_tensor_get_element_size (info.type);
-  hsize = gst_tensor_meta_info_get_header_size (&meta);
-
-  for (i = 0; i < cinfo->num; i++) {
-    _x = (cinfo->region[i].x < mw) ? cinfo->region[i].x : mw;
-    _y = (cinfo->region[i].y < mh) ? cinfo->region[i].y : mh;
-    _w = (_x + cinfo->region[i].w - 1 < mw) ? cinfo->region[i].w : (mw - _x);
-    _h = (_y + cinfo->region[i].h - 1 < mh) ? cinfo->region[i].h : (mh - _y);
-
-    g_assert (_w > 0 && _h > 0);
-    dsize = hsize + (esize * ch * _w * _h);
-    cropped = (guint8 *) g_malloc0 (dsize);
-
-    /* set header for flex tensor */
-    meta.dimension[1] = _w;
-    meta.dimension[2] = _h;
-    meta.dimension[3] = 1;
-    gst_tensor_meta_info_update_header (&meta, cropped);
-
-    for (j = 0; j < _h; j++) {
-      src = dpos + esize * ch * (_x + (j + _y) * mw);
-      desc = cropped + hsize + (esize * ch * _w) * j;
-      memcpy (desc, src, (esize * ch * _w));
-    }
+  /** @todo Add various mode to crop tensor. Now tensor-crop handles NHWC data format only. */
+  if (self->mode == TENSOR_CROP_MODE_ROI_RESIZE) {
+    ret = gst_tensor_crop_resize_regions (self, result, map.data + hsize,
+        &meta, &info, cinfo);
+  } else {
+    ret = gst_tensor_crop_crop_regions (self, result, mem, map.data + hsize,
+        hsize, &meta, &info, cinfo);
+  }
 
-    gst_buffer_append_memory (result,
-        gst_memory_new_wrapped (0, cropped, dsize, 0, dsize, cropped, g_free));
+  if (!ret) {
+    gst_buffer_unref (result);
+    result = NULL;
+    goto done;
   }
 
   /* set timestamp from raw buffer */
@@ -713,6 +1186,8 @@ gst_tensor_crop_chain (GstTensorCrop * self,
 
   g_return_val_if_fail (data_raw && data_info, GST_FLOW_ERROR);
 
+  memset (&cinfo, 0, sizeof (tensor_crop_info_s));
+
   buf_raw = gst_collect_pads_peek (self->collect, data_raw);
   buf_info = gst_collect_pads_peek (self->collect, data_info);
   drop_raw = (buf_raw != NULL);
@@ -768,9 +1243,15 @@ gst_tensor_crop_chain (GstTensorCrop * self,
   }
 
   result = gst_tensor_crop_do_cropping (self, buf_raw, &cinfo);
+  if (!result) {
+    ret = GST_FLOW_ERROR;
+    goto done;
+  }
+
   ret = gst_pad_push (self->srcpad, result);
 
 done:
+  g_free (cinfo.region);
   if (buf_raw)
     gst_buffer_unref (buf_raw);
   if (buf_info)
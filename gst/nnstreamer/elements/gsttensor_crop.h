@@ -33,6 +33,15 @@ G_BEGIN_DECLS
 typedef struct _GstTensorCrop GstTensorCrop;
 typedef struct _GstTensorCropClass GstTensorCropClass;
 
+/**
+ * @brief Mode of tensor_crop.
+ */
+typedef enum
+{
+  TENSOR_CROP_MODE_CROP = 0, /**< crop the regions into the separate tensors */
+  TENSOR_CROP_MODE_ROI_RESIZE, /**< crop and resize the regions into a batched tensor */
+} tensor_crop_mode_e;
+
 /**
  * @brief GstTensorCrop pad data.
  */
@@ -56,6 +65,9 @@ struct _GstTensorCrop
 
   /* <private> */
   gint lateness; /**< time-diff of raw and info buffer */
+  tensor_crop_mode_e mode; /**< mode to crop the regions */
+  guint roi_width; /**< width of the resized region (roi-resize mode) */
+  guint roi_height; /**< height of the resized region (roi-resize mode) */
   gboolean silent; /**< true to print minimized log */
   gboolean send_stream_start; /**< flag to send STREAM_START event */
   GstCollectPads *collect; /**< sink pads */
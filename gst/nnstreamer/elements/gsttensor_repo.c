@@ -42,6 +42,57 @@ static GstTensorRepo _repo = {.num_data = 0,.initialized = FALSE };
 #define GST_REPO_WAIT() (g_cond_wait(&_repo.repo_cond, &_repo.repo_lock))
 #define GST_REPO_BROADCAST() (g_cond_broadcast (&_repo.repo_cond))
 
+/**
+ * @brief Get the number of buffers in the slot.
+ */
+static inline guint
+_repodata_get_level (GstTensorRepoData * data)
+{
+  guint head, tail;
+
+  head = (guint) g_atomic_int_get (&data->head);
+  tail = (guint) g_atomic_int_get (&data->tail);
+
+  return tail - head;
+}
+
+/**
+ * @brief Pop the oldest entry from the slot. Returns FALSE if the slot is empty.
+ * @note The consumer pops the entry, and the producer also pops it to drop the oldest buffer.
+ * The entry is read before moving the head, the producer does not overwrite it until the head is moved.
+ */
+static gboolean
+_repodata_pop_entry (GstTensorRepoData * data, GstTensorRepoEntry * entry)
+{
+  guint head, tail;
+
+  do {
+    head = (guint) g_atomic_int_get (&data->head);
+    tail = (guint) g_atomic_int_get (&data->tail);
+
+    if (head == tail)
+      return FALSE;
+
+    *entry = data->entries[head % GST_TENSOR_REPO_MAX_DEPTH];
+  } while (!g_atomic_int_compare_and_exchange (&data->head, (gint) head,
+          (gint) (head + 1)));
+
+  return TRUE;
+}
+
+/**
+ * @brief Wake up the thread waiting on the condition, only if the flag is set.
+ */
+static inline void
+_repodata_wakeup (GstTensorRepoData * data, gint * waiting, GCond * cond)
+{
+  if (g_atomic_int_get (waiting)) {
+    g_mutex_lock (&data->lock);
+    g_cond_signal (cond);
+    g_mutex_unlock (&data->lock);
+  }
+}
+
 /**
  * @brief Getter to get nth GstTensorRepoData.
  */
@@ -114,8 +165,6 @@ gst_tensor_repo_add_repodata (guint nth, gboolean is_sink)
     else
       data->src_changed = FALSE;
 
-    data->pushed = FALSE;
-
     g_mutex_unlock (&data->lock);
 
     if (DBG)
@@ -132,14 +181,16 @@ gst_tensor_repo_add_repodata (guint nth, gboolean is_sink)
   g_cond_init (&data->cond_push);
   g_cond_init (&data->cond_pull);
   g_mutex_init (&data->lock);
+  g_mutex_init (&data->stats_lock);
 
   g_mutex_lock (&data->lock);
   data->eos = FALSE;
-  data->buffer = NULL;
   data->caps = NULL;
   data->sink_changed = FALSE;
   data->src_changed = FALSE;
-  data->pushed = FALSE;
+  data->head = data->tail = 0;
+  data->depth = 1;
+  data->policy = GST_TENSOR_REPO_POLICY_BLOCK;
   g_mutex_unlock (&data->lock);
 
   GST_REPO_LOCK ();
@@ -158,6 +209,56 @@ gst_tensor_repo_add_repodata (guint nth, gboolean is_sink)
   return ret;
 }
 
+/**
+ * @brief Set the depth and the policy of slot.
+ */
+gboolean
+gst_tensor_repo_set_depth (guint nth, guint depth, GstTensorRepoPolicy policy)
+{
+  GstTensorRepoData *data;
+
+  data = gst_tensor_repo_get_repodata (nth);
+
+  g_return_val_if_fail (data != NULL, FALSE);
+  g_return_val_if_fail (depth > 0 && depth <= GST_TENSOR_REPO_MAX_DEPTH,
+      FALSE);
+
+  g_mutex_lock (&data->lock);
+  g_atomic_int_set (&data->depth, depth);
+  g_atomic_int_set (&data->policy, (guint) policy);
+
+  /* the producer may wait for a free entry with old depth or policy */
+  g_cond_signal (&data->cond_pull);
+  g_mutex_unlock (&data->lock);
+  return TRUE;
+}
+
+/**
+ * @brief Get the occupancy statistics of slot.
+ */
+gboolean
+gst_tensor_repo_get_stats (guint nth, GstTensorRepoStats * stats)
+{
+  GstTensorRepoData *data;
+
+  g_return_val_if_fail (stats != NULL, FALSE);
+
+  data = gst_tensor_repo_get_repodata (nth);
+  if (!data)
+    return FALSE;
+
+  stats->depth = (guint) g_atomic_int_get (&data->depth);
+  stats->level = _repodata_get_level (data);
+  stats->max_level = (guint) g_atomic_int_get (&data->max_level);
+
+  g_mutex_lock (&data->stats_lock);
+  stats->pushed = data->pushed;
+  stats->popped = data->popped;
+  stats->dropped = data->dropped;
+  g_mutex_unlock (&data->stats_lock);
+  return TRUE;
+}
+
 /**
  * @brief Push GstBuffer into repo.
  */
@@ -165,39 +266,74 @@ gboolean
 gst_tensor_repo_set_buffer (guint nth, GstBuffer * buffer, GstCaps * caps)
 {
   GstTensorRepoData *data;
+  GstTensorRepoEntry *entry;
+  guint depth, level, tail;
 
   data = gst_tensor_repo_get_repodata (nth);
 
   g_return_val_if_fail (data != NULL, FALSE);
 
-  g_mutex_lock (&data->lock);
+  while (TRUE) {
+    if (g_atomic_int_get (&data->eos))
+      return FALSE;
+
+    depth = (guint) g_atomic_int_get (&data->depth);
+    if (_repodata_get_level (data) < depth)
+      break;
+
+    if (g_atomic_int_get (&data->policy) == GST_TENSOR_REPO_POLICY_DROP_OLDEST) {
+      GstTensorRepoEntry dropped;
+
+      if (_repodata_pop_entry (data, &dropped)) {
+        gst_buffer_unref (dropped.buffer);
+        gst_caps_unref (dropped.caps);
+        g_mutex_lock (&data->stats_lock);
+        data->dropped++;
+        g_mutex_unlock (&data->stats_lock);
+      }
+      continue;
+    }
 
-  while (data->buffer != NULL && !data->eos) {
     /* wait pull */
-    g_cond_wait (&data->cond_pull, &data->lock);
-  }
-
-  if (data->eos) {
+    g_mutex_lock (&data->lock);
+    g_atomic_int_set (&data->wait_pull, TRUE);
+    while (!data->eos && data->policy == GST_TENSOR_REPO_POLICY_BLOCK &&
+        _repodata_get_level (data) >= data->depth)
+      g_cond_wait (&data->cond_pull, &data->lock);
+    g_atomic_int_set (&data->wait_pull, FALSE);
     g_mutex_unlock (&data->lock);
-    return FALSE;
   }
 
-  data->buffer = gst_buffer_copy_deep (buffer);
+  /* Only the producer updates the caps and the tail. */
   if (!data->caps || !gst_caps_is_equal (data->caps, caps)) {
     if (data->caps)
       gst_caps_unref (data->caps);
     data->caps = gst_caps_copy (caps);
   }
 
+  tail = (guint) g_atomic_int_get (&data->tail);
+  entry = &data->entries[tail % GST_TENSOR_REPO_MAX_DEPTH];
+  entry->buffer = gst_buffer_copy_deep (buffer);
+  entry->caps = gst_caps_ref (data->caps);
+
   if (DBG) {
-    unsigned long size = gst_buffer_get_size (data->buffer);
+    unsigned long size = gst_buffer_get_size (entry->buffer);
     GST_DEBUG ("Pushed [%d] (size : %lu)\n", nth, size);
   }
 
-  /* signal push */
-  g_cond_signal (&data->cond_push);
+  g_atomic_int_set (&data->tail, (gint) (tail + 1));
 
-  g_mutex_unlock (&data->lock);
+  g_mutex_lock (&data->stats_lock);
+  data->pushed++;
+  g_mutex_unlock (&data->stats_lock);
+
+  /* Only the producer updates the max level. */
+  level = _repodata_get_level (data);
+  if (level > (guint) g_atomic_int_get (&data->max_level))
+    g_atomic_int_set (&data->max_level, level);
+
+  /* signal push */
+  _repodata_wakeup (data, &data->wait_push, &data->cond_push);
   return TRUE;
 }
 
@@ -282,44 +418,54 @@ gst_tensor_repo_get_buffer (guint nth, gboolean * eos, guint * newid,
     GstCaps ** caps)
 {
   GstTensorRepoData *data;
-  GstBuffer *buf = NULL;
+  GstTensorRepoEntry entry;
 
   data = gst_tensor_repo_get_repodata (nth);
 
   g_return_val_if_fail (data != NULL, NULL);
 
-  g_mutex_lock (&data->lock);
+  while (!_repodata_pop_entry (data, &entry)) {
+    gboolean done = FALSE;
 
-  while (!data->buffer) {
-    if (gst_tensor_repo_check_changed (nth, newid, FALSE)) {
-      buf = NULL;
-      goto done;
+    g_mutex_lock (&data->lock);
+    g_atomic_int_set (&data->wait_push, TRUE);
+
+    while (_repodata_get_level (data) == 0) {
+      if (gst_tensor_repo_check_changed (nth, newid, FALSE)) {
+        done = TRUE;
+        break;
+      }
+
+      if (gst_tensor_repo_check_eos (nth)) {
+        *eos = TRUE;
+        done = TRUE;
+        break;
+      }
+
+      /* wait push */
+      g_cond_wait (&data->cond_push, &data->lock);
     }
 
-    if (gst_tensor_repo_check_eos (nth)) {
-      *eos = TRUE;
-      buf = NULL;
-      goto done;
-    }
+    g_atomic_int_set (&data->wait_push, FALSE);
+    g_mutex_unlock (&data->lock);
 
-    /* wait push */
-    g_cond_wait (&data->cond_push, &data->lock);
+    if (done)
+      return NULL;
   }
 
-  /* Current buffer will be wasted. */
-  buf = data->buffer;
-  *caps = gst_caps_ref (data->caps);
+  g_mutex_lock (&data->stats_lock);
+  data->popped++;
+  g_mutex_unlock (&data->stats_lock);
+
+  *caps = entry.caps;
   if (DBG) {
-    unsigned long size = gst_buffer_get_size (buf);
+    unsigned long size = gst_buffer_get_size (entry.buffer);
     GST_DEBUG ("Popped [ %d ] (size: %lu)\n", nth, size);
   }
 
-done:
-  data->buffer = NULL;
   /* signal pull */
-  g_cond_signal (&data->cond_pull);
-  g_mutex_unlock (&data->lock);
-  return buf;
+  _repodata_wakeup (data, &data->wait_pull, &data->cond_pull);
+  return entry.buffer;
 }
 
 /**
@@ -337,14 +483,19 @@ gst_tensor_repo_remove_repodata (guint nth)
   data = gst_tensor_repo_get_repodata (nth);
 
   if (data) {
+    GstTensorRepoEntry entry;
+
     g_mutex_lock (&data->lock);
-    if (data->buffer)
-      gst_buffer_unref (data->buffer);
+    while (_repodata_pop_entry (data, &entry)) {
+      gst_buffer_unref (entry.buffer);
+      gst_caps_unref (entry.caps);
+    }
     if (data->caps)
       gst_caps_unref (data->caps);
     g_mutex_unlock (&data->lock);
 
     g_mutex_clear (&data->lock);
+    g_mutex_clear (&data->stats_lock);
     g_cond_clear (&data->cond_pull);
     g_cond_clear (&data->cond_push);
 
@@ -32,14 +32,64 @@
 
 G_BEGIN_DECLS
 
+/**
+ * @brief Max number of buffers in a slot of the repo.
+ */
+#define GST_TENSOR_REPO_MAX_DEPTH (64U)
+
+/**
+ * @brief Policy when the slot is full.
+ */
+typedef enum
+{
+  GST_TENSOR_REPO_POLICY_BLOCK = 0, /**< wait until the oldest buffer is popped */
+  GST_TENSOR_REPO_POLICY_DROP_OLDEST = 1, /**< drop the oldest buffer and push the new one */
+} GstTensorRepoPolicy;
+
+/**
+ * @brief Buffer and its caps in a slot.
+ */
+typedef struct
+{
+  GstBuffer *buffer;
+  GstCaps *caps;
+} GstTensorRepoEntry;
+
+/**
+ * @brief Occupancy statistics of a slot.
+ */
+typedef struct
+{
+  guint depth; /**< max number of buffers in the slot */
+  guint level; /**< current number of buffers in the slot */
+  guint max_level; /**< the highest number of buffers in the slot */
+  guint64 pushed; /**< number of pushed buffers */
+  guint64 popped; /**< number of popped buffers */
+  guint64 dropped; /**< number of buffers dropped by the drop-oldest policy */
+} GstTensorRepoStats;
+
 /**
  * @brief GstTensorRepo internal data structure.
  *
  * GstTensorRepo has GSlist of GstTensorRepoData.
+ * Each slot is a ring of buffers, with a single producer (tensor_reposink) and
+ * a single consumer (tensor_reposrc). The head and tail are updated atomically,
+ * and the lock is held only to wait for the other side or to change the status.
  */
 typedef struct
 {
-  GstBuffer *buffer;
+  GstTensorRepoEntry entries[GST_TENSOR_REPO_MAX_DEPTH];
+  gint head; /**< index of the oldest buffer, updated by the consumer (and by the producer to drop) */
+  gint tail; /**< index of the next buffer, updated by the producer */
+  gint wait_push; /**< TRUE while the consumer waits for a pushed buffer */
+  gint wait_pull; /**< TRUE while the producer waits for a free entry */
+  guint depth; /**< max number of buffers in the slot */
+  guint policy; /**< GstTensorRepoPolicy when the slot is full */
+  guint max_level; /**< the highest number of buffers (atomic) */
+  guint64 pushed; /**< number of pushed buffers (stats_lock) */
+  guint64 popped; /**< number of popped buffers (stats_lock) */
+  guint64 dropped; /**< number of buffers dropped by the drop-oldest policy (stats_lock) */
+  GMutex stats_lock; /**< lock for the 64-bit counters, which do not wrap like the atomic integers */
   GstCaps *caps;
   GCond cond_push;
   GCond cond_pull;
@@ -49,7 +99,6 @@ typedef struct
   guint src_id;
   gboolean sink_changed;
   guint sink_id;
-  gboolean pushed;
 } GstTensorRepoData;
 
 /**
@@ -76,6 +125,18 @@ gst_tensor_repo_get_repodata (guint nth);
 gboolean
 gst_tensor_repo_add_repodata (guint myid, gboolean is_sink);
 
+/**
+ * @brief Set the depth and the policy of slot.
+ */
+gboolean
+gst_tensor_repo_set_depth (guint nth, guint depth, GstTensorRepoPolicy policy);
+
+/**
+ * @brief Get the occupancy statistics of slot.
+ */
+gboolean
+gst_tensor_repo_get_stats (guint nth, GstTensorRepoStats * stats);
+
 /**
  * @brief Push GstBuffer into repo.
  */
@@ -47,13 +47,45 @@ enum
   PROP_0,
   PROP_SIGNAL_RATE,
   PROP_SLOT,
-  PROP_SILENT
+  PROP_SILENT,
+  PROP_DEPTH,
+  PROP_POLICY,
+  PROP_CURRENT_LEVEL,
+  PROP_MAX_LEVEL,
+  PROP_DROPPED
 };
 
 #define DEFAULT_SIGNAL_RATE 0
 #define DEFAULT_SILENT TRUE
 #define DEFAULT_QOS TRUE
 #define DEFAULT_INDEX 0
+#define DEFAULT_DEPTH 1
+#define DEFAULT_POLICY GST_TENSOR_REPO_POLICY_BLOCK
+
+#define GST_TYPE_TENSOR_REPOSINK_POLICY (gst_tensor_reposink_policy_get_type ())
+/**
+ * @brief A private function to register GEnumValue array for the 'policy' property
+ *        to a GType and return it
+ */
+static GType
+gst_tensor_reposink_policy_get_type (void)
+{
+  static GType policy_type = 0;
+
+  if (policy_type == 0) {
+    static GEnumValue policy_types[] = {
+      {GST_TENSOR_REPO_POLICY_BLOCK, "block",
+          "Wait until the oldest buffer is popped"},
+      {GST_TENSOR_REPO_POLICY_DROP_OLDEST, "drop-oldest",
+          "Drop the oldest buffer in the slot"},
+      {0, NULL, NULL},
+    };
+    policy_type = g_enum_register_static ("tensor_reposink_policy",
+        policy_types);
+  }
+
+  return policy_type;
+}
 
 static void gst_tensor_reposink_set_property (GObject * object, guint prop_id,
     const GValue * value, GParamSpec * pspec);
@@ -116,6 +148,36 @@ gst_tensor_reposink_class_init (GstTensorRepoSinkClass * klass)
       g_param_spec_boolean ("silent", "Silent", "Produce verbose output",
           DEFAULT_SILENT, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  g_object_class_install_property (gobject_class, PROP_DEPTH,
+      g_param_spec_uint ("depth", "Depth",
+          "Max number of buffers in the repository slot. "
+          "With 1, the sink waits until tensor_reposrc pops the buffer",
+          1, GST_TENSOR_REPO_MAX_DEPTH, DEFAULT_DEPTH,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_POLICY,
+      g_param_spec_enum ("policy", "Policy",
+          "Policy when the repository slot is full",
+          GST_TYPE_TENSOR_REPOSINK_POLICY, DEFAULT_POLICY,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_CURRENT_LEVEL,
+      g_param_spec_uint ("current-level", "Current level",
+          "Current number of buffers in the repository slot",
+          0, GST_TENSOR_REPO_MAX_DEPTH, 0,
+          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_MAX_LEVEL,
+      g_param_spec_uint ("max-level", "Max level",
+          "The highest number of buffers in the repository slot",
+          0, GST_TENSOR_REPO_MAX_DEPTH, 0,
+          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_DROPPED,
+      g_param_spec_uint64 ("dropped", "Dropped",
+          "Number of buffers dropped by the drop-oldest policy",
+          0, G_MAXUINT64, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_set_static_metadata (element_class,
       "TensorRepoSink",
       "Sink/Tensor/Repository",
@@ -160,6 +222,8 @@ gst_tensor_reposink_init (GstTensorRepoSink * self)
   self->last_render_time = GST_CLOCK_TIME_NONE;
   self->set_startid = FALSE;
   self->in_caps = NULL;
+  self->depth = DEFAULT_DEPTH;
+  self->policy = DEFAULT_POLICY;
 
   gst_base_sink_set_qos_enabled (basesink, DEFAULT_QOS);
 
@@ -191,6 +255,8 @@ gst_tensor_reposink_set_property (GObject * object, guint prop_id,
       self->myid = g_value_get_uint (value);
 
       gst_tensor_repo_add_repodata (self->myid, TRUE);
+      gst_tensor_repo_set_depth (self->myid, self->depth,
+          (GstTensorRepoPolicy) self->policy);
 
       if (!self->set_startid) {
         self->o_myid = self->myid;
@@ -200,6 +266,18 @@ gst_tensor_reposink_set_property (GObject * object, guint prop_id,
       if (self->o_myid != self->myid)
         gst_tensor_repo_set_changed (self->o_myid, self->myid, TRUE);
       break;
+    case PROP_DEPTH:
+    case PROP_POLICY:
+      if (prop_id == PROP_DEPTH)
+        self->depth = g_value_get_uint (value);
+      else
+        self->policy = g_value_get_enum (value);
+
+      /* the slot is added when setting the slot index */
+      if (self->set_startid)
+        gst_tensor_repo_set_depth (self->myid, self->depth,
+            (GstTensorRepoPolicy) self->policy);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -227,6 +305,29 @@ gst_tensor_reposink_get_property (GObject * object, guint prop_id,
     case PROP_SLOT:
       g_value_set_uint (value, self->myid);
       break;
+    case PROP_DEPTH:
+      g_value_set_uint (value, self->depth);
+      break;
+    case PROP_POLICY:
+      g_value_set_enum (value, self->policy);
+      break;
+    case PROP_CURRENT_LEVEL:
+    case PROP_MAX_LEVEL:
+    case PROP_DROPPED:
+    {
+      GstTensorRepoStats stats = { 0, };
+
+      if (self->set_startid)
+        gst_tensor_repo_get_stats (self->myid, &stats);
+
+      if (prop_id == PROP_CURRENT_LEVEL)
+        g_value_set_uint (value, stats.level);
+      else if (prop_id == PROP_MAX_LEVEL)
+        g_value_set_uint (value, stats.max_level);
+      else
+        g_value_set_uint64 (value, stats.dropped);
+      break;
+    }
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
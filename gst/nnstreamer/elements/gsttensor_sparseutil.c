@@ -27,7 +27,8 @@ GstMemory *
 gst_tensor_sparse_to_dense (GstTensorMetaInfo * meta, GstMemory * mem)
 {
   GstMemory *dense = NULL;
-  GstMapInfo map;
+  GstMapInfo map, dense_map;
+  GstTensorMetaInfo dense_meta;
   guint i, nnz;
   guint8 *output, *input;
   guint *indices;
@@ -53,7 +54,28 @@ gst_tensor_sparse_to_dense (GstTensorMetaInfo * meta, GstMemory * mem)
     goto done;
   }
 
-  output = (guint8 *) g_malloc0 (output_size);
+  /**
+   * Reserve the header of dense tensor in front of the data,
+   * then downstream converts it to flexible tensor without copying the data.
+   */
+  gst_tensor_meta_info_init (&dense_meta);
+  dense_meta.type = meta->type;
+  memcpy (dense_meta.dimension, meta->dimension, sizeof (meta->dimension));
+
+  dense = gst_allocator_alloc (NULL,
+      gst_tensor_meta_info_get_header_size (&dense_meta) + output_size, NULL);
+  if (!dense || !gst_tensor_meta_info_reserve_header (&dense_meta, dense) ||
+      !gst_memory_map (dense, &dense_map, GST_MAP_WRITE)) {
+    nns_loge ("Failed to allocate dense tensor");
+    if (dense) {
+      gst_memory_unref (dense);
+      dense = NULL;
+    }
+    goto done;
+  }
+
+  output = dense_map.data;
+  memset (output, 0, output_size);
 
   nnz = meta->sparse_info.nnz;
   input = map.data + gst_tensor_meta_info_get_header_size (meta);
@@ -93,13 +115,14 @@ gst_tensor_sparse_to_dense (GstTensorMetaInfo * meta, GstMemory * mem)
         break;
       default:
         nns_loge ("Error occured during get tensor value");
-        g_free (output);
+        gst_memory_unmap (dense, &dense_map);
+        gst_memory_unref (dense);
+        dense = NULL;
         goto done;
     }
   }
 
-  dense = gst_memory_new_wrapped (0, output, output_size, 0, output_size,
-      output, g_free);
+  gst_memory_unmap (dense, &dense_map);
 
 done:
   gst_memory_unmap (mem, &map);
@@ -69,7 +69,7 @@ GST_DEBUG_CATEGORY_STATIC (gst_tensor_transform_debug);
 #define CAPS_STRING GST_TENSOR_CAP_DEFAULT ";" GST_TENSORS_CAP_MAKE ("{ static, flexible }")
 #define REGEX_DIMCHG_OPTION "^([0-9]|1[0-5]):([0-9]|1[0-5])$"
 #define REGEX_TYPECAST_OPTION "(^[u]?int(8|16|32|64)$|^float(16|32|64)$)"
-#define REGEX_TRANSPOSE_OPTION "^(?:([0-2]):(?!.*\\1)){3}3$"
+#define REGEX_TRANSPOSE_OPTION "^([0-9]|1[0-5])(:([0-9]|1[0-5]))+$"
 #define REGEX_STAND_OPTION "^(default|dc-average)(:([u]?int(8|16|32|64)|float(16|32|64)))?(,per-channel:(true|false))?$"
 #define REGEX_CLAMP_OPTION "^((([-+]?[0-9]*\\.?[0-9]+([eE][-+]?[0-9]+)?))):"\
     "((([-+]?[0-9]*\\.?[0-9]+([eE][-+]?[0-9]+)?)))$"
@@ -80,10 +80,26 @@ GST_DEBUG_CATEGORY_STATIC (gst_tensor_transform_debug);
 #define REGEX_ARITH_OPTION_TYPECAST "(typecast:([u]?int(8|16|32|64)|float(16|32|64)))"
 
 /**
- * @brief The transpose rank is fixed to 4.
- * This RANK does not affect other/tensors(s)'s NNS_TENSOR_RANK_LIMIT.
+ * @brief The max rank of transpose, same as NNS_TENSOR_RANK_LIMIT.
  */
-#define NNS_TENSOR_TRANSPOSE_RANK_LIMIT (4)
+#define NNS_TENSOR_TRANSPOSE_RANK_LIMIT (NNS_TENSOR_RANK_LIMIT)
+
+/**
+ * @brief The max number of stages in "pipeline" mode.
+ */
+#define PIPELINE_STAGE_LIMIT (16U)
+
+/**
+ * @brief The number of elements in a chunk of the fused element-wise stages in "pipeline" mode.
+ */
+#define PIPELINE_CHUNK_SIZE (2048U)
+
+/**
+ * @brief Macro to check the stage of "pipeline" mode processes each element independently.
+ */
+#define pipeline_stage_is_elementwise(s) \
+    ((s)->mode == GTT_TYPECAST || (s)->mode == GTT_CLAMP || \
+    ((s)->mode == GTT_ARITHMETIC && !(s)->data_arithmetic.per_channel_arith))
 
 /**
  * @brief tensor_transform properties
@@ -165,6 +181,9 @@ static gboolean gst_tensor_transform_transform_size (GstBaseTransform * trans,
 static gboolean gst_tensor_transform_convert_dimension (GstTensorTransform *
     filter, GstPadDirection direction, guint idx, const GstTensorInfo * in_info,
     GstTensorInfo * out_info);
+static GstFlowReturn gst_tensor_transform_pipeline (GstTensorTransform *
+    filter, GstTensorInfo * in_info, GstTensorInfo * out_info,
+    const uint8_t * inptr, uint8_t * outptr);
 
 #define GST_TYPE_TENSOR_TRANSFORM_MODE (gst_tensor_transform_mode_get_type ())
 /**
@@ -188,7 +207,7 @@ gst_tensor_transform_mode_get_type (void)
             "option=[typecast:TYPE,][per-channel:(false|true@DIM),]add|mul|div:NUMBER[@CH_IDX], ...",
           "arithmetic"},
       {GTT_TRANSPOSE, "Mode for transposing shape of tensor, "
-            "option=D1\':D2\':D3\':D4 (fixed to 3)",
+            "option=D1\':D2\':...:DN (the last dim is fixed to N-1)",
           "transpose"},
       {GTT_STAND, "Mode for statistical standardization of tensor, "
             "option=(default|dc-average)[:TYPE][,per-channel:(false|true)]",
@@ -196,6 +215,9 @@ gst_tensor_transform_mode_get_type (void)
       {GTT_CLAMP, "Mode for clamping all elements of tensor into the range, "
             "option=CLAMP_MIN:CLAMP_MAX",
           "clamp"},
+      {GTT_PIPELINE, "Mode for running the sequence of the modes at once, "
+            "option=MODE:OPTION|MODE:OPTION|...",
+          "pipeline"},
       {GTT_UNKNOWN, "Unknown or not-implemented-yet mode",
           "unknown"},
       {0, NULL, NULL},
@@ -247,7 +269,7 @@ gst_tensor_transform_class_init (GstTensorTransformClass * klass)
           "", G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
   g_object_class_install_property (gobject_class, PROP_TRANSPOSE_RANK_LIMIT,
       g_param_spec_uint ("transpose-rank-limit", "Transpose rank limit",
-          "The rank limit of transpose, which varies per version of nnstreamer and may be lower than the global rank limit if it is over 4.",
+          "The rank limit of transpose, which varies per version of nnstreamer. It is the same as the global rank limit (it was 4 in the previous releases).",
           0, NNS_TENSOR_RANK_LIMIT, NNS_TENSOR_TRANSPOSE_RANK_LIMIT,
           G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 
@@ -295,6 +317,10 @@ gst_tensor_transform_init (GstTensorTransform * filter)
   filter->operators = NULL;
   filter->acceleration = DEFAULT_ACCELERATION;
   filter->apply = NULL;
+  filter->stages = NULL;
+  filter->stage_buf[0] = filter->stage_buf[1] = NULL;
+  filter->stage_buf_size = 0;
+  filter->stage_chunk = NULL;
 
   gst_tensors_config_init (&filter->in_config);
   gst_tensors_config_init (&filter->out_config);
@@ -466,6 +492,8 @@ refrain_from_heavy_op_on_float16 (gulong n)
 #define orc_func_add(intype) nns_orc_add_c_ ## intype
 #define orc_func_mul(intype) nns_orc_mul_c_ ## intype
 #define orc_func_div(intype) nns_orc_div_c_ ## intype
+#define orc_func_clamp(intype) nns_orc_clamp_ ## intype
+#define orc_func_stand(intype) nns_orc_stand_ ## intype
 
 #define orc_typecast_to(i,o,n,intype,otype,intypename) do { \
     switch (otype) { \
@@ -557,6 +585,130 @@ refrain_from_heavy_op_on_float16 (gulong n)
   } while (0)
 #endif /* HAVE_ORC */
 
+/**
+ * @brief The number of elements processed at once in the typed loops of stand and clamp.
+ */
+#define TRANSFORM_CHUNK_SIZE (256U)
+
+/**
+ * @brief Macro to load the elements with given type into the array of double.
+ */
+#define transform_load_f64(o,i,n,dtype) do { \
+    const dtype *_src = (const dtype *) (i); \
+    gsize _idx; \
+    for (_idx = 0; _idx < (n); ++_idx) \
+      (o)[_idx] = (gdouble) _src[_idx]; \
+  } while (0)
+
+/**
+ * @brief Macro to store the array of double into the elements with given type.
+ * @note Same as gst_tensor_data_typecast(), the floating point value is converted to the signed integer before the unsigned type.
+ */
+#define transform_store_f64(o,i,n,dtype,stype) do { \
+    dtype *_dst = (dtype *) (o); \
+    gsize _idx; \
+    for (_idx = 0; _idx < (n); ++_idx) \
+      _dst[_idx] = (dtype) (stype) (i)[_idx]; \
+  } while (0)
+
+/**
+ * @brief Internal function to typecast the tensor elements to the array of double.
+ */
+static void
+gst_tensor_transform_load_f64 (gdouble * out, const uint8_t * inptr,
+    tensor_type type, gsize n)
+{
+  gsize i, element_size;
+
+  switch (type) {
+    case _NNS_INT32:
+      transform_load_f64 (out, inptr, n, int32_t);
+      break;
+    case _NNS_UINT32:
+      transform_load_f64 (out, inptr, n, uint32_t);
+      break;
+    case _NNS_INT16:
+      transform_load_f64 (out, inptr, n, int16_t);
+      break;
+    case _NNS_UINT16:
+      transform_load_f64 (out, inptr, n, uint16_t);
+      break;
+    case _NNS_INT8:
+      transform_load_f64 (out, inptr, n, int8_t);
+      break;
+    case _NNS_UINT8:
+      transform_load_f64 (out, inptr, n, uint8_t);
+      break;
+    case _NNS_FLOAT64:
+      memcpy (out, inptr, n * sizeof (gdouble));
+      break;
+    case _NNS_FLOAT32:
+      transform_load_f64 (out, inptr, n, float);
+      break;
+    case _NNS_INT64:
+      transform_load_f64 (out, inptr, n, int64_t);
+      break;
+    case _NNS_UINT64:
+      transform_load_f64 (out, inptr, n, uint64_t);
+      break;
+    default:
+      element_size = gst_tensor_get_element_size (type);
+      for (i = 0; i < n; ++i)
+        gst_tensor_data_raw_typecast ((gpointer) (inptr + element_size * i),
+            type, &out[i], _NNS_FLOAT64);
+      break;
+  }
+}
+
+/**
+ * @brief Internal function to typecast the array of double to the tensor elements.
+ */
+static void
+gst_tensor_transform_store_f64 (uint8_t * outptr, tensor_type type,
+    gdouble * in, gsize n)
+{
+  gsize i, element_size;
+
+  switch (type) {
+    case _NNS_INT32:
+      transform_store_f64 (outptr, in, n, int32_t, int32_t);
+      break;
+    case _NNS_UINT32:
+      transform_store_f64 (outptr, in, n, uint32_t, int32_t);
+      break;
+    case _NNS_INT16:
+      transform_store_f64 (outptr, in, n, int16_t, int16_t);
+      break;
+    case _NNS_UINT16:
+      transform_store_f64 (outptr, in, n, uint16_t, int16_t);
+      break;
+    case _NNS_INT8:
+      transform_store_f64 (outptr, in, n, int8_t, int8_t);
+      break;
+    case _NNS_UINT8:
+      transform_store_f64 (outptr, in, n, uint8_t, int8_t);
+      break;
+    case _NNS_FLOAT64:
+      memcpy (outptr, in, n * sizeof (gdouble));
+      break;
+    case _NNS_FLOAT32:
+      transform_store_f64 (outptr, in, n, float, float);
+      break;
+    case _NNS_INT64:
+      transform_store_f64 (outptr, in, n, int64_t, int64_t);
+      break;
+    case _NNS_UINT64:
+      transform_store_f64 (outptr, in, n, uint64_t, int64_t);
+      break;
+    default:
+      element_size = gst_tensor_get_element_size (type);
+      for (i = 0; i < n; ++i)
+        gst_tensor_data_raw_typecast (&in[i], _NNS_FLOAT64,
+            (gpointer) (outptr + element_size * i), type);
+      break;
+  }
+}
+
 /**
  * @brief Macro for operator
  */
@@ -644,6 +796,91 @@ gst_tensor_transform_do_operator (GstTensorTransform * filter,
   return TRUE;
 }
 
+/**
+ * @brief Internal function to release the stages of "pipeline" mode.
+ */
+static void
+gst_tensor_transform_clear_stages (GstTensorTransform * filter)
+{
+  if (filter->stages) {
+    g_ptr_array_free (filter->stages, TRUE);
+    filter->stages = NULL;
+  }
+
+  g_free (filter->stage_buf[0]);
+  g_free (filter->stage_buf[1]);
+  filter->stage_buf[0] = filter->stage_buf[1] = NULL;
+  filter->stage_buf_size = 0;
+
+  g_free (filter->stage_chunk);
+  filter->stage_chunk = NULL;
+}
+
+/**
+ * @brief Internal function to prepare the intermediate tensors between the stages of "pipeline" mode.
+ * @param[in/out] filter "this" pointer
+ * @param[in] size byte size of the largest intermediate tensor
+ * @return TRUE if the intermediate tensors are ready
+ */
+static gboolean
+gst_tensor_transform_alloc_stage_buf (GstTensorTransform * filter, gsize size)
+{
+  if (size <= filter->stage_buf_size)
+    return TRUE;
+
+  g_free (filter->stage_buf[0]);
+  g_free (filter->stage_buf[1]);
+  filter->stage_buf[0] = g_try_malloc (size);
+  filter->stage_buf[1] = g_try_malloc (size);
+
+  if (!filter->stage_buf[0] || !filter->stage_buf[1]) {
+    GST_ERROR_OBJECT (filter, "Failed to allocate the intermediate tensors.");
+    g_free (filter->stage_buf[0]);
+    g_free (filter->stage_buf[1]);
+    filter->stage_buf[0] = filter->stage_buf[1] = NULL;
+    filter->stage_buf_size = 0;
+    return FALSE;
+  }
+
+  filter->stage_buf_size = size;
+  return TRUE;
+}
+
+/**
+ * @brief Internal function to get the tensor info of each stage of "pipeline" mode.
+ * @param[in] filter "this" pointer
+ * @param[in] in_info input tensor info
+ * @param[out] info tensor info of the input of each stage and the output of the last stage. The name is not copied.
+ * @param[out] max_size byte size of the largest intermediate tensor
+ * @return TRUE if the stages accept the input
+ */
+static gboolean
+gst_tensor_transform_get_stage_info (GstTensorTransform * filter,
+    const GstTensorInfo * in_info, GstTensorInfo * info, gsize * max_size)
+{
+  GstTensorTransform *stage;
+  guint s, num;
+
+  num = filter->stages->len;
+  *max_size = 0;
+
+  info[0] = *in_info;
+  info[0].name = NULL;
+
+  for (s = 0; s < num; s++) {
+    stage = (GstTensorTransform *) g_ptr_array_index (filter->stages, s);
+
+    if (!gst_tensor_transform_convert_dimension (stage, GST_PAD_SINK, 0,
+            &info[s], &info[s + 1]))
+      return FALSE;
+
+    if (s + 1 < num)
+      *max_size = MAX (*max_size, gst_tensor_info_get_size (&info[s + 1]));
+  }
+
+  return TRUE;
+}
+
 /**
  * @brief Setup internal data (data_* in GstTensorTransform)
  * @param[in/out] filter "this" pointer. mode & option MUST BE set already.
@@ -843,24 +1080,47 @@ gst_tensor_transform_set_option_data (GstTensorTransform * filter)
     }
     case GTT_TRANSPOSE:
     {
-      int i;
+      guint i, num;
+      guint64 idx;
+      gboolean used[NNS_TENSOR_RANK_LIMIT] = { FALSE, };
       gchar **strv = NULL;
 
       if (!g_regex_match_simple (REGEX_TRANSPOSE_OPTION, filter->option,
               G_REGEX_CASELESS, 0)) {
         ml_loge
-            ("%s: transpose: \'%s\' is not valid option string: it should be in the form of NEW_IDX_DIM0:NEW_IDX_DIM1:NEW_IDX_DIM2:3 (Now transpose mode's rank is fixed to 3. Note that the index of the last dim is always fixed to 3)\n",
+            ("%s: transpose: \'%s\' is not valid option string: it should be in the form of NEW_IDX_DIM0:NEW_IDX_DIM1:...:LAST_DIM (e.g., 2:0:1:3. Note that the index of the last dim is always fixed)\n",
             filter_name, filter->option);
         break;
       }
 
-      strv = g_strsplit (filter->option, ":", NNS_TENSOR_TRANSPOSE_RANK_LIMIT);
-      for (i = 0; i < NNS_TENSOR_TRANSPOSE_RANK_LIMIT; i++) {
-        filter->data_transpose.trans_order[i] =
-            (uint8_t) g_ascii_strtoull (strv[i], NULL, 10);
+      strv = g_strsplit (filter->option, ":", -1);
+      num = g_strv_length (strv);
+
+      /* the option should be a permutation of the axes, and the last axis is fixed. */
+      for (i = 0; num <= NNS_TENSOR_TRANSPOSE_RANK_LIMIT &&
+          i < NNS_TENSOR_TRANSPOSE_RANK_LIMIT; i++) {
+        if (i < num) {
+          idx = g_ascii_strtoull (strv[i], NULL, 10);
+          if (idx >= num || used[idx])
+            break;
+
+          used[idx] = TRUE;
+        } else {
+          idx = i;
+        }
+
+        filter->data_transpose.trans_order[i] = (uint8_t) idx;
+      }
+
+      if (i < NNS_TENSOR_TRANSPOSE_RANK_LIMIT ||
+          filter->data_transpose.trans_order[num - 1] != num - 1) {
+        ml_loge
+            ("%s: transpose: \'%s\' is not valid option string: each index of the dimension should be given once and the index of the last dim should be fixed.\n",
+            filter_name, filter->option);
+      } else {
+        ret = filter->loaded = TRUE;
       }
 
-      ret = filter->loaded = TRUE;
       g_strfreev (strv);
       break;
     }
@@ -948,6 +1208,75 @@ gst_tensor_transform_set_option_data (GstTensorTransform * filter)
       ret = filter->loaded = TRUE;
       break;
     }
+    case GTT_PIPELINE:
+    {
+      GEnumClass *mode_class;
+      GEnumValue *mode_value;
+      GstTensorTransform *stage;
+      gchar **strv, **stage_option;
+      guint i, num;
+
+      gst_tensor_transform_clear_stages (filter);
+
+      strv = g_strsplit (filter->option, "|", -1);
+      num = g_strv_length (strv);
+
+      if (num == 0 || num > PIPELINE_STAGE_LIMIT) {
+        ml_loge
+            ("%s: pipeline: \'%s\' is not valid option string: it should be in the form of MODE:OPTION|MODE:OPTION|... with at most %u stages\n",
+            filter_name, filter->option, PIPELINE_STAGE_LIMIT);
+        g_strfreev (strv);
+        break;
+      }
+
+      mode_class =
+          (GEnumClass *) g_type_class_ref (GST_TYPE_TENSOR_TRANSFORM_MODE);
+      filter->stages = g_ptr_array_new_with_free_func (gst_object_unref);
+
+      for (i = 0; i < num; i++) {
+        stage_option = g_strsplit (g_strstrip (strv[i]), ":", 2);
+        mode_value = NULL;
+
+        if (g_strv_length (stage_option) == 2)
+          mode_value = g_enum_get_value_by_nick (mode_class, stage_option[0]);
+
+        if (mode_value == NULL || mode_value->value == GTT_PIPELINE ||
+            mode_value->value == GTT_UNKNOWN) {
+          ml_loge
+              ("%s: pipeline: \'%s\' is not valid stage: it should be in the form of MODE:OPTION\n",
+              filter_name, strv[i]);
+          g_strfreev (stage_option);
+          break;
+        }
+
+        /* each stage is a tensor_transform instance, which parses the option of the mode. */
+        stage = (GstTensorTransform *) g_object_new (GST_TYPE_TENSOR_TRANSFORM,
+            "mode", mode_value->value, "option", stage_option[1], NULL);
+        g_ptr_array_add (filter->stages, gst_object_ref_sink (stage));
+        g_strfreev (stage_option);
+
+        if (!stage->loaded) {
+          ml_loge ("%s: pipeline: cannot load the stage \'%s\'\n",
+              filter_name, strv[i]);
+          break;
+        }
+
+        stage->acceleration = filter->acceleration;
+      }
+
+      g_type_class_unref (mode_class);
+      g_strfreev (strv);
+
+      if (i < num) {
+        gst_tensor_transform_clear_stages (filter);
+        break;
+      }
+
+      filter->stage_chunk =
+          g_malloc (2 * PIPELINE_CHUNK_SIZE * sizeof (gint64));
+      ret = filter->loaded = TRUE;
+      break;
+    }
     default:
       GST_ERROR_OBJECT (filter, "Cannot identify mode\n");
       ret = FALSE;
@@ -994,6 +1323,16 @@ gst_tensor_transform_set_property (GObject * object, guint prop_id,
 #ifdef HAVE_ORC
       filter->acceleration = g_value_get_boolean (value);
       silent_debug (filter, "acceleration = %d\n", filter->acceleration);
+
+      if (filter->stages) {
+        guint i;
+
+        for (i = 0; i < filter->stages->len; i++) {
+          GstTensorTransform *stage =
+              (GstTensorTransform *) g_ptr_array_index (filter->stages, i);
+          stage->acceleration = filter->acceleration;
+        }
+      }
 #else
       GST_WARNING_OBJECT (filter, "Orc acceleration is not supported");
       filter->acceleration = FALSE;
@@ -1105,6 +1444,8 @@ gst_tensor_transform_finalize (GObject * object)
     filter->apply = NULL;
   }
 
+  gst_tensor_transform_clear_stages (filter);
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -1303,15 +1644,15 @@ gst_tensor_transform_arithmetic (GstTensorTransform * filter,
           continue;
         }
 
+        gst_tensor_data_typecast (&op_s->value, out_info->type);
+
         if (op_s->applying_ch == -1) {
-          gst_tensor_data_typecast (&op_s->value, out_info->type);
           orc_operator (outptr, num, &op_s->value, op_s->op);
         } else {
           for (i = 0; i < num / ch_offset; ++i) {
             tmp_outptr =
                 outptr + (ch_size * op_s->applying_ch +
                 ch_offset * i) * typesize;
-            gst_tensor_data_typecast (&op_s->value, out_info->type);
             orc_operator (tmp_outptr, ch_size, &op_s->value, op_s->op);
           }
         }
@@ -1425,24 +1766,28 @@ gst_tensor_transform_arithmetic (GstTensorTransform * filter,
 }
 
 /**
- * Macro to run loop for various data types with transpose
+ * @brief The size of the square tile (in elements) for the blocked transpose.
  */
-#define transposeloop(cl,ck,cj,ci,sl,sk,sj,si,typesize) do { \
-    size_t i, j, k, l;                                  \
-    int inidx = 0, outidx=0;                            \
-    for(cl=0;cl<sl;cl++)                      \
-      for(ci=0;ci<si;ci++)                    \
-        for(cj=0;cj<sj;cj++)                  \
-          for(ck=0;ck<sk;ck++){               \
-            const uint8_t *_in; \
-            uint8_t *_out; \
-            outidx = si*sj*sk*cl + sj*sk*ci + sk*cj + ck; \
-            inidx = SK*SJ*SI*l + SJ*SI*k + SI*j + i; \
-            _in = inptr + inidx * typesize; \
-            _out = outptr + outidx * typesize; \
-            nns_memcpy(_out, _in, typesize); \
-	  }                                                      \
-  } while(0);
+#define TRANSPOSE_BLOCK_SIZE (16U)
+
+/**
+ * @brief Macro to transpose a 2D plane tile by tile with given element type.
+ *        out[y * os_y + x] = in[x * is_x + y]
+ */
+#define transpose_block(dtype,o,i,nx,ny,is_x,os_y) do { \
+    const dtype *_src = (const dtype *) (i); \
+    dtype *_dst = (dtype *) (o); \
+    gsize _xb, _yb, _xe, _ye, _x, _y; \
+    for (_yb = 0; _yb < (ny); _yb += TRANSPOSE_BLOCK_SIZE) { \
+      _ye = MIN (_yb + TRANSPOSE_BLOCK_SIZE, (ny)); \
+      for (_xb = 0; _xb < (nx); _xb += TRANSPOSE_BLOCK_SIZE) { \
+        _xe = MIN (_xb + TRANSPOSE_BLOCK_SIZE, (nx)); \
+        for (_y = _yb; _y < _ye; _y++) \
+          for (_x = _xb; _x < _xe; _x++) \
+            _dst[_y * (os_y) + _x] = _src[_x * (is_x) + _y]; \
+      } \
+    } \
+  } while (0)
 
 /**
  * @brief subrouting for tensor-tranform, "transpose" case.
@@ -1458,58 +1803,121 @@ gst_tensor_transform_transpose (GstTensorTransform * filter,
     GstTensorInfo * in_info, GstTensorInfo * out_info,
     const uint8_t * inptr, uint8_t * outptr)
 {
-  int i, from, to;
-  gboolean checkdim = FALSE;
+  gsize dim[NNS_TENSOR_RANK_LIMIT], idx[NNS_TENSOR_RANK_LIMIT];
+  gsize in_stride[NNS_TENSOR_RANK_LIMIT], out_stride[NNS_TENSOR_RANK_LIMIT];
+  gsize axis_stride[NNS_TENSOR_RANK_LIMIT];
+  gsize type_size, d, num, in_off, out_off, b, nx, ny, is_x, os_y;
+  guint i, k, rank, axis, inner;
   uint32_t *fromDim = in_info->dimension;
-  gsize type_size = gst_tensor_get_element_size (in_info->type);
-  gsize indexI, indexJ, SL, SI, SJ, SK;
   UNUSED (out_info);
 
+  type_size = gst_tensor_get_element_size (in_info->type);
+
+  /* element stride of each input axis */
+  axis_stride[0] = 1;
+  for (i = 1; i < NNS_TENSOR_RANK_LIMIT; i++) {
+    d = fromDim[i - 1] > 0 ? fromDim[i - 1] : 1;
+    axis_stride[i] = axis_stride[i - 1] * d;
+  }
+
+  /**
+   * The output axis i reads the input axis trans_order[i].
+   * Remove the axes of size 1 and merge the neighboring output axes
+   * which are contiguous in the input too.
+   */
+  rank = 0;
   for (i = 0; i < NNS_TENSOR_TRANSPOSE_RANK_LIMIT; i++) {
-    from = i;
-    to = filter->data_transpose.trans_order[i];
-    if (from != to) {
-      checkdim = TRUE;
-      break;
+    axis = filter->data_transpose.trans_order[i];
+    d = fromDim[axis] > 0 ? fromDim[axis] : 1;
+
+    if (d == 1)
+      continue;
+
+    if (rank > 0 &&
+        in_stride[rank - 1] * dim[rank - 1] == axis_stride[axis]) {
+      dim[rank - 1] *= d;
+      continue;
     }
+
+    dim[rank] = d;
+    in_stride[rank] = axis_stride[axis];
+    rank++;
   }
 
-  if (!checkdim) {
+  if (rank <= 1) {
     nns_memcpy (outptr, inptr, gst_tensor_info_get_size (in_info));
     GST_WARNING_OBJECT (filter,
         "Calling tensor_transform with high memcpy overhead WITHOUT any effects!");
     return GST_FLOW_OK;
   }
 
-  indexI = filter->data_transpose.trans_order[0];
-  indexJ = filter->data_transpose.trans_order[1];
-  SL = fromDim[3] > 0 ? fromDim[3] : 1;
-  SI = fromDim[0] > 0 ? fromDim[0] : 1;
-  SJ = fromDim[1] > 0 ? fromDim[1] : 1;
-  SK = fromDim[2] > 0 ? fromDim[2] : 1;
-
-  switch (indexI) {
-    case 0:
-      if (indexJ == 1) {
-        transposeloop (l, i, j, k, SL, SI, SJ, SK, type_size);
-      } else {
-        transposeloop (l, i, k, j, SL, SI, SK, SJ, type_size);
-      }
-      break;
-    case 1:
-      if (indexJ == 0) {
-        transposeloop (l, j, i, k, SL, SJ, SI, SK, type_size);
-      } else {
-        transposeloop (l, j, k, i, SL, SJ, SK, SI, type_size);
-      }
-      break;
-    case 2:
-      if (indexJ == 0) {
-        transposeloop (l, k, i, j, SL, SK, SI, SJ, type_size);
-      } else {
-        transposeloop (l, k, j, i, SL, SK, SJ, SI, type_size);
+  num = 1;
+  for (i = 0; i < rank; i++) {
+    out_stride[i] = num;
+    num *= dim[i];
+    idx[i] = 0;
+  }
+
+  /**
+   * If the innermost output axis is contiguous in the input, copy the rows.
+   * Otherwise, transpose the plane of the innermost output axis and
+   * the innermost input axis (of which stride is 1) with the tiles.
+   */
+  inner = 0;
+  if (in_stride[0] != 1) {
+    for (inner = 1; inner < rank; inner++) {
+      if (in_stride[inner] == 1)
+        break;
+    }
+    g_assert (inner < rank);
+  }
+
+  nx = dim[0];
+  ny = (inner > 0) ? dim[inner] : 1;
+  is_x = in_stride[0];
+  os_y = out_stride[inner];
+
+  in_off = out_off = 0;
+  for (b = 0; b < num / (nx * ny); b++) {
+    const uint8_t *_in = inptr + in_off * type_size;
+    uint8_t *_out = outptr + out_off * type_size;
+
+    if (inner == 0) {
+      nns_memcpy (_out, _in, nx * type_size);
+    } else {
+      switch (type_size) {
+        case 1:
+          transpose_block (uint8_t, _out, _in, nx, ny, is_x, os_y);
+          break;
+        case 2:
+          transpose_block (uint16_t, _out, _in, nx, ny, is_x, os_y);
+          break;
+        case 4:
+          transpose_block (uint32_t, _out, _in, nx, ny, is_x, os_y);
+          break;
+        case 8:
+          transpose_block (uint64_t, _out, _in, nx, ny, is_x, os_y);
+          break;
+        default:
+          GST_ERROR_OBJECT (filter, "Unsupported element size %zd", type_size);
+          return GST_FLOW_ERROR;
       }
-      break;
+    }
+
+    /* move to the next plane (or row) over the outer axes */
+    for (k = 1; k < rank; k++) {
+      if (k == inner)
+        continue;
+
+      in_off += in_stride[k];
+      out_off += out_stride[k];
+      if (++idx[k] < dim[k])
+        break;
+
+      in_off -= in_stride[k] * dim[k];
+      out_off -= out_stride[k] * dim[k];
+      idx[k] = 0;
+    }
   }
 
   return GST_FLOW_OK;
@@ -1532,15 +1940,16 @@ gst_tensor_transform_stand (GstTensorTransform * filter,
 {
   GstFlowReturn ret = GST_FLOW_OK;
   gsize in_element_size, out_element_size, data_size, ch_size;
-  gulong i, num, data_idx, ch;
-  gdouble tmp, *average, *std;
+  gulong i, j, n, num, ch;
+  gdouble *average, *std;
+  gdouble chunk[TRANSFORM_CHUNK_SIZE];
 
   in_element_size = gst_tensor_get_element_size (in_info->type);
   out_element_size = gst_tensor_get_element_size (out_info->type);
   num = gst_tensor_get_element_count (in_info->dimension);
 
   data_size = gst_tensor_info_get_size (in_info);
-  ch_size = in_info->dimension[0];
+  ch_size = filter->data_stand.per_channel ? in_info->dimension[0] : 1;
 
   /* calc average and std */
   average = std = NULL;
@@ -1560,74 +1969,74 @@ gst_tensor_transform_stand (GstTensorTransform * filter,
           average, &std);
   }
 
-  switch (filter->data_stand.mode) {
-    case STAND_DEFAULT:
-    {
-      if (!filter->data_stand.per_channel) {
-        for (i = 0; i < num; i++) {
-          data_idx = in_element_size * i;
-          gst_tensor_data_raw_typecast ((gpointer) (inptr + data_idx),
-              in_info->type, &tmp, _NNS_FLOAT64);
-
-          tmp = fabs ((tmp - *average) / *std);
+  if (filter->data_stand.mode != STAND_DEFAULT &&
+      filter->data_stand.mode != STAND_DC_AVERAGE) {
+    GST_ERROR_OBJECT (filter, "Cannot identify mode\n");
+    ret = GST_FLOW_ERROR;
+    goto done;
+  }
 
-          data_idx = out_element_size * i;
-          gst_tensor_data_raw_typecast (&tmp, _NNS_FLOAT64,
-              (gpointer) (outptr + data_idx), out_info->type);
-        }
-      } else {
-        for (ch = 0; ch < ch_size; ++ch) {
-          for (i = 0; i < num / ch_size; i++) {
-            data_idx = in_element_size * ((i * ch_size) + ch);
-            gst_tensor_data_raw_typecast ((gpointer) (inptr + data_idx),
-                in_info->type, &tmp, _NNS_FLOAT64);
+  if (average == NULL ||
+      (filter->data_stand.mode == STAND_DEFAULT && std == NULL)) {
+    GST_ERROR_OBJECT (filter, "Failed to calculate average and std\n");
+    ret = GST_FLOW_ERROR;
+    goto done;
+  }
 
-            tmp = fabs ((tmp - average[ch]) / std[ch]);
+#ifdef HAVE_ORC
+  if (orc_supported (filter, in_info->type, out_info->type) &&
+      !filter->data_stand.per_channel) {
+    /* typecast to the output, then standardize the floating point output in place */
+    if (out_info->type == _NNS_FLOAT32) {
+      orc_typecast (inptr, outptr, num, in_info->type, out_info->type);
+
+      if (filter->data_stand.mode == STAND_DEFAULT)
+        orc_func_stand (f32) ((gpointer) outptr, (float) average[0],
+            (float) std[0], num);
+      else
+        orc_func_add (f32) ((gpointer) outptr, (float) -average[0], num);
+      goto done;
+    } else if (out_info->type == _NNS_FLOAT64) {
+      orc_typecast (inptr, outptr, num, in_info->type, out_info->type);
 
-            data_idx = out_element_size * ((i * ch_size) + ch);
-            gst_tensor_data_raw_typecast (&tmp, _NNS_FLOAT64,
-                (gpointer) (outptr + data_idx), out_info->type);
-          }
-        }
-      }
-      break;
+      if (filter->data_stand.mode == STAND_DEFAULT)
+        orc_func_stand (f64) ((gpointer) outptr, average[0], std[0], num);
+      else
+        orc_func_add (f64) ((gpointer) outptr, -average[0], num);
+      goto done;
     }
-    case STAND_DC_AVERAGE:
-    {
-      if (!filter->data_stand.per_channel) {
-        for (i = 0; i < num; i++) {
-          data_idx = in_element_size * i;
-          gst_tensor_data_raw_typecast ((gpointer) (inptr + data_idx),
-              in_info->type, &tmp, _NNS_FLOAT64);
-
-          tmp -= *average;
-
-          data_idx = out_element_size * i;
-          gst_tensor_data_raw_typecast (&tmp, _NNS_FLOAT64,
-              (gpointer) (outptr + data_idx), out_info->type);
-        }
-      } else {
-        for (ch = 0; ch < ch_size; ++ch) {
-          for (i = 0; i < num / ch_size; i++) {
-            data_idx = in_element_size * ((i * ch_size) + ch);
-            gst_tensor_data_raw_typecast ((gpointer) (inptr + data_idx),
-                in_info->type, &tmp, _NNS_FLOAT64);
-
-            tmp -= average[ch];
+  }
+#endif
 
-            data_idx = out_element_size * ((i * ch_size) + ch);
-            gst_tensor_data_raw_typecast (&tmp, _NNS_FLOAT64,
-                (gpointer) (outptr + data_idx), out_info->type);
-          }
-        }
+  /**
+   * Typecast a chunk of elements at once and standardize it in a single pass.
+   * The channel (the first dim) of the element is the index modulo ch_size.
+   */
+  ch = 0;
+  for (i = 0; i < num; i += n) {
+    n = MIN (TRANSFORM_CHUNK_SIZE, num - i);
+    gst_tensor_transform_load_f64 (chunk, inptr + in_element_size * i,
+        in_info->type, n);
+
+    if (filter->data_stand.mode == STAND_DEFAULT) {
+      for (j = 0; j < n; j++) {
+        chunk[j] = fabs ((chunk[j] - average[ch]) / std[ch]);
+        if (++ch == ch_size)
+          ch = 0;
+      }
+    } else {
+      for (j = 0; j < n; j++) {
+        chunk[j] -= average[ch];
+        if (++ch == ch_size)
+          ch = 0;
       }
-      break;
     }
-    default:
-      GST_ERROR_OBJECT (filter, "Cannot identify mode\n");
-      ret = GST_FLOW_ERROR;
+
+    gst_tensor_transform_store_f64 (outptr + out_element_size * i,
+        out_info->type, chunk, n);
   }
 
+done:
   g_free (average);
   g_free (std);
 
@@ -1651,28 +2060,227 @@ gst_tensor_transform_clamp (GstTensorTransform * filter,
     const uint8_t * inptr, uint8_t * outptr)
 {
   gsize in_element_size, out_element_size;
-  gulong i, num, data_idx;
-  gdouble tmp;
+  gulong i, j, n, num;
+  gdouble min, max;
+  gdouble chunk[TRANSFORM_CHUNK_SIZE];
 
   in_element_size = gst_tensor_get_element_size (in_info->type);
   out_element_size = gst_tensor_get_element_size (out_info->type);
   num = gst_tensor_get_element_count (in_info->dimension);
 
-  for (i = 0; i < num; ++i) {
-    data_idx = in_element_size * i;
-    gst_tensor_data_raw_typecast ((gpointer) (inptr + data_idx), in_info->type,
-        &tmp, _NNS_FLOAT64);
+  min = filter->data_clamp.min;
+  max = filter->data_clamp.max;
 
-    tmp = CLAMP (tmp, filter->data_clamp.min, filter->data_clamp.max);
+#ifdef HAVE_ORC
+  if (orc_supported (filter, in_info->type, out_info->type)) {
+    if (out_info->type == _NNS_FLOAT32) {
+      orc_typecast (inptr, outptr, num, in_info->type, out_info->type);
+      orc_func_clamp (f32) ((gpointer) outptr, (float) min, (float) max, num);
+      return GST_FLOW_OK;
+    } else if (out_info->type == _NNS_FLOAT64) {
+      orc_typecast (inptr, outptr, num, in_info->type, out_info->type);
+      orc_func_clamp (f64) ((gpointer) outptr, min, max, num);
+      return GST_FLOW_OK;
+    }
+  }
+#endif
+
+  for (i = 0; i < num; i += n) {
+    n = MIN (TRANSFORM_CHUNK_SIZE, num - i);
+    gst_tensor_transform_load_f64 (chunk, inptr + in_element_size * i,
+        in_info->type, n);
+
+    for (j = 0; j < n; j++)
+      chunk[j] = CLAMP (chunk[j], min, max);
 
-    data_idx = out_element_size * i;
-    gst_tensor_data_raw_typecast (&tmp, _NNS_FLOAT64, outptr + data_idx,
-        out_info->type);
+    gst_tensor_transform_store_f64 (outptr + out_element_size * i,
+        out_info->type, chunk, n);
   }
 
   return GST_FLOW_OK;
 }
 
+/**
+ * @brief Internal function to run the transform of the mode with a tensor.
+ * @param[in/out] filter "this" pointer
+ * @param[in] in_info input tensor info
+ * @param[in] out_info output tensor info
+ * @param[in] inptr input tensor
+ * @param[out] outptr output tensor
+ * @return Gst flow status
+ */
+static GstFlowReturn
+gst_tensor_transform_process (GstTensorTransform * filter,
+    GstTensorInfo * in_info, GstTensorInfo * out_info,
+    const uint8_t * inptr, uint8_t * outptr)
+{
+  GstFlowReturn res;
+
+  switch (filter->mode) {
+    case GTT_DIMCHG:
+      res = gst_tensor_transform_dimchg (filter, in_info, out_info,
+          inptr, outptr);
+      break;
+    case GTT_TYPECAST:
+      res = gst_tensor_transform_typecast (filter, in_info, out_info,
+          inptr, outptr);
+      break;
+    case GTT_ARITHMETIC:
+      res = gst_tensor_transform_arithmetic (filter, in_info, out_info,
+          inptr, outptr);
+      break;
+    case GTT_TRANSPOSE:
+      res = gst_tensor_transform_transpose (filter, in_info, out_info,
+          inptr, outptr);
+      break;
+    case GTT_STAND:
+      res = gst_tensor_transform_stand (filter, in_info, out_info,
+          inptr, outptr);
+      break;
+    case GTT_CLAMP:
+      res = gst_tensor_transform_clamp (filter, in_info, out_info,
+          inptr, outptr);
+      break;
+    case GTT_PIPELINE:
+      res = gst_tensor_transform_pipeline (filter, in_info, out_info,
+          inptr, outptr);
+      break;
+    default:
+      ml_loge ("Not supported tensor transform mode");
+      res = GST_FLOW_NOT_SUPPORTED;
+      break;
+  }
+
+  return res;
+}
+
+/**
+ * @brief Internal function to run the element-wise stages of "pipeline" mode chunk by chunk.
+ *        The chunks between the stages stay in the cache, so the stages take a single pass.
+ * @param[in/out] filter "this" pointer
+ * @param[in] first index of the first stage
+ * @param[in] num_stages number of the stages
+ * @param[in] info tensor info of the input of each stage and the output of the last stage
+ * @param[in] inptr input tensor
+ * @param[out] outptr output tensor
+ * @return Gst flow status
+ */
+static GstFlowReturn
+gst_tensor_transform_pipeline_fused (GstTensorTransform * filter,
+    guint first, guint num_stages, GstTensorInfo * info,
+    const uint8_t * inptr, uint8_t * outptr)
+{
+  GstFlowReturn res = GST_FLOW_OK;
+  GstTensorTransform *stage;
+  GstTensorInfo chunk_in, chunk_out;
+  gsize in_element_size, out_element_size;
+  gulong num, offset, n;
+  const uint8_t *src;
+  uint8_t *dst, *chunk[2];
+  guint t;
+
+  num = gst_tensor_get_element_count (info[0].dimension);
+  in_element_size = gst_tensor_get_element_size (info[0].type);
+  out_element_size = gst_tensor_get_element_size (info[num_stages].type);
+
+  chunk[0] = (uint8_t *) filter->stage_chunk;
+  chunk[1] = chunk[0] + PIPELINE_CHUNK_SIZE * sizeof (gint64);
+
+  gst_tensor_info_init (&chunk_in);
+  gst_tensor_info_init (&chunk_out);
+
+  for (offset = 0; offset < num && res == GST_FLOW_OK; offset += n) {
+    n = MIN (PIPELINE_CHUNK_SIZE, num - offset);
+    src = inptr + in_element_size * offset;
+
+    for (t = 0; t < num_stages && res == GST_FLOW_OK; t++) {
+      stage = (GstTensorTransform *) g_ptr_array_index (filter->stages,
+          first + t);
+
+      chunk_in.type = info[t].type;
+      chunk_in.dimension[0] = n;
+      chunk_out.type = info[t + 1].type;
+      chunk_out.dimension[0] = n;
+
+      if (t == num_stages - 1)
+        dst = outptr + out_element_size * offset;
+      else
+        dst = chunk[t % 2];
+
+      res = gst_tensor_transform_process (stage, &chunk_in, &chunk_out,
+          src, dst);
+      src = dst;
+    }
+  }
+
+  return res;
+}
+
+/**
+ * @brief subrouting for tensor-tranform, "pipeline" case.
+ *        Consecutive element-wise stages (typecast, clamp and arithmetic without per-channel option) are fused in a pass,
+ *        and the other stages run with the intermediate tensors allocated once.
+ * @param[in/out] filter "this" pointer
+ * @param[in] in_info input tensor info
+ * @param[in] out_info output tensor info
+ * @param[in] inptr input tensor
+ * @param[out] outptr output tensor
+ * @return Gst flow status
+ */
+static GstFlowReturn
+gst_tensor_transform_pipeline (GstTensorTransform * filter,
+    GstTensorInfo * in_info, GstTensorInfo * out_info,
+    const uint8_t * inptr, uint8_t * outptr)
+{
+  GstFlowReturn res = GST_FLOW_OK;
+  GstTensorTransform *stage;
+  GstTensorInfo info[PIPELINE_STAGE_LIMIT + 1];
+  const uint8_t *src;
+  uint8_t *dst;
+  gsize size;
+  guint s, e, num, k;
+  UNUSED (out_info);
+
+  g_return_val_if_fail (filter->stages != NULL, GST_FLOW_ERROR);
+  num = filter->stages->len;
+
+  if (!gst_tensor_transform_get_stage_info (filter, in_info, info, &size) ||
+      !gst_tensor_transform_alloc_stage_buf (filter, size))
+    return GST_FLOW_ERROR;
+
+  src = inptr;
+  k = 0;
+
+  for (s = 0; s < num && res == GST_FLOW_OK; s = e) {
+    stage = (GstTensorTransform *) g_ptr_array_index (filter->stages, s);
+    e = s + 1;
+
+    if (pipeline_stage_is_elementwise (stage)) {
+      while (e < num && pipeline_stage_is_elementwise ((GstTensorTransform *)
+              g_ptr_array_index (filter->stages, e)))
+        e++;
+    }
+
+    /* the last stage writes the output tensor, others write the intermediate tensors in turn. */
+    if (e == num) {
+      dst = outptr;
+    } else {
+      dst = (uint8_t *) filter->stage_buf[k];
+      k ^= 1;
+    }
+
+    if (e - s > 1)
+      res = gst_tensor_transform_pipeline_fused (filter, s, e - s, &info[s],
+          src, dst);
+    else
+      res = gst_tensor_transform_process (stage, &info[s], &info[e], src, dst);
+
+    src = dst;
+  }
+
+  return res;
+}
+
 /**
  * @brief non-ip transform. required vmethod for BaseTransform class.
  * @param[in/out] trans "super" pointer
@@ -1786,36 +2394,10 @@ gst_tensor_transform_transform (GstBaseTransform * trans,
       outptr += hsize;
     }
 
-    switch (filter->mode) {
-      case GTT_DIMCHG:
-        res = gst_tensor_transform_dimchg (filter, in_info, out_info,
-            inptr, outptr);
-        break;
-      case GTT_TYPECAST:
-        res = gst_tensor_transform_typecast (filter, in_info, out_info,
-            inptr, outptr);
-        break;
-      case GTT_ARITHMETIC:
-        res = gst_tensor_transform_arithmetic (filter, in_info, out_info,
-            inptr, outptr);
-        break;
-      case GTT_TRANSPOSE:
-        res = gst_tensor_transform_transpose (filter, in_info, out_info,
-            inptr, outptr);
-        break;
-      case GTT_STAND:
-        res = gst_tensor_transform_stand (filter, in_info, out_info,
-            inptr, outptr);
-        break;
-      case GTT_CLAMP:
-        res = gst_tensor_transform_clamp (filter, in_info, out_info,
-            inptr, outptr);
-        break;
-      default:
-        ml_loge ("Not supported tensor transform mode");
-        res = GST_FLOW_NOT_SUPPORTED;
-        goto done;
-    }
+    res = gst_tensor_transform_process (filter, in_info, out_info,
+        inptr, outptr);
+    if (res != GST_FLOW_OK)
+      goto done;
   }
 
 done:
@@ -1967,6 +2549,37 @@ gst_tensor_transform_convert_dimension (GstTensorTransform * filter,
       /* same tensors info, do nothing. */
       break;
 
+    case GTT_PIPELINE:
+    {
+      GstTensorTransform *stage;
+      GstTensorInfo cur, next;
+      guint num;
+
+      if (filter->stages == NULL)
+        return FALSE;
+
+      /* convert the info stage by stage, in reverse order for src pad */
+      cur = *in_info;
+      cur.name = NULL;
+      num = filter->stages->len;
+
+      for (i = 0; i < num; i++) {
+        stage = (GstTensorTransform *) g_ptr_array_index (filter->stages,
+            (direction == GST_PAD_SINK) ? i : (num - 1 - i));
+
+        if (!gst_tensor_transform_convert_dimension (stage, direction, idx,
+                &cur, &next))
+          return FALSE;
+
+        cur = next;
+      }
+
+      out_info->type = cur.type;
+      for (i = 0; i < NNS_TENSOR_RANK_LIMIT; i++)
+        out_info->dimension[i] = cur.dimension[i];
+      break;
+    }
+
     default:
       return FALSE;
   }
@@ -2167,6 +2780,21 @@ gst_tensor_transform_set_caps (GstBaseTransform * trans,
     goto error;
   }
 
+  /* prepare the intermediate tensors of the stages once */
+  if (filter->mode == GTT_PIPELINE && !in_flexible) {
+    GstTensorInfo info[PIPELINE_STAGE_LIMIT + 1];
+    gsize size;
+
+    for (i = 0; i < in_config.info.num_tensors; i++) {
+      if (!gst_tensor_transform_get_stage_info (filter,
+              &in_config.info.info[i], info, &size) ||
+          !gst_tensor_transform_alloc_stage_buf (filter, size)) {
+        GST_ERROR_OBJECT (filter, "Failed to plan the stages of pipeline.");
+        goto error;
+      }
+    }
+  }
+
   /* set in/out tensor info */
   filter->in_config = in_config;
   filter->out_config = out_config;
@@ -62,6 +62,7 @@ typedef enum _tensor_transform_mode
   GTT_TRANSPOSE,      /* Transpose. "transpose" */
   GTT_STAND,          /* Standardization. "stand" */
   GTT_CLAMP,          /* Clamp, "clamp" */
+  GTT_PIPELINE,       /* Sequence of the modes, "pipeline" */
 
   GTT_UNKNOWN = -1,   /* Unknown/Not-implemented-yet Mode. "unknown" */
 } tensor_transform_mode;
@@ -165,6 +166,11 @@ struct _GstTensorTransform
   GstTensorsConfig in_config; /**< input tensors config */
   GstTensorsConfig out_config; /**< output tensors config */
   GList *apply; /**< Select the tensors to apply transformation */
+
+  GPtrArray *stages; /**< tensor_transform instances of each stage in "pipeline" mode */
+  gpointer stage_buf[2]; /**< intermediate tensors between the stages in "pipeline" mode */
+  gsize stage_buf_size; /**< allocated size of each intermediate tensor */
+  gpointer stage_chunk; /**< chunks of the fused element-wise stages in "pipeline" mode */
 };
 
 /**
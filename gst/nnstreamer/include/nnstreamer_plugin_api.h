@@ -97,10 +97,22 @@ gst_tensor_meta_info_parse_memory (GstTensorMetaInfo * meta, GstMemory * mem);
  * @param[in] meta tensor meta structure
  * @param[in] mem pointer to GstMemory
  * @return Newly allocated GstMemory (Caller should free returned memory using gst_memory_unref())
+ * @note If the same header is reserved in front of the data (see gst_tensor_meta_info_reserve_header()), this returns the shared memory without copying the data.
  */
 extern GstMemory *
 gst_tensor_meta_info_append_header (GstTensorMetaInfo * meta, GstMemory * mem);
 
+/**
+ * @brief Reserve the header of flexible tensor in front of the tensor data.
+ * @details The header is written at the head of given memory, then the memory is resized to the tensor data.
+ * Converting the memory to flexible tensor with gst_tensor_meta_info_append_header() costs the header size only.
+ * @param[in] meta tensor meta structure
+ * @param[in] mem pointer to GstMemory (writable) of the header size plus the data size
+ * @return TRUE if successfully reserved the header
+ */
+extern gboolean
+gst_tensor_meta_info_reserve_header (GstTensorMetaInfo * meta, GstMemory * mem);
+
 /**
  * @brief Update caps dimension for negotiation
  * @param caps caps to compare and update
@@ -162,6 +162,7 @@ typedef struct _GstTensorFilterProperties
   int latency; /**< The average latency over the recent 10 inferences in microseconds */
   int throughput; /**< The average throughput in the number of outputs per second */
   int invoke_dynamic; /**< True for supporting invoke with flexible output. */
+  unsigned int batch_size; /**< The number of frames packed along the outermost dimension of each input/output tensor in the current invoke. It is always 1 unless the framework advertises max_batch_size in GstTensorFilterFrameworkInfo and batch-size property of tensor_filter is given. */
 } GstTensorFilterProperties;
 
 /**
@@ -192,6 +193,7 @@ typedef struct _GstTensorFilterFrameworkInfo
   accl_hw accl_auto;  /**< accelerator to be used in auto mode (acceleration to be used but accelerator is not specified for the filter) - default -1 implies use first entry from hw_list */
   accl_hw accl_default;   /**< accelerator to be used by default (valid user input is not provided) - default -1 implies use first entry from hw_list*/
   const GstTensorFilterFrameworkStatistics *statistics;  /**< usage statistics by the framework. This is shared across all opened instances of this framework */
+  int max_batch_size; /**< The maximum number of frames that invoke can process at once. If this is larger than 1, tensor_filter may pack up to this number of frames into the memory of each tensor (prop->batch_size tells the number of packed frames) while the tensor info still describes a single frame. 0 or 1 if batched invoke is not supported. */
 } GstTensorFilterFrameworkInfo;
 
 /**
@@ -487,6 +489,23 @@ struct _GstTensorFilterFramework
        * @return 0 if OK. non-zero if error. -ENOENT if operation is not supported. -EINVAL if operation is supported but provided arguments are invalid.
        */
       void *subplugin_data; /**< This is used by tensor_filter infrastructure. Subplugin authors should NEVER update this. Only the files in /gst/nnstreamer/tensor_filter/ are allowed to access this. */
+
+      int (*invoke_async) (const GstTensorFilterFramework * self,
+          GstTensorFilterProperties * prop, void *private_data,
+          const GstTensorMemory * input, GstTensorMemory * output,
+          void (*done) (void *user_data, int status), void *user_data);
+      /**< Optional. Starts the inference and returns without waiting for the result. tensor_filter calls this instead of invoke only if the property max-inflight is set, and it may start up to max-inflight requests before the first one is done.
+       * The subplugin should call done (user_data, status) exactly once for each accepted request when the output is filled, from any thread. The status has the same meaning as the return value of invoke. The input and output memory are valid until done is called.
+       * If this callback is NULL, tensor_filter calls invoke in its worker thread.
+       *
+       * @param[in] prop read-only property values
+       * @param[in/out] private_data A subplugin may save its internal private data here.
+       * @param[in] input The array of input tensors. Each tensor size = prop->input_meta.info[i] size
+       * @param[out] output The array of output tensors. Each tensor size = prop->output_meta.info[i] size
+       * @param[in] done The callback to notify that the request is finished.
+       * @param[in] user_data The data to be passed to the callback done.
+       * @return 0 if the request is accepted. Other values if error, then done is not called.
+       */
     }
 #ifdef NO_ANONYMOUS_NESTED_STRUCT
         v1
@@ -616,6 +635,78 @@ extern void
 nnstreamer_filter_shared_model_replace (void *instance, const char *key,
     void *new_interpreter, void (*replace_callback) (void *, void *), void (*free_callback) (void*));
 
+/* extern functions for shared model representation */
+/**
+ * @brief Insert the pool of model representations loaded from the same model and get the first one.
+ *        The instances sharing the key acquire an interpreter from the pool for each invoke, so they can run in parallel.
+ * @param[in] instance The instance that is sharing the model representation. It will be registered at the referred list.
+ * @param[in] key The key for shared model.
+ * @param[in] interpreters The array of interpreters to be shared. The pool keeps the interpreters, not the array.
+ * @param[in] num_interpreters The number of interpreters.
+ * @param[in] free_callback The callback function to destroy the interpreter in the pool.
+ * @return The first model interpreter inserted. NULL if it is already inserted.
+ */
+extern void *
+nnstreamer_filter_shared_model_insert_pool_and_get (void *instance, char *key,
+    void **interpreters, unsigned int num_interpreters, void (*free_callback) (void *));
+
+/* extern functions for shared model representation */
+/**
+ * @brief Get the pool of the shared model representation.
+ * @param[in] key The key to find the shared model.
+ * @return The pool handle, which is valid until the instance is removed from the referred list. NULL if the key does not have a pool.
+ */
+extern void *
+nnstreamer_filter_shared_model_get_pool (const char *key);
+
+/* extern functions for shared model representation */
+/**
+ * @brief Acquire an interpreter from the pool. This waits until an interpreter is released if all interpreters are in use.
+ * @param[in] pool The pool handle.
+ * @param[out] handle The handle to release the interpreter.
+ * @return The model interpreter. NULL if the arguments are invalid.
+ */
+extern void *
+nnstreamer_filter_shared_model_pool_acquire (void *pool, void **handle);
+
+/* extern functions for shared model representation */
+/**
+ * @brief Release the interpreter acquired from the pool.
+ * @param[in] pool The pool handle.
+ * @param[in] handle The handle given by nnstreamer_filter_shared_model_pool_acquire().
+ */
+extern void
+nnstreamer_filter_shared_model_pool_release (void *pool, void *handle);
+
+/* extern functions for shared model representation */
+/**
+ * @brief Call the function for each interpreter in the pool (e.g., to update the tensor info).
+ * @param[in] pool The pool handle.
+ * @param[in] func The function to be called. Stop iterating if it returns non-zero.
+ * @param[in] user_data The data to be passed to the function.
+ * @return 0 if OK. The return value of func if it fails.
+ */
+extern int
+nnstreamer_filter_shared_model_pool_foreach (void *pool,
+    int (*func) (void *interpreter, void *user_data), void *user_data);
+
+/* extern functions for shared model representation */
+/**
+ * @brief Replace the whole pool atomically with the new interpreters.
+ *        `replace_callback` is called iterating instances in referred list with the first new interpreter.
+ *        The old interpreters are destroyed with the free callback of the pool when they are released.
+ * @param[in] instance The instance that is sharing the model representation.
+ * @param[in] key The key to find the shared model.
+ * @param[in] new_interpreters The array of new interpreters.
+ * @param[in] num_interpreters The number of new interpreters.
+ * @param[in] replace_callback The callback function to replace with new interpreter.
+ * @return TRUE if the pool is replaced. FALSE if failed to replace it.
+ */
+extern int
+nnstreamer_filter_shared_model_pool_replace (void *instance, const char *key,
+    void **new_interpreters, unsigned int num_interpreters,
+    void (*replace_callback) (void *, void *));
+
 #ifdef __cplusplus
 }
 #endif
@@ -63,6 +63,22 @@ extern int NNS_custom_easy_register (const char * modelname,
     NNS_custom_invoke func, void *data,
     const GstTensorsInfo * in_info, const GstTensorsInfo * out_info);
 
+/**
+ * @brief Register the custom-easy tensor function, which processes multiple frames in a single call (micro-batching of tensor_filter).
+ * @param[in] modelname The name of custom-easy tensor function.
+ * @param[in] func The tensor function body
+ * @param[in/out] private_data The internal data for the function
+ * @param[in] in_info Input tensor metadata of a single frame.
+ * @param[in] out_info Output tensor metadata of a single frame.
+ * @param[in] max_batch_size The maximum number of frames func processes at once. It should be larger than 0.
+ * @note With batch-size property of tensor_filter, up to max_batch_size frames are packed along the outermost dimension of each input and output tensor.
+ *       prop->batch_size tells the number of frames in the current call, and the size of each tensor memory is that of a single frame times prop->batch_size.
+ */
+extern int NNS_custom_easy_batch_register (const char * modelname,
+    NNS_custom_invoke func, void *data,
+    const GstTensorsInfo * in_info, const GstTensorsInfo * out_info,
+    int max_batch_size);
+
 /**
  * @brief Invoke the "main function" with flexible input and output. Output tensor memory should be allocated.
  * @param[in/out] private_data A subplugin may save its internal private data here. The subplugin is responsible for alloc/free of this pointer.
@@ -0,0 +1,95 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file    nnstreamer_edge_data.h
+ * @date    16 Oct 2026
+ * @brief   Internal util to wrap the received nnstreamer-edge data in a buffer.
+ * @see     http://github.com/nnstreamer/nnstreamer
+ * @bug     No known bugs except for NYI items
+ *
+ * This is shared by the edge plugin (edgesrc) and the tensor_query elements.
+ * The edge plugin does not link libnnstreamer, so the helper is in this header.
+ */
+
+#ifndef __NNSTREAMER_EDGE_DATA_H__
+#define __NNSTREAMER_EDGE_DATA_H__
+
+#include <glib.h>
+#include <gst/gst.h>
+#include <nnstreamer-edge.h>
+#include "nnstreamer_log.h"
+
+G_BEGIN_DECLS
+
+/**
+ * @brief Edge data shared by the memories of a received buffer.
+ */
+typedef struct
+{
+  nns_edge_data_h data_h; /**< received edge data */
+  gint refcount; /**< number of references (memories and the caller) */
+} GstEdgeDataRef;
+
+/**
+ * @brief Release a reference of the edge data, and destroy it with the last one.
+ */
+static inline void
+gst_edge_data_ref_unref (gpointer user_data)
+{
+  GstEdgeDataRef *edata = (GstEdgeDataRef *) user_data;
+
+  if (g_atomic_int_dec_and_test (&edata->refcount)) {
+    nns_edge_data_destroy (edata->data_h);
+    g_free (edata);
+  }
+}
+
+/**
+ * @brief Create a buffer wrapping the memories of the received edge data without copying.
+ * @param data_h The edge data. The buffer takes the ownership, the edge data is destroyed when all memories are released (or on failure).
+ * @return Newly created buffer, NULL on failure.
+ */
+static inline GstBuffer *
+gst_edge_data_to_buffer (nns_edge_data_h data_h)
+{
+  GstEdgeDataRef *edata;
+  GstBuffer *buffer;
+  guint i, num_data;
+  int ret;
+
+  ret = nns_edge_data_get_count (data_h, &num_data);
+  if (ret != NNS_EDGE_ERROR_NONE || num_data == 0) {
+    nns_loge ("Failed to get the number of memories of the edge data.");
+    nns_edge_data_destroy (data_h);
+    return NULL;
+  }
+
+  edata = g_new0 (GstEdgeDataRef, 1);
+  edata->data_h = data_h;
+  edata->refcount = 1;
+
+  buffer = gst_buffer_new ();
+  for (i = 0; i < num_data; i++) {
+    void *data = NULL;
+    nns_size_t data_len = 0;
+
+    if (NNS_EDGE_ERROR_NONE != nns_edge_data_get (data_h, i, &data, &data_len)) {
+      nns_loge ("Failed to get the %uth memory of the edge data.", i);
+      gst_buffer_unref (buffer);
+      buffer = NULL;
+      break;
+    }
+
+    g_atomic_int_inc (&edata->refcount);
+    gst_buffer_append_memory (buffer,
+        gst_memory_new_wrapped (0, data, data_len, 0, data_len, edata,
+            gst_edge_data_ref_unref));
+  }
+
+  gst_edge_data_ref_unref (edata);
+  return buffer;
+}
+
+G_END_DECLS
+#endif /* __NNSTREAMER_EDGE_DATA_H__ */
@@ -92,6 +92,85 @@ gst_tensor_extra_info_init (GstTensorExtraInfo * extra, gsize reserved_size)
   }
 }
 
+/**
+ * @brief Check if the extra memory can be expanded in place.
+ * @param[in] mem The extra memory in the buffer.
+ * @param[in] size The new size of the extra memory.
+ * @return TRUE if only the buffer holds @a mem and it has enough room for @a size.
+ */
+static gboolean
+gst_tensor_extra_memory_can_grow (GstMemory * mem, gsize size)
+{
+  gsize offset, maxsize;
+
+  if (GST_MINI_OBJECT_REFCOUNT_VALUE (mem) != 1 ||
+      !gst_memory_is_writable (mem))
+    return FALSE;
+
+  gst_memory_get_sizes (mem, &offset, &maxsize);
+  return (offset + size <= maxsize);
+}
+
+/**
+ * @brief Data structure for the offsets of extra tensors, cached in the extra memory.
+ */
+typedef struct
+{
+  uint64_t reserved; /**< reserved size of the extra memory, to validate the cache */
+  guint num_offsets; /**< the number of calculated offsets */
+  gsize offsets[NNS_TENSOR_SIZE_EXTRA_LIMIT]; /**< offset of each extra tensor in the extra memory */
+} GstTensorExtraOffsets;
+
+G_DEFINE_QUARK (gst-tensor-extra-offsets, gst_tensor_extra_offsets)
+G_LOCK_DEFINE_STATIC (extra_offsets);
+
+/**
+ * @brief Get the offset of the extra tensor in the extra memory.
+ * @details The offsets are calculated once and cached in the extra memory.
+ * Appending a tensor does not change the offsets of previous tensors, so getting the nth tensor costs constant time.
+ * @param[in] mem The extra memory.
+ * @param[in] extra GstTensorExtraInfo of the extra memory.
+ * @param[in] index The index of extra tensor (less than num_extra_tensors).
+ * @return The offset of the extra tensor.
+ */
+static gsize
+gst_tensor_extra_get_offset (GstMemory * mem, GstTensorExtraInfo * extra,
+    guint index)
+{
+  GstTensorExtraOffsets *cache;
+  gsize offset;
+  guint i;
+
+  G_LOCK (extra_offsets);
+
+  cache = (GstTensorExtraOffsets *) gst_mini_object_get_qdata
+      (GST_MINI_OBJECT_CAST (mem), gst_tensor_extra_offsets_quark ());
+  if (!cache) {
+    cache = g_new0 (GstTensorExtraOffsets, 1);
+    gst_mini_object_set_qdata (GST_MINI_OBJECT_CAST (mem),
+        gst_tensor_extra_offsets_quark (), cache, g_free);
+  }
+
+  if (cache->reserved != extra->reserved) {
+    cache->reserved = extra->reserved;
+    cache->num_offsets = 0;
+  }
+
+  for (i = cache->num_offsets; i <= index; i++) {
+    if (i == 0)
+      cache->offsets[i] = sizeof (GstTensorExtraInfo) + extra->reserved;
+    else
+      cache->offsets[i] = cache->offsets[i - 1] +
+          gst_tensor_info_get_size (&extra->infos[i - 1]);
+  }
+
+  cache->num_offsets = MAX (cache->num_offsets, index + 1);
+  offset = cache->offsets[index];
+
+  G_UNLOCK (extra_offsets);
+  return offset;
+}
+
 /**
  * @brief Get the corresponding mode from the string value.
  * @param[in] str The string value for the mode.
@@ -1489,6 +1568,86 @@ gst_tensor_meta_info_parse_memory (GstTensorMetaInfo * meta, GstMemory * mem)
   return ret;
 }
 
+/**
+ * @brief Reserve the header of flexible tensor in front of the tensor data.
+ * @param[in] meta tensor meta structure
+ * @param[in] mem pointer to GstMemory (writable) of the header size plus the data size
+ * @return TRUE if successfully reserved the header
+ */
+gboolean
+gst_tensor_meta_info_reserve_header (GstTensorMetaInfo * meta, GstMemory * mem)
+{
+  GstMapInfo map;
+  gsize hsize;
+
+  g_return_val_if_fail (mem != NULL, FALSE);
+  g_return_val_if_fail (gst_tensor_meta_info_validate (meta), FALSE);
+
+  hsize = gst_tensor_meta_info_get_header_size (meta);
+  if (gst_memory_get_sizes (mem, NULL, NULL) < hsize)
+    return FALSE;
+
+  if (!gst_memory_map (mem, &map, GST_MAP_WRITE)) {
+    nns_loge ("Failed to reserve header, cannot map the memory.");
+    return FALSE;
+  }
+
+  gst_tensor_meta_info_update_header (meta, map.data);
+  gst_memory_unmap (mem, &map);
+
+  /* the memory now starts from the tensor data, the header remains in the prefix. */
+  gst_memory_resize (mem, hsize, map.size - hsize);
+  return TRUE;
+}
+
+/**
+ * @brief Internal function to get the flexible tensor from the memory with the reserved header.
+ * @return Shared memory including the header, or NULL if the header is not reserved in front of the data.
+ */
+static GstMemory *
+_gst_tensor_meta_info_share_reserved_header (GstTensorMetaInfo * meta,
+    GstMemory * mem, gsize hsize)
+{
+  GstMemory *shared;
+  GstMapInfo map;
+  gpointer header;
+  gsize offset, size;
+  gboolean reserved;
+
+  /* sysmem can be shared with negative offset, inside of its maxsize. */
+  if (!gst_memory_is_type (mem, GST_ALLOCATOR_SYSMEM) ||
+      GST_MEMORY_FLAG_IS_SET (mem, GST_MEMORY_FLAG_NO_SHARE))
+    return NULL;
+
+  size = gst_memory_get_sizes (mem, &offset, NULL);
+  if (offset < hsize)
+    return NULL;
+
+  shared = gst_memory_share (mem, -((gssize) hsize), hsize + size);
+  if (!shared)
+    return NULL;
+
+  if (!gst_memory_map (shared, &map, GST_MAP_READ)) {
+    gst_memory_unref (shared);
+    return NULL;
+  }
+
+  /* the prefix may be other data, compare it with the header to be appended. */
+  header = g_malloc0 (hsize);
+  gst_tensor_meta_info_update_header (meta, header);
+  reserved = (memcmp (map.data, header, hsize) == 0);
+  g_free (header);
+
+  gst_memory_unmap (shared, &map);
+
+  if (!reserved) {
+    gst_memory_unref (shared);
+    shared = NULL;
+  }
+
+  return shared;
+}
+
 /**
  * @brief Append header to memory.
  * @param[in] meta tensor meta structure
@@ -1505,13 +1664,19 @@ gst_tensor_meta_info_append_header (GstTensorMetaInfo * meta, GstMemory * mem)
   g_return_val_if_fail (mem != NULL, NULL);
   g_return_val_if_fail (gst_tensor_meta_info_validate (meta), NULL);
 
+  hsize = gst_tensor_meta_info_get_header_size (meta);
+
+  /* no copy if the header is reserved (see gst_tensor_meta_info_reserve_header()) */
+  new_mem = _gst_tensor_meta_info_share_reserved_header (meta, mem, hsize);
+  if (new_mem)
+    return new_mem;
+
   if (!gst_memory_map (mem, &old_map, GST_MAP_READ)) {
     nns_loge ("Failed to append header, cannot map the old memory.");
     return NULL;
   }
 
   /* memory size (header + old memory) */
-  hsize = gst_tensor_meta_info_get_header_size (meta);
   msize = hsize + old_map.size;
 
   new_mem = gst_allocator_alloc (NULL, msize, NULL);
@@ -1540,7 +1705,8 @@ gst_tensor_meta_info_append_header (GstTensorMetaInfo * meta, GstMemory * mem)
 GstMemory *
 gst_tensor_buffer_get_nth_memory (GstBuffer * buffer, const guint index)
 {
-  guint i, num_tensors, offset = 0;
+  guint num_tensors;
+  gsize offset;
   GstMemory *extra_tensors_memory, *res_mem = NULL;
   GstMapInfo extra_tensors_map;
   GstTensorExtraInfo *extra_info;
@@ -1592,11 +1758,8 @@ gst_tensor_buffer_get_nth_memory (GstBuffer * buffer, const guint index)
     goto done;
   }
 
-  offset += extra_info->reserved;
-
-  for (i = 1; i <= index - NNS_TENSOR_SIZE_LIMIT; ++i) {
-    offset += gst_tensor_info_get_size (&extra_info->infos[i - 1]);
-  }
+  offset = gst_tensor_extra_get_offset (extra_tensors_memory, extra_info,
+      index - NNS_TENSOR_SIZE_LIMIT);
 
   /* wrap it as GstMemory */
   res_mem =
@@ -1627,6 +1790,7 @@ gst_tensor_buffer_append_memory (GstBuffer * buffer, GstMemory * memory,
   GstTensorExtraInfo *extra_info;
   GstTensorMetaInfo meta;
   gboolean is_extra, is_static;
+  gboolean in_place = FALSE;
   gboolean appended = FALSE;
 
   if (!GST_IS_BUFFER (buffer)) {
@@ -1673,27 +1837,72 @@ gst_tensor_buffer_append_memory (GstBuffer * buffer, GstMemory * memory,
     goto failed;
   }
 
-  new_mem_size = last_mem_size = gst_memory_get_sizes (last_memory, NULL, NULL);
+  last_mem_size = last_memory_map.size;
 
   /* if the memory does not have proper header, append it */
   is_extra = gst_memory_map_is_extra_tensor (&last_memory_map);
-  if (!is_extra) {
-    new_mem_size += sizeof (GstTensorExtraInfo);
+  if (is_extra) {
+    extra_info = (GstTensorExtraInfo *) last_memory_map.data;
+    new_mem_index = extra_info->num_extra_tensors;
+  } else {
+    new_mem_index = 0;
   }
 
-  new_mem_size += gst_memory_get_sizes (memory, NULL, NULL);
+  gst_memory_unmap (last_memory, &last_memory_map);
+  last_memory = NULL;
 
-  new_memory = gst_allocator_alloc (NULL, new_mem_size, NULL);
-  if (!new_memory) {
-    nns_loge ("Failed to allocate memory for extra tensors.");
+  if (new_mem_index >= NNS_TENSOR_SIZE_EXTRA_LIMIT) {
+    nns_loge ("Failed to append memory, the buffer already has %d tensors.",
+        NNS_TENSOR_SIZE_LIMIT + NNS_TENSOR_SIZE_EXTRA_LIMIT);
     goto failed;
   }
 
-  if (!gst_memory_map (new_memory, &new_memory_map, GST_MAP_WRITE)) {
-    nns_loge ("Failed to map extra memory");
-    gst_memory_unref (new_memory);
-    new_memory = NULL;
-    goto failed;
+  /* memory size (header + last memory + incoming memory) */
+  offset = is_extra ? 0 : sizeof (GstTensorExtraInfo);
+  new_mem_size = offset + last_mem_size + gst_memory_get_sizes (memory, NULL,
+      NULL);
+
+  new_memory = gst_buffer_peek_memory (buffer, num_mems - 1);
+  if (is_extra && gst_tensor_extra_memory_can_grow (new_memory, new_mem_size)) {
+    /* append incoming memory in place, the extra memory has spare room */
+    in_place = TRUE;
+    gst_memory_ref (new_memory);
+    gst_memory_resize (new_memory, 0, new_mem_size);
+
+    if (!gst_memory_map (new_memory, &new_memory_map, GST_MAP_WRITE)) {
+      nns_loge ("Failed to map extra memory");
+      gst_memory_resize (new_memory, 0, last_mem_size);
+      gst_memory_unref (new_memory);
+      new_memory = NULL;
+      goto failed;
+    }
+  } else {
+    /**
+     * Allocate the extra memory with spare room, so that appending next
+     * tensors does not copy the extra tensors again (amortized linear time).
+     */
+    last_memory = new_memory;
+    if (!gst_memory_map (last_memory, &last_memory_map, GST_MAP_READ)) {
+      nns_loge ("Failed to map last memory");
+      last_memory = new_memory = NULL;
+      goto failed;
+    }
+
+    new_memory = gst_allocator_alloc (NULL, new_mem_size + new_mem_size / 2,
+        NULL);
+    if (!new_memory) {
+      nns_loge ("Failed to allocate memory for extra tensors.");
+      goto failed;
+    }
+
+    gst_memory_resize (new_memory, 0, new_mem_size);
+
+    if (!gst_memory_map (new_memory, &new_memory_map, GST_MAP_WRITE)) {
+      nns_loge ("Failed to map extra memory");
+      gst_memory_unref (new_memory);
+      new_memory = NULL;
+      goto failed;
+    }
   }
 
   if (!gst_memory_map (memory, &incoming_memory_map, GST_MAP_READ)) {
@@ -1703,21 +1912,20 @@ gst_tensor_buffer_append_memory (GstBuffer * buffer, GstMemory * memory,
 
   extra_info = (GstTensorExtraInfo *) new_memory_map.data;
 
-  /* if the last_memory does not have proper header, append it */
-  if (!is_extra) {
-    gst_tensor_extra_info_init (extra_info, last_mem_size);
-    offset = sizeof (GstTensorExtraInfo);
-  } else {
-    offset = 0;
-  }
+  if (!in_place) {
+    /* if the last_memory does not have proper header, append it */
+    if (!is_extra)
+      gst_tensor_extra_info_init (extra_info, last_mem_size);
+
+    /* copy last_memory into new_memory */
+    memcpy (new_memory_map.data + offset, last_memory_map.data, last_mem_size);
 
-  /* copy last_memory into new_memory */
-  memcpy (new_memory_map.data + offset, last_memory_map.data,
-      last_memory_map.size);
+    gst_memory_unmap (last_memory, &last_memory_map);
+    last_memory = NULL;
+  }
 
   /* copy incoming_memory into new_memory */
-  new_mem_index = extra_info->num_extra_tensors;
-  extra_info->num_extra_tensors += 1;
+  extra_info->num_extra_tensors = new_mem_index + 1;
 
   /* Copy tensor info into extra. */
   if (is_static) {
@@ -1726,19 +1934,27 @@ gst_tensor_buffer_append_memory (GstBuffer * buffer, GstMemory * memory,
     gst_tensor_meta_info_convert (&meta, &extra_info->infos[new_mem_index]);
   }
 
-  memcpy (new_memory_map.data + offset + last_memory_map.size,
+  memcpy (new_memory_map.data + offset + last_mem_size,
       incoming_memory_map.data, incoming_memory_map.size);
 
   gst_memory_unmap (memory, &incoming_memory_map);
 
-  gst_buffer_replace_memory (buffer, num_mems - 1, new_memory);
+  gst_memory_unmap (new_memory, &new_memory_map);
+
+  if (!in_place)
+    gst_buffer_replace_memory (buffer, num_mems - 1, new_memory);
+  else
+    gst_memory_unref (new_memory);
+
+  new_memory = NULL;
   appended = TRUE;
 
 failed:
   if (new_memory) {
     gst_memory_unmap (new_memory, &new_memory_map);
-    if (!appended)
-      gst_memory_unref (new_memory);
+    if (in_place)
+      gst_memory_resize (new_memory, 0, last_mem_size);
+    gst_memory_unref (new_memory);
   }
 
   if (last_memory)
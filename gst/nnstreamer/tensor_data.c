@@ -303,6 +303,93 @@ gst_tensor_data_raw_typecast (gpointer input, tensor_type in_type,
   return TRUE;
 }
 
+/**
+ * @brief Macro to accumulate the (squared) deviation of strided elements with given type.
+ */
+#define td_raw_deviation(raw,dtype,start,stride,num,average,squared,sum) do { \
+    const dtype *_data = ((const dtype *) (raw)) + (start); \
+    gulong _i; \
+    gdouble _v; \
+    if (squared) { \
+      for (_i = 0; _i < (num); ++_i) { \
+        _v = (gdouble) _data[_i * (stride)] - (average); \
+        (sum) += _v * _v; \
+      } \
+    } else { \
+      for (_i = 0; _i < (num); ++_i) { \
+        (sum) += (gdouble) _data[_i * (stride)] - (average); \
+      } \
+    } \
+  } while (0)
+
+/**
+ * @brief Internal function to get the sum of the (squared) deviation of strided elements.
+ * @param raw pointer of raw tensor data
+ * @param type tensor type
+ * @param start index of the first element
+ * @param stride distance between the elements
+ * @param num number of the elements
+ * @param average the value subtracted from each element
+ * @param squared TRUE to accumulate the squared deviation
+ * @return sum of the deviation
+ */
+static gdouble
+_gst_tensor_data_raw_deviation (gpointer raw, tensor_type type, gulong start,
+    gulong stride, gulong num, gdouble average, gboolean squared)
+{
+  gdouble value, sum = 0.0;
+  gsize element_size;
+  gulong i;
+
+  /* typed loops avoid the typecast of each element and can be vectorized */
+  switch (type) {
+    case _NNS_INT32:
+      td_raw_deviation (raw, int32_t, start, stride, num, average, squared, sum);
+      break;
+    case _NNS_UINT32:
+      td_raw_deviation (raw, uint32_t, start, stride, num, average, squared,
+          sum);
+      break;
+    case _NNS_INT16:
+      td_raw_deviation (raw, int16_t, start, stride, num, average, squared, sum);
+      break;
+    case _NNS_UINT16:
+      td_raw_deviation (raw, uint16_t, start, stride, num, average, squared,
+          sum);
+      break;
+    case _NNS_INT8:
+      td_raw_deviation (raw, int8_t, start, stride, num, average, squared, sum);
+      break;
+    case _NNS_UINT8:
+      td_raw_deviation (raw, uint8_t, start, stride, num, average, squared, sum);
+      break;
+    case _NNS_FLOAT64:
+      td_raw_deviation (raw, double, start, stride, num, average, squared, sum);
+      break;
+    case _NNS_FLOAT32:
+      td_raw_deviation (raw, float, start, stride, num, average, squared, sum);
+      break;
+    case _NNS_INT64:
+      td_raw_deviation (raw, int64_t, start, stride, num, average, squared, sum);
+      break;
+    case _NNS_UINT64:
+      td_raw_deviation (raw, uint64_t, start, stride, num, average, squared,
+          sum);
+      break;
+    default:
+      element_size = gst_tensor_get_element_size (type);
+      for (i = 0; i < num; ++i) {
+        gst_tensor_data_raw_typecast ((guint8 *) raw +
+            element_size * (start + i * stride), type, &value, _NNS_FLOAT64);
+        value -= average;
+        sum += squared ? value * value : value;
+      }
+      break;
+  }
+
+  return sum;
+}
+
 /**
  * @brief Calculate average value of the tensor.
  * @param raw pointer of raw tensor data
@@ -315,10 +402,8 @@ gboolean
 gst_tensor_data_raw_average (gpointer raw, gsize length, tensor_type type,
     gdouble ** result)
 {
-  gdouble value, average;
-  gulong i, num;
+  gulong num;
   gsize element_size;
-  guint8 *data;
 
   g_return_val_if_fail (raw != NULL, FALSE);
   g_return_val_if_fail (length > 0, FALSE);
@@ -327,22 +412,15 @@ gst_tensor_data_raw_average (gpointer raw, gsize length, tensor_type type,
   element_size = gst_tensor_get_element_size (type);
   num = length / element_size;
 
-  average = 0.0;
   *result = (gdouble *) g_try_malloc0 (sizeof (gdouble));
   if (*result == NULL) {
     nns_loge ("Failed to allocate memory for calculating average");
     return FALSE;
   }
 
-  for (i = 0; i < num; ++i) {
-    /* extract value and typecast to double */
-    data = (guint8 *) raw + element_size * i;
-    gst_tensor_data_raw_typecast (data, type, &value, _NNS_FLOAT64);
-
-    average = (value - average) / (i + 1) + average;
-  }
-
-  **result = average;
+  if (num > 0)
+    **result = _gst_tensor_data_raw_deviation (raw, type, 0, 1, num, 0.0,
+        FALSE) / num;
 
   return TRUE;
 }
@@ -360,10 +438,8 @@ gboolean
 gst_tensor_data_raw_average_per_channel (gpointer raw, gsize length,
     tensor_type type, tensor_dim dim, gdouble ** results)
 {
-  gdouble value, average;
-  gulong ch, i, num, offset;
+  gulong ch, num, offset;
   gsize element_size;
-  guint8 *data;
 
   g_return_val_if_fail (raw != NULL, FALSE);
   g_return_val_if_fail (length > 0, FALSE);
@@ -381,16 +457,11 @@ gst_tensor_data_raw_average_per_channel (gpointer raw, gsize length,
     return FALSE;
   }
 
-  for (ch = 0; ch < offset; ++ch) {
-    average = 0.0;
-    for (i = 0; i < num; ++i) {
-      /* extract value and typecast to double */
-      data = (guint8 *) raw + element_size * ((i * offset) + ch);
-      gst_tensor_data_raw_typecast (data, type, &value, _NNS_FLOAT64);
-      average = (value - average) / (i + 1) + average;
+  if (num > 0) {
+    for (ch = 0; ch < offset; ++ch) {
+      (*results)[ch] = _gst_tensor_data_raw_deviation (raw, type, ch, offset,
+          num, 0.0, FALSE) / num;
     }
-
-    (*results)[ch] = average;
   }
 
   return TRUE;
@@ -409,10 +480,9 @@ gboolean
 gst_tensor_data_raw_std (gpointer raw, gsize length, tensor_type type,
     gdouble * average, gdouble ** result)
 {
-  gdouble value, std;
-  gulong i, num;
+  gdouble std = 0.0;
+  gulong num;
   gsize element_size;
-  guint8 *data;
 
   g_return_val_if_fail (raw != NULL, FALSE);
   g_return_val_if_fail (length > 0, FALSE);
@@ -426,14 +496,9 @@ gst_tensor_data_raw_std (gpointer raw, gsize length, tensor_type type,
     return FALSE;
   }
 
-  std = 0.0;
-  for (i = 0; i < num; ++i) {
-    /* extract value and typecast to double */
-    data = (guint8 *) raw + element_size * i;
-    gst_tensor_data_raw_typecast (data, type, &value, _NNS_FLOAT64);
-
-    std += pow (value - *average, 2) / num;
-  }
+  if (num > 0)
+    std = _gst_tensor_data_raw_deviation (raw, type, 0, 1, num, *average,
+        TRUE) / num;
 
   std = (std != 0.0) ? sqrt (std) : (1e-10);
   **result = std;
@@ -455,10 +520,9 @@ gboolean
 gst_tensor_data_raw_std_per_channel (gpointer raw, gsize length,
     tensor_type type, tensor_dim dim, gdouble * averages, gdouble ** results)
 {
-  gdouble value, std;
-  gulong ch, i, num, offset;
+  gdouble std;
+  gulong ch, num, offset;
   gsize element_size;
-  guint8 *data;
 
   g_return_val_if_fail (raw != NULL, FALSE);
   g_return_val_if_fail (length > 0, FALSE);
@@ -478,12 +542,9 @@ gst_tensor_data_raw_std_per_channel (gpointer raw, gsize length,
 
   for (ch = 0; ch < offset; ++ch) {
     std = 0.0;
-    for (i = 0; i < num; ++i) {
-      /* extract value and typecast to double */
-      data = (guint8 *) raw + element_size * ((i * offset) + ch);
-      gst_tensor_data_raw_typecast (data, type, &value, _NNS_FLOAT64);
-      std += pow (value - averages[ch], 2) / num;
-    }
+    if (num > 0)
+      std = _gst_tensor_data_raw_deviation (raw, type, ch, offset, num,
+          averages[ch], TRUE) / num;
 
     std = (std != 0.0) ? sqrt (std) : (1e-10);
     (*results)[ch] = std;
@@ -119,6 +119,42 @@ G_DEFINE_TYPE (GstTensorFilter, gst_tensor_filter, GST_TYPE_BASE_TRANSFORM);
  */
 #define LATENCY_REPORT_THRESHOLD 0.25
 
+/**
+ * @brief Default number of frames packed into a single invoke (micro-batching disabled).
+ */
+#define DEFAULT_BATCH_SIZE 1
+
+/**
+ * @brief Default waiting time (ms) of the first frame in a batch (wait until the batch is full).
+ */
+#define DEFAULT_BATCH_TIMEOUT 0
+
+/**
+ * @brief Default number of invoke requests in flight (synchronous invoke).
+ */
+#define DEFAULT_MAX_INFLIGHT 0
+
+/**
+ * @brief Data structure for the recyclable output memories of a tensor.
+ * @details The element and each memory allocated from the pool hold a reference.
+ * The memory released by downstream goes back to the queue (see gst_tensor_filter_mem_dispose).
+ */
+typedef struct
+{
+  gint refcount;  /**< reference count, updated atomically */
+  gint active;  /**< FALSE if the element has released the pool, updated atomically */
+  gsize size;  /**< the size of each memory */
+  gsize offset;  /**< the offset of newly allocated memory, restored when the memory is reused */
+  GstAllocator *allocator;  /**< the allocator decided by the allocation query (NULL for default) */
+  GstAllocationParams params;  /**< the allocation params decided by the allocation query */
+  GstAtomicQueue *queue;  /**< the memories released by downstream */
+} GstTensorFilterMemPool;
+
+/**
+ * @brief The quark to attach the pool to its memories.
+ */
+static GQuark _mem_pool_quark;
+
 /* GObject vmethod implementations */
 static void gst_tensor_filter_set_property (GObject * object, guint prop_id,
     const GValue * value, GParamSpec * pspec);
@@ -126,9 +162,17 @@ static void gst_tensor_filter_get_property (GObject * object, guint prop_id,
     GValue * value, GParamSpec * pspec);
 static void gst_tensor_filter_finalize (GObject * object);
 
+/* GstElement vmethod implementations */
+static GstStateChangeReturn gst_tensor_filter_change_state (GstElement *
+    element, GstStateChange transition);
+
 /* GstBaseTransform vmethod implementations */
 static GstFlowReturn gst_tensor_filter_transform (GstBaseTransform * trans,
     GstBuffer * inbuf, GstBuffer * outbuf);
+static GstFlowReturn gst_tensor_filter_submit_input_buffer (GstBaseTransform *
+    trans, gboolean is_discont, GstBuffer * input);
+static GstFlowReturn gst_tensor_filter_generate_output (GstBaseTransform *
+    trans, GstBuffer ** outbuf);
 static GstCaps *gst_tensor_filter_transform_caps (GstBaseTransform * trans,
     GstPadDirection direction, GstCaps * caps, GstCaps * filter);
 static GstCaps *gst_tensor_filter_fixate_caps (GstBaseTransform * trans,
@@ -140,6 +184,8 @@ static gboolean gst_tensor_filter_query (GstBaseTransform * trans,
 static gboolean gst_tensor_filter_transform_size (GstBaseTransform * trans,
     GstPadDirection direction, GstCaps * caps, gsize size,
     GstCaps * othercaps, gsize * othersize);
+static gboolean gst_tensor_filter_decide_allocation (GstBaseTransform * trans,
+    GstQuery * query);
 static gboolean gst_tensor_filter_start (GstBaseTransform * trans);
 static gboolean gst_tensor_filter_stop (GstBaseTransform * trans);
 static gboolean gst_tensor_filter_sink_event (GstBaseTransform * trans,
@@ -147,6 +193,8 @@ static gboolean gst_tensor_filter_sink_event (GstBaseTransform * trans,
 static gboolean gst_tensor_filter_src_event (GstBaseTransform * trans,
     GstEvent * event);
 
+static void gst_tensor_filter_batch_loop (gpointer user_data);
+
 /**
  * @brief initialize the tensor_filter's class
  */
@@ -160,6 +208,8 @@ gst_tensor_filter_class_init (GstTensorFilterClass * klass)
   GST_DEBUG_CATEGORY_INIT (gst_tensor_filter_debug, "tensor_filter", 0,
       "Tensor filter to invoke neural network model");
 
+  _mem_pool_quark = g_quark_from_static_string ("GstTensorFilterMemPool");
+
   trans_class = (GstBaseTransformClass *) klass;
   gstelement_class = (GstElementClass *) trans_class;
   gobject_class = (GObjectClass *) gstelement_class;
@@ -170,12 +220,55 @@ gst_tensor_filter_class_init (GstTensorFilterClass * klass)
 
   gst_tensor_filter_install_properties (gobject_class);
 
+  g_object_class_install_property (gobject_class, PROP_BATCH_SIZE,
+      g_param_spec_uint ("batch-size", "Batch size",
+          "The maximum number of incoming buffers packed into a single invoke "
+          "along the outermost dimension of each tensor (micro-batching). "
+          "The outputs are split back into one buffer per incoming buffer. "
+          "This is available only if the framework supports batched invoke "
+          "and the input and output tensors are static. 1 to disable. "
+          "Batched invoke is a framework hook: no inference framework "
+          "supports it yet, and only the custom-easy functions registered "
+          "for batched invoke take a batch. Otherwise, it is ignored.",
+          1, G_MAXUINT, DEFAULT_BATCH_SIZE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_BATCH_TIMEOUT,
+      g_param_spec_uint ("batch-timeout", "Batch timeout",
+          "The maximum time (in ms) the first buffer of a batch waits for "
+          "other buffers. When this deadline expires, the pending batch is "
+          "invoked even if it is not full. "
+          "0 means waiting until the batch is full (or EOS).",
+          0, G_MAXUINT, DEFAULT_BATCH_TIMEOUT,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_MAX_INFLIGHT,
+      g_param_spec_uint ("max-inflight", "Max in-flight",
+          "The maximum number of invoke requests in flight. If it is larger "
+          "than 0, the incoming buffer is handed over to the worker (or the "
+          "invoke_async callback of the framework) and the outputs are pushed "
+          "in order from the src pad task. The upstream is blocked while "
+          "max-inflight requests are pending. 0 for synchronous invoke.",
+          0, G_MAXUINT, DEFAULT_MAX_INFLIGHT,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_OUTPUT_POOL_HITS,
+      g_param_spec_uint64 ("output-pool-hits", "Output pool hits",
+          "The number of output memories reused from the pools after "
+          "downstream has released them.",
+          0, G_MAXUINT64, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_OUTPUT_POOL_MISSES,
+      g_param_spec_uint64 ("output-pool-misses", "Output pool misses",
+          "The number of output memories newly allocated because the pool "
+          "was empty.",
+          0, G_MAXUINT64, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_set_details_simple (gstelement_class,
       "TensorFilter",
       "Filter/Tensor",
       "Handles NN Frameworks (e.g., tensorflow) as Media Filters with other/tensor type stream",
       "MyungJoo Ham <myungjoo.ham@samsung.com>");
 
+  gstelement_class->change_state =
+      GST_DEBUG_FUNCPTR (gst_tensor_filter_change_state);
+
   gst_element_class_add_pad_template (gstelement_class,
       gst_static_pad_template_get (&src_factory));
   gst_element_class_add_pad_template (gstelement_class,
@@ -186,6 +279,10 @@ gst_tensor_filter_class_init (GstTensorFilterClass * klass)
 
   /* Processing units */
   trans_class->transform = GST_DEBUG_FUNCPTR (gst_tensor_filter_transform);
+  trans_class->submit_input_buffer =
+      GST_DEBUG_FUNCPTR (gst_tensor_filter_submit_input_buffer);
+  trans_class->generate_output =
+      GST_DEBUG_FUNCPTR (gst_tensor_filter_generate_output);
 
   /* Negotiation units */
   trans_class->transform_caps =
@@ -196,6 +293,8 @@ gst_tensor_filter_class_init (GstTensorFilterClass * klass)
   /* Allocation units */
   trans_class->transform_size =
       GST_DEBUG_FUNCPTR (gst_tensor_filter_transform_size);
+  trans_class->decide_allocation =
+      GST_DEBUG_FUNCPTR (gst_tensor_filter_decide_allocation);
 
   /* setup events */
   trans_class->sink_event = GST_DEBUG_FUNCPTR (gst_tensor_filter_sink_event);
@@ -225,6 +324,346 @@ gst_tensor_filter_init (GstTensorFilter * self)
   self->prev_ts = GST_CLOCK_TIME_NONE;
   self->throttling_delay = 0;
   self->throttling_accum = 0;
+  /* init micro-batching */
+  self->batch_size = DEFAULT_BATCH_SIZE;
+  self->batch_timeout = DEFAULT_BATCH_TIMEOUT;
+  self->batch_frames = 1;
+  self->batch_start = 0;
+  self->batch_in = g_queue_new ();
+  self->batch_out = g_queue_new ();
+  g_rec_mutex_init (&self->batch_task_lock);
+  self->batch_task = gst_task_new (gst_tensor_filter_batch_loop, self, NULL);
+  gst_task_set_lock (self->batch_task, &self->batch_task_lock);
+  /* init asynchronous invoke */
+  self->max_inflight = DEFAULT_MAX_INFLIGHT;
+  self->async_mode = FALSE;
+  self->async_flushing = FALSE;
+  self->async_flow = GST_FLOW_OK;
+  self->async_queue = g_queue_new ();
+  self->async_pool = NULL;
+  g_mutex_init (&self->async_lock);
+  g_cond_init (&self->async_cond);
+  /* init output memory pools */
+  self->out_pools = g_ptr_array_new ();
+  g_atomic_int_set (&self->out_pool_hits, 0);
+  g_atomic_int_set (&self->out_pool_misses, 0);
+}
+
+/**
+ * @brief Set the arrival time of the first frame in the pending batch and wake up the batch timer.
+ * @param start Monotonic time (usec) of the first frame. 0 if no frame is pending.
+ */
+static void
+gst_tensor_filter_batch_set_start (GstTensorFilter * self, gint64 start)
+{
+  g_mutex_lock (&self->async_lock);
+  self->batch_start = start;
+  g_cond_broadcast (&self->async_cond);
+  g_mutex_unlock (&self->async_lock);
+}
+
+/**
+ * @brief Release the buffers waiting for the batched invoke or to be pushed.
+ */
+static void
+gst_tensor_filter_batch_clear (GstTensorFilter * self)
+{
+  GstBuffer *buffer;
+
+  while ((buffer = g_queue_pop_head (self->batch_in)) != NULL)
+    gst_buffer_unref (buffer);
+
+  while ((buffer = g_queue_pop_head (self->batch_out)) != NULL)
+    gst_buffer_unref (buffer);
+
+  gst_tensor_filter_batch_set_start (self, 0);
+}
+
+/**
+ * @brief Data structure for the invoke request in flight (max-inflight > 0).
+ */
+typedef struct
+{
+  GstTensorFilter *self; /**< tensor-filter instance */
+  GstBuffer *inbuf; /**< input buffer, the metadata is copied to the output */
+  guint num_in; /**< number of input tensors */
+  guint num_out; /**< number of output tensors */
+  GstMemory **in_mem; /**< input memory blocks (mapped) */
+  GstMapInfo *in_info; /**< mapped input memory */
+  GstMemory **out_mem; /**< output memory blocks (mapped, NULL if the subplugin allocates the output) */
+  GstMapInfo *out_info; /**< mapped output memory */
+  GstTensorMemory *in_tensors; /**< input tensors for the invoke */
+  GstTensorMemory *out_tensors; /**< output tensors for the invoke */
+  gint64 start_time; /**< time when the invoke is started, 0 if the statistics are not required */
+  gint status; /**< result of the invoke (same as the return value of invoke) */
+  gboolean done; /**< TRUE if the invoke is finished */
+} GstTensorFilterRequest;
+
+/**
+ * @brief Release the invoke request.
+ */
+static void
+gst_tensor_filter_request_free (GstTensorFilterRequest * req)
+{
+  guint i;
+
+  for (i = 0; i < req->num_in; i++) {
+    if (req->in_mem[i]) {
+      gst_memory_unmap (req->in_mem[i], &req->in_info[i]);
+      gst_memory_unref (req->in_mem[i]);
+    }
+  }
+
+  for (i = 0; i < req->num_out; i++) {
+    if (req->out_mem[i]) {
+      gst_memory_unmap (req->out_mem[i], &req->out_info[i]);
+      gst_memory_unref (req->out_mem[i]);
+    }
+  }
+
+  gst_buffer_unref (req->inbuf);
+  g_free (req->in_mem);
+  g_free (req->in_info);
+  g_free (req->out_mem);
+  g_free (req->out_info);
+  g_free (req->in_tensors);
+  g_free (req->out_tensors);
+  g_free (req);
+}
+
+/**
+ * @brief Wait for the invoke requests in flight and discard them.
+ * @note The caller should stop the src pad task or hold its stream lock.
+ */
+static void
+gst_tensor_filter_async_clear (GstTensorFilter * self)
+{
+  GstTensorFilterRequest *req;
+  GList *list;
+  gboolean pending;
+
+  g_mutex_lock (&self->async_lock);
+  self->async_flushing = TRUE;
+  g_cond_broadcast (&self->async_cond);
+
+  do {
+    pending = FALSE;
+    for (list = self->async_queue->head; list != NULL; list = list->next) {
+      req = (GstTensorFilterRequest *) list->data;
+      if (!req->done) {
+        pending = TRUE;
+        g_cond_wait (&self->async_cond, &self->async_lock);
+        break;
+      }
+    }
+  } while (pending);
+
+  while ((req = g_queue_pop_head (self->async_queue)) != NULL)
+    gst_tensor_filter_request_free (req);
+
+  g_mutex_unlock (&self->async_lock);
+}
+
+/**
+ * @brief Ready to accept the invoke requests (e.g., after flushing).
+ */
+static void
+gst_tensor_filter_async_reset (GstTensorFilter * self)
+{
+  g_mutex_lock (&self->async_lock);
+  self->async_flushing = FALSE;
+  self->async_flow = GST_FLOW_OK;
+  g_mutex_unlock (&self->async_lock);
+}
+
+/**
+ * @brief Create the pool of the output memories.
+ */
+static GstTensorFilterMemPool *
+gst_tensor_filter_mem_pool_new (gsize size, GstAllocator * allocator,
+    const GstAllocationParams * params)
+{
+  GstTensorFilterMemPool *pool;
+
+  pool = g_new0 (GstTensorFilterMemPool, 1);
+  pool->refcount = 1;
+  pool->active = TRUE;
+  pool->size = size;
+  pool->allocator = allocator ? gst_object_ref (allocator) : NULL;
+  if (params)
+    pool->params = *params;
+  else
+    gst_allocation_params_init (&pool->params);
+  pool->queue = gst_atomic_queue_new (4);
+
+  return pool;
+}
+
+/**
+ * @brief Increase the reference count of the pool.
+ */
+static GstTensorFilterMemPool *
+gst_tensor_filter_mem_pool_ref (GstTensorFilterMemPool * pool)
+{
+  g_atomic_int_inc (&pool->refcount);
+  return pool;
+}
+
+/**
+ * @brief Decrease the reference count of the pool and free it if it is not used anymore.
+ */
+static void
+gst_tensor_filter_mem_pool_unref (gpointer data)
+{
+  GstTensorFilterMemPool *pool = (GstTensorFilterMemPool *) data;
+
+  if (!g_atomic_int_dec_and_test (&pool->refcount))
+    return;
+
+  /* each memory in the queue holds a reference, the queue should be empty. */
+  gst_atomic_queue_unref (pool->queue);
+  if (pool->allocator)
+    gst_object_unref (pool->allocator);
+  g_free (pool);
+}
+
+/**
+ * @brief Free the memories in the queue of the pool.
+ */
+static void
+gst_tensor_filter_mem_pool_drain (GstTensorFilterMemPool * pool)
+{
+  GstMemory *mem;
+
+  while ((mem = gst_atomic_queue_pop (pool->queue)) != NULL)
+    gst_memory_unref (mem);
+}
+
+/**
+ * @brief Called when the last reference of the pooled memory is dropped.
+ * @details This may be called from any thread (e.g., downstream sink).
+ * @return FALSE if the memory goes back to the pool, TRUE to free it.
+ */
+static gboolean
+gst_tensor_filter_mem_dispose (GstMiniObject * obj)
+{
+  GstMemory *mem = (GstMemory *) obj;
+  GstTensorFilterMemPool *pool;
+
+  pool = (GstTensorFilterMemPool *) gst_mini_object_get_qdata (obj,
+      _mem_pool_quark);
+  if (!pool || !g_atomic_int_get (&pool->active))
+    return TRUE;
+
+  /* downstream may have locked the memory, do not reuse it. */
+  if (GST_MEMORY_IS_READONLY (mem))
+    return TRUE;
+
+  gst_mini_object_ref (obj);
+  gst_atomic_queue_push (pool->queue, mem);
+
+  /* the element may have released the pool meanwhile. */
+  if (!g_atomic_int_get (&pool->active)) {
+    gst_tensor_filter_mem_pool_ref (pool);
+    gst_tensor_filter_mem_pool_drain (pool);
+    gst_tensor_filter_mem_pool_unref (pool);
+  }
+
+  return FALSE;
+}
+
+/**
+ * @brief Release the output memory pools. The memories held by downstream are freed when they are released.
+ */
+static void
+gst_tensor_filter_release_pools (GstTensorFilter * self)
+{
+  GstTensorFilterMemPool *pool;
+  guint i;
+
+  for (i = 0; i < self->out_pools->len; i++) {
+    pool = (GstTensorFilterMemPool *) g_ptr_array_index (self->out_pools, i);
+    if (pool == NULL)
+      continue;
+
+    g_atomic_int_set (&pool->active, FALSE);
+    gst_tensor_filter_mem_pool_drain (pool);
+    gst_tensor_filter_mem_pool_unref (pool);
+  }
+
+  g_ptr_array_set_size (self->out_pools, 0);
+}
+
+/**
+ * @brief Get the output memory of the given tensor from the pool, or allocate new one if the pool is empty.
+ * @param self "this" pointer
+ * @param index index of the output tensor
+ * @param size the size of the memory
+ * @return The output memory (NULL if failed to allocate). Caller should unref it (not gst_allocator_free) so that it goes back to the pool.
+ */
+static GstMemory *
+gst_tensor_filter_alloc_output (GstTensorFilter * self, guint index,
+    gsize size)
+{
+  GstBaseTransform *trans = GST_BASE_TRANSFORM_CAST (self);
+  GstTensorFilterMemPool *pool = NULL;
+  GstAllocator *allocator = NULL;
+  GstAllocationParams params;
+  GstMemory *mem;
+
+  if (index < self->out_pools->len)
+    pool = (GstTensorFilterMemPool *) g_ptr_array_index (self->out_pools,
+        index);
+  else
+    g_ptr_array_set_size (self->out_pools, index + 1);
+
+  /* the size of the output tensor is changed, drop the old memories. */
+  if (pool && pool->size != size) {
+    g_atomic_int_set (&pool->active, FALSE);
+    gst_tensor_filter_mem_pool_drain (pool);
+    gst_tensor_filter_mem_pool_unref (pool);
+    pool = NULL;
+  }
+
+  if (pool == NULL) {
+    gst_base_transform_get_allocator (trans, &allocator, &params);
+    pool = gst_tensor_filter_mem_pool_new (size, allocator, &params);
+    if (allocator)
+      gst_object_unref (allocator);
+
+    g_ptr_array_index (self->out_pools, index) = pool;
+  }
+
+  mem = (GstMemory *) gst_atomic_queue_pop (pool->queue);
+  if (mem) {
+    gsize offset;
+
+    /* the memory may be resized (e.g., reserved header), restore it. */
+    if (gst_memory_get_sizes (mem, &offset, NULL) != pool->size ||
+        offset != pool->offset)
+      gst_memory_resize (mem, (gssize) pool->offset - (gssize) offset,
+          pool->size);
+
+    g_atomic_int_inc (&self->out_pool_hits);
+    return mem;
+  }
+
+  mem = gst_allocator_alloc (pool->allocator, size, &pool->params);
+  if (!mem)
+    return NULL;
+
+  g_atomic_int_inc (&self->out_pool_misses);
+  gst_memory_get_sizes (mem, &pool->offset, NULL);
+
+  /* the allocator recycles its own memories, do not pool it. */
+  if (GST_MINI_OBJECT_CAST (mem)->dispose != NULL)
+    return mem;
+
+  gst_mini_object_set_qdata (GST_MINI_OBJECT_CAST (mem), _mem_pool_quark,
+      gst_tensor_filter_mem_pool_ref (pool), gst_tensor_filter_mem_pool_unref);
+  GST_MINI_OBJECT_CAST (mem)->dispose = gst_tensor_filter_mem_dispose;
+
+  return mem;
 }
 
 /**
@@ -242,6 +681,21 @@ gst_tensor_filter_finalize (GObject * object)
   gst_tensor_filter_common_close_fw (priv);
   gst_tensor_filter_common_free_property (priv);
 
+  gst_tensor_filter_batch_clear (self);
+  g_queue_free (self->batch_in);
+  g_queue_free (self->batch_out);
+  gst_task_join (self->batch_task);
+  gst_object_unref (self->batch_task);
+  g_rec_mutex_clear (&self->batch_task_lock);
+
+  gst_tensor_filter_async_clear (self);
+  g_queue_free (self->async_queue);
+  g_mutex_clear (&self->async_lock);
+  g_cond_clear (&self->async_cond);
+
+  gst_tensor_filter_release_pools (self);
+  g_ptr_array_free (self->out_pools, TRUE);
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -290,11 +744,23 @@ gst_tensor_filter_set_property (GObject * object, guint prop_id,
 
   silent_debug (self, "Setting property for prop %d.\n", prop_id);
 
-  if (prop_id == PROP_CONFIG) {
-    g_free (priv->config_path);
-    priv->config_path = g_strdup (g_value_get_string (value));
-    gst_tensor_parse_config_file (priv->config_path, object);
-    return;
+  switch (prop_id) {
+    case PROP_CONFIG:
+      g_free (priv->config_path);
+      priv->config_path = g_strdup (g_value_get_string (value));
+      gst_tensor_parse_config_file (priv->config_path, object);
+      return;
+    case PROP_BATCH_SIZE:
+      self->batch_size = g_value_get_uint (value);
+      return;
+    case PROP_BATCH_TIMEOUT:
+      self->batch_timeout = g_value_get_uint (value);
+      return;
+    case PROP_MAX_INFLIGHT:
+      self->max_inflight = g_value_get_uint (value);
+      return;
+    default:
+      break;
   }
 
   if (!gst_tensor_filter_common_set_property (priv, prop_id, value, pspec))
@@ -316,9 +782,27 @@ gst_tensor_filter_get_property (GObject * object, guint prop_id,
 
   silent_debug (self, "Getting property for prop %d.\n", prop_id);
 
-  if (prop_id == PROP_CONFIG) {
-    g_value_set_string (value, priv->config_path ? priv->config_path : "");
-    return;
+  switch (prop_id) {
+    case PROP_CONFIG:
+      g_value_set_string (value, priv->config_path ? priv->config_path : "");
+      return;
+    case PROP_BATCH_SIZE:
+      g_value_set_uint (value, self->batch_size);
+      return;
+    case PROP_BATCH_TIMEOUT:
+      g_value_set_uint (value, self->batch_timeout);
+      return;
+    case PROP_MAX_INFLIGHT:
+      g_value_set_uint (value, self->max_inflight);
+      return;
+    case PROP_OUTPUT_POOL_HITS:
+      g_value_set_uint64 (value, g_atomic_int_get (&self->out_pool_hits));
+      return;
+    case PROP_OUTPUT_POOL_MISSES:
+      g_value_set_uint64 (value, g_atomic_int_get (&self->out_pool_misses));
+      return;
+    default:
+      break;
   }
 
   if (!gst_tensor_filter_common_get_property (priv, prop_id, value, pspec))
@@ -563,11 +1047,11 @@ gst_tensor_filter_check_throttling_delay (GstBaseTransform * trans,
 }
 
 /**
- * @brief Check input paramters for gst_tensor_filter_transform ();
+ * @brief Check the framework and the incoming buffer before invoking the model.
  */
 static GstFlowReturn
-_gst_tensor_filter_transform_validate (GstBaseTransform * trans,
-    GstBuffer * inbuf, GstBuffer * outbuf)
+_gst_tensor_filter_invoke_validate (GstBaseTransform * trans,
+    GstBuffer * inbuf)
 {
   GstTensorFilter *self = GST_TENSOR_FILTER_CAST (trans);
   GstTensorFilterPrivate *priv = &self->priv;
@@ -620,6 +1104,24 @@ _gst_tensor_filter_transform_validate (GstBaseTransform * trans,
   if (gst_tensor_filter_check_throttling_delay (trans, inbuf))
     return GST_BASE_TRANSFORM_FLOW_DROPPED;
 
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief Check input paramters for gst_tensor_filter_transform ();
+ */
+static GstFlowReturn
+_gst_tensor_filter_transform_validate (GstBaseTransform * trans,
+    GstBuffer * inbuf, GstBuffer * outbuf)
+{
+  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (trans);
+  GstTensorFilterProperties *prop = &self->priv.prop;
+  GstFlowReturn ret;
+
+  ret = _gst_tensor_filter_invoke_validate (trans, inbuf);
+  if (ret != GST_FLOW_OK)
+    return ret;
+
   if (!outbuf) {
     GST_ELEMENT_ERROR_BTRACE (self, STREAM, FAILED,
         ("The output buffer for the instance of tensor-filter subplugin (%s / %s) is null. Cannot proceed.",
@@ -770,10 +1272,10 @@ gst_tensor_filter_transform (GstBaseTransform * trans,
     out_tensors[i].size = gst_tensor_filter_get_tensor_size (self, i, FALSE);
 
     hsize = 0;
-    if (out_flexible && !priv->prop.invoke_dynamic) {
+    if (!priv->prop.invoke_dynamic) {
       gboolean ret = FALSE;
-      ret = gst_tensor_info_convert_to_meta (&prop->output_meta.info[i],
-          &out_meta[i]);
+      ret = gst_tensor_info_convert_to_meta (gst_tensors_info_get_nth_info
+          (&prop->output_meta, i), &out_meta[i]);
       if (TRUE != ret) {
         ml_loge_stacktrace
             ("gst_tensor_filter_transform: The configured output tensor information is invalid, at %u'th output tensor\n",
@@ -785,14 +1287,31 @@ gst_tensor_filter_transform (GstBaseTransform * trans,
 
     /* allocate memory if allocate_in_invoke is FALSE */
     if (!allocate_in_invoke) {
-      out_mem[i] =
-          gst_allocator_alloc (NULL, out_tensors[i].size + hsize, NULL);
+      out_mem[i] = gst_tensor_filter_alloc_output (self, i,
+          out_tensors[i].size + hsize);
       if (!out_mem[i]) {
         ml_loge_stacktrace
-            ("gst_tensor_filter_transform: cannot allocate memory for the output buffer (%u'th memory chunk for %u'th tensor), which requires %zd bytes. gst_allocate_alloc has returned Null. Out of memory?",
+            ("gst_tensor_filter_transform: cannot allocate memory for the output buffer (%u'th memory chunk for %u'th tensor), which requires %zd bytes. gst_tensor_filter_alloc_output has returned Null. Out of memory?",
             i, i, out_tensors[i].size + hsize);
         goto mem_map_error;
       }
+
+      /**
+       * Keep the header in front of the static tensor, then downstream
+       * converts it to flexible tensor without copying the data.
+       */
+      if (!out_flexible) {
+        if (!gst_tensor_meta_info_reserve_header (&out_meta[i], out_mem[i])) {
+          ml_loge_stacktrace
+              ("gst_tensor_filter_transform: cannot reserve the header in front of the %u'th output tensor.\n",
+              i);
+          gst_memory_unref (out_mem[i]);
+          out_mem[i] = NULL;
+          goto mem_map_error;
+        }
+        hsize = 0;
+      }
+
       if (!gst_memory_map (out_mem[i], &out_info[i], GST_MAP_WRITE)) {
         ml_loge_stacktrace
             ("gst_tensor_filter_transform: For the given output buffer, allocated by gst_tensor_filter_transform, it cannot map output memory buffer for the %u'th memory chunk (%u'th output tensor) for write.\n",
@@ -837,7 +1356,7 @@ gst_tensor_filter_transform (GstBaseTransform * trans,
     for (i = 0; i < prop->output_meta.num_tensors; i++) {
       gst_memory_unmap (out_mem[i], &out_info[i]);
       if (ret != 0)
-        gst_allocator_free (out_mem[i]->allocator, out_mem[i]);
+        gst_memory_unref (out_mem[i]);
     }
   }
 
@@ -890,7 +1409,7 @@ gst_tensor_filter_transform (GstBaseTransform * trans,
         if (allocate_in_invoke) {
           gst_tensor_filter_destroy_notify_util (priv, out_tensors[i].data);
         } else {
-          gst_allocator_free (out_mem[i]->allocator, out_mem[i]);
+          gst_memory_unref (out_mem[i]);
         }
 
         continue;
@@ -943,7 +1462,7 @@ mem_map_error:
     for (i = 0; i < prop->output_meta.num_tensors; i++) {
       if (out_mem[i]) {
         gst_memory_unmap (out_mem[i], &out_info[i]);
-        gst_allocator_free (out_mem[i]->allocator, out_mem[i]);
+        gst_memory_unref (out_mem[i]);
       }
     }
   }
@@ -951,89 +1470,845 @@ mem_map_error:
 }
 
 /**
- * @brief Configure input and output tensor info from incaps.
- * @param self "this" pointer
- * @param incaps received caps for sink pad
- * @return TRUE if fully configured
+ * @brief Check whether the negotiated stream can be processed with batched invoke.
+ * @return The number of frames packed into a single invoke. 1 if micro-batching is not available.
  */
-static gboolean
-gst_tensor_filter_configure_tensor (GstTensorFilter * self,
-    const GstCaps * incaps)
+static guint
+gst_tensor_filter_batch_get_frames (GstTensorFilter * self,
+    gboolean out_flexible)
 {
-  GstTensorFilterPrivate *priv;
-  GstTensorFilterProperties *prop;
-  GstStructure *structure;
-  GstTensorsConfig in_config, out_config;
-  GstTensorsInfo in_info, out_info;
-  gboolean flexible;
-
-  g_return_val_if_fail (incaps != NULL, FALSE);
-  priv = &self->priv;
-  prop = &priv->prop;
-  gst_tensors_config_init (&in_config);
-  gst_tensors_config_init (&out_config);
-  gst_tensors_info_init (&in_info);
-  gst_tensors_info_init (&out_info);
-
-  /**
-   * GstTensorFilter has to parse the tensor dimension and type from NN model.
-   * 1. Call functions getInputDimension and getOutputDimension to get the dimension and type.
-   * 2. If these functions are not defined, call setInputDimension with parsed info from caps.
-   * 3. If set-prop configured dimension, verify the dimension with fw callbacks.
-   */
-  gst_tensor_filter_load_tensor_info (&self->priv);
+  GstTensorFilterPrivate *priv = &self->priv;
+  guint frames;
 
-  structure = gst_caps_get_structure (incaps, 0);
-  if (G_UNLIKELY (!structure)) {
-    gchar *capstr = gst_caps_to_string (incaps);
-    GST_ELEMENT_ERROR_BTRACE (self, STREAM, WRONG_TYPE,
-        ("%s:%u The input stream padcap is not appropriate. Cannot get structured information from the given padcap: '%s' (gst_caps_get_structure() has returned NULL.). Please check if the caps you've given is correct especially if you have applied caps-filter in front of tensor-filter (%s:%s).",
-            __func__, __LINE__, capstr, GST_STR_NULL (prop->fwname),
-            TF_MODELNAME (prop)));
-    g_free (capstr);
-    goto done;
-  }
-  if (G_UNLIKELY (!gst_tensors_config_from_structure (&in_config, structure))) {
-    gchar *capstr = gst_caps_to_string (incaps);
-    GST_ELEMENT_ERROR_BTRACE (self, STREAM, WRONG_TYPE,
-        ("%s:%u The input stream padcap is not appropriate. It is not a valid tensor stream (other/tensors) or a tensor stream with a few required entries missing. For example, dimesion and type are missing for a static tensor (format=static or other/tensor (single tensor)). The given padcap is '%s' for tensor-filter (%s:%s).",
-            __func__, __LINE__, capstr, GST_STR_NULL (prop->fwname),
-            TF_MODELNAME (prop)));
-    g_free (capstr);
-    goto done;
-  }
+  if (self->batch_size <= 1)
+    return 1;
 
-  /**
-   * Check configuration from caps.
-   * If true, fully configured tensor info from caps.
-   */
-  if (!gst_tensors_config_validate (&in_config)) {
-    gchar *capstr = gst_caps_to_string (incaps);
-    GST_ELEMENT_ERROR_BTRACE (self, STREAM, WRONG_TYPE,
-        ("%s:%u The input stream padcaps cannot be validated. It is not a valid tensor stream for tensor_filter element. Input stream type for tensor_filter (%s:%s) is %s. tensor-filter could get config from the input padcap; however, it cannot be validated: framerate or format is not valid. Try a static tensor stream with a valid (0/1 is also valid!) framerate.",
-            __func__, __LINE__, GST_STR_NULL (prop->fwname),
-            TF_MODELNAME (prop), capstr));
-    g_free (capstr);
-    goto done;
+  if (!GST_TF_FW_V1 (priv->fw) || priv->info.max_batch_size <= 1) {
+    ml_logw
+        ("The tensor-filter subplugin (%s) does not support batched invoke. The property batch-size (%u) is ignored and each buffer is invoked one by one.",
+        GST_STR_NULL (priv->prop.fwname), self->batch_size);
+    return 1;
   }
 
-  if (!gst_tensor_filter_common_get_combined_in_info (priv, &in_config.info,
-          &in_info)) {
-    gchar *capstr = gst_caps_to_string (incaps);
-    GST_ELEMENT_ERROR_BTRACE (self, STREAM, WRONG_TYPE,
-        ("%s:%u Failed to configure combined input info for tensor-filter (%s:%s). The given padcap is '%s'. User has specified input combination (refer to the previous error log), which shuffles the order of tensors, which is not compatible with the given model. Please check the padcap, input combination, and tensor/dimension requirement of your neural network model.",
-            __func__, __LINE__, GST_STR_NULL (prop->fwname),
-            TF_MODELNAME (prop), capstr));
-    g_free (capstr);
-    goto done;
+  if (priv->prop.invoke_dynamic || out_flexible ||
+      gst_tensors_config_is_flexible (&priv->in_config) ||
+      gst_tensor_filter_allocate_in_invoke (priv) ||
+      priv->combi.in_combi_defined || priv->combi.out_combi_i_defined ||
+      priv->combi.out_combi_o_defined) {
+    ml_logw
+        ("Micro-batching of tensor-filter requires static input and output tensors without invoke-dynamic, in/out combination and output allocation in the subplugin. The property batch-size (%u) is ignored.",
+        self->batch_size);
+    return 1;
   }
 
-  /* flexible tensor case, we cannot get the exact info from caps. */
-  flexible = gst_tensors_config_is_flexible (&in_config);
+  frames = MIN (self->batch_size, (guint) priv->info.max_batch_size);
+  GST_INFO_OBJECT (self, "Micro-batching is enabled, %u frames per invoke.",
+      frames);
+  return frames;
+}
 
-  /** if set-property called and already has info, verify it! */
-  if (prop->input_meta.num_tensors > 0) {
-    if (flexible) {
+/**
+ * @brief Pack the pending input buffers, invoke the model once and split the outputs.
+ * @details The output memory of each tensor is allocated once for all frames, and each output buffer shares its own region. The output buffers are queued in batch_out with the metadata (e.g., timestamps) of the corresponding input buffer.
+ */
+static GstFlowReturn
+gst_tensor_filter_batch_invoke (GstTensorFilter * self)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterProperties *prop = &priv->prop;
+  GstMemory *in_mem[NNS_TENSOR_SIZE_LIMIT + NNS_TENSOR_SIZE_EXTRA_LIMIT] =
+      { 0, };
+  GstMapInfo in_info[NNS_TENSOR_SIZE_LIMIT + NNS_TENSOR_SIZE_EXTRA_LIMIT];
+  GstMemory *out_mem[NNS_TENSOR_SIZE_LIMIT + NNS_TENSOR_SIZE_EXTRA_LIMIT] =
+      { 0, };
+  GstMapInfo out_info[NNS_TENSOR_SIZE_LIMIT + NNS_TENSOR_SIZE_EXTRA_LIMIT];
+  GstTensorMemory in_tensors[NNS_TENSOR_SIZE_LIMIT +
+      NNS_TENSOR_SIZE_EXTRA_LIMIT];
+  GstTensorMemory out_tensors[NNS_TENSOR_SIZE_LIMIT +
+      NNS_TENSOR_SIZE_EXTRA_LIMIT];
+  GstBuffer *inbuf, *outbuf;
+  GstMemory *mem;
+  GstMapInfo map;
+  GList *list;
+  guint i, b, frames;
+  gsize size;
+  gint ret = -1;
+  gboolean need_profiling;
+  GstFlowReturn retval = GST_FLOW_ERROR;
+
+  frames = g_queue_get_length (self->batch_in);
+  if (frames == 0)
+    return GST_FLOW_OK;
+
+  /* 1. Pack all input tensors along the outermost dimension. */
+  for (list = self->batch_in->head; list != NULL; list = list->next) {
+    inbuf = GST_BUFFER_CAST (list->data);
+
+    if (gst_tensor_buffer_get_count (inbuf) != prop->input_meta.num_tensors) {
+      ml_loge_stacktrace
+          ("gst_tensor_filter_batch_invoke: Input buffer has invalid number of memory blocks (%u), which is expected to be %u (the number of tensors).\n",
+          gst_tensor_buffer_get_count (inbuf), prop->input_meta.num_tensors);
+      goto done;
+    }
+  }
+
+  for (i = 0; i < prop->input_meta.num_tensors; i++) {
+    size = gst_tensor_filter_get_tensor_size (self, i, TRUE);
+
+    mem = gst_allocator_alloc (NULL, size * frames, NULL);
+    if (!mem || !gst_memory_map (mem, &in_info[i], GST_MAP_WRITE)) {
+      ml_loge_stacktrace
+          ("gst_tensor_filter_batch_invoke: cannot allocate and map the batched input memory (%u'th tensor, %zd bytes).\n",
+          i, size * frames);
+      if (mem)
+        gst_memory_unref (mem);
+      goto done;
+    }
+    in_mem[i] = mem;
+
+    for (list = self->batch_in->head, b = 0; list != NULL;
+        list = list->next, b++) {
+      mem = gst_tensor_buffer_get_nth_memory (GST_BUFFER_CAST (list->data), i);
+
+      if (!gst_memory_map (mem, &map, GST_MAP_READ)) {
+        ml_loge_stacktrace
+            ("gst_tensor_filter_batch_invoke: cannot map the %u'th input memory of the %u'th buffer in the batch.\n",
+            i, b);
+        gst_memory_unref (mem);
+        goto done;
+      }
+
+      if (map.size != size) {
+        ml_loge_stacktrace
+            ("gst_tensor_filter_batch_invoke: Input buffer size (%u'th memory chunk: %zd) is invalid, which is expected to be %zd.\n",
+            i, map.size, size);
+        gst_memory_unmap (mem, &map);
+        gst_memory_unref (mem);
+        goto done;
+      }
+
+      memcpy (in_info[i].data + b * size, map.data, size);
+      gst_memory_unmap (mem, &map);
+      gst_memory_unref (mem);
+    }
+
+    in_tensors[i].data = in_info[i].data;
+    in_tensors[i].size = size * frames;
+  }
+
+  /* 2. Prepare output tensors for all frames. */
+  for (i = 0; i < prop->output_meta.num_tensors; i++) {
+    size = gst_tensor_filter_get_tensor_size (self, i, FALSE);
+
+    /* the pooled memory is sized for a full batch, a partial batch uses its head. */
+    mem = gst_tensor_filter_alloc_output (self, i,
+        size * MAX (frames, self->batch_frames));
+    if (!mem || !gst_memory_map (mem, &out_info[i], GST_MAP_WRITE)) {
+      ml_loge_stacktrace
+          ("gst_tensor_filter_batch_invoke: cannot allocate and map the batched output memory (%u'th tensor, %zd bytes).\n",
+          i, size * frames);
+      if (mem)
+        gst_memory_unref (mem);
+      goto done;
+    }
+    out_mem[i] = mem;
+
+    out_tensors[i].data = out_info[i].data;
+    out_tensors[i].size = size * frames;
+  }
+
+  need_profiling = (priv->latency_mode > 0 || priv->throughput_mode > 0 ||
+      priv->latency_reporting);
+  if (need_profiling)
+    prepare_statistics (priv);
+
+  /* 3. Call the filter-subplugin callback, "invoke", once for all frames. */
+  prop->batch_size = frames;
+  GST_TF_FW_INVOKE_COMPAT (priv, ret, in_tensors, out_tensors);
+  prop->batch_size = 1;
+
+  if (need_profiling) {
+    record_statistics (priv);
+    track_latency (self);
+  }
+
+  if (ret < 0) {
+    ml_loge_stacktrace
+        ("Calling invoke function (inference instance) of the tensor-filter subplugin (%s for %s) with %u frames has failed with error code (%d).\n",
+        prop->fwname, TF_MODELNAME (prop), frames, ret);
+    goto done;
+  }
+
+  retval = GST_FLOW_OK;
+
+done:
+  for (i = 0; i < prop->input_meta.num_tensors; i++) {
+    if (in_mem[i]) {
+      gst_memory_unmap (in_mem[i], &in_info[i]);
+      gst_memory_unref (in_mem[i]);
+    }
+  }
+
+  for (i = 0; i < prop->output_meta.num_tensors; i++) {
+    if (out_mem[i])
+      gst_memory_unmap (out_mem[i], &out_info[i]);
+  }
+
+  /* 4. Split the outputs (ret > 0 means dropping the whole batch). */
+  b = 0;
+  while ((inbuf = g_queue_pop_head (self->batch_in)) != NULL) {
+    if (retval == GST_FLOW_OK && ret == 0) {
+      outbuf = gst_buffer_new ();
+      gst_buffer_copy_into (outbuf, inbuf, GST_BUFFER_COPY_METADATA, 0, -1);
+
+      for (i = 0; i < prop->output_meta.num_tensors; i++) {
+        size = gst_tensor_filter_get_tensor_size (self, i, FALSE);
+        mem = gst_memory_share (out_mem[i], b * size, size);
+
+        gst_tensor_buffer_append_memory (outbuf, mem,
+            gst_tensors_info_get_nth_info (&prop->output_meta, i));
+      }
+
+      g_queue_push_tail (self->batch_out, outbuf);
+    }
+
+    gst_buffer_unref (inbuf);
+    b++;
+  }
+
+  for (i = 0; i < prop->output_meta.num_tensors; i++) {
+    if (out_mem[i])
+      gst_memory_unref (out_mem[i]);
+  }
+
+  gst_tensor_filter_batch_set_start (self, 0);
+  return retval;
+}
+
+/**
+ * @brief Invoke the pending batch and push all outputs to the src pad (e.g., at EOS).
+ */
+static GstFlowReturn
+gst_tensor_filter_batch_drain (GstTensorFilter * self)
+{
+  GstPad *srcpad = GST_BASE_TRANSFORM_SRC_PAD (self);
+  GstBuffer *outbuf;
+  GstFlowReturn ret;
+
+  ret = gst_tensor_filter_batch_invoke (self);
+
+  while ((outbuf = g_queue_pop_head (self->batch_out)) != NULL) {
+    if (ret == GST_FLOW_OK)
+      ret = gst_pad_push (srcpad, outbuf);
+    else
+      gst_buffer_unref (outbuf);
+  }
+
+  return ret;
+}
+
+/**
+ * @brief The batch timer, invoke the pending batch if the first frame has waited longer than batch-timeout.
+ * @details The timer takes the stream lock of the sink pad, so the batch is not touched by the streaming thread while it is invoked and pushed.
+ */
+static void
+gst_tensor_filter_batch_loop (gpointer user_data)
+{
+  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (user_data);
+  GstPad *sinkpad = GST_BASE_TRANSFORM_SINK_PAD (self);
+  GstFlowReturn ret = GST_FLOW_OK;
+  gint64 timeout, deadline;
+
+  timeout = (gint64) self->batch_timeout * G_TIME_SPAN_MILLISECOND;
+
+  g_mutex_lock (&self->async_lock);
+  while (!self->async_flushing) {
+    if (self->batch_start == 0) {
+      g_cond_wait (&self->async_cond, &self->async_lock);
+      continue;
+    }
+
+    deadline = self->batch_start + timeout;
+    if (g_get_monotonic_time () >= deadline)
+      break;
+
+    g_cond_wait_until (&self->async_cond, &self->async_lock, deadline);
+  }
+
+  if (self->async_flushing) {
+    g_mutex_unlock (&self->async_lock);
+    gst_task_pause (self->batch_task);
+    return;
+  }
+  g_mutex_unlock (&self->async_lock);
+
+  /* the streaming thread may have invoked the batch meanwhile, check it again */
+  GST_PAD_STREAM_LOCK (sinkpad);
+  g_mutex_lock (&self->async_lock);
+  deadline = self->batch_start + timeout;
+  g_mutex_unlock (&self->async_lock);
+
+  if (!g_queue_is_empty (self->batch_in) &&
+      g_get_monotonic_time () >= deadline) {
+    GST_DEBUG_OBJECT (self, "Batch timeout, invoke %u pending frames.",
+        g_queue_get_length (self->batch_in));
+    ret = gst_tensor_filter_batch_drain (self);
+  }
+  GST_PAD_STREAM_UNLOCK (sinkpad);
+
+  if (ret == GST_FLOW_ERROR || ret == GST_FLOW_NOT_NEGOTIATED) {
+    GST_ELEMENT_ERROR_BTRACE (self, STREAM, FAILED,
+        ("Failed to push the output of tensor-filter (%s:%s): %s.",
+            GST_STR_NULL (self->priv.prop.fwname),
+            TF_MODELNAME (&self->priv.prop), gst_flow_get_name (ret)));
+  }
+}
+
+/**
+ * @brief Check whether the subplugin supports asynchronous invoke.
+ */
+#define GST_TF_FW_ASYNC(fw) (GST_TF_FW_V1 (fw) && (fw)->invoke_async != NULL)
+
+/**
+ * @brief Prepare the invoke request. The request takes the ownership of the input buffer.
+ * @return Newly allocated request. NULL if the input buffer is invalid.
+ */
+static GstTensorFilterRequest *
+gst_tensor_filter_request_new (GstTensorFilter * self, GstBuffer * inbuf)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterProperties *prop = &priv->prop;
+  GstTensorFilterRequest *req;
+  GstTensorMetaInfo meta;
+  GstMemory *mem;
+  gsize size, hsize;
+  guint i;
+
+  req = g_new0 (GstTensorFilterRequest, 1);
+  req->self = self;
+  req->inbuf = inbuf;
+  req->num_in = prop->input_meta.num_tensors;
+  req->num_out = prop->output_meta.num_tensors;
+  req->in_mem = g_new0 (GstMemory *, req->num_in);
+  req->in_info = g_new0 (GstMapInfo, req->num_in);
+  req->in_tensors = g_new0 (GstTensorMemory, req->num_in);
+  req->out_mem = g_new0 (GstMemory *, req->num_out);
+  req->out_info = g_new0 (GstMapInfo, req->num_out);
+  req->out_tensors = g_new0 (GstTensorMemory, req->num_out);
+
+  if (gst_tensor_buffer_get_count (inbuf) != req->num_in) {
+    ml_loge_stacktrace
+        ("gst_tensor_filter_request_new: Input buffer has invalid number of memory blocks (%u), which is expected to be %u (the number of tensors).\n",
+        gst_tensor_buffer_get_count (inbuf), req->num_in);
+    goto error;
+  }
+
+  for (i = 0; i < req->num_in; i++) {
+    size = gst_tensor_filter_get_tensor_size (self, i, TRUE);
+    mem = gst_tensor_buffer_get_nth_memory (inbuf, i);
+
+    if (!gst_memory_map (mem, &req->in_info[i], GST_MAP_READ)) {
+      ml_loge_stacktrace
+          ("gst_tensor_filter_request_new: cannot map the %u'th input memory.\n",
+          i);
+      gst_memory_unref (mem);
+      goto error;
+    }
+    req->in_mem[i] = mem;
+
+    if (req->in_info[i].size != size) {
+      ml_loge_stacktrace
+          ("gst_tensor_filter_request_new: Input buffer size (%u'th memory chunk: %zd) is invalid, which is expected to be %zd.\n",
+          i, req->in_info[i].size, size);
+      goto error;
+    }
+
+    req->in_tensors[i].data = req->in_info[i].data;
+    req->in_tensors[i].size = size;
+  }
+
+  for (i = 0; i < req->num_out; i++) {
+    req->out_tensors[i].data = NULL;
+    req->out_tensors[i].size = gst_tensor_filter_get_tensor_size (self, i,
+        FALSE);
+
+    /* allocate memory if allocate_in_invoke is FALSE */
+    if (gst_tensor_filter_allocate_in_invoke (priv))
+      continue;
+
+    /* static tensors only, keep the header in front of the data (see transform) */
+    gst_tensor_info_convert_to_meta (gst_tensors_info_get_nth_info
+        (&prop->output_meta, i), &meta);
+    hsize = gst_tensor_meta_info_get_header_size (&meta);
+
+    mem = gst_tensor_filter_alloc_output (self, i,
+        req->out_tensors[i].size + hsize);
+    if (!mem || !gst_tensor_meta_info_reserve_header (&meta, mem) ||
+        !gst_memory_map (mem, &req->out_info[i], GST_MAP_WRITE)) {
+      ml_loge_stacktrace
+          ("gst_tensor_filter_request_new: cannot allocate and map the %u'th output memory (%zd bytes).\n",
+          i, req->out_tensors[i].size);
+      if (mem)
+        gst_memory_unref (mem);
+      goto error;
+    }
+    req->out_mem[i] = mem;
+    req->out_tensors[i].data = req->out_info[i].data;
+  }
+
+  return req;
+
+error:
+  gst_tensor_filter_request_free (req);
+  return NULL;
+}
+
+/**
+ * @brief Callback to notify that the invoke request is finished.
+ * @details This may be called from any thread (the worker or the subplugin).
+ */
+static void
+gst_tensor_filter_async_done (void *user_data, int status)
+{
+  GstTensorFilterRequest *req = (GstTensorFilterRequest *) user_data;
+  GstTensorFilter *self = req->self;
+  GstTensorFilterPrivate *priv = &self->priv;
+  gboolean need_profiling;
+
+  g_mutex_lock (&self->async_lock);
+  need_profiling = (req->start_time > 0);
+  if (need_profiling) {
+    priv->stat.latest_invoke_time = req->start_time;
+    record_statistics (priv);
+  }
+
+  req->status = status;
+  req->done = TRUE;
+  g_cond_broadcast (&self->async_cond);
+  g_mutex_unlock (&self->async_lock);
+
+  /* do not access the request, it may be released after done is set */
+  if (need_profiling)
+    track_latency (self);
+}
+
+/**
+ * @brief Start the invoke request.
+ */
+static void
+gst_tensor_filter_async_invoke (GstTensorFilter * self,
+    GstTensorFilterRequest * req)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  gint ret = -1;
+
+  if (priv->latency_mode > 0 || priv->throughput_mode > 0 ||
+      priv->latency_reporting)
+    req->start_time = g_get_real_time ();
+
+  if (GST_TF_FW_ASYNC (priv->fw)) {
+    ret = priv->fw->invoke_async (priv->fw, &priv->prop, priv->privateData,
+        req->in_tensors, req->out_tensors, gst_tensor_filter_async_done, req);
+    if (ret == 0)
+      return;
+
+    /* the request is not accepted, treat it as an error */
+    if (ret > 0)
+      ret = -ret;
+  } else {
+    GST_TF_FW_INVOKE_COMPAT (priv, ret, req->in_tensors, req->out_tensors);
+  }
+
+  gst_tensor_filter_async_done (req, ret);
+}
+
+/**
+ * @brief Worker to call the blocking invoke of the subplugin.
+ */
+static void
+gst_tensor_filter_async_worker (gpointer data, gpointer user_data)
+{
+  GstTensorFilterRequest *req = (GstTensorFilterRequest *) data;
+  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (user_data);
+  gboolean flushing;
+
+  g_mutex_lock (&self->async_lock);
+  flushing = self->async_flushing;
+  g_mutex_unlock (&self->async_lock);
+
+  /* skip the invoke, the request will be discarded */
+  if (flushing)
+    gst_tensor_filter_async_done (req, 1);
+  else
+    gst_tensor_filter_async_invoke (self, req);
+}
+
+/**
+ * @brief Make the output buffer of the finished request.
+ * @return The output buffer, NULL if the result is dropped.
+ */
+static GstFlowReturn
+gst_tensor_filter_async_get_output (GstTensorFilter * self,
+    GstTensorFilterRequest * req, GstBuffer ** outbuf)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterProperties *prop = &priv->prop;
+  GstMemory *mem;
+  guint i;
+
+  *outbuf = NULL;
+
+  if (req->status < 0) {
+    ml_loge_stacktrace
+        ("Calling invoke function (inference instance) of the tensor-filter subplugin (%s for %s) has failed with error code (%d).\n",
+        prop->fwname, TF_MODELNAME (prop), req->status);
+    return GST_FLOW_ERROR;
+  } else if (req->status > 0) {
+    /* drop this buffer */
+    return GST_FLOW_OK;
+  }
+
+  *outbuf = gst_buffer_new ();
+  gst_buffer_copy_into (*outbuf, req->inbuf, GST_BUFFER_COPY_METADATA, 0, -1);
+
+  for (i = 0; i < req->num_out; i++) {
+    if (req->out_mem[i]) {
+      gst_memory_unmap (req->out_mem[i], &req->out_info[i]);
+      mem = req->out_mem[i];
+      req->out_mem[i] = NULL;
+    } else {
+      mem = gst_tensor_filter_get_wrapped_mem (self,
+          req->out_tensors[i].data, req->out_tensors[i].size);
+    }
+
+    gst_tensor_buffer_append_memory (*outbuf, mem,
+        gst_tensors_info_get_nth_info (&prop->output_meta, i));
+  }
+
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief The src pad task to push the outputs in the order of the incoming buffers.
+ */
+static void
+gst_tensor_filter_async_loop (gpointer user_data)
+{
+  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (user_data);
+  GstPad *srcpad = GST_BASE_TRANSFORM_SRC_PAD (self);
+  GstTensorFilterRequest *req = NULL;
+  GstBuffer *outbuf;
+  GstFlowReturn ret;
+
+  g_mutex_lock (&self->async_lock);
+  while (!self->async_flushing) {
+    req = g_queue_peek_head (self->async_queue);
+    if (req && req->done)
+      break;
+
+    g_cond_wait (&self->async_cond, &self->async_lock);
+  }
+
+  if (self->async_flushing) {
+    g_mutex_unlock (&self->async_lock);
+    gst_pad_pause_task (srcpad);
+    return;
+  }
+  g_mutex_unlock (&self->async_lock);
+
+  /* only this task removes the request, keep it in flight until it is pushed */
+  ret = gst_tensor_filter_async_get_output (self, req, &outbuf);
+  if (outbuf)
+    ret = gst_pad_push (srcpad, outbuf);
+
+  g_mutex_lock (&self->async_lock);
+  g_queue_pop_head (self->async_queue);
+  gst_tensor_filter_request_free (req);
+  if (ret != GST_FLOW_OK)
+    self->async_flow = ret;
+  g_cond_broadcast (&self->async_cond);
+  g_mutex_unlock (&self->async_lock);
+
+  if (ret != GST_FLOW_OK) {
+    if (ret == GST_FLOW_ERROR || ret == GST_FLOW_NOT_NEGOTIATED) {
+      GST_ELEMENT_ERROR_BTRACE (self, STREAM, FAILED,
+          ("Failed to push the output of tensor-filter (%s:%s): %s.",
+              GST_STR_NULL (self->priv.prop.fwname),
+              TF_MODELNAME (&self->priv.prop), gst_flow_get_name (ret)));
+    }
+
+    gst_pad_pause_task (srcpad);
+  }
+}
+
+/**
+ * @brief Check whether the negotiated stream can be processed with asynchronous invoke.
+ * @return TRUE if the invoke requests are handed over to the worker (or invoke_async of the subplugin).
+ */
+static gboolean
+gst_tensor_filter_async_prepare (GstTensorFilter * self, gboolean out_flexible)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GError *error = NULL;
+
+  if (self->max_inflight == 0)
+    return FALSE;
+
+  if (self->batch_frames > 1) {
+    ml_logw
+        ("Micro-batching of tensor-filter is enabled. The property max-inflight (%u) is ignored.",
+        self->max_inflight);
+    return FALSE;
+  }
+
+  if (priv->prop.invoke_dynamic || out_flexible ||
+      gst_tensors_config_is_flexible (&priv->in_config) ||
+      priv->combi.in_combi_defined || priv->combi.out_combi_i_defined ||
+      priv->combi.out_combi_o_defined) {
+    ml_logw
+        ("Asynchronous invoke of tensor-filter requires static input and output tensors without invoke-dynamic and in/out combination. The property max-inflight (%u) is ignored.",
+        self->max_inflight);
+    return FALSE;
+  }
+
+  /* single worker, the invoke of a subplugin instance is not reentrant */
+  if (!GST_TF_FW_ASYNC (priv->fw) && self->async_pool == NULL) {
+    self->async_pool = g_thread_pool_new (gst_tensor_filter_async_worker,
+        self, 1, FALSE, &error);
+
+    if (!self->async_pool) {
+      ml_loge ("Failed to create the worker of tensor-filter: %s",
+          error ? error->message : "unknown error");
+      g_clear_error (&error);
+      return FALSE;
+    }
+  }
+
+  GST_INFO_OBJECT (self, "Asynchronous invoke is enabled, %u requests in flight.",
+      self->max_inflight);
+  return TRUE;
+}
+
+/**
+ * @brief Hand over the incoming buffer to the worker (or invoke_async of the subplugin).
+ * @details The upstream is blocked while max-inflight requests are pending.
+ */
+static GstFlowReturn
+gst_tensor_filter_async_submit (GstTensorFilter * self, GstBuffer * input)
+{
+  GstPad *srcpad = GST_BASE_TRANSFORM_SRC_PAD (self);
+  GstTensorFilterRequest *req;
+  GstFlowReturn ret;
+
+  g_mutex_lock (&self->async_lock);
+  while (!self->async_flushing && self->async_flow == GST_FLOW_OK &&
+      g_queue_get_length (self->async_queue) >= self->max_inflight)
+    g_cond_wait (&self->async_cond, &self->async_lock);
+
+  ret = self->async_flushing ? GST_FLOW_FLUSHING : self->async_flow;
+  g_mutex_unlock (&self->async_lock);
+
+  if (ret != GST_FLOW_OK) {
+    gst_buffer_unref (input);
+    return ret;
+  }
+
+  req = gst_tensor_filter_request_new (self, input);
+  if (!req)
+    return GST_FLOW_ERROR;
+
+  g_mutex_lock (&self->async_lock);
+  if (self->async_flushing) {
+    g_mutex_unlock (&self->async_lock);
+    gst_tensor_filter_request_free (req);
+    return GST_FLOW_FLUSHING;
+  }
+
+  g_queue_push_tail (self->async_queue, req);
+  gst_pad_start_task (srcpad, gst_tensor_filter_async_loop, self, NULL);
+  g_mutex_unlock (&self->async_lock);
+
+  if (self->async_pool)
+    g_thread_pool_push (self->async_pool, req, NULL);
+  else
+    gst_tensor_filter_async_invoke (self, req);
+
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief Wait until all requests in flight are pushed (e.g., before the serialized events).
+ */
+static GstFlowReturn
+gst_tensor_filter_async_drain (GstTensorFilter * self)
+{
+  GstFlowReturn ret;
+
+  g_mutex_lock (&self->async_lock);
+  while (!self->async_flushing && self->async_flow == GST_FLOW_OK &&
+      !g_queue_is_empty (self->async_queue))
+    g_cond_wait (&self->async_cond, &self->async_lock);
+
+  ret = self->async_flushing ? GST_FLOW_FLUSHING : self->async_flow;
+  g_mutex_unlock (&self->async_lock);
+
+  return ret;
+}
+
+/**
+ * @brief Receive the input buffer. optional vmethod of GstBaseTransform.
+ * @details With micro-batching, the incoming buffer is queued and the model is invoked when the batch is full or when the first queued frame has waited longer than batch-timeout.
+ * With asynchronous invoke, the incoming buffer is handed over to the worker and the output is pushed from the src pad task.
+ */
+static GstFlowReturn
+gst_tensor_filter_submit_input_buffer (GstBaseTransform * trans,
+    gboolean is_discont, GstBuffer * input)
+{
+  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (trans);
+  GstFlowReturn ret;
+  gint64 now;
+
+  if (self->batch_frames <= 1 && !self->async_mode) {
+    return GST_BASE_TRANSFORM_CLASS (parent_class)->submit_input_buffer (trans,
+        is_discont, input);
+  }
+
+  ret = _gst_tensor_filter_invoke_validate (trans, input);
+  if (ret != GST_FLOW_OK) {
+    gst_buffer_unref (input);
+    return (ret == GST_BASE_TRANSFORM_FLOW_DROPPED) ? GST_FLOW_OK : ret;
+  }
+
+  if (self->async_mode)
+    return gst_tensor_filter_async_submit (self, input);
+
+  now = g_get_monotonic_time ();
+  if (g_queue_is_empty (self->batch_in)) {
+    /* arm the batch timer with the first frame */
+    gst_tensor_filter_batch_set_start (self, now);
+    if (self->batch_timeout > 0)
+      gst_task_start (self->batch_task);
+  }
+  g_queue_push_tail (self->batch_in, input);
+
+  if (g_queue_get_length (self->batch_in) >= self->batch_frames ||
+      (self->batch_timeout > 0 &&
+          (now - self->batch_start) >=
+          (gint64) self->batch_timeout * G_TIME_SPAN_MILLISECOND)) {
+    return gst_tensor_filter_batch_invoke (self);
+  }
+
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief Get the output buffer to be pushed. optional vmethod of GstBaseTransform.
+ */
+static GstFlowReturn
+gst_tensor_filter_generate_output (GstBaseTransform * trans,
+    GstBuffer ** outbuf)
+{
+  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (trans);
+
+  if (self->async_mode) {
+    /* the outputs are pushed from the src pad task */
+    *outbuf = NULL;
+    return GST_FLOW_OK;
+  }
+
+  if (self->batch_frames <= 1 && g_queue_is_empty (self->batch_out)) {
+    return GST_BASE_TRANSFORM_CLASS (parent_class)->generate_output (trans,
+        outbuf);
+  }
+
+  *outbuf = g_queue_pop_head (self->batch_out);
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief Configure input and output tensor info from incaps.
+ * @param self "this" pointer
+ * @param incaps received caps for sink pad
+ * @return TRUE if fully configured
+ */
+static gboolean
+gst_tensor_filter_configure_tensor (GstTensorFilter * self,
+    const GstCaps * incaps)
+{
+  GstTensorFilterPrivate *priv;
+  GstTensorFilterProperties *prop;
+  GstStructure *structure;
+  GstTensorsConfig in_config, out_config;
+  GstTensorsInfo in_info, out_info;
+  gboolean flexible;
+
+  g_return_val_if_fail (incaps != NULL, FALSE);
+  priv = &self->priv;
+  prop = &priv->prop;
+  gst_tensors_config_init (&in_config);
+  gst_tensors_config_init (&out_config);
+  gst_tensors_info_init (&in_info);
+  gst_tensors_info_init (&out_info);
+
+  /**
+   * GstTensorFilter has to parse the tensor dimension and type from NN model.
+   * 1. Call functions getInputDimension and getOutputDimension to get the dimension and type.
+   * 2. If these functions are not defined, call setInputDimension with parsed info from caps.
+   * 3. If set-prop configured dimension, verify the dimension with fw callbacks.
+   */
+  gst_tensor_filter_load_tensor_info (&self->priv);
+
+  structure = gst_caps_get_structure (incaps, 0);
+  if (G_UNLIKELY (!structure)) {
+    gchar *capstr = gst_caps_to_string (incaps);
+    GST_ELEMENT_ERROR_BTRACE (self, STREAM, WRONG_TYPE,
+        ("%s:%u The input stream padcap is not appropriate. Cannot get structured information from the given padcap: '%s' (gst_caps_get_structure() has returned NULL.). Please check if the caps you've given is correct especially if you have applied caps-filter in front of tensor-filter (%s:%s).",
+            __func__, __LINE__, capstr, GST_STR_NULL (prop->fwname),
+            TF_MODELNAME (prop)));
+    g_free (capstr);
+    goto done;
+  }
+  if (G_UNLIKELY (!gst_tensors_config_from_structure (&in_config, structure))) {
+    gchar *capstr = gst_caps_to_string (incaps);
+    GST_ELEMENT_ERROR_BTRACE (self, STREAM, WRONG_TYPE,
+        ("%s:%u The input stream padcap is not appropriate. It is not a valid tensor stream (other/tensors) or a tensor stream with a few required entries missing. For example, dimesion and type are missing for a static tensor (format=static or other/tensor (single tensor)). The given padcap is '%s' for tensor-filter (%s:%s).",
+            __func__, __LINE__, capstr, GST_STR_NULL (prop->fwname),
+            TF_MODELNAME (prop)));
+    g_free (capstr);
+    goto done;
+  }
+
+  /**
+   * Check configuration from caps.
+   * If true, fully configured tensor info from caps.
+   */
+  if (!gst_tensors_config_validate (&in_config)) {
+    gchar *capstr = gst_caps_to_string (incaps);
+    GST_ELEMENT_ERROR_BTRACE (self, STREAM, WRONG_TYPE,
+        ("%s:%u The input stream padcaps cannot be validated. It is not a valid tensor stream for tensor_filter element. Input stream type for tensor_filter (%s:%s) is %s. tensor-filter could get config from the input padcap; however, it cannot be validated: framerate or format is not valid. Try a static tensor stream with a valid (0/1 is also valid!) framerate.",
+            __func__, __LINE__, GST_STR_NULL (prop->fwname),
+            TF_MODELNAME (prop), capstr));
+    g_free (capstr);
+    goto done;
+  }
+
+  if (!gst_tensor_filter_common_get_combined_in_info (priv, &in_config.info,
+          &in_info)) {
+    gchar *capstr = gst_caps_to_string (incaps);
+    GST_ELEMENT_ERROR_BTRACE (self, STREAM, WRONG_TYPE,
+        ("%s:%u Failed to configure combined input info for tensor-filter (%s:%s). The given padcap is '%s'. User has specified input combination (refer to the previous error log), which shuffles the order of tensors, which is not compatible with the given model. Please check the padcap, input combination, and tensor/dimension requirement of your neural network model.",
+            __func__, __LINE__, GST_STR_NULL (prop->fwname),
+            TF_MODELNAME (prop), capstr));
+    g_free (capstr);
+    goto done;
+  }
+
+  /* flexible tensor case, we cannot get the exact info from caps. */
+  flexible = gst_tensors_config_is_flexible (&in_config);
+
+  /** if set-property called and already has info, verify it! */
+  if (prop->input_meta.num_tensors > 0) {
+    if (flexible) {
       /**
        * If incoming tensor is flexible, we cannot validate tensor info here.
        * Need to compare buffer size in transform().
@@ -1362,6 +2637,11 @@ gst_tensor_filter_set_caps (GstBaseTransform * trans,
     return FALSE;
   }
 
+  self->batch_frames = gst_tensor_filter_batch_get_frames (self,
+      gst_tensors_config_is_flexible (&config));
+  self->async_mode = gst_tensor_filter_async_prepare (self,
+      gst_tensors_config_is_flexible (&config));
+
   gst_tensors_config_free (&config);
 
   return TRUE;
@@ -1464,6 +2744,26 @@ gst_tensor_filter_transform_size (GstBaseTransform * trans,
   return TRUE;
 }
 
+/**
+ * @brief Decide the allocator of the output memories. optional vmethod of BaseTransform
+ * @details The output memories are allocated with the allocator and params negotiated
+ * through the allocation query, and recycled in the pool of each output tensor.
+ */
+static gboolean
+gst_tensor_filter_decide_allocation (GstBaseTransform * trans,
+    GstQuery * query)
+{
+  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (trans);
+
+  if (!GST_BASE_TRANSFORM_CLASS (parent_class)->decide_allocation (trans,
+          query))
+    return FALSE;
+
+  /* the allocator may be changed, the pools are created again with the new one. */
+  gst_tensor_filter_release_pools (self);
+  return TRUE;
+}
+
 /**
  * @brief Event handler for sink pad of tensor filter.
  * @param trans "this" pointer
@@ -1477,6 +2777,12 @@ gst_tensor_filter_sink_event (GstBaseTransform * trans, GstEvent * event)
   GstTensorFilterPrivate *priv;
   self = GST_TENSOR_FILTER_CAST (trans);
   priv = &self->priv;
+
+  /* push the outputs in flight before the serialized events */
+  if (GST_EVENT_IS_SERIALIZED (event) &&
+      GST_EVENT_TYPE (event) != GST_EVENT_FLUSH_STOP)
+    gst_tensor_filter_async_drain (self);
+
   switch (GST_EVENT_TYPE (event)) {
     case GST_EVENT_CUSTOM_DOWNSTREAM:
     {
@@ -1497,6 +2803,28 @@ gst_tensor_filter_sink_event (GstBaseTransform * trans, GstEvent * event)
       gst_event_unref (event);
       return (ret == 0);
     }
+    case GST_EVENT_EOS:
+    case GST_EVENT_CAPS:
+      /* invoke the pending frames with the current configuration */
+      if (!g_queue_is_empty (self->batch_in))
+        gst_tensor_filter_batch_drain (self);
+      break;
+    case GST_EVENT_FLUSH_START:
+      /* wake up the src pad task and the upstream waiting for the requests */
+      g_mutex_lock (&self->async_lock);
+      self->async_flushing = TRUE;
+      g_cond_broadcast (&self->async_cond);
+      g_mutex_unlock (&self->async_lock);
+      break;
+    case GST_EVENT_FLUSH_STOP:
+      gst_tensor_filter_batch_clear (self);
+
+      /* the src pad task is paused while flushing */
+      GST_PAD_STREAM_LOCK (GST_BASE_TRANSFORM_SRC_PAD (self));
+      gst_tensor_filter_async_clear (self);
+      gst_tensor_filter_async_reset (self);
+      GST_PAD_STREAM_UNLOCK (GST_BASE_TRANSFORM_SRC_PAD (self));
+      break;
     default:
       break;
   }
@@ -1560,6 +2888,9 @@ gst_tensor_filter_start (GstBaseTransform * trans)
   if (priv->fw == NULL)
     return FALSE;
   gst_tensor_filter_common_open_fw (priv);
+  gst_tensor_filter_async_reset (self);
+  g_atomic_int_set (&self->out_pool_hits, 0);
+  g_atomic_int_set (&self->out_pool_misses, 0);
 
   return priv->prop.fw_opened;
 }
@@ -1576,6 +2907,47 @@ gst_tensor_filter_stop (GstBaseTransform * trans)
   GstTensorFilterPrivate *priv;
   self = GST_TENSOR_FILTER_CAST (trans);
   priv = &self->priv;
+  gst_tensor_filter_batch_clear (self);
+  self->batch_frames = 1;
+  /* the src pad task is stopped in change_state */
+  gst_tensor_filter_async_clear (self);
+  if (self->async_pool) {
+    g_thread_pool_free (self->async_pool, FALSE, TRUE);
+    self->async_pool = NULL;
+  }
+  self->async_mode = FALSE;
+  GST_DEBUG_OBJECT (self, "output pool hits %u, misses %u",
+      (guint) g_atomic_int_get (&self->out_pool_hits),
+      (guint) g_atomic_int_get (&self->out_pool_misses));
+  gst_tensor_filter_release_pools (self);
   gst_tensor_filter_common_close_fw (priv);
   return TRUE;
 }
+
+/**
+ * @brief Change state of tensor filter. optional vmethod of GstElement
+ */
+static GstStateChangeReturn
+gst_tensor_filter_change_state (GstElement * element,
+    GstStateChange transition)
+{
+  GstTensorFilter *self = GST_TENSOR_FILTER (element);
+
+  switch (transition) {
+    case GST_STATE_CHANGE_PAUSED_TO_READY:
+      /* stop the src pad task before deactivating the pads */
+      g_mutex_lock (&self->async_lock);
+      self->async_flushing = TRUE;
+      g_cond_broadcast (&self->async_cond);
+      g_mutex_unlock (&self->async_lock);
+
+      gst_pad_stop_task (GST_BASE_TRANSFORM_SRC_PAD (self));
+      gst_task_stop (self->batch_task);
+      gst_task_join (self->batch_task);
+      break;
+    default:
+      break;
+  }
+
+  return GST_ELEMENT_CLASS (parent_class)->change_state (element, transition);
+}
@@ -67,6 +67,28 @@ struct _GstTensorFilter
   GstClockTime prev_ts;  /**< previous timestamp */
   GstClockTimeDiff throttling_delay;  /**< throttling delay from tensor rate */
   GstClockTimeDiff throttling_accum;  /**< accumulated frame durations for throttling */
+
+  guint batch_size;  /**< max number of frames packed into a single invoke (property) */
+  guint batch_timeout;  /**< max waiting time (ms) of the first frame in a batch. 0 to wait until the batch is full (property) */
+  guint batch_frames;  /**< number of frames per invoke decided at set_caps. 1 if micro-batching is not available */
+  gint64 batch_start;  /**< monotonic time (usec) when the first frame of the pending batch arrived, 0 if no frame is pending (protected by async_lock) */
+  GQueue *batch_in;  /**< pending input buffers to be packed into the next invoke */
+  GQueue *batch_out;  /**< output buffers split from the batched invoke, to be pushed */
+  GstTask *batch_task;  /**< timer invoking the pending batch when batch-timeout expires */
+  GRecMutex batch_task_lock;  /**< stream lock of batch_task */
+
+  guint max_inflight;  /**< max number of invoke requests in flight (property). 0 for synchronous invoke */
+  gboolean async_mode;  /**< TRUE if the invoke runs asynchronously, decided at set_caps */
+  gboolean async_flushing;  /**< TRUE while flushing or stopping, pending requests are discarded and the batch timer is paused */
+  GstFlowReturn async_flow;  /**< the last flow return of the src pad task */
+  GQueue *async_queue;  /**< invoke requests in flight, in the order of the incoming buffers */
+  GThreadPool *async_pool;  /**< worker calling the blocking invoke if the subplugin does not support invoke_async */
+  GMutex async_lock;  /**< lock for the requests in flight and the batch timer */
+  GCond async_cond;  /**< signalled when a request is done or pushed, or the batch timer is armed */
+
+  GPtrArray *out_pools;  /**< recyclable output memories of each output tensor */
+  guint out_pool_hits;  /**< number of output memories reused from the pools (atomic) */
+  guint out_pool_misses;  /**< number of output memories newly allocated (atomic) */
 };
 
 /**
@@ -519,6 +519,8 @@ gst_tensor_filter_properties_init (GstTensorFilterProperties * prop)
   gst_tensors_info_init (&prop->output_meta);
   gst_tensors_layout_init (prop->output_layout);
   gst_tensors_rank_init (prop->output_ranks);
+
+  prop->batch_size = 1;
 }
 
 /**
@@ -536,6 +538,7 @@ gst_tensor_filter_framework_info_init (GstTensorFilterFrameworkInfo * info)
   info->accl_auto = -1;
   info->accl_default = -1;
   info->statistics = NULL;
+  info->max_batch_size = 0;
 }
 
 /**
@@ -1044,6 +1047,143 @@ gst_tensor_filter_common_init_property (GstTensorFilterPrivate * priv)
   gst_tensors_config_init (&priv->out_config);
 }
 
+/**
+ * @brief Create the set of interpreters in the shared model pool.
+ */
+static GstTensorFilterSharedModelSet *
+_shared_model_set_new (void **interpreters, guint num_interpreters)
+{
+  GstTensorFilterSharedModelSet *set;
+  guint i;
+
+  set = g_new0 (GstTensorFilterSharedModelSet, 1);
+  set->num_slots = num_interpreters;
+  set->slots = g_new0 (GstTensorFilterSharedModelSlot, num_interpreters);
+
+  for (i = 0; i < num_interpreters; i++) {
+    set->slots[i].interpreter = interpreters[i];
+    set->slots[i].state = SHARED_MODEL_SLOT_FREE;
+    set->slots[i].set = set;
+  }
+
+  return set;
+}
+
+/**
+ * @brief Destroy the interpreter of the replaced set if it is not in use.
+ * @details Both the releasing thread and the replacing thread try this, and only one of them destroys the interpreter.
+ */
+static void
+_shared_model_slot_retire (GstTensorFilterSharedModelPool * pool,
+    GstTensorFilterSharedModelSlot * slot)
+{
+  if (g_atomic_int_compare_and_exchange (&slot->state,
+          SHARED_MODEL_SLOT_FREE, SHARED_MODEL_SLOT_RETIRED)) {
+    if (pool->free_callback)
+      pool->free_callback (slot->interpreter);
+    slot->interpreter = NULL;
+  }
+}
+
+/**
+ * @brief Mark the set as replaced and destroy the interpreters not in use.
+ */
+static void
+_shared_model_set_retire (GstTensorFilterSharedModelPool * pool,
+    GstTensorFilterSharedModelSet * set)
+{
+  guint i;
+
+  g_atomic_int_set (&set->retired, TRUE);
+
+  for (i = 0; i < set->num_slots; i++)
+    _shared_model_slot_retire (pool, &set->slots[i]);
+}
+
+/**
+ * @brief Try to acquire a free interpreter from the current set of the pool.
+ * @return The model interpreter. NULL if all interpreters are in use.
+ */
+static void *
+_shared_model_pool_try_acquire (GstTensorFilterSharedModelPool * pool,
+    void **handle)
+{
+  GstTensorFilterSharedModelSet *set;
+  GstTensorFilterSharedModelSlot *slot;
+  guint i;
+
+  while (TRUE) {
+    /* the replaced set is not freed until the pool is destroyed */
+    set = g_atomic_pointer_get (&pool->current);
+
+    for (i = 0; i < set->num_slots; i++) {
+      slot = &set->slots[i];
+
+      if (!g_atomic_int_compare_and_exchange (&slot->state,
+              SHARED_MODEL_SLOT_FREE, SHARED_MODEL_SLOT_BUSY))
+        continue;
+
+      if (g_atomic_int_get (&set->retired)) {
+        /* the set has been replaced, retry with the new one */
+        g_atomic_int_set (&slot->state, SHARED_MODEL_SLOT_FREE);
+        _shared_model_slot_retire (pool, slot);
+        break;
+      }
+
+      *handle = slot;
+      return slot->interpreter;
+    }
+
+    if (i == set->num_slots)
+      return NULL;
+  }
+}
+
+/**
+ * @brief Create the pool of interpreters.
+ */
+static GstTensorFilterSharedModelPool *
+_shared_model_pool_new (void **interpreters, guint num_interpreters,
+    void (*free_callback) (void *))
+{
+  GstTensorFilterSharedModelPool *pool;
+
+  pool = g_new0 (GstTensorFilterSharedModelPool, 1);
+  pool->current = _shared_model_set_new (interpreters, num_interpreters);
+  pool->retired_sets = NULL;
+  pool->free_callback = free_callback;
+  pool->waiters = 0;
+  g_mutex_init (&pool->lock);
+  g_cond_init (&pool->cond);
+
+  return pool;
+}
+
+/**
+ * @brief Destroy the pool and the interpreters. No instance should use the pool.
+ */
+static void
+_shared_model_pool_free (GstTensorFilterSharedModelPool * pool)
+{
+  GstTensorFilterSharedModelSet *set;
+  GSList *list;
+
+  _shared_model_set_retire (pool, pool->current);
+  pool->retired_sets = g_slist_prepend (pool->retired_sets, pool->current);
+  pool->current = NULL;
+
+  for (list = pool->retired_sets; list != NULL; list = list->next) {
+    set = (GstTensorFilterSharedModelSet *) list->data;
+    g_free (set->slots);
+    g_free (set);
+  }
+
+  g_slist_free (pool->retired_sets);
+  g_mutex_clear (&pool->lock);
+  g_cond_clear (&pool->cond);
+  g_free (pool);
+}
+
 /**
  * @brief Free the properties for tensor-filter.
  */
@@ -1080,22 +1220,6 @@ gst_tensor_filter_common_free_property (GstTensorFilterPrivate * priv)
       g_free (latency);
     g_queue_free (queue);
   }
-
-  G_LOCK (shared_model_table);
-  if (shared_model_table) {
-    GstTensorFilterSharedModelRepresenatation *rep;
-    GList *value = g_hash_table_get_values (shared_model_table);
-
-    while (value) {
-      rep = (GstTensorFilterSharedModelRepresenatation *) value->data;
-      g_list_free (rep->referred_list);
-      value = g_list_next (value);
-    }
-
-    g_hash_table_destroy (shared_model_table);
-    shared_model_table = NULL;
-  }
-  G_UNLOCK (shared_model_table);
 }
 
 /**
@@ -3061,7 +3185,9 @@ nnstreamer_filter_shared_model_remove (void *instance, const char *key,
 
   /* remove key from table if list is empty */
   if (g_list_length (model_rep->referred_list) == 0) {
-    if (free_callback)
+    if (model_rep->pool)
+      _shared_model_pool_free (model_rep->pool);
+    else if (free_callback)
       free_callback (model_rep->shared_interpreter);
     g_hash_table_remove (shared_model_table, key);
   }
@@ -3101,7 +3227,10 @@ nnstreamer_filter_shared_model_replace (void *instance, const char *key,
 
   G_LOCK (shared_model_table);
   model_rep = g_hash_table_lookup (shared_model_table, key);
-  if (model_rep) {
+  if (model_rep && model_rep->pool) {
+    ml_loge ("The shared model of the key %s has a pool of interpreters. "
+        "Use nnstreamer_filter_shared_model_pool_replace() instead.", key);
+  } else if (model_rep) {
     itr = model_rep->referred_list;
     while (itr) {
       replace_callback (itr->data, new_interpreter);
@@ -3113,3 +3242,276 @@ nnstreamer_filter_shared_model_replace (void *instance, const char *key,
   }
   G_UNLOCK (shared_model_table);
 }
+
+/* extern functions for shared model representation */
+/**
+ * @brief Insert the pool of model representations loaded from the same model and get the first one.
+ *        The instances sharing the key acquire an interpreter from the pool for each invoke, so they can run in parallel.
+ * @param[in] instance The instance that is sharing the model representation. It will be registered at the referred list.
+ * @param[in] key The key for shared model.
+ * @param[in] interpreters The array of interpreters to be shared. The pool keeps the interpreters, not the array.
+ * @param[in] num_interpreters The number of interpreters.
+ * @param[in] free_callback The callback function to destroy the interpreter in the pool.
+ * @return The first model interpreter inserted. NULL if it is already inserted.
+ */
+void *
+nnstreamer_filter_shared_model_insert_pool_and_get (void *instance, char *key,
+    void **interpreters, unsigned int num_interpreters,
+    void (*free_callback) (void *))
+{
+  GstTensorFilterSharedModelRepresenatation *model_rep;
+  void *interpreter = NULL;
+  guint i;
+
+  /* validate arguments */
+  if (!instance) {
+    ml_loge ("The instance should NOT be NULL!");
+    return NULL;
+  }
+  if (!key) {
+    ml_loge ("The key should NOT be NULL!");
+    return NULL;
+  }
+  if (!interpreters || num_interpreters == 0) {
+    ml_loge ("The interpreters should NOT be empty!");
+    return NULL;
+  }
+  for (i = 0; i < num_interpreters; i++) {
+    if (!interpreters[i]) {
+      ml_loge ("The interpreter should NOT be NULL!");
+      return NULL;
+    }
+  }
+
+  G_LOCK (shared_model_table);
+  if (!shared_model_table) {
+    ml_loge ("The shared model representation is not supported properly!");
+    goto done;
+  }
+
+  if (g_hash_table_lookup (shared_model_table, key)) {
+    /**
+     * Internal error case.
+     * The interpreter already exists in shared table, do not insert and return null.
+     */
+    goto done;
+  }
+
+  interpreter = interpreters[0];
+  model_rep = (GstTensorFilterSharedModelRepresenatation *)
+      g_malloc0 (sizeof (GstTensorFilterSharedModelRepresenatation));
+  model_rep->shared_interpreter = interpreter;
+  model_rep->referred_list = g_list_append (model_rep->referred_list, instance);
+  model_rep->pool = _shared_model_pool_new (interpreters, num_interpreters,
+      free_callback);
+  g_hash_table_insert (shared_model_table, g_strdup (key),
+      (gpointer) model_rep);
+
+done:
+  G_UNLOCK (shared_model_table);
+  return interpreter;
+}
+
+/* extern functions for shared model representation */
+/**
+ * @brief Get the pool of the shared model representation.
+ * @param[in] key The key to find the shared model.
+ * @return The pool handle, which is valid until the instance is removed from the referred list. NULL if the key does not have a pool.
+ */
+void *
+nnstreamer_filter_shared_model_get_pool (const char *key)
+{
+  GstTensorFilterSharedModelRepresenatation *model_rep = NULL;
+
+  if (!key) {
+    ml_loge ("The key should NOT be NULL!");
+    return NULL;
+  }
+
+  G_LOCK (shared_model_table);
+  if (shared_model_table)
+    model_rep = g_hash_table_lookup (shared_model_table, key);
+  G_UNLOCK (shared_model_table);
+
+  return model_rep ? model_rep->pool : NULL;
+}
+
+/* extern functions for shared model representation */
+/**
+ * @brief Acquire an interpreter from the pool. This waits until an interpreter is released if all interpreters are in use.
+ * @param[in] pool The pool handle.
+ * @param[out] handle The handle to release the interpreter.
+ * @return The model interpreter. NULL if the arguments are invalid.
+ */
+void *
+nnstreamer_filter_shared_model_pool_acquire (void *pool, void **handle)
+{
+  GstTensorFilterSharedModelPool *model_pool;
+  void *interpreter;
+
+  if (!pool || !handle) {
+    ml_loge ("The pool and handle should NOT be NULL!");
+    return NULL;
+  }
+
+  model_pool = (GstTensorFilterSharedModelPool *) pool;
+
+  interpreter = _shared_model_pool_try_acquire (model_pool, handle);
+  if (interpreter)
+    return interpreter;
+
+  /**
+   * All interpreters are in use. Rescan under the lock, the releasing thread
+   * broadcasts with the lock held so that the wake-up is not lost.
+   */
+  g_mutex_lock (&model_pool->lock);
+  g_atomic_int_inc (&model_pool->waiters);
+  while (!(interpreter = _shared_model_pool_try_acquire (model_pool, handle)))
+    g_cond_wait (&model_pool->cond, &model_pool->lock);
+  g_atomic_int_add (&model_pool->waiters, -1);
+  g_mutex_unlock (&model_pool->lock);
+
+  return interpreter;
+}
+
+/* extern functions for shared model representation */
+/**
+ * @brief Release the interpreter acquired from the pool.
+ * @param[in] pool The pool handle.
+ * @param[in] handle The handle given by nnstreamer_filter_shared_model_pool_acquire().
+ */
+void
+nnstreamer_filter_shared_model_pool_release (void *pool, void *handle)
+{
+  GstTensorFilterSharedModelPool *model_pool;
+  GstTensorFilterSharedModelSlot *slot;
+
+  if (!pool || !handle) {
+    ml_loge ("The pool and handle should NOT be NULL!");
+    return;
+  }
+
+  model_pool = (GstTensorFilterSharedModelPool *) pool;
+  slot = (GstTensorFilterSharedModelSlot *) handle;
+
+  g_atomic_int_set (&slot->state, SHARED_MODEL_SLOT_FREE);
+
+  /* destroy the old interpreter if the model is reloaded while in use */
+  if (g_atomic_int_get (&slot->set->retired))
+    _shared_model_slot_retire (model_pool, slot);
+
+  if (g_atomic_int_get (&model_pool->waiters) > 0) {
+    g_mutex_lock (&model_pool->lock);
+    g_cond_broadcast (&model_pool->cond);
+    g_mutex_unlock (&model_pool->lock);
+  }
+}
+
+/* extern functions for shared model representation */
+/**
+ * @brief Call the function for each interpreter in the pool (e.g., to update the tensor info).
+ * @param[in] pool The pool handle.
+ * @param[in] func The function to be called. Stop iterating if it returns non-zero.
+ * @param[in] user_data The data to be passed to the function.
+ * @return 0 if OK. The return value of func if it fails.
+ */
+int
+nnstreamer_filter_shared_model_pool_foreach (void *pool,
+    int (*func) (void *interpreter, void *user_data), void *user_data)
+{
+  GstTensorFilterSharedModelPool *model_pool;
+  GstTensorFilterSharedModelSet *set;
+  guint i;
+  int ret = 0;
+
+  if (!pool || !func) {
+    ml_loge ("The pool and function should NOT be NULL!");
+    return -EINVAL;
+  }
+
+  model_pool = (GstTensorFilterSharedModelPool *) pool;
+
+  /* the set is not replaced while iterating */
+  g_mutex_lock (&model_pool->lock);
+  set = model_pool->current;
+  for (i = 0; i < set->num_slots; i++) {
+    ret = func (set->slots[i].interpreter, user_data);
+    if (ret != 0)
+      break;
+  }
+  g_mutex_unlock (&model_pool->lock);
+
+  return ret;
+}
+
+/* extern functions for shared model representation */
+/**
+ * @brief Replace the whole pool atomically with the new interpreters.
+ *        `replace_callback` is called iterating instances in referred list with the first new interpreter.
+ *        The old interpreters are destroyed with the free callback of the pool when they are released.
+ * @param[in] instance The instance that is sharing the model representation.
+ * @param[in] key The key to find the shared model.
+ * @param[in] new_interpreters The array of new interpreters.
+ * @param[in] num_interpreters The number of new interpreters.
+ * @param[in] replace_callback The callback function to replace with new interpreter.
+ * @return TRUE if the pool is replaced. FALSE if failed to replace it.
+ */
+int
+nnstreamer_filter_shared_model_pool_replace (void *instance, const char *key,
+    void **new_interpreters, unsigned int num_interpreters,
+    void (*replace_callback) (void *, void *))
+{
+  GstTensorFilterSharedModelRepresenatation *model_rep;
+  GstTensorFilterSharedModelPool *pool;
+  GstTensorFilterSharedModelSet *old_set, *new_set;
+  GList *itr;
+  int ret = FALSE;
+  UNUSED (instance);
+
+  if (!key) {
+    ml_loge ("The key should NOT be NULL!");
+    return FALSE;
+  }
+  if (!new_interpreters || num_interpreters == 0) {
+    ml_loge ("The interpreters should NOT be empty!");
+    return FALSE;
+  }
+
+  G_LOCK (shared_model_table);
+  if (!shared_model_table) {
+    ml_loge ("The shared model representation is not supported properly!");
+    goto done;
+  }
+
+  model_rep = g_hash_table_lookup (shared_model_table, key);
+  if (!model_rep || !model_rep->pool) {
+    ml_loge ("There is no pool of the key: %s", key);
+    goto done;
+  }
+
+  pool = model_rep->pool;
+  new_set = _shared_model_set_new (new_interpreters, num_interpreters);
+
+  /* swap the whole set, new invokes acquire the new interpreters */
+  g_mutex_lock (&pool->lock);
+  old_set = pool->current;
+  g_atomic_pointer_set (&pool->current, new_set);
+  pool->retired_sets = g_slist_prepend (pool->retired_sets, old_set);
+  /* wake up the waiters to acquire the new interpreters */
+  g_cond_broadcast (&pool->cond);
+  g_mutex_unlock (&pool->lock);
+
+  model_rep->shared_interpreter = new_interpreters[0];
+  if (replace_callback) {
+    for (itr = model_rep->referred_list; itr != NULL; itr = itr->next)
+      replace_callback (itr->data, new_interpreters[0]);
+  }
+
+  /* the interpreters in use are destroyed when they are released */
+  _shared_model_set_retire (pool, old_set);
+  ret = TRUE;
+
+done:
+  G_UNLOCK (shared_model_table);
+  return ret;
+}
@@ -106,7 +106,12 @@ enum
   PROP_SHARED_TENSOR_FILTER_KEY,
   PROP_LATENCY_REPORT,
   PROP_INVOKE_DYNAMIC,
-  PROP_CONFIG
+  PROP_CONFIG,
+  PROP_BATCH_SIZE,
+  PROP_BATCH_TIMEOUT,
+  PROP_MAX_INFLIGHT,
+  PROP_OUTPUT_POOL_HITS,
+  PROP_OUTPUT_POOL_MISSES
 };
 
 /**
@@ -136,12 +141,55 @@ typedef struct _GstTensorFilterCombination
   gboolean out_combi_o_defined;/**< True if output combination from model output is defined */
 } GstTensorFilterCombination;
 
+/**
+ * @brief State of the interpreter in the shared model pool.
+ */
+typedef enum
+{
+  SHARED_MODEL_SLOT_FREE = 0, /**< ready to be acquired */
+  SHARED_MODEL_SLOT_BUSY, /**< acquired by an instance */
+  SHARED_MODEL_SLOT_RETIRED /**< replaced and destroyed */
+} GstTensorFilterSharedModelSlotState;
+
+typedef struct _GstTensorFilterSharedModelSet GstTensorFilterSharedModelSet;
+
+/**
+ * @brief Data Structure for the interpreter in the shared model pool
+ */
+typedef struct {
+  void *interpreter; /**< the model representation */
+  gint state; /**< GstTensorFilterSharedModelSlotState, updated atomically */
+  GstTensorFilterSharedModelSet *set; /**< the set that includes this slot */
+} GstTensorFilterSharedModelSlot;
+
+/**
+ * @brief Data Structure for the interpreters loaded from the same model
+ */
+struct _GstTensorFilterSharedModelSet {
+  guint num_slots; /**< the number of interpreters */
+  GstTensorFilterSharedModelSlot *slots; /**< the interpreters */
+  gint retired; /**< TRUE if the set is replaced, updated atomically */
+};
+
+/**
+ * @brief Data Structure for the pool of interpreters sharing the same key
+ */
+typedef struct {
+  GstTensorFilterSharedModelSet *current; /**< the set to be acquired, swapped atomically when the model is reloaded */
+  GSList *retired_sets; /**< the replaced sets, released with the pool */
+  void (*free_callback) (void *); /**< the callback to destroy the interpreter */
+  gint waiters; /**< the number of threads waiting for a free interpreter */
+  GMutex lock; /**< lock to wait for a free interpreter and to replace the set */
+  GCond cond; /**< signalled when an interpreter is released */
+} GstTensorFilterSharedModelPool;
+
 /**
  * @brief Data Structure to store shared table
  */
 typedef struct {
   void *shared_interpreter; /**< the model representation for each sub-plugins */
   GList *referred_list; /**< the referred list about the instances sharing the same key */
+  GstTensorFilterSharedModelPool *pool; /**< the pool of interpreters. NULL if a single interpreter is shared */
 } GstTensorFilterSharedModelRepresenatation;
 
 /**
@@ -45,6 +45,7 @@ typedef struct _internal_data
   GstTensorsInfo out_info;
   void *data; /**< The easy-filter writer's data */
   NNS_custom_invoke_dynamic func_dynamic;
+  int max_batch_size; /**< The maximum number of frames func processes at once (0 if func takes a single frame) */
 } internal_data;
 
 /**
@@ -69,17 +70,18 @@ custom_free_internal_data (internal_data * data)
 }
 
 /**
- * @brief Register the custom-easy tensor function. More info in .h
+ * @brief Internal function to register the custom-easy tensor function with the maximum batch size.
  * @return 0 if success. -ERRNO if error.
  */
-int
-NNS_custom_easy_register (const char *modelname,
+static int
+custom_easy_register_internal (const char *modelname,
     NNS_custom_invoke func, void *data,
-    const GstTensorsInfo * in_info, const GstTensorsInfo * out_info)
+    const GstTensorsInfo * in_info, const GstTensorsInfo * out_info,
+    int max_batch_size)
 {
   internal_data *ptr;
 
-  if (!func || !in_info || !out_info)
+  if (!func || !in_info || !out_info || max_batch_size < 0)
     return -EINVAL;
 
   if (!gst_tensors_info_validate (in_info) ||
@@ -93,6 +95,7 @@ NNS_custom_easy_register (const char *modelname,
 
   ptr->func = func;
   ptr->data = data;
+  ptr->max_batch_size = max_batch_size;
   gst_tensors_info_copy (&ptr->in_info, in_info);
   gst_tensors_info_copy (&ptr->out_info, out_info);
 
@@ -103,6 +106,36 @@ NNS_custom_easy_register (const char *modelname,
   return -EINVAL;
 }
 
+/**
+ * @brief Register the custom-easy tensor function. More info in .h
+ * @return 0 if success. -ERRNO if error.
+ */
+int
+NNS_custom_easy_register (const char *modelname,
+    NNS_custom_invoke func, void *data,
+    const GstTensorsInfo * in_info, const GstTensorsInfo * out_info)
+{
+  return custom_easy_register_internal (modelname, func, data, in_info,
+      out_info, 0);
+}
+
+/**
+ * @brief Register the custom-easy tensor function for batched invoke. More info in .h
+ * @return 0 if success. -ERRNO if error.
+ */
+int
+NNS_custom_easy_batch_register (const char *modelname,
+    NNS_custom_invoke func, void *data,
+    const GstTensorsInfo * in_info, const GstTensorsInfo * out_info,
+    int max_batch_size)
+{
+  if (max_batch_size < 1)
+    return -EINVAL;
+
+  return custom_easy_register_internal (modelname, func, data, in_info,
+      out_info, max_batch_size);
+}
+
 
 /**
  * @brief Register the custom-easy tensor function. More info in .h
@@ -279,9 +312,9 @@ custom_getFrameworkInfo (const GstTensorFilterFramework * self,
     const GstTensorFilterProperties * prop, void *private_data,
     GstTensorFilterFrameworkInfo * fw_info)
 {
+  runtime_data *rd = (runtime_data *) private_data;
   UNUSED (self);
   UNUSED (prop);
-  UNUSED (private_data);
   fw_info->name = fw_name;
   fw_info->allow_in_place = 0;
   fw_info->allocate_in_invoke = 0;
@@ -289,6 +322,8 @@ custom_getFrameworkInfo (const GstTensorFilterFramework * self,
   fw_info->verify_model_path = 0;
   fw_info->hw_list = NULL;
   fw_info->num_hw = 0;
+  /* only the function registered with NNS_custom_easy_batch_register takes a batch */
+  fw_info->max_batch_size = (rd && rd->model) ? rd->model->max_batch_size : 0;
 
   return 0;
 }
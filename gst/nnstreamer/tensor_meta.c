@@ -51,6 +51,7 @@ gst_meta_query_init (GstMeta * meta, gpointer params, GstBuffer * buffer)
   UNUSED (params);
   UNUSED (buffer);
   emeta->client_id = 0;
+  emeta->request_id = -1;
   return TRUE;
 }
 
@@ -77,6 +78,7 @@ gst_meta_query_transform (GstBuffer * transbuf, GstMeta * meta,
   UNUSED (type);
   UNUSED (data);
   dest_meta->client_id = src_meta->client_id;
+  dest_meta->request_id = src_meta->request_id;
   return TRUE;
 }
 
@@ -28,6 +28,7 @@ typedef struct
   GstMeta meta;
 
   query_client_id_t client_id;
+  int64_t request_id; /**< sequence id of the request to be echoed in the reply, -1 if not given */
 } GstMetaQuery;
 
 /**
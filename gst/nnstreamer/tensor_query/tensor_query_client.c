@@ -20,6 +20,7 @@
 #include <glib.h>
 #include <string.h>
 #include "tensor_query_common.h"
+#include "nnstreamer_edge_data.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -45,6 +46,8 @@ enum
   PROP_CONNECT_TYPE,
   PROP_TOPIC,
   PROP_TIMEOUT,
+  PROP_MAX_OUTSTANDING,
+  PROP_DROP_STALE,
   PROP_SILENT,
 };
 
@@ -53,8 +56,32 @@ enum
 #define TCP_DEFAULT_SRV_SRC_PORT 3000
 #define TCP_DEFAULT_CLIENT_SRC_PORT 3001
 #define DEFAULT_CLIENT_TIMEOUT  0
+#define DEFAULT_MAX_OUTSTANDING 1
+#define DEFAULT_DROP_STALE FALSE
 #define DEFAULT_SILENT TRUE
 
+/**
+ * @brief Timeout (in ms) of a request in windowed mode when timeout property is 0.
+ */
+#define DEFAULT_REQUEST_TIMEOUT 10000
+
+/**
+ * @brief Max number of requests in flight.
+ */
+#define MAX_OUTSTANDING_LIMIT 64
+
+/**
+ * @brief Request sent to the server and waiting for the reply (windowed mode).
+ */
+typedef struct
+{
+  gint64 seq; /**< sequence id of the request */
+  gint64 deadline; /**< monotonic time (usec) to give up the request */
+  GstBuffer *meta_buf; /**< empty buffer holding the metadata of the incoming buffer */
+  nns_edge_data_h reply; /**< received reply, NULL if not arrived yet */
+  gboolean pushing; /**< TRUE while the reply is pushed by the src pad task */
+} GstTensorQueryRequest;
+
 GST_DEBUG_CATEGORY_STATIC (gst_tensor_query_client_debug);
 #define GST_CAT_DEFAULT gst_tensor_query_client_debug
 
@@ -91,6 +118,8 @@ static GstFlowReturn gst_tensor_query_client_chain (GstPad * pad,
     GstObject * parent, GstBuffer * buf);
 static GstCaps *gst_tensor_query_client_query_caps (GstTensorQueryClient * self,
     GstPad * pad, GstCaps * filter);
+static GstStateChangeReturn gst_tensor_query_client_change_state (GstElement *
+    element, GstStateChange transition);
 
 /**
  * @brief initialize the class
@@ -107,6 +136,8 @@ gst_tensor_query_client_class_init (GstTensorQueryClientClass * klass)
   gobject_class->set_property = gst_tensor_query_client_set_property;
   gobject_class->get_property = gst_tensor_query_client_get_property;
   gobject_class->finalize = gst_tensor_query_client_finalize;
+  gstelement_class->change_state =
+      GST_DEBUG_FUNCPTR (gst_tensor_query_client_change_state);
 
   /** install property goes here */
   g_object_class_install_property (gobject_class, PROP_HOST,
@@ -145,6 +176,19 @@ gst_tensor_query_client_class_init (GstTensorQueryClientClass * klass)
           "A timeout value (in ms) to wait message from query server after sending buffer to server. 0 means no wait.",
           0, G_MAXUINT, DEFAULT_CLIENT_TIMEOUT,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_MAX_OUTSTANDING,
+      g_param_spec_uint ("max-outstanding", "Max outstanding requests",
+          "The max number of requests sent to query server without waiting for the reply. "
+          "1 means the client waits for the reply of each request. "
+          "If larger than 1, the requests are tagged with a sequence id, the replies are pushed in the order of requests "
+          "and the timeout (in ms) is applied to each request (0 means the default, 10 seconds).",
+          1, MAX_OUTSTANDING_LIMIT, DEFAULT_MAX_OUTSTANDING,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_DROP_STALE,
+      g_param_spec_boolean ("drop-stale", "Drop stale requests",
+          "In windowed mode (max-outstanding > 1), give up the pending requests older than a received reply "
+          "instead of waiting for them until timeout.",
+          DEFAULT_DROP_STALE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
   gst_element_class_add_pad_template (gstelement_class,
       gst_static_pad_template_get (&sinktemplate));
@@ -190,8 +234,45 @@ gst_tensor_query_client_init (GstTensorQueryClient * self)
   self->topic = NULL;
   self->in_caps_str = NULL;
   self->timeout = DEFAULT_CLIENT_TIMEOUT;
+  self->max_outstanding = DEFAULT_MAX_OUTSTANDING;
+  self->drop_stale = DEFAULT_DROP_STALE;
+  self->request_seq = 0;
+  self->requests = g_queue_new ();
   self->edge_h = NULL;
-  self->msg_queue = g_async_queue_new ();
+  g_mutex_init (&self->lock);
+  g_cond_init (&self->cond);
+  self->replies = g_queue_new ();
+  self->flushing = FALSE;
+  self->flow = GST_FLOW_OK;
+  self->shm_writer = NULL;
+  self->shm_reader = gst_tensor_query_shm_reader_new ();
+  self->shm_peer = 0;
+}
+
+/**
+ * @brief Drop the received reply without pushing it.
+ * The slot of the reply in shared memory is returned to the server.
+ */
+static void
+gst_tensor_query_client_drop_reply (GstTensorQueryClient * self,
+    nns_edge_data_h data_h)
+{
+  if (self->connect_type == QUERY_CONNECT_TYPE_SHM)
+    gst_tensor_query_shm_discard (self->shm_reader, data_h);
+  nns_edge_data_destroy (data_h);
+}
+
+/**
+ * @brief Free the request in flight.
+ */
+static void
+gst_tensor_query_request_free (GstTensorQueryClient * self,
+    GstTensorQueryRequest * req)
+{
+  if (req->reply)
+    gst_tensor_query_client_drop_reply (self, req->reply);
+  gst_buffer_unref (req->meta_buf);
+  g_free (req);
 }
 
 /**
@@ -201,6 +282,7 @@ static void
 gst_tensor_query_client_finalize (GObject * object)
 {
   GstTensorQueryClient *self = GST_TENSOR_QUERY_CLIENT (object);
+  GstTensorQueryRequest *req;
   nns_edge_data_h data_h;
 
   g_free (self->host);
@@ -212,20 +294,29 @@ gst_tensor_query_client_finalize (GObject * object)
   g_free (self->in_caps_str);
   self->in_caps_str = NULL;
 
-  while ((data_h = g_async_queue_try_pop (self->msg_queue))) {
-    nns_edge_data_destroy (data_h);
-  }
-
-  if (self->msg_queue) {
-    g_async_queue_unref (self->msg_queue);
-    self->msg_queue = NULL;
-  }
-
+  /* release the handle first, no more reply is received after this */
   if (self->edge_h) {
     nns_edge_release_handle (self->edge_h);
     self->edge_h = NULL;
   }
 
+  while ((data_h = g_queue_pop_head (self->replies)))
+    gst_tensor_query_client_drop_reply (self, data_h);
+  g_queue_free (self->replies);
+  self->replies = NULL;
+
+  while ((req = g_queue_pop_head (self->requests)))
+    gst_tensor_query_request_free (self, req);
+  g_queue_free (self->requests);
+  self->requests = NULL;
+  g_mutex_clear (&self->lock);
+  g_cond_clear (&self->cond);
+
+  gst_tensor_query_shm_writer_free (self->shm_writer);
+  self->shm_writer = NULL;
+  gst_tensor_query_shm_reader_free (self->shm_reader);
+  self->shm_reader = NULL;
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -276,6 +367,12 @@ gst_tensor_query_client_set_property (GObject * object, guint prop_id,
     case PROP_TIMEOUT:
       self->timeout = g_value_get_uint (value);
       break;
+    case PROP_MAX_OUTSTANDING:
+      self->max_outstanding = g_value_get_uint (value);
+      break;
+    case PROP_DROP_STALE:
+      self->drop_stale = g_value_get_boolean (value);
+      break;
     case PROP_SILENT:
       self->silent = g_value_get_boolean (value);
       break;
@@ -316,6 +413,12 @@ gst_tensor_query_client_get_property (GObject * object, guint prop_id,
     case PROP_TIMEOUT:
       g_value_set_uint (value, self->timeout);
       break;
+    case PROP_MAX_OUTSTANDING:
+      g_value_set_uint (value, self->max_outstanding);
+      break;
+    case PROP_DROP_STALE:
+      g_value_set_boolean (value, self->drop_stale);
+      break;
     case PROP_SILENT:
       g_value_set_boolean (value, self->silent);
       break;
@@ -414,6 +517,234 @@ _nns_edge_parse_caps (gchar * caps_str, gboolean is_src)
   return ret_str;
 }
 
+/**
+ * @brief Push the reply from query server with the metadata of the request.
+ * @note The output buffer takes the ownership of the reply (without copying the memories).
+ */
+static GstFlowReturn
+gst_tensor_query_client_push_reply (GstTensorQueryClient * self,
+    nns_edge_data_h data_h, GstBuffer * meta_buf)
+{
+  GstBuffer *out_buf = NULL;
+
+  if (self->connect_type == QUERY_CONNECT_TYPE_SHM)
+    out_buf = gst_tensor_query_shm_read (self->shm_reader, data_h);
+  if (!out_buf)
+    out_buf = gst_edge_data_to_buffer (data_h);
+  if (!out_buf)
+    return GST_FLOW_ERROR;
+
+  /* metadata from incoming buffer */
+  gst_buffer_copy_into (out_buf, meta_buf, GST_BUFFER_COPY_METADATA, 0, -1);
+
+  return gst_pad_push (self->srcpad, out_buf);
+}
+
+/**
+ * @brief Store the received reply to the matching request in flight.
+ * @note The caller should hold the lock.
+ */
+static void
+gst_tensor_query_client_handle_reply (GstTensorQueryClient * self,
+    nns_edge_data_h data_h)
+{
+  GstTensorQueryRequest *req = NULL;
+  GList *l;
+  gchar *val = NULL;
+  gint64 seq = -1;
+
+  if (NNS_EDGE_ERROR_NONE == nns_edge_data_get_info (data_h, "request_id",
+          &val)) {
+    seq = g_ascii_strtoll (val, NULL, 10);
+    g_free (val);
+  }
+
+  for (l = self->requests->head; l; l = l->next) {
+    GstTensorQueryRequest *r = (GstTensorQueryRequest *) l->data;
+
+    /* The server without sequence id replies in the order of requests. */
+    if (!r->pushing && r->reply == NULL && (seq < 0 || r->seq == seq)) {
+      req = r;
+      break;
+    }
+  }
+
+  if (req) {
+    req->reply = data_h;
+  } else {
+    GST_DEBUG_OBJECT (self, "Drop stale reply of request %" G_GINT64_FORMAT,
+        seq);
+    gst_tensor_query_client_drop_reply (self, data_h);
+  }
+}
+
+/**
+ * @brief Check whether a reply of the requests in flight has arrived.
+ * @note The caller should hold the lock.
+ */
+static gboolean
+gst_tensor_query_client_has_reply (GstTensorQueryClient * self)
+{
+  GList *l;
+
+  for (l = self->requests->head; l; l = l->next) {
+    if (((GstTensorQueryRequest *) l->data)->reply)
+      return TRUE;
+  }
+
+  return FALSE;
+}
+
+/**
+ * @brief The src pad task to push the replies in the order of requests (max-outstanding > 1).
+ * The request which is timed out (or older than a received reply if drop-stale is enabled) is given up.
+ */
+static void
+gst_tensor_query_client_loop (gpointer user_data)
+{
+  GstTensorQueryClient *self = GST_TENSOR_QUERY_CLIENT_CAST (user_data);
+  GstTensorQueryRequest *req = NULL;
+  nns_edge_data_h data_h;
+  GstFlowReturn res;
+
+  g_mutex_lock (&self->lock);
+  while (!self->flushing) {
+    req = g_queue_peek_head (self->requests);
+
+    if (!req) {
+      g_cond_wait (&self->cond, &self->lock);
+      continue;
+    }
+
+    if (req->reply)
+      break;
+
+    if (g_get_monotonic_time () >= req->deadline) {
+      nns_logw ("Failed to receive the reply of request %" G_GINT64_FORMAT
+          " in time, drop it.", req->seq);
+    } else if (self->drop_stale && gst_tensor_query_client_has_reply (self)) {
+      GST_DEBUG_OBJECT (self, "Drop stale request %" G_GINT64_FORMAT, req->seq);
+    } else {
+      g_cond_wait_until (&self->cond, &self->lock, req->deadline);
+      continue;
+    }
+
+    g_queue_pop_head (self->requests);
+    gst_tensor_query_request_free (self, req);
+    g_cond_broadcast (&self->cond);
+  }
+
+  if (self->flushing) {
+    g_mutex_unlock (&self->lock);
+    gst_pad_pause_task (self->srcpad);
+    return;
+  }
+
+  /* keep the request in flight until the reply is pushed (e.g., for EOS) */
+  req->pushing = TRUE;
+  data_h = req->reply;
+  req->reply = NULL;
+  g_mutex_unlock (&self->lock);
+
+  res = gst_tensor_query_client_push_reply (self, data_h, req->meta_buf);
+
+  g_mutex_lock (&self->lock);
+  g_queue_remove (self->requests, req);
+  gst_tensor_query_request_free (self, req);
+  if (res != GST_FLOW_OK)
+    self->flow = res;
+  g_cond_broadcast (&self->cond);
+  g_mutex_unlock (&self->lock);
+
+  if (res != GST_FLOW_OK) {
+    if (res == GST_FLOW_ERROR || res == GST_FLOW_NOT_NEGOTIATED) {
+      GST_ELEMENT_ERROR (self, STREAM, FAILED,
+          ("Failed to push the reply of tensor_query_client: %s.",
+              gst_flow_get_name (res)), (NULL));
+    }
+
+    gst_pad_pause_task (self->srcpad);
+  }
+}
+
+/**
+ * @brief Wait until the number of requests in flight is not larger than the limit.
+ */
+static GstFlowReturn
+gst_tensor_query_client_wait_requests (GstTensorQueryClient * self,
+    guint limit)
+{
+  GstFlowReturn res;
+
+  g_mutex_lock (&self->lock);
+  while (!self->flushing && self->flow == GST_FLOW_OK &&
+      g_queue_get_length (self->requests) > limit)
+    g_cond_wait (&self->cond, &self->lock);
+
+  res = self->flushing ? GST_FLOW_FLUSHING : self->flow;
+  g_mutex_unlock (&self->lock);
+
+  return res;
+}
+
+/**
+ * @brief Wait for the reply of the request (max-outstanding is 1).
+ * @return The received reply, NULL if timed out or flushing.
+ */
+static nns_edge_data_h
+gst_tensor_query_client_wait_reply (GstTensorQueryClient * self)
+{
+  nns_edge_data_h data_h;
+  gint64 end_time;
+
+  end_time = g_get_monotonic_time () +
+      (gint64) self->timeout * G_TIME_SPAN_MILLISECOND;
+
+  g_mutex_lock (&self->lock);
+  while (!self->flushing && g_queue_is_empty (self->replies) &&
+      g_get_monotonic_time () < end_time)
+    g_cond_wait_until (&self->cond, &self->lock, end_time);
+
+  data_h = self->flushing ? NULL : g_queue_pop_head (self->replies);
+  g_mutex_unlock (&self->lock);
+
+  return data_h;
+}
+
+/**
+ * @brief Set the flushing state and wake up the threads waiting for the replies.
+ */
+static void
+gst_tensor_query_client_set_flushing (GstTensorQueryClient * self,
+    gboolean flushing)
+{
+  g_mutex_lock (&self->lock);
+  self->flushing = flushing;
+  if (!flushing)
+    self->flow = GST_FLOW_OK;
+  g_cond_broadcast (&self->cond);
+  g_mutex_unlock (&self->lock);
+}
+
+/**
+ * @brief Discard the requests in flight and the received replies.
+ * @note The caller should stop the src pad task or hold its stream lock.
+ */
+static void
+gst_tensor_query_client_clear_requests (GstTensorQueryClient * self)
+{
+  GstTensorQueryRequest *req;
+  nns_edge_data_h data_h;
+
+  g_mutex_lock (&self->lock);
+  while ((req = g_queue_pop_head (self->requests)))
+    gst_tensor_query_request_free (self, req);
+
+  while ((data_h = g_queue_pop_head (self->replies)))
+    gst_tensor_query_client_drop_reply (self, data_h);
+  g_mutex_unlock (&self->lock);
+}
+
 /**
  * @brief nnstreamer-edge event callback.
  */
@@ -487,7 +818,18 @@ _nns_edge_event_cb (nns_edge_event_h event_h, void *user_data)
       nns_edge_data_h data;
 
       nns_edge_event_parse_new_data (event_h, &data);
-      g_async_queue_push (self->msg_queue, data);
+
+      /* the server on the same host replies in shared memory, so do the requests */
+      if (self->shm_writer && gst_tensor_query_shm_is_local (data))
+        g_atomic_int_set (&self->shm_peer, 1);
+
+      g_mutex_lock (&self->lock);
+      if (self->max_outstanding > 1)
+        gst_tensor_query_client_handle_reply (self, data);
+      else
+        g_queue_push_tail (self->replies, data);
+      g_cond_broadcast (&self->cond);
+      g_mutex_unlock (&self->lock);
       break;
     }
     default:
@@ -521,11 +863,16 @@ gst_tensor_query_client_create_edge_handle (GstTensorQueryClient * self)
     }
   }
 
-  ret = nns_edge_create_handle ("TEMP_ID", self->connect_type,
+  ret = nns_edge_create_handle ("TEMP_ID",
+      gst_tensor_query_get_edge_connect_type (self->connect_type),
       NNS_EDGE_NODE_TYPE_QUERY_CLIENT, &self->edge_h);
   if (ret != NNS_EDGE_ERROR_NONE)
     return FALSE;
 
+  if (self->connect_type == QUERY_CONNECT_TYPE_SHM && !self->shm_writer)
+    self->shm_writer = gst_tensor_query_shm_writer_new ();
+  g_atomic_int_set (&self->shm_peer, 0);
+
   nns_edge_set_event_callback (self->edge_h, _nns_edge_event_cb, self);
 
   if (self->topic)
@@ -592,6 +939,27 @@ gst_tensor_query_client_sink_event (GstPad * pad,
       gst_event_unref (event);
       return ret;
     }
+    case GST_EVENT_EOS:
+      /* push the replies of the requests in flight before EOS */
+      gst_tensor_query_client_wait_requests (self, 0);
+      break;
+    case GST_EVENT_FLUSH_START:
+    {
+      gboolean ret;
+
+      /* wake up the src pad task and the upstream waiting for the replies */
+      gst_tensor_query_client_set_flushing (self, TRUE);
+      ret = gst_pad_event_default (pad, parent, event);
+      gst_pad_pause_task (self->srcpad);
+      return ret;
+    }
+    case GST_EVENT_FLUSH_STOP:
+      /* the src pad task is paused while flushing */
+      GST_PAD_STREAM_LOCK (self->srcpad);
+      gst_tensor_query_client_clear_requests (self);
+      gst_tensor_query_client_set_flushing (self, FALSE);
+      GST_PAD_STREAM_UNLOCK (self->srcpad);
+      break;
     default:
       break;
   }
@@ -658,19 +1026,30 @@ gst_tensor_query_client_chain (GstPad * pad,
     GstObject * parent, GstBuffer * buf)
 {
   GstTensorQueryClient *self = GST_TENSOR_QUERY_CLIENT (parent);
-  GstBuffer *out_buf = NULL;
+  GstTensorQueryRequest *req = NULL;
   GstFlowReturn res = GST_FLOW_OK;
   nns_edge_data_h data_h;
-  guint i, num_mems, num_data;
+  guint i, num_mems = 0;
   int ret;
   GstMemory *mem[NNS_TENSOR_SIZE_LIMIT];
   GstMapInfo map[NNS_TENSOR_SIZE_LIMIT];
   gchar *val;
   UNUSED (pad);
 
+  if (self->max_outstanding > 1) {
+    /* keep sending while the window is not full */
+    res = gst_tensor_query_client_wait_requests (self,
+        self->max_outstanding - 1);
+    if (res != GST_FLOW_OK) {
+      gst_buffer_unref (buf);
+      return res;
+    }
+  }
+
   ret = nns_edge_data_create (&data_h);
   if (ret != NNS_EDGE_ERROR_NONE) {
     nns_loge ("Failed to create data handle in client chain.");
+    gst_buffer_unref (buf);
     return GST_FLOW_ERROR;
   }
 
@@ -682,46 +1061,75 @@ gst_tensor_query_client_chain (GstPad * pad,
       num_mems = i;
       goto done;
     }
-    nns_edge_data_add (data_h, map[i].data, map[i].size, NULL);
+  }
+
+  /**
+   * Pass the tensor data in shared memory if the server is on the same host
+   * and a slot is available. The host key tells the server it can do the same.
+   */
+  if (self->shm_writer)
+    gst_tensor_query_shm_set_host (data_h);
+
+  if (!self->shm_writer || !g_atomic_int_get (&self->shm_peer) ||
+      !gst_tensor_query_shm_write (self->shm_writer, data_h, map, num_mems)) {
+    for (i = 0; i < num_mems; i++)
+      nns_edge_data_add (data_h, map[i].data, map[i].size, NULL);
   }
 
   nns_edge_get_info (self->edge_h, "client_id", &val);
   nns_edge_data_set_info (data_h, "client_id", val);
   g_free (val);
 
+  if (self->max_outstanding > 1) {
+    guint timeout =
+        (self->timeout > 0) ? self->timeout : DEFAULT_REQUEST_TIMEOUT;
+
+    /* windowed mode, the server echoes the sequence id in the reply. */
+    req = g_new0 (GstTensorQueryRequest, 1);
+    req->seq = self->request_seq++;
+    req->deadline = g_get_monotonic_time () +
+        timeout * G_TIME_SPAN_MILLISECOND;
+    req->meta_buf = gst_buffer_new ();
+    gst_buffer_copy_into (req->meta_buf, buf, GST_BUFFER_COPY_METADATA, 0, -1);
+
+    val = g_strdup_printf ("%" G_GINT64_FORMAT, req->seq);
+    nns_edge_data_set_info (data_h, "request_id", val);
+    g_free (val);
+
+    /* register the request before sending, the reply may arrive at once */
+    g_mutex_lock (&self->lock);
+    g_queue_push_tail (self->requests, req);
+    gst_pad_start_task (self->srcpad, gst_tensor_query_client_loop, self,
+        NULL);
+    g_mutex_unlock (&self->lock);
+  }
+
   if (NNS_EDGE_ERROR_NONE != nns_edge_send (self->edge_h, data_h)) {
     nns_logw ("Failed to publish to server node, retry connection.");
+    if (self->shm_writer)
+      gst_tensor_query_shm_cancel (self->shm_writer, data_h);
+
+    if (req) {
+      g_mutex_lock (&self->lock);
+      g_queue_remove (self->requests, req);
+      gst_tensor_query_request_free (self, req);
+      g_cond_broadcast (&self->cond);
+      g_mutex_unlock (&self->lock);
+    }
     goto retry;
   }
 
   nns_edge_data_destroy (data_h);
+  data_h = NULL;
 
-  data_h = g_async_queue_timeout_pop (self->msg_queue,
-      self->timeout * G_TIME_SPAN_MILLISECOND);
-  if (data_h) {
-    ret = nns_edge_data_get_count (data_h, &num_data);
-    if (ret != NNS_EDGE_ERROR_NONE || num_data == 0) {
-      nns_loge ("Failed to get the number of memories of the edge data.");
-      res = GST_FLOW_ERROR;
-      goto done;
-    }
-
-    out_buf = gst_buffer_new ();
-    for (i = 0; i < num_data; i++) {
-      void *data = NULL;
-      nns_size_t data_len;
-      gpointer new_data;
-
-      nns_edge_data_get (data_h, i, &data, &data_len);
-      new_data = _g_memdup (data, data_len);
-      gst_buffer_append_memory (out_buf,
-          gst_memory_new_wrapped (0, new_data, data_len, 0,
-              data_len, new_data, g_free));
-    }
-    /* metadata from incoming buffer */
-    gst_buffer_copy_into (out_buf, buf, GST_BUFFER_COPY_METADATA, 0, -1);
+  /* windowed mode, the reply is pushed by the src pad task */
+  if (req)
+    goto done;
 
-    res = gst_pad_push (self->srcpad, out_buf);
+  data_h = gst_tensor_query_client_wait_reply (self);
+  if (data_h) {
+    res = gst_tensor_query_client_push_reply (self, data_h, buf);
+    data_h = NULL;
   }
   goto done;
 
@@ -742,6 +1150,32 @@ done:
   return res;
 }
 
+/**
+ * @brief Change state of tensor_query_client.
+ */
+static GstStateChangeReturn
+gst_tensor_query_client_change_state (GstElement * element,
+    GstStateChange transition)
+{
+  GstTensorQueryClient *self = GST_TENSOR_QUERY_CLIENT (element);
+
+  switch (transition) {
+    case GST_STATE_CHANGE_READY_TO_PAUSED:
+      gst_tensor_query_client_set_flushing (self, FALSE);
+      break;
+    case GST_STATE_CHANGE_PAUSED_TO_READY:
+      /* stop the src pad task before deactivating the pads */
+      gst_tensor_query_client_set_flushing (self, TRUE);
+      gst_pad_stop_task (self->srcpad);
+      gst_tensor_query_client_clear_requests (self);
+      break;
+    default:
+      break;
+  }
+
+  return GST_ELEMENT_CLASS (parent_class)->change_state (element, transition);
+}
+
 /**
  * @brief Get pad caps for caps negotiation.
  */
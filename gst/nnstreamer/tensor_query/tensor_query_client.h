@@ -17,6 +17,7 @@
 #include <gio/gio.h>
 #include <tensor_common.h>
 #include <nnstreamer-edge.h>
+#include "tensor_query_shm.h"
 
 G_BEGIN_DECLS
 
@@ -48,6 +49,10 @@ struct _GstTensorQueryClient
   gchar *in_caps_str;
 
   guint timeout; /**< timeout value (in ms) to wait message from server */
+  guint max_outstanding; /**< max number of requests in flight. 1 to wait for the reply of each request */
+  gboolean drop_stale; /**< TRUE to give up the pending requests older than a received reply */
+  gint64 request_seq; /**< sequence id of the next request */
+  GQueue *requests; /**< requests in flight, in the order of sending */
 
   /* Query-hybrid feature */
   gchar *topic; /**< Main operation such as 'object_detection' or 'image_segmentation' */
@@ -58,7 +63,16 @@ struct _GstTensorQueryClient
 
   nns_edge_connect_type_e connect_type;
   nns_edge_h edge_h;
-  GAsyncQueue *msg_queue;
+
+  GMutex lock; /**< lock for the requests in flight and the received replies */
+  GCond cond; /**< signalled when a reply arrives, a request is done or flushing */
+  GQueue *replies; /**< received replies waiting to be pushed, if max-outstanding is 1 */
+  gboolean flushing; /**< TRUE while flushing or stopping, the waiting threads give up */
+  GstFlowReturn flow; /**< the last flow return of the src pad task pushing the replies */
+
+  GstTensorQueryShmWriter *shm_writer; /**< shared-memory ring for the requests, if connect-type is SHM */
+  GstTensorQueryShmReader *shm_reader; /**< segments of the replies in shared memory */
+  gint shm_peer; /**< 1 if the server is on the same host, the requests are sent in shared memory then */
 };
 
 /**
@@ -36,6 +36,8 @@ gst_tensor_query_get_connect_type (void)
           "Directly sending stream frames via TCP connections."},
       {NNS_EDGE_CONNECT_TYPE_HYBRID, "HYBRID",
           "Connect with MQTT brokers and directly sending stream frames via TCP connections."},
+      {QUERY_CONNECT_TYPE_SHM, "SHM",
+          "Passing tensor data in shared memory and the descriptors via TCP connections (same host only)."},
       {0, NULL, NULL},
     };
     protocol = g_enum_register_static ("tensor_query_protocol", protocols);
@@ -43,3 +45,13 @@ gst_tensor_query_get_connect_type (void)
 
   return protocol;
 }
+
+/**
+ * @brief Get the connect type of nnstreamer-edge handle from query connect-type property.
+ */
+nns_edge_connect_type_e
+gst_tensor_query_get_edge_connect_type (nns_edge_connect_type_e connect_type)
+{
+  return (connect_type == QUERY_CONNECT_TYPE_SHM) ?
+      NNS_EDGE_CONNECT_TYPE_TCP : connect_type;
+}
@@ -34,12 +34,24 @@ extern "C" {
 #define DEFAULT_CONNECT_TYPE (NNS_EDGE_CONNECT_TYPE_TCP)
 #define GST_TYPE_QUERY_CONNECT_TYPE (gst_tensor_query_get_connect_type ())
 
+/**
+ * @brief Connect type for the same-host query. The tensor data is passed in shared memory and the descriptor via TCP connection.
+ */
+#define QUERY_CONNECT_TYPE_SHM ((nns_edge_connect_type_e) 0x100)
+
 /**
  * @brief Register GEnumValue array for query connect-type property.
  */
 GType
 gst_tensor_query_get_connect_type (void);
 
+/**
+ * @brief Get the connect type of nnstreamer-edge handle from query connect-type property.
+ */
+nns_edge_connect_type_e
+gst_tensor_query_get_edge_connect_type (nns_edge_connect_type_e connect_type);
+
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
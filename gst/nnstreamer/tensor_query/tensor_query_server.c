@@ -15,6 +15,7 @@
 #endif
 
 #include "tensor_query_server.h"
+#include "tensor_query_common.h"
 #include <tensor_typedef.h>
 #include <tensor_common.h>
 
@@ -47,6 +48,9 @@ _release_server_data (gpointer data)
     _data->edge_h = NULL;
   }
 
+  if (_data->shm_clients)
+    g_hash_table_destroy (_data->shm_clients);
+
   g_mutex_clear (&_data->lock);
   g_cond_clear (&_data->cond);
   g_free (_data->id);
@@ -94,8 +98,11 @@ gst_tensor_query_server_add_data (const char *id,
   g_cond_init (&data->cond);
   data->id = g_strdup (id);
   data->configured = FALSE;
+  data->shm_clients = g_hash_table_new_full (g_int64_hash, g_int64_equal,
+      g_free, NULL);
 
-  ret = nns_edge_create_handle (id, connect_type,
+  ret = nns_edge_create_handle (id,
+      gst_tensor_query_get_edge_connect_type (connect_type),
       NNS_EDGE_NODE_TYPE_QUERY_SERVER, &data->edge_h);
   if (NNS_EDGE_ERROR_NONE != ret) {
     GST_ERROR ("Failed to get nnstreamer edge handle.");
@@ -184,6 +191,50 @@ gst_tensor_query_server_set_configured (edge_server_handle server_h)
   g_mutex_unlock (&data->lock);
 }
 
+/**
+ * @brief Set the client on the same host, the replies to the client are sent in shared memory.
+ */
+void
+gst_tensor_query_server_add_shm_client (edge_server_handle server_h,
+    query_client_id_t client_id)
+{
+  GstTensorQueryServer *data = (GstTensorQueryServer *) server_h;
+  gint64 *key;
+
+  if (NULL == data) {
+    return;
+  }
+
+  g_mutex_lock (&data->lock);
+  if (!g_hash_table_contains (data->shm_clients, &client_id)) {
+    key = g_new (gint64, 1);
+    *key = client_id;
+    g_hash_table_add (data->shm_clients, key);
+  }
+  g_mutex_unlock (&data->lock);
+}
+
+/**
+ * @brief Check whether the replies to the client can be sent in shared memory.
+ */
+gboolean
+gst_tensor_query_server_is_shm_client (edge_server_handle server_h,
+    query_client_id_t client_id)
+{
+  GstTensorQueryServer *data = (GstTensorQueryServer *) server_h;
+  gboolean is_shm;
+
+  if (NULL == data) {
+    return FALSE;
+  }
+
+  g_mutex_lock (&data->lock);
+  is_shm = g_hash_table_contains (data->shm_clients, &client_id);
+  g_mutex_unlock (&data->lock);
+
+  return is_shm;
+}
+
 /**
  * @brief set query server caps.
  */
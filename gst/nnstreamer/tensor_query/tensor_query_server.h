@@ -35,6 +35,7 @@ typedef struct
   GCond cond;
 
   nns_edge_h edge_h;
+  GHashTable *shm_clients; /**< ids of the clients on the same host, to send the replies in shared memory */
 } GstTensorQueryServer;
 
 /**
@@ -73,6 +74,18 @@ gst_tensor_query_server_get_edge_handle (edge_server_handle server_h);
 void
 gst_tensor_query_server_set_configured (edge_server_handle server_h);
 
+/**
+ * @brief Set the client on the same host, the replies to the client are sent in shared memory.
+ */
+void
+gst_tensor_query_server_add_shm_client (edge_server_handle server_h, query_client_id_t client_id);
+
+/**
+ * @brief Check whether the replies to the client can be sent in shared memory.
+ */
+gboolean
+gst_tensor_query_server_is_shm_client (edge_server_handle server_h, query_client_id_t client_id);
+
 /**
  * @brief set query server caps.
  */
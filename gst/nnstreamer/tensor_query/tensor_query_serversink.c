@@ -121,6 +121,7 @@ gst_tensor_query_serversink_init (GstTensorQueryServerSink * sink)
   sink->timeout = QUERY_DEFAULT_TIMEOUT_SEC;
   sink->sink_id = DEFAULT_SERVER_ID;
   sink->metaless_frame_count = 0;
+  sink->shm_writer = NULL;
 }
 
 /**
@@ -131,6 +132,7 @@ gst_tensor_query_serversink_finalize (GObject * object)
 {
   GstTensorQueryServerSink *sink = GST_TENSOR_QUERY_SERVERSINK (object);
   gst_tensor_query_server_remove_data (sink->server_h);
+  gst_tensor_query_shm_writer_free (sink->shm_writer);
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -207,6 +209,9 @@ gst_tensor_query_serversink_start (GstBaseSink * bsink)
   sink->edge_h = gst_tensor_query_server_get_edge_handle (sink->server_h);
   gst_tensor_query_server_set_configured (sink->server_h);
 
+  if (sink->connect_type == QUERY_CONNECT_TYPE_SHM && !sink->shm_writer)
+    sink->shm_writer = gst_tensor_query_shm_writer_new ();
+
   return TRUE;
 }
 
@@ -264,14 +269,37 @@ gst_tensor_query_serversink_render (GstBaseSink * bsink, GstBuffer * buf)
         nns_edge_data_destroy (data_h);
         goto done;
       }
-      nns_edge_data_add (data_h, map[i].data, map[i].size, NULL);
+    }
+
+    /**
+     * Pass the tensor data in shared memory if the client is on the same host
+     * and a slot is available. The host key tells the client it can do the same.
+     */
+    if (sink->shm_writer)
+      gst_tensor_query_shm_set_host (data_h);
+
+    if (!sink->shm_writer ||
+        !gst_tensor_query_server_is_shm_client (sink->server_h,
+            meta_query->client_id) ||
+        !gst_tensor_query_shm_write (sink->shm_writer, data_h, map,
+            num_mems)) {
+      for (i = 0; i < num_mems; i++)
+        nns_edge_data_add (data_h, map[i].data, map[i].size, NULL);
     }
 
     val = g_strdup_printf ("%lld", (long long) meta_query->client_id);
     nns_edge_data_set_info (data_h, "client_id", val);
     g_free (val);
 
-    nns_edge_send (sink->edge_h, data_h);
+    if (meta_query->request_id >= 0) {
+      val = g_strdup_printf ("%lld", (long long) meta_query->request_id);
+      nns_edge_data_set_info (data_h, "request_id", val);
+      g_free (val);
+    }
+
+    if (NNS_EDGE_ERROR_NONE != nns_edge_send (sink->edge_h, data_h) &&
+        sink->shm_writer)
+      gst_tensor_query_shm_cancel (sink->shm_writer, data_h);
     nns_edge_data_destroy (data_h);
   } else {
     nns_logw ("Cannot get tensor query meta. Drop buffers!\n");
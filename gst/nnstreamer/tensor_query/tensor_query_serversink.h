@@ -19,6 +19,7 @@
 #include <tensor_meta.h>
 #include "tensor_query_server.h"
 #include "tensor_query_common.h"
+#include "tensor_query_shm.h"
 G_BEGIN_DECLS
 
 #define GST_TYPE_TENSOR_QUERY_SERVERSINK \
@@ -51,6 +52,7 @@ struct _GstTensorQueryServerSink
   nns_edge_connect_type_e connect_type;
   edge_server_handle server_h;
   nns_edge_h edge_h;
+  GstTensorQueryShmWriter *shm_writer; /**< shared-memory ring for the replies, if connect-type is SHM */
 };
 
 /**
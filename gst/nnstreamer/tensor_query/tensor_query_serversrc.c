@@ -18,6 +18,7 @@
 #include <tensor_common.h>
 #include "tensor_query_serversrc.h"
 #include "tensor_query_common.h"
+#include "nnstreamer_edge_data.h"
 #include "nnstreamer_util.h"
 
 GST_DEBUG_CATEGORY_STATIC (gst_tensor_query_serversrc_debug);
@@ -27,6 +28,16 @@ GST_DEBUG_CATEGORY_STATIC (gst_tensor_query_serversrc_debug);
 #define DEFAULT_IS_LIVE TRUE
 #define DEFAULT_MQTT_HOST "127.0.0.1"
 #define DEFAULT_MQTT_PORT 1883
+#define DEFAULT_CLIENT_QUEUE_LIMIT 0
+
+/**
+ * @brief Pending requests of a query client.
+ */
+typedef struct
+{
+  query_client_id_t client_id; /**< id of the client, also used as the key of the table */
+  GQueue *pending; /**< received edge data, in the order of arrival */
+} GstTensorQueryServerClient;
 
 /**
  * @brief the capabilities of the outputs
@@ -50,7 +61,8 @@ enum
   PROP_TIMEOUT,
   PROP_TOPIC,
   PROP_ID,
-  PROP_IS_LIVE
+  PROP_IS_LIVE,
+  PROP_CLIENT_QUEUE_LIMIT
 };
 
 #define gst_tensor_query_serversrc_parent_class parent_class
@@ -125,6 +137,13 @@ gst_tensor_query_serversrc_class_init (GstTensorQueryServerSrcClass * klass)
       g_param_spec_boolean ("is-live", "Is Live",
           "Synchronize the incoming buffers' timestamp with the current running time",
           DEFAULT_IS_LIVE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_CLIENT_QUEUE_LIMIT,
+      g_param_spec_uint ("client-queue-limit", "Client queue limit",
+          "The max number of pending requests of each client. "
+          "The requests are served in round-robin order of the clients, "
+          "and the oldest request of a client is dropped when its queue is full. "
+          "0 means unlimited.", 0, G_MAXUINT, DEFAULT_CLIENT_QUEUE_LIMIT,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
   gst_element_class_add_pad_template (gstelement_class,
       gst_static_pad_template_get (&srctemplate));
@@ -141,6 +160,32 @@ gst_tensor_query_serversrc_class_init (GstTensorQueryServerSrcClass * klass)
       "tensor_query_serversrc", 0, "Tensor Query Server Source");
 }
 
+/**
+ * @brief Free the query client.
+ * @note The pending requests should be dropped with _gst_tensor_query_serversrc_drop() before.
+ */
+static void
+gst_tensor_query_server_client_free (gpointer data)
+{
+  GstTensorQueryServerClient *client = (GstTensorQueryServerClient *) data;
+
+  g_queue_free (client->pending);
+  g_free (client);
+}
+
+/**
+ * @brief Drop the received request without serving it.
+ * The slot of the request in shared memory is returned to the client.
+ */
+static void
+_gst_tensor_query_serversrc_drop (GstTensorQueryServerSrc * src,
+    nns_edge_data_h data_h)
+{
+  if (src->connect_type == QUERY_CONNECT_TYPE_SHM)
+    gst_tensor_query_shm_discard (src->shm_reader, data_h);
+  nns_edge_data_destroy (data_h);
+}
+
 /**
  * @brief initialize the new query_serversrc element
  */
@@ -157,6 +202,11 @@ gst_tensor_query_serversrc_init (GstTensorQueryServerSrc * src)
   src->src_id = DEFAULT_SERVER_ID;
   src->configured = FALSE;
   src->msg_queue = g_async_queue_new ();
+  src->client_queue_limit = DEFAULT_CLIENT_QUEUE_LIMIT;
+  src->clients = g_hash_table_new_full (g_int64_hash, g_int64_equal, NULL,
+      gst_tensor_query_server_client_free);
+  src->client_ring = g_queue_new ();
+  src->shm_reader = gst_tensor_query_shm_reader_new ();
 
   gst_base_src_set_format (GST_BASE_SRC (src), GST_FORMAT_TIME);
   /** set the timestamps on each buffer */
@@ -172,6 +222,8 @@ static void
 gst_tensor_query_serversrc_finalize (GObject * object)
 {
   GstTensorQueryServerSrc *src = GST_TENSOR_QUERY_SERVERSRC (object);
+  GstTensorQueryServerClient *client;
+  GHashTableIter iter;
   nns_edge_data_h data_h;
 
   g_free (src->host);
@@ -182,10 +234,20 @@ gst_tensor_query_serversrc_finalize (GObject * object)
   src->topic = NULL;
 
   while ((data_h = g_async_queue_try_pop (src->msg_queue))) {
-    nns_edge_data_destroy (data_h);
+    _gst_tensor_query_serversrc_drop (src, data_h);
   }
   g_async_queue_unref (src->msg_queue);
 
+  g_hash_table_iter_init (&iter, src->clients);
+  while (g_hash_table_iter_next (&iter, NULL, (gpointer *) & client)) {
+    while ((data_h = g_queue_pop_head (client->pending)))
+      _gst_tensor_query_serversrc_drop (src, data_h);
+  }
+
+  g_queue_free (src->client_ring);
+  g_hash_table_destroy (src->clients);
+  gst_tensor_query_shm_reader_free (src->shm_reader);
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -242,6 +304,9 @@ gst_tensor_query_serversrc_set_property (GObject * object, guint prop_id,
       gst_base_src_set_live (GST_BASE_SRC (serversrc),
           g_value_get_boolean (value));
       break;
+    case PROP_CLIENT_QUEUE_LIMIT:
+      serversrc->client_queue_limit = g_value_get_uint (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -286,6 +351,9 @@ gst_tensor_query_serversrc_get_property (GObject * object, guint prop_id,
       g_value_set_boolean (value,
           gst_base_src_is_live (GST_BASE_SRC (serversrc)));
       break;
+    case PROP_CLIENT_QUEUE_LIMIT:
+      g_value_set_uint (value, serversrc->client_queue_limit);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -370,6 +438,79 @@ gst_tensor_query_serversrc_start (GstBaseSrc * bsrc)
   return TRUE;
 }
 
+/**
+ * @brief Put the received edge data into the pending queue of its client.
+ */
+static void
+_gst_tensor_query_serversrc_enqueue (GstTensorQueryServerSrc * src,
+    nns_edge_data_h data_h)
+{
+  GstTensorQueryServerClient *client;
+  query_client_id_t client_id;
+  char *val;
+
+  if (NNS_EDGE_ERROR_NONE != nns_edge_data_get_info (data_h, "client_id",
+          &val)) {
+    nns_logw ("Cannot get the client id of the received data. Drop it.");
+    _gst_tensor_query_serversrc_drop (src, data_h);
+    return;
+  }
+
+  client_id = g_ascii_strtoll (val, NULL, 10);
+  g_free (val);
+
+  client = g_hash_table_lookup (src->clients, &client_id);
+  if (!client) {
+    client = g_new0 (GstTensorQueryServerClient, 1);
+    client->client_id = client_id;
+    client->pending = g_queue_new ();
+
+    g_hash_table_insert (src->clients, &client->client_id, client);
+    g_queue_push_tail (src->client_ring, client);
+  }
+
+  g_queue_push_tail (client->pending, data_h);
+
+  if (src->client_queue_limit > 0 &&
+      g_queue_get_length (client->pending) > src->client_queue_limit) {
+    GST_DEBUG_OBJECT (src, "Too many requests from client %lld, "
+        "drop the oldest one.", (long long) client_id);
+    _gst_tensor_query_serversrc_drop (src, g_queue_pop_head (client->pending));
+  }
+}
+
+/**
+ * @brief Get the next request to be served.
+ * @details The received data are sorted into the pending queue of each client, and the clients are served in round-robin order, so that a client sending many requests cannot starve the others.
+ */
+static nns_edge_data_h
+_gst_tensor_query_serversrc_next_request (GstTensorQueryServerSrc * src)
+{
+  GstTensorQueryServerClient *client;
+  nns_edge_data_h data_h;
+
+  while ((data_h = g_async_queue_try_pop (src->msg_queue)))
+    _gst_tensor_query_serversrc_enqueue (src, data_h);
+
+  while (g_queue_is_empty (src->client_ring)) {
+    data_h = g_async_queue_pop (src->msg_queue);
+    if (!data_h)
+      return NULL;
+
+    _gst_tensor_query_serversrc_enqueue (src, data_h);
+  }
+
+  client = g_queue_pop_head (src->client_ring);
+  data_h = g_queue_pop_head (client->pending);
+
+  if (g_queue_is_empty (client->pending))
+    g_hash_table_remove (src->clients, &client->client_id);
+  else
+    g_queue_push_tail (src->client_ring, client);
+
+  return data_h;
+}
+
 /**
  * @brief Get buffer from message queue.
  */
@@ -378,53 +519,55 @@ _gst_tensor_query_serversrc_get_buffer (GstTensorQueryServerSrc * src)
 {
   nns_edge_data_h data_h;
   GstBuffer *buffer = NULL;
-  guint i, num_data;
   GstMetaQuery *meta_query;
-  int ret;
+  query_client_id_t client_id;
+  gint64 request_id = -1;
+  char *val;
 
-  data_h = g_async_queue_pop (src->msg_queue);
+  data_h = _gst_tensor_query_serversrc_next_request (src);
 
   if (!data_h) {
     nns_loge ("Failed to get message from the server message queue");
     return NULL;
   }
 
-  ret = nns_edge_data_get_count (data_h, &num_data);
-  if (ret != NNS_EDGE_ERROR_NONE || num_data == 0) {
-    nns_loge ("Failed to get the number of memories of the edge data.");
-    goto done;
+  if (NNS_EDGE_ERROR_NONE != nns_edge_data_get_info (data_h, "client_id",
+          &val)) {
+    _gst_tensor_query_serversrc_drop (src, data_h);
+    return NULL;
+  }
+  client_id = g_ascii_strtoll (val, NULL, 10);
+  g_free (val);
+
+  /* The client tags the request with a sequence id in windowed mode. */
+  if (NNS_EDGE_ERROR_NONE == nns_edge_data_get_info (data_h, "request_id",
+          &val)) {
+    request_id = g_ascii_strtoll (val, NULL, 10);
+    g_free (val);
   }
 
-  buffer = gst_buffer_new ();
-  for (i = 0; i < num_data; i++) {
-    void *data = NULL;
-    nns_size_t data_len = 0;
-    gpointer new_data;
-
-    nns_edge_data_get (data_h, i, &data, &data_len);
-    new_data = _g_memdup (data, data_len);
-
-    gst_buffer_append_memory (buffer,
-        gst_memory_new_wrapped (0, new_data, data_len, 0, data_len, new_data,
-            g_free));
+  /**
+   * The client on the same host passes the tensor data in shared memory,
+   * and the replies to the client are sent in shared memory.
+   */
+  if (src->connect_type == QUERY_CONNECT_TYPE_SHM &&
+      gst_tensor_query_shm_is_local (data_h)) {
+    gst_tensor_query_server_add_shm_client (src->server_h, client_id);
+    buffer = gst_tensor_query_shm_read (src->shm_reader, data_h);
   }
 
+  /* The buffer takes the received memories without copying. */
+  if (!buffer)
+    buffer = gst_edge_data_to_buffer (data_h);
+  if (!buffer)
+    return NULL;
+
   meta_query = gst_buffer_add_meta_query (buffer);
   if (meta_query) {
-    char *val;
-
-    ret = nns_edge_data_get_info (data_h, "client_id", &val);
-    if (NNS_EDGE_ERROR_NONE != ret) {
-      gst_buffer_unref (buffer);
-      buffer = NULL;
-    } else {
-      meta_query->client_id = g_ascii_strtoll (val, NULL, 10);
-      g_free (val);
-    }
+    meta_query->client_id = client_id;
+    meta_query->request_id = request_id;
   }
 
-done:
-  nns_edge_data_destroy (data_h);
   return buffer;
 }
 
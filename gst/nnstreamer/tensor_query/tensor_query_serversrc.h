@@ -17,6 +17,7 @@
 #include <gst/base/gstpushsrc.h>
 #include <tensor_meta.h>
 #include "tensor_query_server.h"
+#include "tensor_query_shm.h"
 
 G_BEGIN_DECLS
 
@@ -57,6 +58,11 @@ struct _GstTensorQueryServerSrc
   edge_server_handle server_h;
   nns_edge_h edge_h;
   GAsyncQueue *msg_queue;
+  GstTensorQueryShmReader *shm_reader; /**< segments of the requests in shared memory */
+
+  guint client_queue_limit; /**< max number of pending requests of each client, 0 for unlimited */
+  GHashTable *clients; /**< pending requests of each client (client_id to GstTensorQueryServerClient) */
+  GQueue *client_ring; /**< clients having pending requests, in round-robin order */
 };
 
 /**
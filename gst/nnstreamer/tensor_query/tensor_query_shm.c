@@ -0,0 +1,749 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file   tensor_query_shm.c
+ * @date   15 Oct 2026
+ * @brief  Shared-memory payload transport for the same-host tensor query
+ * @see    https://github.com/nnstreamer/nnstreamer
+ * @bug    No known bugs except for NYI items
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "tensor_query_shm.h"
+#include "tensor_typedef.h"
+#include "nnstreamer_log.h"
+
+#if defined(__ANDROID__)
+/**
+ * @brief Bionic does not provide POSIX shared memory. The writer fails to create the segment, then the tensor data is sent in the edge data.
+ */
+#define shm_open(name,flag,mode) (errno = ENOSYS, -1)
+#define shm_unlink(name) (0)
+#endif
+
+/**
+ * @brief Magic number of the shared-memory segment.
+ */
+#define SHM_MAGIC (0x51534e4eU)
+
+/**
+ * @brief Number of slots in the ring of a sender.
+ */
+#define SHM_NUM_SLOTS (8U)
+
+/**
+ * @brief Alignment of the slots and the tensor data in a slot.
+ */
+#define SHM_SLOT_ALIGN (4096U)
+#define SHM_DATA_ALIGN (64U)
+
+#define SHM_ALIGN_UP(v,a) (((v) + (a) - 1) / (a) * (a))
+
+/**
+ * @brief Slot states, updated atomically by the sender and the receiver.
+ */
+enum
+{
+  SHM_SLOT_FREE = 0,
+  SHM_SLOT_BUSY = 1,
+};
+
+/**
+ * @brief Header at the beginning of the shared-memory segment.
+ */
+typedef struct
+{
+  guint32 magic; /**< SHM_MAGIC */
+  guint32 num_slots; /**< number of slots */
+  guint64 slot_size; /**< size of each slot */
+  gint state[SHM_NUM_SLOTS]; /**< state of each slot */
+} GstTensorQueryShmHeader;
+
+#define SHM_HEADER_SIZE SHM_ALIGN_UP (sizeof (GstTensorQueryShmHeader), SHM_SLOT_ALIGN)
+
+/**
+ * @brief Shared-memory segment created by a sender.
+ */
+typedef struct
+{
+  gchar *name; /**< name of the segment */
+  gpointer addr; /**< mapped address */
+  gsize size; /**< mapped size */
+} GstTensorQueryShmSegment;
+
+/**
+ * @brief Shared-memory ring of a sender.
+ */
+struct _GstTensorQueryShmWriter
+{
+  gchar *id; /**< unique id of the writer in this host */
+  guint gen; /**< generation of the segment, increased when the slots grow */
+  GstTensorQueryShmSegment *current; /**< current segment */
+  GSList *retired; /**< old segments, unlinked when all slots are returned */
+  guint next_slot; /**< next slot to try */
+};
+
+/**
+ * @brief Segment mapped by a receiver, shared by the buffers referring it.
+ */
+typedef struct
+{
+  gchar *name; /**< name of the segment */
+  gpointer addr; /**< mapped address */
+  gsize size; /**< mapped size */
+  guint num_slots; /**< number of slots, validated when the segment is mapped */
+  guint64 slot_size; /**< size of each slot, validated when the segment is mapped */
+  gint refcount; /**< number of references (reader and slots) */
+} GstTensorQueryShmMap;
+
+/**
+ * @brief Slot referred by the memories of a received buffer.
+ */
+typedef struct
+{
+  GstTensorQueryShmMap *map; /**< segment of the slot */
+  guint slot; /**< index of the slot */
+  gint refcount; /**< number of references (memories and the reader) */
+} GstTensorQueryShmSlot;
+
+/**
+ * @brief Segments mapped by a receiver.
+ */
+struct _GstTensorQueryShmReader
+{
+  GHashTable *maps; /**< writer id to the current segment */
+};
+
+/**
+ * @brief Get the offsets of the tensor data in a slot.
+ * @return Total size of the data in the slot.
+ */
+static gsize
+_shm_get_offsets (const gsize * sizes, guint num, gsize * offsets)
+{
+  gsize offset = 0;
+  guint i;
+
+  for (i = 0; i < num; i++) {
+    offsets[i] = offset;
+    offset = SHM_ALIGN_UP (offset + sizes[i], SHM_DATA_ALIGN);
+  }
+
+  return offset;
+}
+
+/**
+ * @brief Get the key of this host. The peer with the same key shares the shared memory.
+ */
+static const gchar *
+_shm_get_host_key (void)
+{
+  static gsize initialized = 0;
+  static gchar *host_key = NULL;
+
+  if (g_once_init_enter (&initialized)) {
+    gchar *boot_id = NULL;
+
+    /* the host name may be the same on the devices (e.g., localhost) */
+    if (g_file_get_contents ("/proc/sys/kernel/random/boot_id", &boot_id,
+            NULL, NULL))
+      g_strstrip (boot_id);
+
+    host_key = g_strdup_printf ("%s/%s", g_get_host_name (),
+        boot_id ? boot_id : "");
+    g_free (boot_id);
+
+    g_once_init_leave (&initialized, 1);
+  }
+
+  return host_key;
+}
+
+/**
+ * @brief Set the key of this host to the edge data.
+ */
+void
+gst_tensor_query_shm_set_host (nns_edge_data_h data_h)
+{
+  nns_edge_data_set_info (data_h, "shm_host", _shm_get_host_key ());
+}
+
+/**
+ * @brief Check whether the edge data is sent from the peer on this host.
+ */
+gboolean
+gst_tensor_query_shm_is_local (nns_edge_data_h data_h)
+{
+  gchar *val = NULL;
+  gboolean is_local = FALSE;
+
+  if (NNS_EDGE_ERROR_NONE == nns_edge_data_get_info (data_h, "shm_host", &val))
+    is_local = g_str_equal (val, _shm_get_host_key ());
+
+  g_free (val);
+  return is_local;
+}
+
+/**
+ * @brief Create a writer which owns the shared-memory ring of a sender.
+ */
+GstTensorQueryShmWriter *
+gst_tensor_query_shm_writer_new (void)
+{
+  static gint serial = 0;
+  GstTensorQueryShmWriter *writer;
+
+  writer = g_new0 (GstTensorQueryShmWriter, 1);
+  writer->id = g_strdup_printf ("%d-%d", (gint) getpid (),
+      g_atomic_int_add (&serial, 1));
+
+  return writer;
+}
+
+/**
+ * @brief Unmap and unlink the segment of the writer.
+ */
+static void
+_shm_segment_free (gpointer data)
+{
+  GstTensorQueryShmSegment *seg = (GstTensorQueryShmSegment *) data;
+
+  if (seg->addr)
+    munmap (seg->addr, seg->size);
+
+  shm_unlink (seg->name);
+  g_free (seg->name);
+  g_free (seg);
+}
+
+/**
+ * @brief Check whether all slots of the segment are returned from the receivers.
+ */
+static gboolean
+_shm_segment_is_idle (GstTensorQueryShmSegment * seg)
+{
+  GstTensorQueryShmHeader *header = (GstTensorQueryShmHeader *) seg->addr;
+  guint i;
+
+  for (i = 0; i < header->num_slots; i++) {
+    if (g_atomic_int_get (&header->state[i]) != SHM_SLOT_FREE)
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Find the segment of the writer with given name.
+ */
+static GstTensorQueryShmSegment *
+_shm_writer_find_segment (GstTensorQueryShmWriter * writer, const gchar * name)
+{
+  GSList *l;
+
+  if (writer->current && g_str_equal (writer->current->name, name))
+    return writer->current;
+
+  for (l = writer->retired; l; l = l->next) {
+    GstTensorQueryShmSegment *seg = (GstTensorQueryShmSegment *) l->data;
+
+    if (g_str_equal (seg->name, name))
+      return seg;
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Unlink the old segments of which all slots are returned.
+ * The receiver may open the old segment for the data in flight, so it is kept until then.
+ */
+static void
+_shm_writer_release_retired (GstTensorQueryShmWriter * writer)
+{
+  GSList *l = writer->retired;
+
+  while (l) {
+    GSList *next = l->next;
+    GstTensorQueryShmSegment *seg = (GstTensorQueryShmSegment *) l->data;
+
+    if (_shm_segment_is_idle (seg)) {
+      writer->retired = g_slist_delete_link (writer->retired, l);
+      _shm_segment_free (seg);
+    }
+
+    l = next;
+  }
+}
+
+/**
+ * @brief Create new segment of the writer, with the slots larger than the given size.
+ * The current segment is retired, it is unlinked after all slots are returned.
+ */
+static gboolean
+_shm_writer_map (GstTensorQueryShmWriter * writer, gsize data_size)
+{
+  GstTensorQueryShmSegment *seg;
+  GstTensorQueryShmHeader *header;
+  gsize slot_size, size;
+  int fd;
+
+  if (writer->current) {
+    writer->retired = g_slist_prepend (writer->retired, writer->current);
+    writer->current = NULL;
+  }
+
+  slot_size = SHM_ALIGN_UP (data_size, SHM_SLOT_ALIGN);
+  size = SHM_HEADER_SIZE + slot_size * SHM_NUM_SLOTS;
+
+  writer->gen++;
+  seg = g_new0 (GstTensorQueryShmSegment, 1);
+  seg->name = g_strdup_printf ("/nnsquery-%s-%u", writer->id, writer->gen);
+
+  fd = shm_open (seg->name, O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd < 0) {
+    nns_loge ("Failed to create shared memory %s (%d).", seg->name, errno);
+    goto error;
+  }
+
+  if (ftruncate (fd, size) != 0) {
+    nns_loge ("Failed to resize shared memory %s (%d).", seg->name, errno);
+    close (fd);
+    goto error;
+  }
+
+  seg->addr = mmap (NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close (fd);
+
+  if (seg->addr == MAP_FAILED) {
+    nns_loge ("Failed to map shared memory %s (%d).", seg->name, errno);
+    seg->addr = NULL;
+    goto error;
+  }
+
+  seg->size = size;
+
+  header = (GstTensorQueryShmHeader *) seg->addr;
+  header->num_slots = SHM_NUM_SLOTS;
+  header->slot_size = slot_size;
+  /* the new segment is zero-filled, all slots are free. */
+  header->magic = SHM_MAGIC;
+
+  writer->current = seg;
+  writer->next_slot = 0;
+  return TRUE;
+
+error:
+  _shm_segment_free (seg);
+  return FALSE;
+}
+
+/**
+ * @brief Release the writer and unlink its shared-memory segments.
+ */
+void
+gst_tensor_query_shm_writer_free (GstTensorQueryShmWriter * writer)
+{
+  if (!writer)
+    return;
+
+  if (writer->current)
+    _shm_segment_free (writer->current);
+  g_slist_free_full (writer->retired, _shm_segment_free);
+  g_free (writer->id);
+  g_free (writer);
+}
+
+/**
+ * @brief Copy the mapped memories into a free slot and set the descriptor to the edge data.
+ */
+gboolean
+gst_tensor_query_shm_write (GstTensorQueryShmWriter * writer,
+    nns_edge_data_h data_h, GstMapInfo * map, guint num)
+{
+  GstTensorQueryShmHeader *header;
+  gsize sizes[NNS_TENSOR_SIZE_LIMIT], offsets[NNS_TENSOR_SIZE_LIMIT];
+  gsize total;
+  guint8 *slot_data;
+  GString *str;
+  gchar *val;
+  guint i, slot = 0;
+  gboolean found = FALSE;
+
+  g_return_val_if_fail (writer != NULL, FALSE);
+
+  if (num == 0 || num > NNS_TENSOR_SIZE_LIMIT)
+    return FALSE;
+
+  for (i = 0; i < num; i++)
+    sizes[i] = map[i].size;
+  total = _shm_get_offsets (sizes, num, offsets);
+
+  _shm_writer_release_retired (writer);
+
+  if (!writer->current ||
+      total > ((GstTensorQueryShmHeader *) writer->current->addr)->slot_size) {
+    if (!_shm_writer_map (writer, total))
+      return FALSE;
+  }
+
+  header = (GstTensorQueryShmHeader *) writer->current->addr;
+
+  for (i = 0; i < header->num_slots; i++) {
+    slot = (writer->next_slot + i) % header->num_slots;
+
+    if (g_atomic_int_compare_and_exchange (&header->state[slot],
+            SHM_SLOT_FREE, SHM_SLOT_BUSY)) {
+      found = TRUE;
+      break;
+    }
+  }
+
+  if (!found) {
+    /* all slots are held by the receivers */
+    return FALSE;
+  }
+
+  writer->next_slot = (slot + 1) % header->num_slots;
+
+  slot_data = (guint8 *) writer->current->addr + SHM_HEADER_SIZE +
+      slot * header->slot_size;
+  str = g_string_new (NULL);
+  for (i = 0; i < num; i++) {
+    memcpy (slot_data + offsets[i], map[i].data, sizes[i]);
+    g_string_append_printf (str, "%s%zu", (i > 0) ? "," : "", sizes[i]);
+  }
+
+  nns_edge_data_set_info (data_h, "shm_id", writer->id);
+  nns_edge_data_set_info (data_h, "shm_name", writer->current->name);
+  nns_edge_data_set_info (data_h, "shm_sizes", str->str);
+  g_string_free (str, TRUE);
+
+  val = g_strdup_printf ("%u", slot);
+  nns_edge_data_set_info (data_h, "shm_slot", val);
+  g_free (val);
+
+  return TRUE;
+}
+
+/**
+ * @brief Return the slot described in the edge data, if the data is not delivered to the receiver.
+ */
+void
+gst_tensor_query_shm_cancel (GstTensorQueryShmWriter * writer,
+    nns_edge_data_h data_h)
+{
+  GstTensorQueryShmSegment *seg;
+  GstTensorQueryShmHeader *header;
+  gchar *name = NULL, *val = NULL;
+  guint slot;
+
+  g_return_if_fail (writer != NULL);
+
+  if (NNS_EDGE_ERROR_NONE == nns_edge_data_get_info (data_h, "shm_name", &name)
+      && NNS_EDGE_ERROR_NONE == nns_edge_data_get_info (data_h, "shm_slot",
+          &val) && (seg = _shm_writer_find_segment (writer, name)) != NULL) {
+    header = (GstTensorQueryShmHeader *) seg->addr;
+    slot = (guint) g_ascii_strtoull (val, NULL, 10);
+    if (slot < header->num_slots)
+      g_atomic_int_set (&header->state[slot], SHM_SLOT_FREE);
+  }
+
+  g_free (name);
+  g_free (val);
+}
+
+/**
+ * @brief Check whether the string is not empty and has only the digits.
+ */
+static gboolean
+_shm_is_digits (const gchar * str)
+{
+  if (*str == '\0')
+    return FALSE;
+
+  for (; *str; str++) {
+    if (!g_ascii_isdigit (*str))
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Release a reference of the mapped segment.
+ */
+static void
+_shm_map_unref (gpointer data)
+{
+  GstTensorQueryShmMap *map = (GstTensorQueryShmMap *) data;
+
+  if (g_atomic_int_dec_and_test (&map->refcount)) {
+    munmap (map->addr, map->size);
+    g_free (map->name);
+    g_free (map);
+  }
+}
+
+/**
+ * @brief Map the segment of a sender.
+ */
+static GstTensorQueryShmMap *
+_shm_map_open (const gchar * name)
+{
+  GstTensorQueryShmMap *map;
+  GstTensorQueryShmHeader *header;
+  struct stat st;
+  gpointer addr;
+  guint num_slots;
+  guint64 slot_size;
+  int fd;
+
+  fd = shm_open (name, O_RDWR, 0);
+  if (fd < 0) {
+    nns_loge ("Failed to open shared memory %s (%d).", name, errno);
+    return NULL;
+  }
+
+  if (fstat (fd, &st) != 0 || (gsize) st.st_size < SHM_HEADER_SIZE) {
+    nns_loge ("Invalid shared memory %s.", name);
+    close (fd);
+    return NULL;
+  }
+
+  addr = mmap (NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close (fd);
+
+  if (addr == MAP_FAILED) {
+    nns_loge ("Failed to map shared memory %s (%d).", name, errno);
+    return NULL;
+  }
+
+  /* the header is written by the sender, check the slots are in the segment */
+  header = (GstTensorQueryShmHeader *) addr;
+  num_slots = header->num_slots;
+  slot_size = header->slot_size;
+  if (header->magic != SHM_MAGIC || num_slots == 0 ||
+      num_slots > SHM_NUM_SLOTS || slot_size == 0 ||
+      slot_size > ((guint64) st.st_size - SHM_HEADER_SIZE) / num_slots) {
+    nns_loge ("Invalid shared memory %s.", name);
+    munmap (addr, st.st_size);
+    return NULL;
+  }
+
+  map = g_new0 (GstTensorQueryShmMap, 1);
+  map->name = g_strdup (name);
+  map->addr = addr;
+  map->size = st.st_size;
+  map->num_slots = num_slots;
+  map->slot_size = slot_size;
+  map->refcount = 1;
+
+  return map;
+}
+
+/**
+ * @brief Release a reference of the slot, and return it to the sender with the last one.
+ */
+static void
+_shm_slot_unref (gpointer data)
+{
+  GstTensorQueryShmSlot *sslot = (GstTensorQueryShmSlot *) data;
+  GstTensorQueryShmHeader *header;
+
+  if (g_atomic_int_dec_and_test (&sslot->refcount)) {
+    header = (GstTensorQueryShmHeader *) sslot->map->addr;
+    g_atomic_int_set (&header->state[sslot->slot], SHM_SLOT_FREE);
+
+    _shm_map_unref (sslot->map);
+    g_free (sslot);
+  }
+}
+
+/**
+ * @brief Create a reader which maps the shared-memory segments of the senders.
+ */
+GstTensorQueryShmReader *
+gst_tensor_query_shm_reader_new (void)
+{
+  GstTensorQueryShmReader *reader;
+
+  reader = g_new0 (GstTensorQueryShmReader, 1);
+  reader->maps = g_hash_table_new_full (g_str_hash, g_str_equal, g_free,
+      _shm_map_unref);
+
+  return reader;
+}
+
+/**
+ * @brief Release the reader.
+ */
+void
+gst_tensor_query_shm_reader_free (GstTensorQueryShmReader * reader)
+{
+  if (!reader)
+    return;
+
+  g_hash_table_destroy (reader->maps);
+  g_free (reader);
+}
+
+/**
+ * @brief Find the slot described in the edge data, and get the offsets and sizes of the tensor data in the slot.
+ * @return The segment of the slot (owned by the reader), NULL if the edge data does not carry the descriptor (or on failure).
+ */
+static GstTensorQueryShmMap *
+_shm_reader_find_slot (GstTensorQueryShmReader * reader,
+    nns_edge_data_h data_h, guint * slot, guint * num, gsize * sizes,
+    gsize * offsets)
+{
+  GstTensorQueryShmMap *map = NULL, *found = NULL;
+  gchar *id = NULL, *name = NULL, *sizes_str = NULL, *slot_str = NULL;
+  gchar *prefix = NULL;
+  gchar **strv = NULL;
+  guint i;
+
+  if (NNS_EDGE_ERROR_NONE != nns_edge_data_get_info (data_h, "shm_name",
+          &name)) {
+    /* the tensor data is in the edge data */
+    return NULL;
+  }
+
+  if (NNS_EDGE_ERROR_NONE != nns_edge_data_get_info (data_h, "shm_id", &id) ||
+      NNS_EDGE_ERROR_NONE != nns_edge_data_get_info (data_h, "shm_sizes",
+          &sizes_str) ||
+      NNS_EDGE_ERROR_NONE != nns_edge_data_get_info (data_h, "shm_slot",
+          &slot_str)) {
+    nns_loge ("Invalid shared memory descriptor.");
+    goto done;
+  }
+
+  if (!gst_tensor_query_shm_is_local (data_h)) {
+    nns_loge ("The shared memory %s is not on this host.", name);
+    goto done;
+  }
+
+  /* only the segments of the query senders, named by the writer id */
+  prefix = g_strdup_printf ("/nnsquery-%s-", id);
+  if (strchr (id, '/') || !g_str_has_prefix (name, prefix) ||
+      !_shm_is_digits (name + strlen (prefix))) {
+    nns_loge ("Invalid shared memory name %s.", name);
+    goto done;
+  }
+
+  strv = g_strsplit (sizes_str, ",", -1);
+  *num = g_strv_length (strv);
+  if (*num == 0 || *num > NNS_TENSOR_SIZE_LIMIT) {
+    nns_loge ("Invalid number of tensors in shared memory (%u).", *num);
+    goto done;
+  }
+
+  for (i = 0; i < *num; i++)
+    sizes[i] = (gsize) g_ascii_strtoull (strv[i], NULL, 10);
+
+  /* the sender creates new segment when the slots grow. */
+  map = g_hash_table_lookup (reader->maps, id);
+  if (!map || !g_str_equal (map->name, name)) {
+    map = _shm_map_open (name);
+    if (!map)
+      goto done;
+
+    g_hash_table_replace (reader->maps, g_strdup (id), map);
+  }
+
+  /* check each size first, the total size does not overflow then */
+  for (i = 0; i < *num; i++) {
+    if (sizes[i] > map->slot_size)
+      break;
+  }
+
+  *slot = (guint) g_ascii_strtoull (slot_str, NULL, 10);
+  if (i < *num || *slot >= map->num_slots ||
+      _shm_get_offsets (sizes, *num, offsets) > map->slot_size) {
+    nns_loge ("Invalid shared memory slot %u of %s.", *slot, name);
+    goto done;
+  }
+
+  found = map;
+
+done:
+  g_strfreev (strv);
+  g_free (prefix);
+  g_free (id);
+  g_free (name);
+  g_free (sizes_str);
+  g_free (slot_str);
+  return found;
+}
+
+/**
+ * @brief Create a buffer referring the slot described in the edge data.
+ */
+GstBuffer *
+gst_tensor_query_shm_read (GstTensorQueryShmReader * reader,
+    nns_edge_data_h data_h)
+{
+  GstTensorQueryShmMap *map;
+  GstTensorQueryShmSlot *sslot;
+  GstBuffer *buffer;
+  gsize sizes[NNS_TENSOR_SIZE_LIMIT], offsets[NNS_TENSOR_SIZE_LIMIT];
+  guint8 *slot_data;
+  guint i, num = 0, slot = 0;
+
+  g_return_val_if_fail (reader != NULL, NULL);
+
+  map = _shm_reader_find_slot (reader, data_h, &slot, &num, sizes, offsets);
+  if (!map)
+    return NULL;
+
+  sslot = g_new0 (GstTensorQueryShmSlot, 1);
+  sslot->map = map;
+  sslot->slot = slot;
+  sslot->refcount = 1;
+  g_atomic_int_inc (&map->refcount);
+
+  slot_data = (guint8 *) map->addr + SHM_HEADER_SIZE + slot * map->slot_size;
+
+  buffer = gst_buffer_new ();
+  for (i = 0; i < num; i++) {
+    g_atomic_int_inc (&sslot->refcount);
+    gst_buffer_append_memory (buffer,
+        gst_memory_new_wrapped (0, slot_data + offsets[i], sizes[i], 0,
+            sizes[i], sslot, _shm_slot_unref));
+  }
+
+  _shm_slot_unref (sslot);
+  nns_edge_data_destroy (data_h);
+
+  return buffer;
+}
+
+/**
+ * @brief Return the slot described in the edge data to the sender, when the data is dropped without reading.
+ */
+void
+gst_tensor_query_shm_discard (GstTensorQueryShmReader * reader,
+    nns_edge_data_h data_h)
+{
+  GstTensorQueryShmMap *map;
+  GstTensorQueryShmHeader *header;
+  gsize sizes[NNS_TENSOR_SIZE_LIMIT], offsets[NNS_TENSOR_SIZE_LIMIT];
+  guint num = 0, slot = 0;
+
+  g_return_if_fail (reader != NULL);
+
+  map = _shm_reader_find_slot (reader, data_h, &slot, &num, sizes, offsets);
+  if (map) {
+    header = (GstTensorQueryShmHeader *) map->addr;
+    g_atomic_int_set (&header->state[slot], SHM_SLOT_FREE);
+  }
+}
@@ -0,0 +1,101 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file   tensor_query_shm.h
+ * @date   15 Oct 2026
+ * @brief  Shared-memory payload transport for the same-host tensor query
+ * @see    https://github.com/nnstreamer/nnstreamer
+ * @bug    No known bugs except for NYI items
+ *
+ * The sender copies the tensor data into a slot of a POSIX shared-memory
+ * ring, and the edge data carries only the descriptor (segment name, slot and
+ * sizes). The receiver maps the segment and wraps the slot without copying,
+ * the slot is returned to the sender when the memories are released.
+ * If all slots are held (e.g., by a receiver which stopped), the sender falls
+ * back to the tensor data in the edge data.
+ * The edge data carries the key of the sender's host. A sender uses the shared
+ * memory only after it receives the edge data from the peer on the same host.
+ */
+
+#ifndef __TENSOR_QUERY_SHM_H__
+#define __TENSOR_QUERY_SHM_H__
+
+#include <gst/gst.h>
+#include <nnstreamer-edge.h>
+
+G_BEGIN_DECLS
+
+typedef struct _GstTensorQueryShmWriter GstTensorQueryShmWriter;
+typedef struct _GstTensorQueryShmReader GstTensorQueryShmReader;
+
+/**
+ * @brief Set the key of this host to the edge data.
+ */
+void
+gst_tensor_query_shm_set_host (nns_edge_data_h data_h);
+
+/**
+ * @brief Check whether the edge data is sent from the peer on this host.
+ */
+gboolean
+gst_tensor_query_shm_is_local (nns_edge_data_h data_h);
+
+/**
+ * @brief Create a writer which owns the shared-memory ring of a sender.
+ */
+GstTensorQueryShmWriter *
+gst_tensor_query_shm_writer_new (void);
+
+/**
+ * @brief Release the writer and unlink its shared-memory segments.
+ */
+void
+gst_tensor_query_shm_writer_free (GstTensorQueryShmWriter * writer);
+
+/**
+ * @brief Copy the mapped memories into a free slot and set the descriptor to the edge data.
+ * @return TRUE if the data is written. FALSE if no slot is available, then the caller should add the memories to the edge data.
+ */
+gboolean
+gst_tensor_query_shm_write (GstTensorQueryShmWriter * writer,
+    nns_edge_data_h data_h, GstMapInfo * map, guint num);
+
+/**
+ * @brief Return the slot described in the edge data, if the data is not delivered to the receiver.
+ */
+void
+gst_tensor_query_shm_cancel (GstTensorQueryShmWriter * writer,
+    nns_edge_data_h data_h);
+
+/**
+ * @brief Create a reader which maps the shared-memory segments of the senders.
+ */
+GstTensorQueryShmReader *
+gst_tensor_query_shm_reader_new (void);
+
+/**
+ * @brief Release the reader. The segments are unmapped when the buffers referring them are released.
+ */
+void
+gst_tensor_query_shm_reader_free (GstTensorQueryShmReader * reader);
+
+/**
+ * @brief Create a buffer referring the slot described in the edge data.
+ * @return Newly created buffer, and the edge data is destroyed. NULL if the edge data does not carry the descriptor (or on failure), the caller keeps the ownership of the edge data.
+ * @note The descriptor is accepted only from the same host, for the segment named by the sender's id.
+ */
+GstBuffer *
+gst_tensor_query_shm_read (GstTensorQueryShmReader * reader,
+    nns_edge_data_h data_h);
+
+/**
+ * @brief Return the slot described in the edge data to the sender, when the data is dropped without reading.
+ * @note The caller keeps the ownership of the edge data. Call this before destroying the received edge data which is not read.
+ */
+void
+gst_tensor_query_shm_discard (GstTensorQueryShmReader * reader,
+    nns_edge_data_h data_h);
+
+G_END_DECLS
+#endif /* __TENSOR_QUERY_SHM_H__ */
@@ -51,6 +51,7 @@ NNSTREAMER_PLUGINS_SRCS := \
     $(NNSTREAMER_GST_HOME)/registerer/nnstreamer.c \
     $(NNSTREAMER_GST_HOME)/elements/gsttensor_aggregator.c \
     $(NNSTREAMER_GST_HOME)/elements/gsttensor_converter.c \
+    $(NNSTREAMER_GST_HOME)/elements/gsttensor_converter_yuv.c \
     $(NNSTREAMER_GST_HOME)/elements/gsttensor_crop.c \
     $(NNSTREAMER_GST_HOME)/elements/gsttensor_debug.c \
     $(NNSTREAMER_GST_HOME)/elements/gsttensor_decoder.c \
@@ -77,7 +78,8 @@ NNSTREAMER_QUERY_SRCS := \
     $(NNSTREAMER_GST_HOME)/tensor_query/tensor_query_client.c \
     $(NNSTREAMER_GST_HOME)/tensor_query/tensor_query_serversink.c \
     $(NNSTREAMER_GST_HOME)/tensor_query/tensor_query_serversrc.c \
-    $(NNSTREAMER_GST_HOME)/tensor_query/tensor_query_server.c
+    $(NNSTREAMER_GST_HOME)/tensor_query/tensor_query_server.c \
+    $(NNSTREAMER_GST_HOME)/tensor_query/tensor_query_shm.c
 
 # source AMC (Android MediaCodec)
 NNSTREAMER_SOURCE_AMC_SRCS := \
@@ -141,12 +143,14 @@ NNSTREAMER_DECODER_FLEXBUF_SRCS := \
 NNSTREAMER_DECODER_BB_SRCS := \
     $(NNSTREAMER_EXT_HOME)/tensor_decoder/tensordec-boundingbox.c \
     $(NNSTREAMER_EXT_HOME)/tensor_decoder/tensordecutil.c \
+    $(NNSTREAMER_EXT_HOME)/tensor_decoder/tensordecnms.c \
     $(NNSTREAMER_EXT_HOME)/tensor_decoder/tensordec-font.c
 
 #decoder tensorRegion
 NNSTREAMER_DECODER_TR_SRCS := \
     $(NNSTREAMER_EXT_HOME)/tensor_decoder/tensordec-tensor_region.c \
     $(NNSTREAMER_EXT_HOME)/tensor_decoder/tensordecutil.c \
+    $(NNSTREAMER_EXT_HOME)/tensor_decoder/tensordecnms.c
 
 # decoder directvideo
 NNSTREAMER_DECODER_DV_SRCS := \
@@ -183,7 +187,8 @@ NNSTREAMER_MQTT_SRCS := \
     $(NNSTREAMER_ROOT)/gst/mqtt/mqttelements.c \
     $(NNSTREAMER_ROOT)/gst/mqtt/mqttsink.c \
     $(NNSTREAMER_ROOT)/gst/mqtt/mqttsrc.c \
-    $(NNSTREAMER_ROOT)/gst/mqtt/ntputil.c
+    $(NNSTREAMER_ROOT)/gst/mqtt/ntputil.c \
+    $(NNSTREAMER_ROOT)/gst/mqtt/mqttcommon.c
 
 # common features
 NO_AUDIO := false
@@ -1625,6 +1625,97 @@ TEST (commonMetaInfo, appendHeaderInvalidParam_n)
   gst_memory_unref (data);
 }
 
+/**
+ * @brief Test for tensor meta info (append header to memory with reserved header).
+ */
+TEST (commonMetaInfo, reserveHeader)
+{
+  GstTensorMetaInfo meta1, meta2;
+  GstMemory *result, *data;
+  GstMapInfo data_map, result_map;
+  gsize hsize, msize;
+  guint i;
+
+  gst_tensor_meta_info_init (&meta1);
+  meta1.type = _NNS_UINT8;
+  meta1.dimension[0] = 300U;
+  meta1.dimension[1] = 1U;
+
+  hsize = gst_tensor_meta_info_get_header_size (&meta1);
+  data = gst_allocator_alloc (NULL, hsize + 300, NULL);
+
+  EXPECT_TRUE (gst_tensor_meta_info_reserve_header (&meta1, data));
+  msize = gst_memory_get_sizes (data, NULL, NULL);
+  EXPECT_EQ (msize, 300U);
+
+  ASSERT_TRUE (gst_memory_map (data, &data_map, GST_MAP_WRITE));
+  for (i = 0; i < 300U; i++)
+    data_map.data[i] = (guint8) i;
+  gst_memory_unmap (data, &data_map);
+
+  /* same header, the data is not copied */
+  result = gst_tensor_meta_info_append_header (&meta1, data);
+  EXPECT_TRUE (result != NULL);
+
+  msize = gst_memory_get_sizes (result, NULL, NULL);
+  EXPECT_EQ (msize, hsize + 300U);
+
+  EXPECT_TRUE (gst_tensor_meta_info_parse_memory (&meta2, result));
+  EXPECT_EQ (meta2.type, _NNS_UINT8);
+  EXPECT_EQ (meta2.dimension[0], 300U);
+
+  ASSERT_TRUE (gst_memory_map (data, &data_map, GST_MAP_READ));
+  ASSERT_TRUE (gst_memory_map (result, &result_map, GST_MAP_READ));
+  EXPECT_TRUE (result_map.data + hsize == data_map.data);
+  gst_memory_unmap (result, &result_map);
+  gst_memory_unmap (data, &data_map);
+  gst_memory_unref (result);
+
+  /* different header, the data is copied */
+  meta2 = meta1;
+  meta2.media_type = _NNS_OCTET;
+  result = gst_tensor_meta_info_append_header (&meta2, data);
+  EXPECT_TRUE (result != NULL);
+
+  ASSERT_TRUE (gst_memory_map (data, &data_map, GST_MAP_READ));
+  ASSERT_TRUE (gst_memory_map (result, &result_map, GST_MAP_READ));
+  EXPECT_FALSE (result_map.data + hsize == data_map.data);
+  for (i = 0; i < 300U; i++)
+    EXPECT_EQ (result_map.data[hsize + i], (guint8) i);
+  gst_memory_unmap (result, &result_map);
+  gst_memory_unmap (data, &data_map);
+
+  EXPECT_TRUE (gst_tensor_meta_info_parse_memory (&meta1, result));
+  EXPECT_EQ ((media_type) meta1.media_type, _NNS_OCTET);
+
+  gst_memory_unref (data);
+  gst_memory_unref (result);
+}
+
+/**
+ * @brief Test for tensor meta info (reserve header with invalid param).
+ */
+TEST (commonMetaInfo, reserveHeaderInvalidParam_n)
+{
+  GstTensorMetaInfo meta;
+  GstMemory *data;
+  gsize hsize;
+
+  gst_tensor_meta_info_init (&meta);
+  meta.type = _NNS_UINT8;
+  meta.dimension[0] = 10U;
+
+  hsize = gst_tensor_meta_info_get_header_size (&meta);
+  data = gst_allocator_alloc (NULL, hsize - 1, NULL);
+
+  EXPECT_FALSE (gst_tensor_meta_info_reserve_header (NULL, data));
+  EXPECT_FALSE (gst_tensor_meta_info_reserve_header (&meta, NULL));
+  /* memory is smaller than the header */
+  EXPECT_FALSE (gst_tensor_meta_info_reserve_header (&meta, data));
+
+  gst_memory_unref (data);
+}
+
 /**
  * @brief Test for tensor meta info (convert meta).
  */
@@ -2164,6 +2255,79 @@ TEST (commonUtil, createTensorBufferInvalidSize_n)
   gst_buffer_unref (out);
 }
 
+/**
+ * @brief Test tensor buffer util (append extra tensors)
+ */
+TEST (commonUtil, appendExtraTensors)
+{
+  GstTensorInfo info;
+  GstBuffer *buffer;
+  GstMemory *mem, *last;
+  GstMapInfo map;
+  guint i, num, realloc_count = 0;
+  const guint max_tensors = NNS_TENSOR_SIZE_LIMIT + NNS_TENSOR_SIZE_EXTRA_LIMIT;
+
+  gst_tensor_info_init (&info);
+  info.type = _NNS_UINT32;
+  gst_tensor_parse_dimension ("2", info.dimension);
+
+  buffer = gst_buffer_new ();
+  last = NULL;
+
+  for (i = 0; i < max_tensors; i++) {
+    mem = gst_allocator_alloc (NULL, 2 * sizeof (guint), NULL);
+    ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_WRITE));
+    ((guint *) map.data)[0] = i;
+    ((guint *) map.data)[1] = i * 10;
+    gst_memory_unmap (mem, &map);
+
+    EXPECT_TRUE (gst_tensor_buffer_append_memory (buffer, mem, &info));
+
+    if (i >= NNS_TENSOR_SIZE_LIMIT) {
+      mem = gst_buffer_peek_memory (buffer, NNS_TENSOR_SIZE_LIMIT - 1);
+      if (mem != last)
+        realloc_count++;
+      last = mem;
+    }
+  }
+
+  /* the extra memory grows in place, not reallocated on every append */
+  EXPECT_LT (realloc_count, 20U);
+  EXPECT_EQ (gst_buffer_n_memory (buffer), (guint) NNS_TENSOR_SIZE_LIMIT);
+
+  num = gst_tensor_buffer_get_count (buffer);
+  EXPECT_EQ (num, max_tensors);
+
+  /* get the tensors in reverse order, then in order */
+  for (i = num; i > 0; i--) {
+    mem = gst_tensor_buffer_get_nth_memory (buffer, i - 1);
+    ASSERT_TRUE (mem != NULL);
+    ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READ));
+    EXPECT_EQ (map.size, 2 * sizeof (guint));
+    EXPECT_EQ (((guint *) map.data)[0], i - 1);
+    EXPECT_EQ (((guint *) map.data)[1], (i - 1) * 10);
+    gst_memory_unmap (mem, &map);
+    gst_memory_unref (mem);
+  }
+
+  for (i = 0; i < num; i++) {
+    mem = gst_tensor_buffer_get_nth_memory (buffer, i);
+    ASSERT_TRUE (mem != NULL);
+    ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READ));
+    EXPECT_EQ (((guint *) map.data)[0], i);
+    gst_memory_unmap (mem, &map);
+    gst_memory_unref (mem);
+  }
+
+  /* no more room for the tensor */
+  mem = gst_allocator_alloc (NULL, 2 * sizeof (guint), NULL);
+  EXPECT_FALSE (gst_tensor_buffer_append_memory (buffer, mem, &info));
+  EXPECT_EQ (gst_tensor_buffer_get_count (buffer), max_tensors);
+
+  gst_buffer_unref (buffer);
+  gst_tensor_info_free (&info);
+}
+
 /**
  * @brief Test tensor dimension validation check util
  */
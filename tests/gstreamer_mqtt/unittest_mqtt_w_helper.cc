@@ -220,6 +220,7 @@ TEST (testMqttSink, sinkGetSetProperties)
   gchar *sprop = NULL;
   gboolean bprop;
   gint iprop;
+  guint uprop;
   gulong ulprop;
 
   ASSERT_TRUE (h != NULL);
@@ -284,6 +285,34 @@ TEST (testMqttSink, sinkGetSetProperties)
   EXPECT_STREQ (sprop, "time.google.com:123");
   g_free (sprop);
 
+  g_object_get (h->element, "compact-header", &bprop, NULL);
+  EXPECT_FALSE (bprop);
+
+  g_object_set (h->element, "compact-header", true, NULL);
+  g_object_get (h->element, "compact-header", &bprop, NULL);
+  EXPECT_TRUE (bprop);
+
+  g_object_get (h->element, "aggregate-buffers", &uprop, NULL);
+  EXPECT_EQ (uprop, 1U);
+
+  g_object_set (h->element, "aggregate-buffers", 8U, NULL);
+  g_object_get (h->element, "aggregate-buffers", &uprop, NULL);
+  EXPECT_EQ (uprop, 8U);
+
+  g_object_get (h->element, "aggregate-bytes", &ulprop, NULL);
+  EXPECT_EQ (ulprop, 0UL);
+
+  g_object_set (h->element, "aggregate-bytes", 65536UL, NULL);
+  g_object_get (h->element, "aggregate-bytes", &ulprop, NULL);
+  EXPECT_EQ (ulprop, 65536UL);
+
+  g_object_get (h->element, "aggregate-delay", &uprop, NULL);
+  EXPECT_EQ (uprop, 10U);
+
+  g_object_set (h->element, "aggregate-delay", 0U, NULL);
+  g_object_get (h->element, "aggregate-delay", &uprop, NULL);
+  EXPECT_EQ (uprop, 0U);
+
   gst_harness_teardown (h);
 }
 
@@ -1064,6 +1093,227 @@ free_strs:
     FAIL () << err_msg;
 }
 
+/**
+ * @brief Test for the compact message header (encode and decode)
+ */
+TEST (testMqttCommon, compactHeader)
+{
+  const gchar caps_str[] = "other/tensors,format=static,num_tensors=1";
+  GstMQTTMessageHdr hdr, decoded;
+  guint8 msg[GST_MQTT_LEN_MSG_HDR];
+  gboolean with_caps;
+  guint32 hash;
+  gsize len, i;
+
+  memset (&hdr, 0, sizeof (hdr));
+  hdr.num_mems = 2;
+  hdr.size_mems[0] = 16;
+  hdr.size_mems[1] = 300;
+  hdr.base_time_epoch = g_get_real_time () * GST_US_TO_NS_MULTIPLIER;
+  hdr.sent_time_epoch = hdr.base_time_epoch + GST_SECOND;
+  hdr.pts = 5 * GST_SECOND;
+  hdr.dts = GST_CLOCK_TIME_NONE;
+  hdr.duration = 33 * GST_MSECOND;
+  g_strlcpy (hdr.gst_caps_str, caps_str, GST_MQTT_MAX_LEN_GST_CAPS_STR);
+
+  /* without caps */
+  len = gst_mqtt_compact_hdr_encode (
+      &hdr, gst_mqtt_caps_hash (caps_str), FALSE, msg, sizeof (msg));
+  EXPECT_GT (len, 0U);
+  EXPECT_LT (len, 64U);
+  EXPECT_TRUE (gst_mqtt_is_compact_hdr (msg, len));
+
+  EXPECT_EQ (gst_mqtt_compact_hdr_decode (msg, sizeof (msg), &decoded, &hash, &with_caps), len);
+  EXPECT_FALSE (with_caps);
+  EXPECT_EQ (hash, gst_mqtt_caps_hash (caps_str));
+  EXPECT_EQ (decoded.num_mems, 2U);
+  EXPECT_EQ (decoded.size_mems[0], 16U);
+  EXPECT_EQ (decoded.size_mems[1], 300U);
+  EXPECT_EQ (decoded.base_time_epoch, hdr.base_time_epoch);
+  EXPECT_EQ (decoded.sent_time_epoch, hdr.sent_time_epoch);
+  EXPECT_EQ (decoded.pts, hdr.pts);
+  EXPECT_EQ (decoded.dts, GST_CLOCK_TIME_NONE);
+  EXPECT_EQ (decoded.duration, hdr.duration);
+
+  /* with caps */
+  len = gst_mqtt_compact_hdr_encode (
+      &hdr, gst_mqtt_caps_hash (caps_str), TRUE, msg, sizeof (msg));
+  EXPECT_GT (len, strlen (caps_str));
+  EXPECT_EQ (gst_mqtt_compact_hdr_decode (msg, len, &decoded, &hash, &with_caps), len);
+  EXPECT_TRUE (with_caps);
+  EXPECT_STREQ (decoded.gst_caps_str, caps_str);
+
+  /* truncated header */
+  for (i = 0; i < len; i++)
+    EXPECT_EQ (gst_mqtt_compact_hdr_decode (msg, i, &decoded, &hash, &with_caps), 0U);
+  EXPECT_EQ (gst_mqtt_compact_hdr_encode (&hdr, 0, TRUE, msg, len - 1), 0U);
+}
+
+/**
+ * @brief Test for the compact header of the aggregated message
+ */
+TEST (testMqttCommon, compactHeaderAggregated)
+{
+  const gchar *caps_str = "other/tensors,num_tensors=1,format=static";
+  const guint num_bufs = 4;
+  GstMQTTMessageHdr hdr, decoded;
+  GstMQTTBufferInfo infos[4];
+  GstMQTTBufferInfo *decoded_infos;
+  guint8 *msg;
+  gsize msg_size, len, i;
+  guint num_infos;
+  gboolean with_caps;
+  guint32 hash;
+
+  memset (&hdr, 0, sizeof (hdr));
+  hdr.base_time_epoch = g_get_real_time () * GST_US_TO_NS_MULTIPLIER;
+  hdr.sent_time_epoch = hdr.base_time_epoch + GST_SECOND;
+  g_strlcpy (hdr.gst_caps_str, caps_str, GST_MQTT_MAX_LEN_GST_CAPS_STR);
+
+  memset (infos, 0, sizeof (infos));
+  for (i = 0; i < num_bufs; i++) {
+    infos[i].num_mems = 1 + (i % 2);
+    infos[i].size_mems[0] = 64 * (i + 1);
+    infos[i].size_mems[1] = 3;
+    infos[i].pts = (i + 1) * 33 * GST_MSECOND;
+    infos[i].dts = GST_CLOCK_TIME_NONE;
+    infos[i].duration = (i == 2) ? GST_CLOCK_TIME_NONE : 33 * GST_MSECOND;
+  }
+
+  msg_size = GST_MQTT_LEN_MSG_HDR + num_bufs * GST_MQTT_MAX_LEN_BUF_INFO;
+  msg = (guint8 *) g_malloc0 (msg_size);
+  decoded_infos = g_new0 (GstMQTTBufferInfo, GST_MQTT_MAX_AGGREGATED_BUFFERS);
+
+  len = gst_mqtt_compact_hdr_encode_aggregated (&hdr, infos, num_bufs,
+      gst_mqtt_caps_hash (caps_str), TRUE, msg, msg_size);
+  EXPECT_GT (len, strlen (caps_str));
+  EXPECT_TRUE (gst_mqtt_is_compact_hdr (msg, len));
+
+  /* the single-buffer decoder does not accept the aggregated message */
+  EXPECT_EQ (gst_mqtt_compact_hdr_decode (msg, len, &decoded, &hash, &with_caps), 0U);
+
+  EXPECT_EQ (gst_mqtt_compact_hdr_decode_aggregated (msg, len, &decoded,
+                 decoded_infos, &num_infos, &hash, &with_caps),
+      len);
+  EXPECT_EQ (num_infos, num_bufs);
+  EXPECT_TRUE (with_caps);
+  EXPECT_EQ (hash, gst_mqtt_caps_hash (caps_str));
+  EXPECT_STREQ (decoded.gst_caps_str, caps_str);
+  EXPECT_EQ (decoded.base_time_epoch, hdr.base_time_epoch);
+  EXPECT_EQ (decoded.sent_time_epoch, hdr.sent_time_epoch);
+
+  for (i = 0; i < num_bufs; i++) {
+    EXPECT_EQ (decoded_infos[i].num_mems, infos[i].num_mems);
+    EXPECT_EQ (decoded_infos[i].size_mems[0], infos[i].size_mems[0]);
+    if (infos[i].num_mems > 1) {
+      EXPECT_EQ (decoded_infos[i].size_mems[1], infos[i].size_mems[1]);
+    }
+    EXPECT_EQ (decoded_infos[i].pts, infos[i].pts);
+    EXPECT_EQ (decoded_infos[i].dts, infos[i].dts);
+    EXPECT_EQ (decoded_infos[i].duration, infos[i].duration);
+  }
+
+  /* truncated header */
+  for (i = 0; i < len; i++)
+    EXPECT_EQ (gst_mqtt_compact_hdr_decode_aggregated (msg, i, &decoded,
+                   decoded_infos, &num_infos, &hash, &with_caps),
+        0U);
+
+  /* no room for the header */
+  EXPECT_EQ (gst_mqtt_compact_hdr_encode_aggregated (&hdr, infos, num_bufs,
+                 gst_mqtt_caps_hash (caps_str), TRUE, msg, len - 1),
+      0U);
+
+  g_free (decoded_infos);
+  g_free (msg);
+}
+
+/**
+ * @brief Test for the legacy message header, not detected as the compact header
+ */
+TEST (testMqttCommon, compactHeaderLegacy_n)
+{
+  GstMQTTMessageHdr hdr;
+
+  memset (&hdr, 0, sizeof (hdr));
+  hdr.num_mems = GST_MQTT_MAX_NUM_MEMS;
+
+  EXPECT_FALSE (gst_mqtt_is_compact_hdr ((guint8 *) &hdr, sizeof (hdr)));
+  EXPECT_FALSE (gst_mqtt_is_compact_hdr (NULL, 0));
+}
+
+/**
+ * @brief Test mqttsrc receiving the message with the compact header
+ */
+TEST (testMqttSrcWithHelper, srcCompactHeader)
+{
+  const gsize len_buf = 1024;
+  gchar *caps_str = g_strdup ("video/x-raw,width=640,height=320,format=RGB");
+  gchar *topic_name = g_strdup ("test_topic");
+  gchar *str_pipeline = g_strdup_printf (
+      "mqttsrc sub-topic=%s debug=true is-live=true num-buffers=%d "
+      "sub-timeout=%" G_GINT64_FORMAT " ! "
+      "capsfilter caps=%s ! videoconvert ! videoscale ! fakesink",
+      topic_name, 1, G_TIME_SPAN_MINUTE, caps_str);
+  GError *err = NULL;
+  GstElement *pipeline;
+  GstStateChangeReturn ret;
+  GstState cur_state;
+  GstMQTTMessageHdr hdr;
+  MQTTAsync_message *msg;
+  std::future<int> ma_ret;
+  gsize hdr_len;
+
+  pipeline = gst_parse_launch (str_pipeline, &err);
+  g_free (str_pipeline);
+  ASSERT_TRUE (pipeline != NULL);
+  ASSERT_TRUE (err == NULL);
+  GstMqttTestHelper::getInstance ().initFailFlags ();
+
+  _set_ts_gst_mqtt_message_hdr (pipeline, &hdr, GST_SECOND, 500 * GST_MSECOND);
+  g_strlcpy (hdr.gst_caps_str, caps_str, GST_MQTT_MAX_LEN_GST_CAPS_STR);
+  hdr.num_mems = 1;
+  hdr.size_mems[0] = len_buf;
+
+  msg = (MQTTAsync_message *) g_malloc0 (sizeof (*msg));
+  msg->payload = g_malloc0 (GST_MQTT_LEN_MSG_HDR + len_buf);
+  hdr_len = gst_mqtt_compact_hdr_encode (&hdr, gst_mqtt_caps_hash (caps_str),
+      TRUE, (guint8 *) msg->payload, GST_MQTT_LEN_MSG_HDR);
+  ASSERT_GT (hdr_len, 0U);
+  msg->payloadlen = hdr_len + len_buf;
+
+  ret = gst_element_set_state (pipeline, GST_STATE_PAUSED);
+  EXPECT_NE (ret, GST_STATE_CHANGE_FAILURE);
+
+  ret = gst_element_get_state (pipeline, &cur_state, NULL, GST_CLOCK_TIME_NONE);
+  EXPECT_EQ (ret, GST_STATE_CHANGE_NO_PREROLL);
+  EXPECT_EQ (cur_state, GST_STATE_PAUSED);
+
+  ret = gst_element_set_state (pipeline, GST_STATE_PLAYING);
+  EXPECT_NE (ret, GST_STATE_CHANGE_FAILURE);
+
+  ma_ret = std::async (std::launch::async,
+      GstMqttTestHelper::getInstance ().getCbMessageArrived (),
+      GstMqttTestHelper::getInstance ().getContext (), topic_name, 0, msg);
+  EXPECT_TRUE (ma_ret.get ());
+
+  ret = gst_element_get_state (pipeline, &cur_state, NULL, GST_CLOCK_TIME_NONE);
+  EXPECT_EQ (ret, GST_STATE_CHANGE_SUCCESS);
+  EXPECT_EQ (cur_state, GST_STATE_PLAYING);
+
+  ret = gst_element_set_state (pipeline, GST_STATE_NULL);
+  EXPECT_NE (ret, GST_STATE_CHANGE_FAILURE);
+
+  ret = gst_element_get_state (pipeline, &cur_state, NULL, GST_CLOCK_TIME_NONE);
+  EXPECT_EQ (ret, GST_STATE_CHANGE_SUCCESS);
+  gst_object_unref (pipeline);
+
+  g_free (msg->payload);
+  g_free (msg);
+  g_free (caps_str);
+  g_free (topic_name);
+}
+
 /**
  * @brief Main GTest
  */
@@ -11,7 +11,9 @@
 #include <flatbuffers/flexbuffers.h>
 #include <glib.h>
 #include <gst/app/gstappsrc.h>
+#include <gst/check/gstharness.h>
 #include <gst/gst.h>
+#include <gst/video/gstvideometa.h>
 #include <nnstreamer_plugin_api_converter.h>
 #include <nnstreamer_util.h>
 #include <tensor_common.h>
@@ -724,6 +726,360 @@ TEST (tensorConverterPython, invalidParam6_n)
   g_free (test_model);
 }
 
+/**
+ * @brief Internal function to convert a solid-color (R 200, G 100, B 50) YUV frame with tensor_converter.
+ */
+static gchar *
+_convert_yuv_frame (const gchar *format, const gchar *option, gsize exp_len)
+{
+  gchar *content = NULL;
+  gsize len = 0;
+  char *tmp_raw = getTempFilename ();
+  gchar *str_pipeline = g_strdup_printf (
+      "videotestsrc num-buffers=1 pattern=solid-color foreground-color=0xffc86432 ! "
+      "video/x-raw,format=%s,width=640,height=480,framerate=30/1 ! tensor_converter %s ! "
+      "filesink location=%s buffer-mode=unbuffered sync=false async=false",
+      format, option, tmp_raw);
+  GstElement *pipeline = gst_parse_launch (str_pipeline, NULL);
+
+  EXPECT_NE (pipeline, nullptr);
+  if (pipeline) {
+    EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PLAYING, TEST_TIMEOUT_MS), 0);
+    _wait_pipeline_save_files (tmp_raw, content, len, exp_len, TEST_TIMEOUT_MS);
+    EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_NULL, TEST_TIMEOUT_MS), 0);
+    gst_object_unref (pipeline);
+  }
+
+  EXPECT_EQ (len, exp_len);
+  if (len != exp_len) {
+    g_free (content);
+    content = NULL;
+  }
+
+  g_free (str_pipeline);
+  removeTempFile (&tmp_raw);
+  return content;
+}
+
+/**
+ * @brief Test for YUV video stream converted to RGB tensor.
+ */
+TEST (tensorConverterYuv, convertRgb)
+{
+  const gchar *formats[] = { "NV12", "I420", "YUY2" };
+  const gsize size = 640 * 480 * 3;
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (formats); i++) {
+    guint8 *data = (guint8 *) _convert_yuv_frame (formats[i], "", size);
+
+    ASSERT_NE (data, nullptr);
+    EXPECT_NEAR (data[0], 200, 4);
+    EXPECT_NEAR (data[1], 100, 4);
+    EXPECT_NEAR (data[2], 50, 4);
+    EXPECT_NEAR (data[size - 3], 200, 4);
+    EXPECT_NEAR (data[size - 2], 100, 4);
+    EXPECT_NEAR (data[size - 1], 50, 4);
+    g_free (data);
+  }
+}
+
+/**
+ * @brief Test for YUV video stream resized with letterbox.
+ */
+TEST (tensorConverterYuv, resizeLetterbox)
+{
+  /* 640x480 is resized to 320x240, and the first and last 40 rows are black. */
+  const gsize row = 320 * 3;
+  guint8 *data = (guint8 *) _convert_yuv_frame (
+      "NV12", "output-size=320:320 letterbox=true", 320 * row);
+
+  ASSERT_NE (data, nullptr);
+  EXPECT_EQ (data[0], 0);
+  EXPECT_EQ (data[39 * row + 1], 0);
+  EXPECT_NEAR (data[40 * row], 200, 4);
+  EXPECT_NEAR (data[160 * row + 160 * 3 + 1], 100, 4);
+  EXPECT_NEAR (data[279 * row + 2], 50, 4);
+  EXPECT_EQ (data[280 * row], 0);
+  EXPECT_EQ (data[320 * row - 1], 0);
+  g_free (data);
+}
+
+/**
+ * @brief Test for YUV video stream normalized to float32 BGR tensor.
+ */
+TEST (tensorConverterYuv, normalizeBgr)
+{
+  const gsize num = 160 * 120 * 3;
+  gfloat *data = (gfloat *) _convert_yuv_frame ("I420",
+      "output-size=160:120 output-format=BGR normalize=127.5:127.5", num * sizeof (gfloat));
+
+  ASSERT_NE (data, nullptr);
+  EXPECT_NEAR (data[0], (50 - 127.5) / 127.5, 0.04);
+  EXPECT_NEAR (data[1], (100 - 127.5) / 127.5, 0.04);
+  EXPECT_NEAR (data[2], (200 - 127.5) / 127.5, 0.04);
+  EXPECT_NEAR (data[num - 1], (200 - 127.5) / 127.5, 0.04);
+  g_free (data);
+}
+
+/**
+ * @brief Test for YUV video stream converted to GRAY8 tensor.
+ */
+TEST (tensorConverterYuv, convertGray)
+{
+  const gsize size = 640 * 480;
+  guint8 *data = (guint8 *) _convert_yuv_frame ("YUY2", "output-format=GRAY8", size);
+
+  ASSERT_NE (data, nullptr);
+  /* 0.299 * 200 + 0.587 * 100 + 0.114 * 50 */
+  EXPECT_NEAR (data[0], 124, 4);
+  EXPECT_NEAR (data[size - 1], 124, 4);
+  g_free (data);
+}
+
+/**
+ * @brief Test for the properties to convert YUV video stream.
+ */
+TEST (tensorConverterYuv, properties)
+{
+  GstElement *converter = gst_element_factory_make ("tensor_converter", NULL);
+  gchar *str = NULL;
+  gboolean letterbox = TRUE;
+
+  ASSERT_NE (converter, nullptr);
+
+  g_object_get (converter, "output-size", &str, NULL);
+  EXPECT_STREQ (str, "");
+  g_free (str);
+  g_object_get (converter, "output-format", &str, NULL);
+  EXPECT_STREQ (str, "RGB");
+  g_free (str);
+
+  g_object_set (converter, "output-size", "320:240", "output-format", "bgr",
+      "normalize", "127.5:127.5", NULL);
+  g_object_get (converter, "output-size", &str, NULL);
+  EXPECT_STREQ (str, "320:240");
+  g_free (str);
+  g_object_get (converter, "output-format", &str, NULL);
+  EXPECT_STREQ (str, "BGR");
+  g_free (str);
+  g_object_get (converter, "normalize", &str, NULL);
+  EXPECT_STREQ (str, "127.5,127.5,127.5:127.5,127.5,127.5");
+  g_free (str);
+  g_object_get (converter, "letterbox", &letterbox, NULL);
+  EXPECT_FALSE (letterbox);
+
+  gst_object_unref (converter);
+}
+
+/**
+ * @brief Test for the properties to convert YUV video stream with invalid value.
+ */
+TEST (tensorConverterYuv, propertiesInvalid_n)
+{
+  GstElement *converter = gst_element_factory_make ("tensor_converter", NULL);
+  gchar *str = NULL;
+
+  ASSERT_NE (converter, nullptr);
+
+  g_object_set (converter, "output-size", "320", "output-format", "YUV",
+      "normalize", "127.5:0", NULL);
+  g_object_get (converter, "output-size", &str, NULL);
+  EXPECT_STREQ (str, "");
+  g_free (str);
+  g_object_get (converter, "output-format", &str, NULL);
+  EXPECT_STREQ (str, "RGB");
+  g_free (str);
+  g_object_get (converter, "normalize", &str, NULL);
+  EXPECT_STREQ (str, "");
+  g_free (str);
+
+  g_object_set (converter, "normalize", "1,2:3", NULL);
+  g_object_get (converter, "normalize", &str, NULL);
+  EXPECT_STREQ (str, "");
+  g_free (str);
+
+  gst_object_unref (converter);
+}
+
+/**
+ * @brief Internal function to push a RGB frame (3x2) with padded rows and get the tensor.
+ */
+static guint8 *
+_convert_padded_frame (gsize offset, gint stride, gboolean add_meta, gsize exp_len)
+{
+  GstElement *pipeline, *appsrc_handle;
+  GstBuffer *buf;
+  GstMapInfo map;
+  gchar *content = NULL;
+  gsize len = 0, buf_size, h;
+  char *tmp_raw = getTempFilename ();
+  gchar *str_pipeline = g_strdup_printf (
+      "appsrc name=srcx caps=video/x-raw,format=RGB,width=3,height=2,framerate=0/1 ! "
+      "tensor_converter ! filesink location=%s buffer-mode=unbuffered sync=false async=false",
+      tmp_raw);
+
+  pipeline = gst_parse_launch (str_pipeline, NULL);
+  g_free (str_pipeline);
+  EXPECT_NE (pipeline, nullptr);
+  if (pipeline == nullptr) {
+    removeTempFile (&tmp_raw);
+    return NULL;
+  }
+
+  appsrc_handle = gst_bin_get_by_name (GST_BIN (pipeline), "srcx");
+  EXPECT_NE (appsrc_handle, nullptr);
+
+  /* each row has 9 bytes of data (1, 2, ..., 9 and 11, 12, ..., 19), fill padding with 0xff. */
+  buf_size = offset + stride * 2;
+  buf = gst_buffer_new_allocate (NULL, buf_size, NULL);
+  EXPECT_TRUE (gst_buffer_map (buf, &map, GST_MAP_WRITE));
+  memset (map.data, 0xff, buf_size);
+  for (h = 0; h < 9; h++) {
+    map.data[offset + h] = (guint8) (h + 1);
+    map.data[offset + stride + h] = (guint8) (h + 11);
+  }
+  gst_buffer_unmap (buf, &map);
+
+  if (add_meta) {
+    gsize offsets[GST_VIDEO_MAX_PLANES] = { offset };
+    gint strides[GST_VIDEO_MAX_PLANES] = { stride };
+
+    gst_buffer_add_video_meta_full (buf, GST_VIDEO_FRAME_FLAG_NONE,
+        GST_VIDEO_FORMAT_RGB, 3, 2, 1, offsets, strides);
+  }
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PLAYING, TEST_TIMEOUT_MS), 0);
+  EXPECT_EQ (gst_app_src_push_buffer (GST_APP_SRC (appsrc_handle), buf), GST_FLOW_OK);
+  EXPECT_EQ (gst_app_src_end_of_stream (GST_APP_SRC (appsrc_handle)), GST_FLOW_OK);
+  _wait_pipeline_save_files (tmp_raw, content, len, exp_len, TEST_TIMEOUT_MS);
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_NULL, TEST_TIMEOUT_MS), 0);
+
+  gst_object_unref (appsrc_handle);
+  gst_object_unref (pipeline);
+  removeTempFile (&tmp_raw);
+
+  EXPECT_EQ (len, exp_len);
+  if (len != exp_len) {
+    g_free (content);
+    content = NULL;
+  }
+
+  return (guint8 *) content;
+}
+
+/**
+ * @brief Test for video stream with padded rows, the padding is removed.
+ */
+TEST (tensorConverterVideo, removePadding)
+{
+  const guint8 expected[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 11, 12, 13, 14, 15, 16, 17, 18, 19 };
+  guint8 *data;
+
+  /* default stride of caps (RU4) */
+  data = _convert_padded_frame (0, 12, FALSE, sizeof (expected));
+  ASSERT_NE (data, nullptr);
+  EXPECT_EQ (memcmp (data, expected, sizeof (expected)), 0);
+  g_free (data);
+
+  /* offset and stride in video meta */
+  data = _convert_padded_frame (5, 32, TRUE, sizeof (expected));
+  ASSERT_NE (data, nullptr);
+  EXPECT_EQ (memcmp (data, expected, sizeof (expected)), 0);
+  g_free (data);
+
+  /* rows without padding in video meta, the memory is shared. */
+  data = _convert_padded_frame (3, 9, TRUE, sizeof (expected));
+  ASSERT_NE (data, nullptr);
+  EXPECT_EQ (memcmp (data, expected, sizeof (expected)), 0);
+  g_free (data);
+}
+
+/**
+ * @brief Internal function to push a RGB frame (3x2) with the given size and layout, and return the flow of the converter.
+ */
+static GstFlowReturn
+_convert_short_frame (gsize buf_size, gsize offset, gint stride, gboolean add_meta)
+{
+  GstHarness *h;
+  GstBuffer *buf;
+  GstFlowReturn ret;
+
+  h = gst_harness_new ("tensor_converter");
+  gst_harness_set_src_caps_str (h, "video/x-raw,format=RGB,width=3,height=2,framerate=0/1");
+
+  buf = gst_harness_create_buffer (h, buf_size);
+  gst_buffer_memset (buf, 0, 0xff, buf_size);
+
+  if (add_meta) {
+    gsize offsets[GST_VIDEO_MAX_PLANES] = { offset };
+    gint strides[GST_VIDEO_MAX_PLANES] = { stride };
+
+    gst_buffer_add_video_meta_full (buf, GST_VIDEO_FRAME_FLAG_NONE,
+        GST_VIDEO_FORMAT_RGB, 3, 2, 1, offsets, strides);
+  }
+
+  ret = gst_harness_push (h, buf);
+  EXPECT_EQ (gst_harness_buffers_received (h), 0U);
+
+  gst_harness_teardown (h);
+  return ret;
+}
+
+/**
+ * @brief Test for video stream with the frame smaller than its layout, the converter returns an error.
+ */
+TEST (tensorConverterVideo, shortFrame_n)
+{
+  /* default stride of caps (RU4), 2 rows need 12 + 9 bytes */
+  EXPECT_EQ (_convert_short_frame (20, 0, 0, FALSE), GST_FLOW_ERROR);
+
+  /* offset and stride in video meta, 2 rows need 5 + 32 + 9 bytes */
+  EXPECT_EQ (_convert_short_frame (45, 5, 32, TRUE), GST_FLOW_ERROR);
+
+  /* stride in video meta is smaller than a row (9 bytes) */
+  EXPECT_EQ (_convert_short_frame (32, 0, 8, TRUE), GST_FLOW_ERROR);
+}
+
+/**
+ * @brief Test for YUV video stream with the frame smaller than the caps, the converter fails without abort.
+ */
+TEST (tensorConverterYuv, shortFrame_n)
+{
+  GstElement *pipeline, *appsrc_handle;
+  GstBus *bus;
+  GstMessage *msg;
+  GstBuffer *buf;
+
+  pipeline = gst_parse_launch (
+      "appsrc name=srcx caps=video/x-raw,format=NV12,width=4,height=4,framerate=0/1 ! "
+      "tensor_converter ! fakesink sync=false async=false",
+      NULL);
+  ASSERT_NE (pipeline, nullptr);
+
+  appsrc_handle = gst_bin_get_by_name (GST_BIN (pipeline), "srcx");
+  EXPECT_NE (appsrc_handle, nullptr);
+
+  /* NV12 4x4 frame is 24 bytes */
+  buf = gst_buffer_new_allocate (NULL, 10, NULL);
+  gst_buffer_memset (buf, 0, 0x80, 10);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PLAYING, TEST_TIMEOUT_MS), 0);
+  EXPECT_EQ (gst_app_src_push_buffer (GST_APP_SRC (appsrc_handle), buf), GST_FLOW_OK);
+
+  bus = gst_element_get_bus (pipeline);
+  msg = gst_bus_timed_pop_filtered (
+      bus, TEST_TIMEOUT_MS * GST_MSECOND, GST_MESSAGE_ERROR);
+  EXPECT_NE (msg, nullptr);
+  if (msg)
+    gst_message_unref (msg);
+  gst_object_unref (bus);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_NULL, TEST_TIMEOUT_MS), 0);
+  gst_object_unref (appsrc_handle);
+  gst_object_unref (pipeline);
+}
+
 /**
  * @brief Main GTest
  */
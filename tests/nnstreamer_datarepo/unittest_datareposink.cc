@@ -367,6 +367,63 @@ TEST (datareposink, writeFlexibleTensors)
   g_remove ("flexible.json");
 }
 
+/**
+ * @brief Test for writing flexible tensors with the sample offsets in the binary index
+ */
+TEST (datareposink, writeFlexibleTensorsBinaryIndex)
+{
+  GFile *file = NULL;
+  gchar *contents = NULL;
+  gsize length = 0;
+  GstBus *bus;
+  GMainLoop *loop;
+  gboolean ret;
+  const gchar *str_pipeline
+      = "videotestsrc num-buffers=3 ! videoconvert ! videoscale ! "
+        "video/x-raw,format=RGB,width=176,height=144,framerate=10/1 ! tensor_converter ! join0.sink_0 "
+        "videotestsrc num-buffers=3 ! videoconvert ! videoscale ! "
+        "video/x-raw,format=RGB,width=320,height=240,framerate=10/1 ! tensor_converter ! join0.sink_1 "
+        "join name=join0 ! other/tensors,format=flexible ! "
+        "datareposink location=flexible.data json=flexible.json binary-index=true";
+
+  GstElement *pipeline = gst_parse_launch (str_pipeline, NULL);
+  ASSERT_NE (pipeline, nullptr);
+
+  loop = g_main_loop_new (NULL, FALSE);
+  bus = gst_pipeline_get_bus (GST_PIPELINE (pipeline));
+  ASSERT_NE (bus, nullptr);
+  gst_bus_add_watch (bus, bus_callback, loop);
+  gst_object_unref (bus);
+
+  setPipelineStateSync (pipeline, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT);
+  g_main_loop_run (loop);
+
+  setPipelineStateSync (pipeline, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT);
+  gst_object_unref (pipeline);
+  g_main_loop_unref (loop);
+
+  /* Confirm the sample offsets are not in JSON */
+  file = g_file_new_for_path ("flexible.json");
+  ret = g_file_load_contents (file, NULL, &contents, NULL, NULL, NULL);
+  g_object_unref (file);
+  ASSERT_EQ (ret, TRUE);
+  EXPECT_TRUE (g_strstr_len (contents, -1, "sample_offset") == NULL);
+  g_free (contents);
+
+  /* Confirm the binary index, header (24 bytes), 3 samples (16 bytes each) and 9 tensor sizes (8 bytes each) */
+  file = g_file_new_for_path ("flexible.data.idx");
+  ret = g_file_load_contents (file, NULL, &contents, &length, NULL, NULL);
+  g_object_unref (file);
+  ASSERT_EQ (ret, TRUE);
+  EXPECT_EQ (length, 24U + 3 * 16U + 9 * 8U);
+  EXPECT_TRUE (g_str_has_prefix (contents, "NDRI"));
+  g_free (contents);
+
+  g_remove ("flexible.data");
+  g_remove ("flexible.data.idx");
+  g_remove ("flexible.json");
+}
+
 
 /**
  * @brief Test for writing sparse tensors
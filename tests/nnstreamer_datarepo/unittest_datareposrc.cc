@@ -106,7 +106,7 @@ create_sparse_tensors_test_file ()
  * @brief create flexible tensors file
  */
 static void
-create_flexible_tensors_test_file (gint fps)
+create_flexible_tensors_test_file (gint fps, gboolean binary_index)
 {
   GstBus *bus;
   GMainLoop *loop;
@@ -119,8 +119,8 @@ create_flexible_tensors_test_file (gint fps)
       "videotestsrc num-buffers=10 ! videoconvert ! videoscale ! "
       "video/x-raw,format=RGB,width=640,height=480,framerate=%d/1 ! tensor_converter ! join0.sink_2 "
       "join name=join0 ! other/tensors,format=flexible ! "
-      "datareposink location=flexible.data json=flexible.json",
-      rate_n, rate_n, rate_n);
+      "datareposink location=flexible.data json=flexible.json binary-index=%s",
+      rate_n, rate_n, rate_n, binary_index ? "true" : "false");
 
   GstElement *pipeline = gst_parse_launch (str_pipeline, NULL);
   g_free (str_pipeline);
@@ -583,6 +583,68 @@ TEST (datareposrc, readTensors)
   g_free (json_path);
 }
 
+/**
+ * @brief Test for reading a tensors file with mmap and prefetch
+ * the number of total sample(mnist.data) is 10 (0~9), 20 buffers for 2 epochs.
+ */
+TEST (datareposrc, readTensorsMmapPrefetch)
+{
+  GstBus *bus;
+  GMainLoop *loop;
+  gchar *file_path = NULL;
+  gchar *json_path = NULL;
+  GstElement *datareposrc = NULL;
+  GstElement *tensor_sink;
+  gint buffer_count = 0;
+  gboolean get_bool;
+  guint get_value;
+
+  loop = g_main_loop_new (NULL, FALSE);
+
+  file_path = get_file_path (filename);
+  json_path = get_file_path (json);
+
+  gchar *str_pipeline = g_strdup_printf ("datareposrc name=datareposrc location=%s json=%s "
+                                         "start-sample-index=0 stop-sample-index=9 epochs=2 "
+                                         "use-mmap=true prefetch=4 ! tensor_sink name=tensor_sink0",
+      file_path, json_path);
+  GstElement *pipeline = gst_parse_launch (str_pipeline, NULL);
+  g_free (str_pipeline);
+  ASSERT_NE (pipeline, nullptr);
+
+  datareposrc = gst_bin_get_by_name (GST_BIN (pipeline), "datareposrc");
+  EXPECT_NE (datareposrc, nullptr);
+
+  tensor_sink = gst_bin_get_by_name (GST_BIN (pipeline), "tensor_sink0");
+  ASSERT_NE (tensor_sink, nullptr);
+  g_signal_connect (tensor_sink, "new-data", G_CALLBACK (new_data_cb), &buffer_count);
+
+  bus = gst_pipeline_get_bus (GST_PIPELINE (pipeline));
+  ASSERT_NE (bus, nullptr);
+  gst_bus_add_watch (bus, bus_callback, loop);
+  gst_object_unref (bus);
+
+  g_object_get (datareposrc, "use-mmap", &get_bool, NULL);
+  EXPECT_TRUE (get_bool);
+
+  g_object_get (datareposrc, "prefetch", &get_value, NULL);
+  EXPECT_EQ (get_value, 4U);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  g_main_loop_run (loop);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  EXPECT_EQ (buffer_count, 20);
+
+  gst_object_unref (tensor_sink);
+  gst_object_unref (datareposrc);
+  gst_object_unref (pipeline);
+  g_main_loop_unref (loop);
+  g_free (file_path);
+  g_free (json_path);
+}
+
 /**
  * @brief Test for reading a file composed of flexible tensors
  * the default shuffle is TRUE.
@@ -599,7 +661,7 @@ TEST (datareposrc, readFlexibleTensors)
                  "t. ! queue ! datareposink location=result.data json=result.json "
                  "t. ! queue ! tensor_sink";
 
-  create_flexible_tensors_test_file (fps);
+  create_flexible_tensors_test_file (fps, FALSE);
   GstElement *pipeline = gst_parse_launch (str_pipeline, NULL);
   ASSERT_NE (pipeline, nullptr);
 
@@ -643,10 +705,66 @@ error:
   g_free (data_2);
   g_remove ("flexible.json");
   g_remove ("flexible.data");
+  g_remove ("flexible.data.idx");
   g_remove ("result.json");
   g_remove ("result.data");
+  g_remove ("result.data.idx");
 }
 
+/**
+ * @brief Test for reading flexible tensors with the sample offsets in the binary index
+ */
+TEST (datareposrc, readFlexibleTensorsBinaryIndex)
+{
+  gchar *data = NULL;
+  gsize size_1 = 0, size_2 = 0;
+  GStatBuf st;
+  GstBus *bus;
+  GMainLoop *loop;
+  const gchar *str_pipeline
+      = "datareposrc location=flexible.data json=flexible.json ! "
+        "datareposink location=result.data json=result.json";
+
+  create_flexible_tensors_test_file (10, TRUE);
+  ASSERT_TRUE (g_file_test ("flexible.data.idx", G_FILE_TEST_EXISTS));
+
+  GstElement *pipeline = gst_parse_launch (str_pipeline, NULL);
+  ASSERT_NE (pipeline, nullptr);
+
+  loop = g_main_loop_new (NULL, FALSE);
+  bus = gst_pipeline_get_bus (GST_PIPELINE (pipeline));
+  ASSERT_NE (bus, nullptr);
+  gst_bus_add_watch (bus, bus_callback, loop);
+  gst_object_unref (bus);
+
+  setPipelineStateSync (pipeline, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT);
+  g_main_loop_run (loop);
+
+  setPipelineStateSync (pipeline, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT);
+  gst_object_unref (pipeline);
+  g_main_loop_unref (loop);
+
+  /* all samples are read, and written again with the offsets in JSON */
+  if (g_stat ("flexible.data", &st) == 0)
+    size_1 = st.st_size;
+  if (g_stat ("result.data", &st) == 0)
+    size_2 = st.st_size;
+  EXPECT_GT (size_1, 0U);
+  EXPECT_EQ (size_1, size_2);
+
+  EXPECT_TRUE (g_file_get_contents ("result.json", &data, NULL, NULL));
+  if (data) {
+    EXPECT_TRUE (g_strstr_len (data, -1, "\"total_samples\" : 10") != NULL);
+    EXPECT_TRUE (g_strstr_len (data, -1, "sample_offset") != NULL);
+  }
+  g_free (data);
+
+  g_remove ("flexible.json");
+  g_remove ("flexible.data");
+  g_remove ("flexible.data.idx");
+  g_remove ("result.json");
+  g_remove ("result.data");
+}
 
 /**
  * @brief Framerate Test for reading a file composed of flexible tensors
@@ -663,7 +781,7 @@ TEST (datareposrc, fps30ReadFlexibleTensors)
   GMainLoop *loop;
   str_pipeline = "datareposrc location=flexible.data json=flexible.json ! queue ! tensor_sink name=tensor_sink0 sync=true";
 
-  create_flexible_tensors_test_file (fps);
+  create_flexible_tensors_test_file (fps, FALSE);
   GstElement *pipeline = gst_parse_launch (str_pipeline, NULL);
   ASSERT_NE (pipeline, nullptr);
 
@@ -742,6 +860,7 @@ TEST (datareposrc, fps30ReadFlexibleTensors)
 
   g_remove ("flexible.json");
   g_remove ("flexible.data");
+  g_remove ("flexible.data.idx");
 }
 
 /**
@@ -804,6 +923,7 @@ error:
   g_free (sample_data);
   g_remove ("sparse.json");
   g_remove ("sparse.data");
+  g_remove ("sparse.data.idx");
   g_remove ("sample.data");
 }
 
@@ -1151,7 +1271,7 @@ TEST (datareposrc, readInvalidFlexibleTensors_n)
       = "datareposrc location=audio1.raw json=flexible.json ! tensor_sink name=tensor_sink0";
   GstElement *tensor_sink;
 
-  create_flexible_tensors_test_file (fps);
+  create_flexible_tensors_test_file (fps, FALSE);
   create_audio_test_file ();
 
   GstElement *pipeline = gst_parse_launch (str_pipeline, NULL);
@@ -1186,6 +1306,7 @@ TEST (datareposrc, readInvalidFlexibleTensors_n)
   g_remove ("audio1.raw");
   g_remove ("flexible.json");
   g_remove ("flexible.data");
+  g_remove ("flexible.data.idx");
 }
 
 /**
@@ -1237,6 +1358,7 @@ TEST (datareposrc, readInvalidSparseTensors_n)
   g_remove ("audio1.raw");
   g_remove ("sparse.json");
   g_remove ("sparse.data");
+  g_remove ("sparse.data.idx");
 }
 
 /**
@@ -0,0 +1,277 @@
+/**
+ * @file	unittest_decoder_nms.cc
+ * @date	16 Oct 2026
+ * @brief	Unit test and microbenchmark for NMS of the tensor decoder subplugins
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @bug		No known bugs.
+ */
+#include <gtest/gtest.h>
+#include <glib.h>
+#include <string.h>
+#include <vector>
+#include <algorithm>
+#include <tensordecnms.h>
+
+/**
+ * @brief Box for the reference NMS, same as the decoders used before.
+ */
+typedef struct {
+  int valid;
+  int index;
+  int group;
+  int x;
+  int y;
+  int width;
+  int height;
+  float score;
+} ref_box;
+
+/**
+ * @brief IoU of the reference NMS.
+ */
+static float
+ref_iou (const ref_box *a, const ref_box *b)
+{
+  int x1 = MAX (a->x, b->x);
+  int y1 = MAX (a->y, b->y);
+  int x2 = MIN (a->x + a->width, b->x + b->width);
+  int y2 = MIN (a->y + a->height, b->y + b->height);
+  int w = MAX (0, (x2 - x1 + 1));
+  int h = MAX (0, (y2 - y1 + 1));
+  float inter = w * h;
+  float areaA = a->width * a->height;
+  float areaB = b->width * b->height;
+  float o = inter / (areaA + areaB - inter);
+  return (o >= 0) ? o : 0;
+}
+
+/**
+ * @brief O(n^2) reference NMS. Returns the indices of the kept boxes.
+ */
+static std::vector<guint>
+ref_nms (std::vector<ref_box> boxes, float threshold)
+{
+  std::vector<guint> keep;
+  size_t i, j;
+
+  std::stable_sort (boxes.begin (), boxes.end (),
+      [] (const ref_box &a, const ref_box &b) { return a.score > b.score; });
+
+  for (i = 0; i < boxes.size (); i++) {
+    if (!boxes[i].valid)
+      continue;
+
+    keep.push_back (boxes[i].index);
+    for (j = i + 1; j < boxes.size (); j++) {
+      if (boxes[j].valid && boxes[i].group == boxes[j].group
+          && ref_iou (&boxes[i], &boxes[j]) > threshold)
+        boxes[j].valid = FALSE;
+    }
+  }
+
+  return keep;
+}
+
+/**
+ * @brief Generate random boxes in 640x480 image.
+ */
+static std::vector<ref_box>
+gen_boxes (guint num, guint num_groups, guint32 seed)
+{
+  std::vector<ref_box> boxes (num);
+  GRand *rand = g_rand_new_with_seed (seed);
+  guint i;
+
+  for (i = 0; i < num; i++) {
+    boxes[i].valid = TRUE;
+    boxes[i].index = i;
+    boxes[i].group = g_rand_int_range (rand, 0, num_groups);
+    boxes[i].x = g_rand_int_range (rand, 0, 640);
+    boxes[i].y = g_rand_int_range (rand, 0, 480);
+    boxes[i].width = g_rand_int_range (rand, 0, 120);
+    boxes[i].height = g_rand_int_range (rand, 0, 120);
+    /* a few boxes with the same score */
+    boxes[i].score = g_rand_int_range (rand, 0, 1000) / 1000.f;
+  }
+
+  g_rand_free (rand);
+  return boxes;
+}
+
+/**
+ * @brief Run the shared NMS with the boxes.
+ */
+static std::vector<guint>
+run_nms (const std::vector<ref_box> &boxes, float threshold)
+{
+  nms_boxes_t nms;
+  std::vector<guint> keep (MAX (boxes.size (), 1U));
+  guint num_kept;
+
+  nms_boxes_init (&nms, 4U);
+  for (const ref_box &b : boxes)
+    nms_boxes_add (&nms, b.x, b.y, b.width, b.height, b.score, b.group);
+
+  num_kept = nms_boxes_run (&nms, threshold, keep.data ());
+
+  nms_boxes_free (&nms);
+  keep.resize (num_kept);
+  return keep;
+}
+
+/**
+ * @brief Test for class-agnostic NMS.
+ */
+TEST (decoderNms, classAgnostic)
+{
+  const float thresholds[] = { 0.0f, 0.05f, 0.45f, 0.7f, 1.0f };
+  const guint counts[] = { 1U, 10U, 100U, 1000U };
+
+  for (guint num : counts) {
+    std::vector<ref_box> boxes = gen_boxes (num, 1U, num);
+
+    for (float th : thresholds) {
+      EXPECT_EQ (run_nms (boxes, th), ref_nms (boxes, th));
+    }
+  }
+}
+
+/**
+ * @brief Test for class-aware NMS.
+ */
+TEST (decoderNms, classAware)
+{
+  std::vector<ref_box> boxes = gen_boxes (1000U, 80U, 7U);
+
+  EXPECT_EQ (run_nms (boxes, 0.45f), ref_nms (boxes, 0.45f));
+  EXPECT_EQ (run_nms (boxes, 0.0f), ref_nms (boxes, 0.0f));
+}
+
+/**
+ * @brief Test for batched NMS, the group is the combination of the batch and the class.
+ */
+TEST (decoderNms, batched)
+{
+  const guint num_classes = 5U;
+  std::vector<ref_box> boxes;
+  guint b, i;
+
+  for (b = 0; b < 4U; b++) {
+    std::vector<ref_box> batch = gen_boxes (300U, num_classes, b);
+
+    for (i = 0; i < batch.size (); i++) {
+      batch[i].index = b * 300U + i;
+      batch[i].group = b * num_classes + batch[i].group;
+    }
+    boxes.insert (boxes.end (), batch.begin (), batch.end ());
+  }
+
+  EXPECT_EQ (run_nms (boxes, 0.5f), ref_nms (boxes, 0.5f));
+}
+
+/**
+ * @brief Test for the boxes with the same location and the boxes with negative size.
+ */
+TEST (decoderNms, degenerateBoxes)
+{
+  std::vector<ref_box> boxes = gen_boxes (200U, 1U, 3U);
+  guint i;
+
+  for (i = 0; i < boxes.size (); i += 3) {
+    boxes[i].x = boxes[i].y = 10;
+    boxes[i].width = boxes[i].height = (i % 2) ? -5 : 0;
+  }
+
+  EXPECT_EQ (run_nms (boxes, 0.3f), ref_nms (boxes, 0.3f));
+  EXPECT_EQ (run_nms (boxes, 0.0f), ref_nms (boxes, 0.0f));
+}
+
+/**
+ * @brief Test for negative threshold, the box with the highest score in each group is kept.
+ */
+TEST (decoderNms, negativeThreshold)
+{
+  std::vector<ref_box> boxes = gen_boxes (500U, 3U, 11U);
+  std::vector<guint> keep = run_nms (boxes, -1.0f);
+
+  EXPECT_EQ (keep.size (), 3U);
+  EXPECT_EQ (keep, ref_nms (boxes, -1.0f));
+}
+
+/**
+ * @brief Test for NMS without boxes.
+ */
+TEST (decoderNms, empty)
+{
+  std::vector<ref_box> boxes;
+
+  EXPECT_EQ (run_nms (boxes, 0.5f).size (), 0U);
+}
+
+/**
+ * @brief Test for NMS with invalid param.
+ */
+TEST (decoderNms, invalidParam_n)
+{
+  nms_boxes_t nms;
+  guint keep[2];
+
+  nms_boxes_init (&nms, 2U);
+  nms_boxes_add (&nms, 0, 0, 10, 10, 0.5f, 0);
+
+  EXPECT_EQ (nms_boxes_run (NULL, 0.5f, keep), 0U);
+  EXPECT_EQ (nms_boxes_run (&nms, 0.5f, NULL), 0U);
+
+  nms_boxes_free (&nms);
+}
+
+/**
+ * @brief Microbenchmark across box counts, compared with the O(n^2) NMS.
+ * @note Disabled by default, the timing does not gate the test. Run with --gtest_also_run_disabled_tests.
+ */
+TEST (decoderNms, DISABLED_benchmark)
+{
+  const guint counts[] = { 100U, 1000U, 8400U };
+  const float threshold = 0.45f;
+
+  for (guint num : counts) {
+    std::vector<ref_box> boxes = gen_boxes (num, 1U, 1U);
+    std::vector<guint> keep, ref;
+    gint64 elapsed, ref_elapsed, start;
+
+    start = g_get_monotonic_time ();
+    ref = ref_nms (boxes, threshold);
+    ref_elapsed = g_get_monotonic_time () - start;
+
+    start = g_get_monotonic_time ();
+    keep = run_nms (boxes, threshold);
+    elapsed = g_get_monotonic_time () - start;
+
+    EXPECT_EQ (keep, ref);
+    g_print ("NMS %u boxes (kept %zu): %" G_GINT64_FORMAT " usec, O(n^2) %"
+        G_GINT64_FORMAT " usec\n", num, ref.size (), elapsed, ref_elapsed);
+  }
+}
+
+/**
+ * @brief Main GTest
+ */
+int
+main (int argc, char **argv)
+{
+  int ret = -1;
+
+  try {
+    testing::InitGoogleTest (&argc, argv);
+  } catch (...) {
+    g_warning ("catch 'testing::internal::<unnamed>::ClassUniqueToAlwaysTrue'");
+  }
+
+  try {
+    ret = RUN_ALL_TESTS ();
+  } catch (...) {
+    g_warning ("catch `testing::internal::GoogleTestFailureException`");
+  }
+
+  return ret;
+}
@@ -12,6 +12,7 @@
 #include <glib.h>
 #include <gst/app/gstappsrc.h>
 #include <gst/gst.h>
+#include "nnstreamer_edge_data.h"
 #include "nnstreamer_log.h"
 #include "unittest_util.h"
 
@@ -357,6 +358,59 @@ TEST (edgeSinkSrc, runNormalAitt)
   g_free (sink_pipeline);
 }
 #endif
+/**
+ * @brief Callback to release the payload of the edge data.
+ */
+static void
+_edge_data_payload_free (void *data)
+{
+  data_received++;
+  g_free (data);
+}
+
+/**
+ * @brief Test the received edge data is wrapped in a buffer without copying.
+ */
+TEST (edgeData, toBufferNoCopy)
+{
+  nns_edge_data_h data_h;
+  GstBuffer *buffer;
+  GstMemory *mem;
+  GstMapInfo map;
+  guint8 *payload[2];
+  guint i;
+
+  data_received = 0;
+  ASSERT_EQ (NNS_EDGE_ERROR_NONE, nns_edge_data_create (&data_h));
+
+  for (i = 0; i < 2; i++) {
+    payload[i] = (guint8 *) g_malloc0 (16 * (i + 1));
+    ASSERT_EQ (NNS_EDGE_ERROR_NONE,
+        nns_edge_data_add (data_h, payload[i], 16 * (i + 1), _edge_data_payload_free));
+  }
+
+  buffer = gst_edge_data_to_buffer (data_h);
+  ASSERT_TRUE (buffer != NULL);
+  EXPECT_EQ (gst_buffer_n_memory (buffer), 2U);
+
+  /* each memory wraps the payload of the edge data */
+  for (i = 0; i < 2; i++) {
+    mem = gst_buffer_peek_memory (buffer, i);
+    ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READ));
+    EXPECT_EQ (map.data, payload[i]);
+    EXPECT_EQ (map.size, 16U * (i + 1));
+    gst_memory_unmap (mem, &map);
+  }
+
+  /* the edge data is released with the last memory */
+  mem = gst_buffer_get_memory (buffer, 0);
+  gst_buffer_unref (buffer);
+  EXPECT_EQ (data_received, 0);
+
+  gst_memory_unref (mem);
+  EXPECT_EQ (data_received, 2);
+}
+
 /**
  * @brief Main GTest
  */
@@ -10,10 +10,15 @@
 #include <gtest/gtest.h>
 #include <glib.h>
 #include <glib/gstdio.h>
+#include <unistd.h>
 #include <gst/gst.h>
+#include <gst/app/gstappsink.h>
+#include <gst/app/gstappsrc.h>
 #include <tensor_common.h>
+#include <tensor_filter_custom_easy.h>
 #include <unittest_util.h>
 #include "../gst/nnstreamer/tensor_query/tensor_query_common.h"
+#include "../gst/nnstreamer/tensor_query/tensor_query_serversrc.h"
 
 /**
  * @brief Test for tensor_query_server get and set properties
@@ -92,6 +97,13 @@ TEST (tensorQuery, serverProperties0)
   g_object_get (srv_handle, "id", &uint_val, NULL);
   EXPECT_EQ (12345U, uint_val);
 
+  g_object_get (srv_handle, "client-queue-limit", &uint_val, NULL);
+  EXPECT_EQ (0U, uint_val);
+
+  g_object_set (srv_handle, "client-queue-limit", 4U, NULL);
+  g_object_get (srv_handle, "client-queue-limit", &uint_val, NULL);
+  EXPECT_EQ (4U, uint_val);
+
   gst_object_unref (srv_handle);
 
   /* Get properties of query server sink */
@@ -187,6 +199,12 @@ TEST (tensorQuery, clientProperties0)
   g_object_get (client_handle, "silent", &bool_val, NULL);
   EXPECT_EQ (TRUE, bool_val);
 
+  g_object_get (client_handle, "max-outstanding", &uint_val, NULL);
+  EXPECT_EQ (1U, uint_val);
+
+  g_object_get (client_handle, "drop-stale", &bool_val, NULL);
+  EXPECT_EQ (FALSE, bool_val);
+
   /* Set properties of query client */
   g_object_set (client_handle, "host", "127.0.0.2", NULL);
   g_object_get (client_handle, "host", &str_val, NULL);
@@ -205,6 +223,18 @@ TEST (tensorQuery, clientProperties0)
   g_object_get (client_handle, "silent", &bool_val, NULL);
   EXPECT_EQ (FALSE, bool_val);
 
+  g_object_set (client_handle, "max-outstanding", 4U, NULL);
+  g_object_get (client_handle, "max-outstanding", &uint_val, NULL);
+  EXPECT_EQ (4U, uint_val);
+
+  g_object_set (client_handle, "drop-stale", TRUE, NULL);
+  g_object_get (client_handle, "drop-stale", &bool_val, NULL);
+  EXPECT_EQ (TRUE, bool_val);
+
+  gst_util_set_object_arg (G_OBJECT (client_handle), "connect-type", "SHM");
+  g_object_get (client_handle, "connect-type", &connect_type, NULL);
+  EXPECT_EQ ((gint) connect_type, 0x100);
+
   gst_object_unref (client_handle);
   gst_object_unref (gstpipe);
   g_free (pipeline);
@@ -239,6 +269,910 @@ TEST (tensorQuery, serverRun)
   g_free (pipeline);
 }
 
+/**
+ * @brief Data to check the requests served by tensor_query_serversrc.
+ */
+typedef struct {
+  GMutex lock; /**< lock for the served values */
+  GArray *served; /**< values of the requests, in the order of the buffers reaching serversink */
+  gboolean blocked; /**< TRUE if the src pad of serversrc is blocked */
+} QueryServeData;
+
+/**
+ * @brief Create the edge data of a request (single uint32 tensor) from the given client.
+ */
+static nns_edge_data_h
+_query_request_new (query_client_id_t client_id, guint value)
+{
+  nns_edge_data_h data_h;
+  guint *data;
+  gchar *val;
+
+  if (NNS_EDGE_ERROR_NONE != nns_edge_data_create (&data_h))
+    return NULL;
+
+  data = g_new0 (guint, 1);
+  *data = value;
+  nns_edge_data_add (data_h, data, sizeof (guint), g_free);
+
+  val = g_strdup_printf ("%lld", (long long) client_id);
+  nns_edge_data_set_info (data_h, "client_id", val);
+  g_free (val);
+
+  return data_h;
+}
+
+/**
+ * @brief Pad probe to block the src pad of serversrc, the requests are pending meanwhile.
+ */
+static GstPadProbeReturn
+_query_block_probe_cb (GstPad *pad, GstPadProbeInfo *info, gpointer user_data)
+{
+  QueryServeData *sdata = (QueryServeData *) user_data;
+
+  g_mutex_lock (&sdata->lock);
+  sdata->blocked = TRUE;
+  g_mutex_unlock (&sdata->lock);
+
+  return GST_PAD_PROBE_OK;
+}
+
+/**
+ * @brief Pad probe to get the value of the request reaching serversink.
+ */
+static GstPadProbeReturn
+_query_serve_probe_cb (GstPad *pad, GstPadProbeInfo *info, gpointer user_data)
+{
+  QueryServeData *sdata = (QueryServeData *) user_data;
+  GstBuffer *buffer = GST_PAD_PROBE_INFO_BUFFER (info);
+  GstMapInfo map;
+  guint value;
+
+  if (gst_buffer_map (buffer, &map, GST_MAP_READ)) {
+    value = *((guint *) map.data);
+    gst_buffer_unmap (buffer, &map);
+
+    g_mutex_lock (&sdata->lock);
+    g_array_append_val (sdata->served, value);
+    g_mutex_unlock (&sdata->lock);
+  }
+
+  return GST_PAD_PROBE_OK;
+}
+
+/**
+ * @brief Wait until the number of served requests reaches the given count.
+ */
+static gboolean
+_query_wait_served (QueryServeData *sdata, guint count)
+{
+  guint i, len;
+
+  for (i = 0; i < TEST_TIMEOUT_LIMIT_MS / 10; i++) {
+    g_mutex_lock (&sdata->lock);
+    len = sdata->served->len;
+    g_mutex_unlock (&sdata->lock);
+
+    if (len >= count)
+      return TRUE;
+
+    g_usleep (10000);
+  }
+
+  return FALSE;
+}
+
+/**
+ * @brief Wait until the src pad of serversrc is blocked.
+ */
+static gboolean
+_query_wait_blocked (QueryServeData *sdata)
+{
+  gboolean blocked = FALSE;
+  guint i;
+
+  for (i = 0; i < TEST_TIMEOUT_LIMIT_MS / 10 && !blocked; i++) {
+    g_mutex_lock (&sdata->lock);
+    blocked = sdata->blocked;
+    g_mutex_unlock (&sdata->lock);
+
+    if (!blocked)
+      g_usleep (10000);
+  }
+
+  return blocked;
+}
+
+/**
+ * @brief Test tensor_query_serversrc serves the clients in round-robin order and drops the oldest request over client-queue-limit.
+ */
+TEST (tensorQuery, serverRoundRobin)
+{
+  gchar *pipeline;
+  GstElement *gstpipe, *serversrc, *serversink;
+  GstPad *srcpad, *sinkpad;
+  GAsyncQueue *msg_queue;
+  QueryServeData sdata;
+  gulong block_id;
+  guint src_port;
+  const guint expected[] = { 0, 2, 10, 20, 3 };
+  guint i;
+
+  g_mutex_init (&sdata.lock);
+  sdata.served = g_array_new (FALSE, TRUE, sizeof (guint));
+  sdata.blocked = FALSE;
+
+  src_port = get_available_port ();
+
+  pipeline = g_strdup_printf ("tensor_query_serversrc name=serversrc id=11 port=%u client-queue-limit=2 ! "
+                              "other/tensors,num_tensors=1,dimensions=1:1:1:1,types=uint32,format=static,framerate=0/1 ! "
+                              "tensor_query_serversink name=serversink id=11 sync=false async=false",
+      src_port);
+  gstpipe = gst_parse_launch (pipeline, NULL);
+  ASSERT_NE (gstpipe, nullptr);
+
+  serversrc = gst_bin_get_by_name (GST_BIN (gstpipe), "serversrc");
+  serversink = gst_bin_get_by_name (GST_BIN (gstpipe), "serversink");
+  ASSERT_NE (serversrc, nullptr);
+  ASSERT_NE (serversink, nullptr);
+  msg_queue = GST_TENSOR_QUERY_SERVERSRC_CAST (serversrc)->msg_queue;
+
+  srcpad = gst_element_get_static_pad (serversrc, "src");
+  block_id = gst_pad_add_probe (srcpad,
+      (GstPadProbeType) (GST_PAD_PROBE_TYPE_BLOCK | GST_PAD_PROBE_TYPE_BUFFER),
+      _query_block_probe_cb, &sdata, NULL);
+  sinkpad = gst_element_get_static_pad (serversink, "sink");
+  gst_pad_add_probe (sinkpad, GST_PAD_PROBE_TYPE_BUFFER, _query_serve_probe_cb, &sdata, NULL);
+
+  EXPECT_EQ (setPipelineStateSync (gstpipe, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  /* the first request is blocked at the src pad, the others are pending */
+  g_async_queue_push (msg_queue, _query_request_new (1, 0));
+  EXPECT_TRUE (_query_wait_blocked (&sdata));
+
+  g_async_queue_push (msg_queue, _query_request_new (1, 1));
+  g_async_queue_push (msg_queue, _query_request_new (1, 2));
+  g_async_queue_push (msg_queue, _query_request_new (1, 3));
+  g_async_queue_push (msg_queue, _query_request_new (2, 10));
+  g_async_queue_push (msg_queue, _query_request_new (3, 20));
+
+  gst_pad_remove_probe (srcpad, block_id);
+
+  /* client 1 keeps the latest 2 requests, then the clients take turns */
+  EXPECT_TRUE (_query_wait_served (&sdata, 5U));
+  g_usleep (100000);
+
+  g_mutex_lock (&sdata.lock);
+  EXPECT_EQ (sdata.served->len, 5U);
+  for (i = 0; i < MIN (sdata.served->len, 5U); i++)
+    EXPECT_EQ (g_array_index (sdata.served, guint, i), expected[i]);
+  g_mutex_unlock (&sdata.lock);
+
+  EXPECT_EQ (setPipelineStateSync (gstpipe, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  gst_object_unref (srcpad);
+  gst_object_unref (sinkpad);
+  gst_object_unref (serversrc);
+  gst_object_unref (serversink);
+  gst_object_unref (gstpipe);
+  g_free (pipeline);
+  g_array_free (sdata.served, TRUE);
+  g_mutex_clear (&sdata.lock);
+}
+
+/**
+ * @brief In-Code Test Function for custom-easy filter (passthrough)
+ */
+static int
+_custom_easy_filter_passthrough (void *data, const GstTensorFilterProperties *prop,
+    const GstTensorMemory *input, GstTensorMemory *output)
+{
+  memcpy (output[0].data, input[0].data, input[0].size);
+  return 0;
+}
+
+/**
+ * @brief Test a lone request is served by the batched tensor_filter of the query server after batch-timeout.
+ */
+TEST (tensorQuery, serverBatchTimeout)
+{
+  gchar *pipeline;
+  GstElement *gstpipe, *serversrc, *serversink;
+  GstPad *sinkpad;
+  QueryServeData sdata;
+  GstTensorsInfo info;
+  guint src_port;
+  int ret;
+
+  gst_tensors_info_init (&info);
+  info.num_tensors = 1U;
+  info.info[0].type = _NNS_UINT32;
+  gst_tensor_parse_dimension ("1:1:1:1", info.info[0].dimension);
+
+  ret = NNS_custom_easy_batch_register (
+      "query_batch_filter", _custom_easy_filter_passthrough, NULL, &info, &info, 4);
+  ASSERT_EQ (ret, 0);
+
+  g_mutex_init (&sdata.lock);
+  sdata.served = g_array_new (FALSE, TRUE, sizeof (guint));
+  sdata.blocked = FALSE;
+
+  src_port = get_available_port ();
+
+  pipeline = g_strdup_printf ("tensor_query_serversrc name=serversrc id=12 port=%u ! "
+                              "other/tensors,num_tensors=1,dimensions=1:1:1:1,types=uint32,format=static,framerate=0/1 ! "
+                              "tensor_filter framework=custom-easy model=query_batch_filter batch-size=4 batch-timeout=50 ! "
+                              "tensor_query_serversink name=serversink id=12 sync=false async=false",
+      src_port);
+  gstpipe = gst_parse_launch (pipeline, NULL);
+  ASSERT_NE (gstpipe, nullptr);
+
+  serversrc = gst_bin_get_by_name (GST_BIN (gstpipe), "serversrc");
+  serversink = gst_bin_get_by_name (GST_BIN (gstpipe), "serversink");
+  ASSERT_NE (serversrc, nullptr);
+  ASSERT_NE (serversink, nullptr);
+
+  sinkpad = gst_element_get_static_pad (serversink, "sink");
+  gst_pad_add_probe (sinkpad, GST_PAD_PROBE_TYPE_BUFFER, _query_serve_probe_cb, &sdata, NULL);
+
+  EXPECT_EQ (setPipelineStateSync (gstpipe, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  /* a single request, fewer than batch-size, is not held until the next one */
+  g_async_queue_push (GST_TENSOR_QUERY_SERVERSRC_CAST (serversrc)->msg_queue,
+      _query_request_new (1, 7));
+  EXPECT_TRUE (_query_wait_served (&sdata, 1U));
+
+  g_mutex_lock (&sdata.lock);
+  if (sdata.served->len > 0)
+    EXPECT_EQ (g_array_index (sdata.served, guint, 0), 7U);
+  g_mutex_unlock (&sdata.lock);
+
+  EXPECT_EQ (setPipelineStateSync (gstpipe, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  gst_object_unref (sinkpad);
+  gst_object_unref (serversrc);
+  gst_object_unref (serversink);
+  gst_object_unref (gstpipe);
+  g_free (pipeline);
+  g_array_free (sdata.served, TRUE);
+  g_mutex_clear (&sdata.lock);
+
+  ret = NNS_custom_easy_unregister ("query_batch_filter");
+  ASSERT_EQ (0, ret);
+}
+
+/**
+ * @brief Caps of the requests and replies in the query client tests.
+ */
+#define QUERY_TEST_CAPS "other/tensors,num_tensors=1,dimensions=1:1:1:1,types=uint32,format=static,framerate=0/1"
+
+/**
+ * @brief Max number of the requests in the query client tests.
+ */
+#define QUERY_TEST_MAX_REQUESTS 16U
+
+/**
+ * @brief Query server controlled by the test, to send the replies to tensor_query_client in any order.
+ */
+typedef struct {
+  GstElement *server; /**< server pipeline */
+  GstElement *client; /**< client pipeline */
+  GstElement *srv_sink; /**< appsink to receive the requests */
+  GstElement *srv_src; /**< appsrc to send the replies */
+  GstElement *cli_src; /**< appsrc of the client input */
+  GstElement *cli_sink; /**< appsink of the client output */
+  GstBuffer *requests[QUERY_TEST_MAX_REQUESTS]; /**< requests received by the server, indexed by the value */
+} QueryReplyTest;
+
+/**
+ * @brief Create a buffer of single uint32 tensor.
+ */
+static GstBuffer *
+_query_buffer_new (guint value)
+{
+  GstBuffer *buffer;
+
+  buffer = gst_buffer_new_allocate (NULL, sizeof (guint), NULL);
+  gst_buffer_fill (buffer, 0, &value, sizeof (guint));
+
+  return buffer;
+}
+
+/**
+ * @brief Get the value of single uint32 tensor.
+ */
+static guint
+_query_buffer_get_value (GstBuffer *buffer)
+{
+  guint value = G_MAXUINT;
+
+  gst_buffer_extract (buffer, 0, &value, sizeof (guint));
+  return value;
+}
+
+/**
+ * @brief Wait until both the src and sink caps of the query server are set.
+ */
+static gboolean
+_query_wait_server_caps (guint id)
+{
+  edge_server_handle server_h;
+  gchar *id_str, *caps_str;
+  gboolean configured = FALSE;
+  guint i;
+
+  id_str = g_strdup_printf ("%u", id);
+  server_h = gst_tensor_query_server_get_handle (id_str);
+  g_free (id_str);
+
+  if (!server_h)
+    return FALSE;
+
+  for (i = 0; i < TEST_TIMEOUT_LIMIT_MS / 10 && !configured; i++) {
+    caps_str = NULL;
+    nns_edge_get_info (gst_tensor_query_server_get_edge_handle (server_h), "CAPS", &caps_str);
+
+    configured = (caps_str && strstr (caps_str, "@query_server_src_caps@")
+                  && strstr (caps_str, "@query_server_sink_caps@"));
+    g_free (caps_str);
+
+    if (!configured)
+      g_usleep (10000);
+  }
+
+  return configured;
+}
+
+/**
+ * @brief Start the query server and the client with given caps and properties.
+ */
+static gboolean
+_query_reply_test_start (QueryReplyTest *test, guint id, const gchar *caps_str,
+    const gchar *server_props, const gchar *client_props)
+{
+  gchar *pipeline;
+  GstCaps *caps;
+  guint src_port;
+
+  memset (test, 0, sizeof (QueryReplyTest));
+  src_port = get_available_port ();
+
+  /* the requests are given to the test, and the replies are sent from the test */
+  pipeline = g_strdup_printf ("tensor_query_serversrc id=%u port=%u %s ! %s ! "
+                              "appsink name=srv_sink sync=false "
+                              "appsrc name=srv_src ! tensor_query_serversink id=%u limit=10 %s sync=false async=false",
+      id, src_port, server_props, caps_str, id, server_props);
+  test->server = gst_parse_launch (pipeline, NULL);
+  g_free (pipeline);
+
+  if (!test->server)
+    return FALSE;
+
+  test->srv_sink = gst_bin_get_by_name (GST_BIN (test->server), "srv_sink");
+  test->srv_src = gst_bin_get_by_name (GST_BIN (test->server), "srv_src");
+
+  caps = gst_caps_from_string (caps_str);
+  gst_app_src_set_caps (GST_APP_SRC (test->srv_src), caps);
+
+  if (setPipelineStateSync (test->server, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT) != 0) {
+    gst_caps_unref (caps);
+    return FALSE;
+  }
+
+  /* dummy buffer without query meta to configure the caps of serversink */
+  gst_app_src_push_buffer (GST_APP_SRC (test->srv_src), _query_buffer_new (G_MAXUINT));
+
+  if (!_query_wait_server_caps (id)) {
+    gst_caps_unref (caps);
+    return FALSE;
+  }
+
+  pipeline = g_strdup_printf ("appsrc name=cli_src ! tensor_query_client name=client dest-port=%u port=0 %s ! "
+                              "appsink name=cli_sink sync=false",
+      src_port, client_props);
+  test->client = gst_parse_launch (pipeline, NULL);
+  g_free (pipeline);
+
+  if (!test->client) {
+    gst_caps_unref (caps);
+    return FALSE;
+  }
+
+  test->cli_src = gst_bin_get_by_name (GST_BIN (test->client), "cli_src");
+  test->cli_sink = gst_bin_get_by_name (GST_BIN (test->client), "cli_sink");
+  gst_app_src_set_caps (GST_APP_SRC (test->cli_src), caps);
+  gst_caps_unref (caps);
+
+  return (setPipelineStateSync (test->client, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT) == 0);
+}
+
+/**
+ * @brief Stop the query server and the client.
+ */
+static void
+_query_reply_test_stop (QueryReplyTest *test)
+{
+  guint i;
+
+  if (test->client) {
+    EXPECT_EQ (setPipelineStateSync (test->client, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+    gst_object_unref (test->cli_src);
+    gst_object_unref (test->cli_sink);
+    gst_object_unref (test->client);
+  }
+
+  if (test->server) {
+    EXPECT_EQ (setPipelineStateSync (test->server, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+    gst_object_unref (test->srv_src);
+    gst_object_unref (test->srv_sink);
+    gst_object_unref (test->server);
+  }
+
+  for (i = 0; i < QUERY_TEST_MAX_REQUESTS; i++) {
+    if (test->requests[i])
+      gst_buffer_unref (test->requests[i]);
+  }
+}
+
+/**
+ * @brief Receive the given number of requests at the server.
+ */
+static gboolean
+_query_reply_test_receive (QueryReplyTest *test, guint count)
+{
+  GstSample *sample;
+  GstBuffer *buffer;
+  guint i, value;
+
+  for (i = 0; i < count; i++) {
+    sample = gst_app_sink_try_pull_sample (
+        GST_APP_SINK (test->srv_sink), TEST_TIMEOUT_LIMIT_MS * GST_MSECOND);
+    if (!sample)
+      return FALSE;
+
+    buffer = gst_sample_get_buffer (sample);
+    value = _query_buffer_get_value (buffer);
+    if (value < QUERY_TEST_MAX_REQUESTS && !test->requests[value])
+      test->requests[value] = gst_buffer_ref (buffer);
+    gst_sample_unref (sample);
+
+    if (value >= QUERY_TEST_MAX_REQUESTS)
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Send the reply of the request with given value.
+ */
+static void
+_query_reply_test_reply (QueryReplyTest *test, guint value)
+{
+  ASSERT_LT (value, QUERY_TEST_MAX_REQUESTS);
+  ASSERT_NE (test->requests[value], nullptr);
+
+  /* the reply is the request itself, with the query meta */
+  gst_app_src_push_buffer (GST_APP_SRC (test->srv_src), test->requests[value]);
+  test->requests[value] = NULL;
+}
+
+/**
+ * @brief Pull the output of the client in given time, returns G_MAXUINT if there is no output.
+ */
+static guint
+_query_reply_test_pull (QueryReplyTest *test, guint timeout_ms)
+{
+  GstSample *sample;
+  guint value = G_MAXUINT;
+
+  sample = gst_app_sink_try_pull_sample (GST_APP_SINK (test->cli_sink), timeout_ms * GST_MSECOND);
+  if (sample) {
+    value = _query_buffer_get_value (gst_sample_get_buffer (sample));
+    gst_sample_unref (sample);
+  }
+
+  return value;
+}
+
+/**
+ * @brief Test tensor_query_client pushes the replies in the order of the requests.
+ */
+TEST (tensorQuery, clientReplyOrder)
+{
+  QueryReplyTest test;
+  guint i;
+
+  ASSERT_TRUE (_query_reply_test_start (&test, 21, QUERY_TEST_CAPS, "",
+      "max-outstanding=4 timeout=10000"));
+
+  for (i = 0; i < 4; i++)
+    gst_app_src_push_buffer (GST_APP_SRC (test.cli_src), _query_buffer_new (i));
+  EXPECT_TRUE (_query_reply_test_receive (&test, 4U));
+
+  _query_reply_test_reply (&test, 3);
+  _query_reply_test_reply (&test, 1);
+  _query_reply_test_reply (&test, 2);
+
+  /* the replies are held until the reply of the oldest request */
+  EXPECT_EQ (_query_reply_test_pull (&test, 200), G_MAXUINT);
+
+  _query_reply_test_reply (&test, 0);
+  for (i = 0; i < 4; i++)
+    EXPECT_EQ (_query_reply_test_pull (&test, TEST_TIMEOUT_LIMIT_MS), i);
+
+  _query_reply_test_stop (&test);
+}
+
+/**
+ * @brief Test tensor_query_client drops the request without reply after the timeout, without next input.
+ */
+TEST (tensorQuery, clientReplyTimeout)
+{
+  QueryReplyTest test;
+  guint i;
+
+  ASSERT_TRUE (_query_reply_test_start (&test, 22, QUERY_TEST_CAPS, "",
+      "max-outstanding=4 timeout=300"));
+
+  for (i = 0; i < 3; i++)
+    gst_app_src_push_buffer (GST_APP_SRC (test.cli_src), _query_buffer_new (i));
+  EXPECT_TRUE (_query_reply_test_receive (&test, 3U));
+
+  _query_reply_test_reply (&test, 0);
+  _query_reply_test_reply (&test, 2);
+
+  EXPECT_EQ (_query_reply_test_pull (&test, TEST_TIMEOUT_LIMIT_MS), 0U);
+  EXPECT_EQ (_query_reply_test_pull (&test, TEST_TIMEOUT_LIMIT_MS), 2U);
+
+  /* the late reply of the dropped request is ignored */
+  _query_reply_test_reply (&test, 1);
+  EXPECT_EQ (_query_reply_test_pull (&test, 300), G_MAXUINT);
+
+  _query_reply_test_stop (&test);
+}
+
+/**
+ * @brief Test tensor_query_client with drop-stale pushes the newer reply without waiting for the older ones.
+ */
+TEST (tensorQuery, clientReplyDropStale)
+{
+  QueryReplyTest test;
+  gint64 start, elapsed;
+  guint i;
+
+  ASSERT_TRUE (_query_reply_test_start (&test, 23, QUERY_TEST_CAPS, "",
+      "max-outstanding=4 timeout=10000 drop-stale=true"));
+
+  for (i = 0; i < 3; i++)
+    gst_app_src_push_buffer (GST_APP_SRC (test.cli_src), _query_buffer_new (i));
+  EXPECT_TRUE (_query_reply_test_receive (&test, 3U));
+
+  start = g_get_monotonic_time ();
+  _query_reply_test_reply (&test, 2);
+  EXPECT_EQ (_query_reply_test_pull (&test, TEST_TIMEOUT_LIMIT_MS), 2U);
+  elapsed = g_get_monotonic_time () - start;
+
+  /* not held until the timeout of the older requests */
+  EXPECT_LT (elapsed, 5 * G_TIME_SPAN_SECOND);
+
+  _query_reply_test_reply (&test, 0);
+  EXPECT_EQ (_query_reply_test_pull (&test, 300), G_MAXUINT);
+
+  _query_reply_test_stop (&test);
+}
+
+/**
+ * @brief Test flush wakes up tensor_query_client waiting for a free slot of the requests.
+ */
+TEST (tensorQuery, clientReplyFlush)
+{
+  QueryReplyTest test;
+  GstElement *client;
+  GstPad *sinkpad;
+  gint64 start, elapsed;
+  guint i;
+
+  ASSERT_TRUE (_query_reply_test_start (&test, 24, QUERY_TEST_CAPS, "",
+      "max-outstanding=2 timeout=10000"));
+
+  client = gst_bin_get_by_name (GST_BIN (test.client), "client");
+  ASSERT_NE (client, nullptr);
+  sinkpad = gst_element_get_static_pad (client, "sink");
+
+  /* the third input waits for the replies of the previous requests */
+  for (i = 0; i < 3; i++)
+    gst_app_src_push_buffer (GST_APP_SRC (test.cli_src), _query_buffer_new (i));
+  EXPECT_TRUE (_query_reply_test_receive (&test, 2U));
+  g_usleep (100000);
+
+  /* flush-stop takes the stream lock, it returns after the chain function is done */
+  start = g_get_monotonic_time ();
+  EXPECT_TRUE (gst_pad_send_event (sinkpad, gst_event_new_flush_start ()));
+  EXPECT_TRUE (gst_pad_send_event (sinkpad, gst_event_new_flush_stop (TRUE)));
+  elapsed = g_get_monotonic_time () - start;
+
+  EXPECT_LT (elapsed, 5 * G_TIME_SPAN_SECOND);
+
+  gst_object_unref (sinkpad);
+  gst_object_unref (client);
+  _query_reply_test_stop (&test);
+}
+
+/**
+ * @brief Count the shared-memory segments of the query elements in this process.
+ */
+static guint
+_query_count_shm_segments (void)
+{
+  GDir *dir;
+  const gchar *name;
+  gchar *prefix;
+  guint count = 0;
+
+  dir = g_dir_open ("/dev/shm", 0, NULL);
+  if (!dir)
+    return 0;
+
+  prefix = g_strdup_printf ("nnsquery-%d-", (gint) getpid ());
+  while ((name = g_dir_read_name (dir)) != NULL) {
+    if (g_str_has_prefix (name, prefix))
+      count++;
+  }
+
+  g_free (prefix);
+  g_dir_close (dir);
+  return count;
+}
+
+/**
+ * @brief Wait until the number of the shared-memory segments reaches the given count.
+ */
+static gboolean
+_query_wait_shm_segments (guint count)
+{
+  guint i;
+
+  for (i = 0; i < TEST_TIMEOUT_LIMIT_MS / 10; i++) {
+    if (_query_count_shm_segments () == count)
+      return TRUE;
+
+    g_usleep (10000);
+  }
+
+  return FALSE;
+}
+
+/**
+ * @brief Test the same-host query with connect-type SHM passes the tensor data in shared memory.
+ */
+TEST (tensorQuery, clientShm)
+{
+  QueryReplyTest test;
+  guint i;
+
+  ASSERT_TRUE (_query_reply_test_start (&test, 25, QUERY_TEST_CAPS,
+      "connect-type=SHM", "connect-type=SHM max-outstanding=4 timeout=10000"));
+
+  for (i = 0; i < 4; i++) {
+    gst_app_src_push_buffer (GST_APP_SRC (test.cli_src), _query_buffer_new (i));
+    EXPECT_TRUE (_query_reply_test_receive (&test, 1U));
+    _query_reply_test_reply (&test, i);
+    EXPECT_EQ (_query_reply_test_pull (&test, TEST_TIMEOUT_LIMIT_MS), i);
+  }
+
+  /* the first request is sent via TCP, then both the client and the server use shared memory */
+  EXPECT_EQ (_query_count_shm_segments (), 2U);
+
+  _query_reply_test_stop (&test);
+  EXPECT_EQ (_query_count_shm_segments (), 0U);
+}
+
+/**
+ * @brief Create a buffer with the value and the pattern of given size.
+ */
+static GstBuffer *
+_query_payload_new (guint value, gsize size)
+{
+  GstBuffer *buffer;
+  GstMapInfo map;
+  gsize i;
+
+  buffer = gst_buffer_new_allocate (NULL, size, NULL);
+  gst_buffer_map (buffer, &map, GST_MAP_WRITE);
+  for (i = sizeof (guint); i < size; i++)
+    map.data[i] = (guint8) (value + i);
+  memcpy (map.data, &value, sizeof (guint));
+  gst_buffer_unmap (buffer, &map);
+
+  return buffer;
+}
+
+/**
+ * @brief Check the buffer has the value and the pattern of given size.
+ */
+static gboolean
+_query_payload_is_valid (GstBuffer *buffer, guint value, gsize size)
+{
+  GstMapInfo map;
+  gboolean valid;
+  gsize i;
+
+  if (!buffer || gst_buffer_get_size (buffer) != size)
+    return FALSE;
+
+  if (!gst_buffer_map (buffer, &map, GST_MAP_READ))
+    return FALSE;
+
+  valid = (memcmp (map.data, &value, sizeof (guint)) == 0);
+  for (i = sizeof (guint); i < size && valid; i++)
+    valid = (map.data[i] == (guint8) (value + i));
+
+  gst_buffer_unmap (buffer, &map);
+  return valid;
+}
+
+/**
+ * @brief Pull the output of the client and check the payload.
+ */
+static gboolean
+_query_reply_test_pull_payload (QueryReplyTest *test, guint value, gsize size)
+{
+  GstSample *sample;
+  gboolean valid;
+
+  sample = gst_app_sink_try_pull_sample (
+      GST_APP_SINK (test->cli_sink), TEST_TIMEOUT_LIMIT_MS * GST_MSECOND);
+  if (!sample)
+    return FALSE;
+
+  valid = _query_payload_is_valid (gst_sample_get_buffer (sample), value, size);
+  gst_sample_unref (sample);
+
+  return valid;
+}
+
+/**
+ * @brief Test the old segment is kept until its slots are returned, when the payload grows with connect-type SHM.
+ */
+TEST (tensorQuery, clientShmGrow)
+{
+  QueryReplyTest test;
+  const gsize small = 4096, medium = 65536, large = 1048576;
+
+  /* any stream is passed, the payload size changes */
+  ASSERT_TRUE (_query_reply_test_start (&test, 26, "application/octet-stream",
+      "connect-type=SHM", "connect-type=SHM max-outstanding=8 timeout=10000"));
+
+  /* the first request is sent via TCP, the reply tells the server is on the same host */
+  gst_app_src_push_buffer (GST_APP_SRC (test.cli_src), _query_payload_new (0, small));
+  EXPECT_TRUE (_query_reply_test_receive (&test, 1U));
+  EXPECT_TRUE (_query_payload_is_valid (test.requests[0], 0, small));
+  _query_reply_test_reply (&test, 0);
+  EXPECT_TRUE (_query_reply_test_pull_payload (&test, 0, small));
+
+  /**
+   * The server holds two requests (one in the appsink and one blocked), so
+   * the next requests are read after the client grows the slots twice.
+   */
+  g_object_set (test.srv_sink, "max-buffers", 1U, NULL);
+  gst_app_src_push_buffer (GST_APP_SRC (test.cli_src), _query_payload_new (4, small));
+  gst_app_src_push_buffer (GST_APP_SRC (test.cli_src), _query_payload_new (5, small));
+  gst_app_src_push_buffer (GST_APP_SRC (test.cli_src), _query_payload_new (1, medium));
+  gst_app_src_push_buffer (GST_APP_SRC (test.cli_src), _query_payload_new (2, large));
+
+  /* three generations of the client and one of the server */
+  EXPECT_TRUE (_query_wait_shm_segments (4U));
+
+  EXPECT_TRUE (_query_reply_test_receive (&test, 4U));
+  EXPECT_TRUE (_query_payload_is_valid (test.requests[4], 4, small));
+  EXPECT_TRUE (_query_payload_is_valid (test.requests[5], 5, small));
+  EXPECT_TRUE (_query_payload_is_valid (test.requests[1], 1, medium));
+  EXPECT_TRUE (_query_payload_is_valid (test.requests[2], 2, large));
+
+  _query_reply_test_reply (&test, 4);
+  _query_reply_test_reply (&test, 5);
+  _query_reply_test_reply (&test, 1);
+  _query_reply_test_reply (&test, 2);
+
+  EXPECT_TRUE (_query_reply_test_pull_payload (&test, 4, small));
+  EXPECT_TRUE (_query_reply_test_pull_payload (&test, 5, small));
+  EXPECT_TRUE (_query_reply_test_pull_payload (&test, 1, medium));
+  EXPECT_TRUE (_query_reply_test_pull_payload (&test, 2, large));
+
+  /* all slots are returned, the old segments are unlinked with the next data */
+  gst_app_src_push_buffer (GST_APP_SRC (test.cli_src), _query_payload_new (3, medium));
+  EXPECT_TRUE (_query_reply_test_receive (&test, 1U));
+  EXPECT_TRUE (_query_payload_is_valid (test.requests[3], 3, medium));
+  _query_reply_test_reply (&test, 3);
+  EXPECT_TRUE (_query_reply_test_pull_payload (&test, 3, medium));
+
+  EXPECT_TRUE (_query_wait_shm_segments (2U));
+
+  _query_reply_test_stop (&test);
+}
+
+/**
+ * @brief Check whether the memory of the buffer is in the shared memory of the query elements.
+ */
+static gboolean
+_query_buffer_in_shm (GstBuffer *buffer)
+{
+  gchar *maps = NULL;
+  gchar **lines;
+  GstMapInfo map;
+  guint64 addr;
+  gboolean found = FALSE;
+  guint i;
+
+  if (!gst_buffer_map (buffer, &map, GST_MAP_READ))
+    return FALSE;
+
+  addr = (guint64) (guintptr) map.data;
+  gst_buffer_unmap (buffer, &map);
+
+  if (!g_file_get_contents ("/proc/self/maps", &maps, NULL, NULL))
+    return FALSE;
+
+  lines = g_strsplit (maps, "\n", -1);
+  for (i = 0; lines[i] && !found; i++) {
+    unsigned long long start, end;
+
+    if (strstr (lines[i], "/dev/shm/nnsquery-")
+        && sscanf (lines[i], "%llx-%llx", &start, &end) == 2)
+      found = (addr >= start && addr < end);
+  }
+
+  g_strfreev (lines);
+  g_free (maps);
+  return found;
+}
+
+/**
+ * @brief Test the slots of the replies dropped by tensor_query_client are returned to the server.
+ */
+TEST (tensorQuery, clientShmDropReplies)
+{
+  QueryReplyTest test;
+  GstSample *sample;
+  GstBuffer *buffer;
+  guint i;
+
+  ASSERT_TRUE (_query_reply_test_start (&test, 27, QUERY_TEST_CAPS,
+      "connect-type=SHM", "connect-type=SHM max-outstanding=4 timeout=200"));
+
+  /* the first request is sent via TCP, the reply tells the server is on the same host */
+  gst_app_src_push_buffer (GST_APP_SRC (test.cli_src), _query_buffer_new (0));
+  EXPECT_TRUE (_query_reply_test_receive (&test, 1U));
+  _query_reply_test_reply (&test, 0);
+  EXPECT_EQ (_query_reply_test_pull (&test, TEST_TIMEOUT_LIMIT_MS), 0U);
+
+  /* the replies after the timeout are dropped, more than the slots of the server */
+  for (i = 1; i <= 10; i++) {
+    gst_app_src_push_buffer (GST_APP_SRC (test.cli_src), _query_buffer_new (i));
+    EXPECT_TRUE (_query_reply_test_receive (&test, 1U));
+    g_usleep (400000);
+    _query_reply_test_reply (&test, i);
+  }
+
+  EXPECT_EQ (_query_reply_test_pull (&test, 300), G_MAXUINT);
+
+  /* the reply is still passed in shared memory */
+  gst_app_src_push_buffer (GST_APP_SRC (test.cli_src), _query_buffer_new (11));
+  EXPECT_TRUE (_query_reply_test_receive (&test, 1U));
+  _query_reply_test_reply (&test, 11);
+
+  sample = gst_app_sink_try_pull_sample (
+      GST_APP_SINK (test.cli_sink), TEST_TIMEOUT_LIMIT_MS * GST_MSECOND);
+  ASSERT_TRUE (sample != NULL);
+  buffer = gst_sample_get_buffer (sample);
+  EXPECT_EQ (_query_buffer_get_value (buffer), 11U);
+  EXPECT_TRUE (_query_buffer_in_shm (buffer));
+  gst_sample_unref (sample);
+
+  _query_reply_test_stop (&test);
+}
+
 /**
  * @brief Run tensor query client without server
  */
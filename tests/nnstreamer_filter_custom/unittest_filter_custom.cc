@@ -9,6 +9,7 @@
 
 #include <gtest/gtest.h>
 #include <glib/gstdio.h>
+#include <gst/check/gstharness.h>
 #include <gst/gst.h>
 #include <nnstreamer_plugin_api.h>
 #include <nnstreamer_plugin_api_util.h>
@@ -381,6 +382,388 @@ TEST (tensorFilterCustom, dynamicRegisterInvalidParam_n)
   EXPECT_NE (0, ret);
 }
 
+/**
+ * @brief In-Code Test Function for custom-easy filter (add 1 to each element)
+ */
+static int
+_custom_easy_filter_add (void *data, const GstTensorFilterProperties *prop,
+    const GstTensorMemory *input, GstTensorMemory *output)
+{
+  guint i;
+
+  for (i = 0; i < input[0].size / sizeof (guint); i++)
+    ((guint *) output[0].data)[i] = ((guint *) input[0].data)[i] + 1;
+
+  return 0;
+}
+
+/**
+ * @brief Register custom-easy filter (add 1 to each element) with single uint32 tensor (4:1:1:1).
+ */
+static int
+_custom_easy_add_register (const gchar *name)
+{
+  GstTensorsInfo info;
+
+  gst_tensors_info_init (&info);
+  info.num_tensors = 1U;
+  info.info[0].type = _NNS_UINT32;
+  gst_tensor_parse_dimension ("4:1:1:1", info.info[0].dimension);
+
+  return NNS_custom_easy_register (name, _custom_easy_filter_add, NULL, &info, &info);
+}
+
+/**
+ * @brief In-Code Test Function for custom-easy filter (add 1 to each element of the batched frames and count the invokes)
+ */
+static int
+_custom_easy_filter_add_batch (void *data, const GstTensorFilterProperties *prop,
+    const GstTensorMemory *input, GstTensorMemory *output)
+{
+  guint *invoked = (guint *) data;
+
+  if (input[0].size != prop->batch_size * 4 * sizeof (guint))
+    return -1;
+
+  (*invoked)++;
+  return _custom_easy_filter_add (NULL, prop, input, output);
+}
+
+/**
+ * @brief Register custom-easy filter (add 1 to each element) for batched invoke with single uint32 tensor (4:1:1:1).
+ */
+static int
+_custom_easy_add_batch_register (const gchar *name, guint *invoked, int max_batch_size)
+{
+  GstTensorsInfo info;
+
+  gst_tensors_info_init (&info);
+  info.num_tensors = 1U;
+  info.info[0].type = _NNS_UINT32;
+  gst_tensor_parse_dimension ("4:1:1:1", info.info[0].dimension);
+
+  return NNS_custom_easy_batch_register (
+      name, _custom_easy_filter_add_batch, invoked, &info, &info, max_batch_size);
+}
+
+/**
+ * @brief Create a harness of the tensor filter with custom-easy filter (add 1 to each element).
+ */
+static GstHarness *
+_custom_easy_add_harness_new (const gchar *launch_line)
+{
+  GstHarness *h;
+
+  h = gst_harness_new_parse (launch_line);
+  gst_harness_set_src_caps_str (h, "other/tensors,num_tensors=1,types=uint32,dimensions=4:1:1:1,format=static,framerate=(fraction)0/1");
+
+  return h;
+}
+
+/**
+ * @brief Push the b-th input buffer (b * 10 + i for each element) to the harness.
+ */
+static GstFlowReturn
+_custom_easy_add_push (GstHarness *h, guint b)
+{
+  GstBuffer *in_buf;
+  GstMapInfo map;
+  guint i;
+
+  in_buf = gst_harness_create_buffer (h, 4 * sizeof (guint));
+  GST_BUFFER_PTS (in_buf) = b * GST_SECOND;
+
+  if (!gst_buffer_map (in_buf, &map, GST_MAP_WRITE)) {
+    gst_buffer_unref (in_buf);
+    return GST_FLOW_ERROR;
+  }
+
+  for (i = 0; i < 4; i++)
+    ((guint *) map.data)[i] = b * 10 + i;
+  gst_buffer_unmap (in_buf, &map);
+
+  return gst_harness_push (h, in_buf);
+}
+
+/**
+ * @brief Pull the output buffer from the harness and check it is the result of the b-th input buffer.
+ */
+static void
+_custom_easy_add_check_output (GstHarness *h, guint b)
+{
+  GstBuffer *out_buf;
+  GstMemory *mem;
+  GstMapInfo map;
+  guint i, val;
+
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  EXPECT_EQ (GST_BUFFER_PTS (out_buf), b * GST_SECOND);
+  EXPECT_EQ (gst_buffer_n_memory (out_buf), 1U);
+
+  mem = gst_buffer_peek_memory (out_buf, 0);
+  if (gst_memory_map (mem, &map, GST_MAP_READ)) {
+    EXPECT_EQ (map.size, 4 * sizeof (guint));
+    for (i = 0; i < 4; i++) {
+      val = ((guint *) map.data)[i];
+      EXPECT_EQ (val, b * 10 + i + 1);
+    }
+    gst_memory_unmap (mem, &map);
+  } else {
+    ADD_FAILURE () << "Failed to map the output memory.";
+  }
+
+  gst_buffer_unref (out_buf);
+}
+
+/**
+ * @brief Test micro-batching of tensor filter (batch-size).
+ */
+TEST (tensorFilterCustom, batchInvoke_p)
+{
+  GstHarness *h;
+  guint b, invoked = 0;
+  int ret;
+
+  ret = _custom_easy_add_batch_register ("batch_filter", &invoked, 8);
+  ASSERT_EQ (ret, 0);
+
+  h = _custom_easy_add_harness_new ("tensor_filter framework=custom-easy model=batch_filter batch-size=3");
+
+  /* push 7 buffers, the last one remains in the pending batch */
+  for (b = 0; b < 7; b++)
+    EXPECT_EQ (_custom_easy_add_push (h, b), GST_FLOW_OK);
+
+  EXPECT_EQ (gst_harness_buffers_received (h), 6U);
+
+  /* EOS invokes the pending frame */
+  EXPECT_TRUE (gst_harness_push_event (h, gst_event_new_eos ()));
+  EXPECT_EQ (gst_harness_buffers_received (h), 7U);
+
+  /* 3 + 3 + 1 frames */
+  EXPECT_EQ (invoked, 3U);
+
+  for (b = 0; b < 7; b++)
+    _custom_easy_add_check_output (h, b);
+
+  gst_harness_teardown (h);
+
+  ret = NNS_custom_easy_unregister ("batch_filter");
+  ASSERT_EQ (0, ret);
+}
+
+/**
+ * @brief Test the batch is limited to the maximum batch size of the custom-easy function.
+ */
+TEST (tensorFilterCustom, batchInvokeMaxSize_p)
+{
+  GstHarness *h;
+  guint b, invoked = 0;
+  int ret;
+
+  ret = _custom_easy_add_batch_register ("batch_max_filter", &invoked, 2);
+  ASSERT_EQ (ret, 0);
+
+  h = _custom_easy_add_harness_new ("tensor_filter framework=custom-easy model=batch_max_filter batch-size=4");
+
+  for (b = 0; b < 4; b++)
+    EXPECT_EQ (_custom_easy_add_push (h, b), GST_FLOW_OK);
+
+  EXPECT_EQ (gst_harness_buffers_received (h), 4U);
+  EXPECT_EQ (invoked, 2U);
+
+  for (b = 0; b < 4; b++)
+    _custom_easy_add_check_output (h, b);
+
+  gst_harness_teardown (h);
+
+  ret = NNS_custom_easy_unregister ("batch_max_filter");
+  ASSERT_EQ (0, ret);
+}
+
+/**
+ * @brief Test batch-size is ignored with the custom-easy function taking a single frame.
+ */
+TEST (tensorFilterCustom, batchInvokeNotSupported_p)
+{
+  GstHarness *h;
+  guint b;
+  int ret;
+
+  ret = _custom_easy_add_register ("batch_not_supported_filter");
+  ASSERT_EQ (ret, 0);
+
+  h = _custom_easy_add_harness_new ("tensor_filter framework=custom-easy model=batch_not_supported_filter batch-size=3");
+
+  /* each buffer is invoked one by one */
+  for (b = 0; b < 2; b++) {
+    EXPECT_EQ (_custom_easy_add_push (h, b), GST_FLOW_OK);
+    EXPECT_EQ (gst_harness_buffers_received (h), b + 1);
+  }
+
+  for (b = 0; b < 2; b++)
+    _custom_easy_add_check_output (h, b);
+
+  gst_harness_teardown (h);
+
+  ret = NNS_custom_easy_unregister ("batch_not_supported_filter");
+  ASSERT_EQ (0, ret);
+}
+
+/**
+ * @brief Test registering the custom-easy function for batched invoke with invalid maximum batch size.
+ */
+TEST (tensorFilterCustom, batchRegisterInvalidSize_n)
+{
+  guint invoked = 0;
+
+  EXPECT_NE (0, _custom_easy_add_batch_register ("batch_invalid_filter", &invoked, 0));
+  EXPECT_NE (0, _custom_easy_add_batch_register ("batch_invalid_filter", &invoked, -1));
+}
+
+/**
+ * @brief Test the partial batch is invoked when batch-timeout expires.
+ */
+TEST (tensorFilterCustom, batchTimeout_p)
+{
+  GstHarness *h;
+  guint b, invoked = 0;
+  int ret;
+
+  ret = _custom_easy_add_batch_register ("batch_timeout_filter", &invoked, 4);
+  ASSERT_EQ (ret, 0);
+
+  h = _custom_easy_add_harness_new ("tensor_filter framework=custom-easy model=batch_timeout_filter batch-size=4 batch-timeout=50");
+
+  /* push 2 buffers, fewer than batch-size, and no more buffers arrive */
+  for (b = 0; b < 2; b++)
+    EXPECT_EQ (_custom_easy_add_push (h, b), GST_FLOW_OK);
+
+  /* the batch timer invokes the pending frames without EOS */
+  for (b = 0; b < 2; b++)
+    _custom_easy_add_check_output (h, b);
+
+  EXPECT_EQ (gst_harness_buffers_received (h), 2U);
+  EXPECT_EQ (invoked, 1U);
+
+  gst_harness_teardown (h);
+
+  ret = NNS_custom_easy_unregister ("batch_timeout_filter");
+  ASSERT_EQ (0, ret);
+}
+
+/**
+ * @brief Test micro-batching properties of tensor filter.
+ */
+TEST (tensorFilterCustom, batchProperties_p)
+{
+  GstElement *filter;
+  guint size, timeout;
+
+  filter = gst_element_factory_make ("tensor_filter", NULL);
+  ASSERT_TRUE (filter != NULL);
+
+  g_object_get (filter, "batch-size", &size, "batch-timeout", &timeout, NULL);
+  EXPECT_EQ (size, 1U);
+  EXPECT_EQ (timeout, 0U);
+
+  g_object_set (filter, "batch-size", 8U, "batch-timeout", 30U, NULL);
+  g_object_get (filter, "batch-size", &size, "batch-timeout", &timeout, NULL);
+  EXPECT_EQ (size, 8U);
+  EXPECT_EQ (timeout, 30U);
+
+  gst_object_unref (filter);
+}
+
+/**
+ * @brief Test asynchronous invoke of tensor filter (max-inflight).
+ */
+TEST (tensorFilterCustom, asyncInvoke_p)
+{
+  GstHarness *h;
+  guint b;
+  int ret;
+
+  ret = _custom_easy_add_register ("async_filter");
+  ASSERT_EQ (ret, 0);
+
+  h = _custom_easy_add_harness_new ("tensor_filter framework=custom-easy model=async_filter max-inflight=2");
+
+  for (b = 0; b < 10; b++)
+    EXPECT_EQ (_custom_easy_add_push (h, b), GST_FLOW_OK);
+
+  /* EOS waits for the requests in flight */
+  EXPECT_TRUE (gst_harness_push_event (h, gst_event_new_eos ()));
+  EXPECT_EQ (gst_harness_buffers_received (h), 10U);
+
+  /* the outputs are pushed in the order of the incoming buffers */
+  for (b = 0; b < 10; b++)
+    _custom_easy_add_check_output (h, b);
+
+  gst_harness_teardown (h);
+
+  ret = NNS_custom_easy_unregister ("async_filter");
+  ASSERT_EQ (0, ret);
+}
+
+/**
+ * @brief Test the default value of max-inflight (synchronous invoke).
+ */
+TEST (tensorFilterCustom, asyncProperties_p)
+{
+  GstElement *filter;
+  guint inflight;
+
+  filter = gst_element_factory_make ("tensor_filter", NULL);
+  ASSERT_TRUE (filter != NULL);
+
+  g_object_get (filter, "max-inflight", &inflight, NULL);
+  EXPECT_EQ (inflight, 0U);
+
+  g_object_set (filter, "max-inflight", 4U, NULL);
+  g_object_get (filter, "max-inflight", &inflight, NULL);
+  EXPECT_EQ (inflight, 4U);
+
+  gst_object_unref (filter);
+}
+
+/**
+ * @brief Test the output memories are recycled once downstream drops them.
+ */
+TEST (tensorFilterCustom, outputPool_p)
+{
+  GstHarness *h;
+  GstElement *filter;
+  guint64 hits, misses;
+  guint b;
+  int ret;
+
+  ret = _custom_easy_add_register ("pool_filter");
+  ASSERT_EQ (ret, 0);
+
+  h = _custom_easy_add_harness_new ("tensor_filter framework=custom-easy model=pool_filter");
+
+  for (b = 0; b < 10; b++) {
+    EXPECT_EQ (_custom_easy_add_push (h, b), GST_FLOW_OK);
+
+    /* the output memory goes back to the pool when the buffer is released */
+    _custom_easy_add_check_output (h, b);
+  }
+
+  filter = gst_harness_find_element (h, "tensor_filter");
+  ASSERT_TRUE (filter != NULL);
+  g_object_get (filter, "output-pool-hits", &hits, "output-pool-misses",
+      &misses, NULL);
+  gst_object_unref (filter);
+  EXPECT_EQ (misses, 1U);
+  EXPECT_EQ (hits, 9U);
+
+  gst_harness_teardown (h);
+
+  ret = NNS_custom_easy_unregister ("pool_filter");
+  ASSERT_EQ (0, ret);
+}
+
 /**
  * @brief Main gtest
  */
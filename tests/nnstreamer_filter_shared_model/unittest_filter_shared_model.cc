@@ -12,6 +12,7 @@
 #include <gtest/gtest.h>
 #include <glib.h>
 #include <gst/gst.h>
+#include <nnstreamer_plugin_api_filter.h>
 #include <nnstreamer_util.h>
 #include <tensor_common.h>
 #include <unittest_util.h>
@@ -53,7 +54,8 @@ _new_data_cb (GstElement *element, GstBuffer *buffer, gpointer user_data)
  * @brief helper to get base pipeline string
  */
 static void
-_get_pipeline_str (gchar **str, const gchar *model1, const gchar *model2)
+_get_pipeline_str (gchar **str, const gchar *model1, const gchar *model2,
+    const gchar *custom = NULL)
 {
   const gchar *src_root = g_getenv ("NNSTREAMER_SOURCE_ROOT_PATH");
   gchar *root_path = src_root ? g_strdup (src_root) : g_get_current_dir ();
@@ -63,19 +65,23 @@ _get_pipeline_str (gchar **str, const gchar *model1, const gchar *model2)
       = g_build_filename (root_path, "tests", "test_models", "models", model2, NULL);
   gchar *image_path
       = g_build_filename (root_path, "tests", "test_models", "data", data_name, NULL);
+  gchar *custom_opt;
 
   ASSERT_TRUE (g_file_test (model_path1, G_FILE_TEST_EXISTS));
   ASSERT_TRUE (g_file_test (model_path2, G_FILE_TEST_EXISTS));
   ASSERT_TRUE (g_file_test (image_path, G_FILE_TEST_EXISTS));
 
+  custom_opt = custom ? g_strdup_printf ("custom=%s", custom) : g_strdup ("");
+
   *str = g_strdup_printf (
       "filesrc location=%s ! pngdec ! videoscale ! imagefreeze ! videoconvert ! "
       "video/x-raw,format=RGB,framerate=10/1 ! tensor_converter ! tee name=t t. ! "
       "queue ! tensor_filter name=filter1 framework=tensorflow-lite model=%s is-updatable=TRUE "
-      "shared-tensor-filter-key=%s ! tensor_sink name=sink1 t. ! "
+      "shared-tensor-filter-key=%s %s ! tensor_sink name=sink1 t. ! "
       "queue ! tensor_filter name=filter2 framework=tensorflow-lite model=%s is-updatable=TRUE "
-      "shared-tensor-filter-key=%s ! tensor_sink name=sink2",
-      image_path, model_path1, shared_key, model_path2, shared_key);
+      "shared-tensor-filter-key=%s %s ! tensor_sink name=sink2",
+      image_path, model_path1, shared_key, custom_opt, model_path2, shared_key, custom_opt);
+  g_free (custom_opt);
   g_free (root_path);
   g_free (model_path1);
   g_free (model_path2);
@@ -206,6 +212,154 @@ TEST (nnstreamerFilterSharedModel, tfliteSharedReload)
   gst_object_unref (pipeline);
 }
 
+/**
+ * @brief Test filters sharing the pool of interpreters to reload new model
+ */
+TEST (nnstreamerFilterSharedModel, tfliteSharedPoolReload)
+{
+  gchar *pipeline_str;
+  GstElement *pipeline, *filter1, *sink1, *sink2;
+  gint idx0 = 0, idx1 = 1;
+  const gchar *src_root = g_getenv ("NNSTREAMER_SOURCE_ROOT_PATH");
+  gchar *root_path = src_root ? g_strdup (src_root) : g_get_current_dir ();
+  gchar *new_model_path = g_build_filename (
+      root_path, "tests", "test_models", "models", model_name2, NULL);
+  g_free (root_path);
+
+  _get_pipeline_str (&pipeline_str, model_name1, model_name1, "NumInterpreters:2");
+  pipeline = gst_parse_launch (pipeline_str, NULL);
+  g_free (pipeline_str);
+  memset (res, 0, sizeof (res));
+
+  filter1 = gst_bin_get_by_name (GST_BIN (pipeline), "filter1");
+  ASSERT_TRUE (filter1 != NULL);
+
+  sink1 = gst_bin_get_by_name (GST_BIN (pipeline), "sink1");
+  EXPECT_NE (sink1, nullptr);
+  g_signal_connect (sink1, "new-data", (GCallback) _new_data_cb, (gpointer) &idx0);
+  sink2 = gst_bin_get_by_name (GST_BIN (pipeline), "sink2");
+  EXPECT_NE (sink2, nullptr);
+  g_signal_connect (sink2, "new-data", (GCallback) _new_data_cb, (gpointer) &idx1);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  g_usleep (TEST_DEFAULT_SLEEP_TIME);
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PAUSED, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  g_usleep (TEST_DEFAULT_SLEEP_TIME);
+
+  /* check two filters have same output */
+  EXPECT_NE (res[0], 0U);
+  EXPECT_EQ (res[0], res[1]);
+  memset (res, 0, sizeof (res));
+
+  /* reload filter, the whole pool is replaced */
+  g_object_set (filter1, "model", new_model_path, NULL);
+  g_free (new_model_path);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  g_usleep (TEST_DEFAULT_SLEEP_TIME);
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PAUSED, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  g_usleep (TEST_DEFAULT_SLEEP_TIME);
+
+  /* same output with new model */
+  EXPECT_NE (res[0], 0U);
+  EXPECT_EQ (res[0], res[1]);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  gst_object_unref (filter1);
+  gst_object_unref (sink1);
+  gst_object_unref (sink2);
+  gst_object_unref (pipeline);
+}
+
+static gint freed_count = 0;
+
+/**
+ * @brief callback to destroy the dummy interpreter in the pool
+ */
+static void
+_free_dummy_interpreter (void *interpreter)
+{
+  UNUSED (interpreter);
+  g_atomic_int_inc (&freed_count);
+}
+
+/**
+ * @brief Test to acquire the interpreters from the pool and to replace the pool.
+ */
+TEST (nnstreamerFilterSharedModel, poolAcquireReplace_p)
+{
+  GstElement *filter;
+  gint instance = 0;
+  gint old_interp[2], new_interp[2];
+  void *old_list[2] = { &old_interp[0], &old_interp[1] };
+  void *new_list[2] = { &new_interp[0], &new_interp[1] };
+  void *pool, *handle1, *handle2, *interp1, *interp2;
+  gchar key[] = "pool_key";
+
+  /* the shared model table is initialized with the property */
+  filter = gst_element_factory_make ("tensor_filter", NULL);
+  ASSERT_TRUE (filter != NULL);
+  g_object_set (filter, "shared-tensor-filter-key", key, NULL);
+  freed_count = 0;
+
+  EXPECT_EQ (nnstreamer_filter_shared_model_insert_pool_and_get (
+                 &instance, key, old_list, 2, _free_dummy_interpreter),
+      &old_interp[0]);
+  EXPECT_EQ (nnstreamer_filter_shared_model_get (&instance, key), &old_interp[0]);
+
+  pool = nnstreamer_filter_shared_model_get_pool (key);
+  ASSERT_TRUE (pool != NULL);
+
+  /* two interpreters in use at the same time */
+  interp1 = nnstreamer_filter_shared_model_pool_acquire (pool, &handle1);
+  interp2 = nnstreamer_filter_shared_model_pool_acquire (pool, &handle2);
+  EXPECT_TRUE (interp1 == &old_interp[0] || interp1 == &old_interp[1]);
+  EXPECT_TRUE (interp2 == &old_interp[0] || interp2 == &old_interp[1]);
+  EXPECT_NE (interp1, interp2);
+  nnstreamer_filter_shared_model_pool_release (pool, handle2);
+
+  /* the interpreter in use is destroyed when it is released */
+  EXPECT_TRUE (nnstreamer_filter_shared_model_pool_replace (
+      &instance, key, new_list, 2, NULL));
+  EXPECT_EQ (freed_count, 1);
+  nnstreamer_filter_shared_model_pool_release (pool, handle1);
+  EXPECT_EQ (freed_count, 2);
+
+  interp1 = nnstreamer_filter_shared_model_pool_acquire (pool, &handle1);
+  EXPECT_TRUE (interp1 == &new_interp[0] || interp1 == &new_interp[1]);
+  nnstreamer_filter_shared_model_pool_release (pool, handle1);
+
+  EXPECT_TRUE (nnstreamer_filter_shared_model_remove (&instance, key, NULL));
+  EXPECT_EQ (freed_count, 4);
+
+  gst_object_unref (filter);
+}
+
+/**
+ * @brief Test to insert the pool with invalid parameters.
+ */
+TEST (nnstreamerFilterSharedModel, poolInvalidParam_n)
+{
+  gint instance = 0;
+  gint interp = 0;
+  void *list[1] = { &interp };
+  void *handle;
+  gchar key[] = "pool_key_invalid";
+
+  EXPECT_EQ (nnstreamer_filter_shared_model_insert_pool_and_get (
+                 NULL, key, list, 1, _free_dummy_interpreter),
+      nullptr);
+  EXPECT_EQ (nnstreamer_filter_shared_model_insert_pool_and_get (
+                 &instance, NULL, list, 1, _free_dummy_interpreter),
+      nullptr);
+  EXPECT_EQ (nnstreamer_filter_shared_model_insert_pool_and_get (
+                 &instance, key, list, 0, _free_dummy_interpreter),
+      nullptr);
+  EXPECT_EQ (nnstreamer_filter_shared_model_pool_acquire (NULL, &handle), nullptr);
+  EXPECT_FALSE (nnstreamer_filter_shared_model_pool_replace (&instance, key, list, 1, NULL));
+}
+
 /**
  * @brief Main gtest
  */
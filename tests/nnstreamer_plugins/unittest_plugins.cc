@@ -13,6 +13,7 @@
 #include <gst/check/gstharness.h>
 #include <gst/check/gsttestclock.h>
 #include <gst/gst.h>
+#include <math.h>
 #include <nnstreamer_plugin_api_converter.h>
 #include <nnstreamer_plugin_api_decoder.h>
 #include <nnstreamer_plugin_api_filter.h>
@@ -949,6 +950,454 @@ TEST (testTensorTransform, standProperties5_n)
 
   gst_harness_teardown (h);
 }
+/**
+ * @brief Internal function to push a tensor into tensor_transform and get the output.
+ */
+static gboolean
+_transform_run_single (gint mode, const gchar *option, gboolean accel,
+    tensor_type type, const gchar *dim, gconstpointer input, gpointer output,
+    gsize out_size)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorsConfig config;
+  GstMapInfo info;
+  gsize data_size;
+  gboolean ret = FALSE;
+
+  h = gst_harness_new ("tensor_transform");
+  g_object_set (h->element, "mode", mode, "option", option, NULL);
+  g_object_set (h->element, "acceleration", accel, NULL);
+
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1U;
+  config.info.info[0].type = type;
+  gst_tensor_parse_dimension (dim, config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+  data_size = gst_tensors_info_get_size (&config.info, 0);
+
+  in_buf = gst_harness_create_buffer (h, data_size);
+  gst_buffer_fill (in_buf, 0, input, data_size);
+
+  if (gst_harness_push (h, in_buf) != GST_FLOW_OK)
+    goto done;
+
+  out_buf = gst_harness_pull (h);
+  if (out_buf == NULL)
+    goto done;
+
+  if (gst_buffer_get_size (out_buf) == out_size
+      && gst_buffer_map (out_buf, &info, GST_MAP_READ)) {
+    memcpy (output, info.data, out_size);
+    gst_buffer_unmap (out_buf, &info);
+    ret = TRUE;
+  }
+
+  gst_buffer_unref (out_buf);
+
+done:
+  gst_harness_teardown (h);
+  return ret;
+}
+
+/**
+ * @brief Test for tensor_transform stand (uint8 > float32, with and without acceleration)
+ */
+TEST (testTensorTransform, standDefault)
+{
+  const guint array_size = 48;
+  uint8_t input[array_size];
+  float output[array_size];
+  gdouble average, stddev;
+  guint i, a;
+
+  average = stddev = 0.0;
+  for (i = 0; i < array_size; i++) {
+    input[i] = (i * 37) % 251;
+    average += input[i];
+  }
+  average /= array_size;
+
+  for (i = 0; i < array_size; i++)
+    stddev += (input[i] - average) * (input[i] - average);
+  stddev = sqrt (stddev / array_size);
+
+  for (a = 0; a < 2; a++) {
+    EXPECT_TRUE (_transform_run_single (GTT_STAND, "default:float32",
+        (gboolean) a, _NNS_UINT8, "3:16", input, output, sizeof (output)));
+
+    for (i = 0; i < array_size; i++)
+      EXPECT_NEAR (output[i], fabs ((input[i] - average) / stddev), 1e-5);
+  }
+}
+
+/**
+ * @brief Test for tensor_transform stand (per-channel, uint8 > float32, with and without acceleration)
+ */
+TEST (testTensorTransform, standPerChannel)
+{
+  const guint ch_size = 3;
+  const guint array_size = 48;
+  uint8_t input[array_size];
+  float output[array_size];
+  gdouble average[ch_size] = { 0.0, };
+  gdouble stddev[ch_size] = { 0.0, };
+  guint i, a, ch;
+
+  for (i = 0; i < array_size; i++) {
+    input[i] = (i * 53) % 241;
+    average[i % ch_size] += input[i];
+  }
+
+  for (ch = 0; ch < ch_size; ch++)
+    average[ch] /= (array_size / ch_size);
+
+  for (i = 0; i < array_size; i++) {
+    ch = i % ch_size;
+    stddev[ch] += (input[i] - average[ch]) * (input[i] - average[ch]);
+  }
+
+  for (ch = 0; ch < ch_size; ch++)
+    stddev[ch] = sqrt (stddev[ch] / (array_size / ch_size));
+
+  for (a = 0; a < 2; a++) {
+    EXPECT_TRUE (_transform_run_single (GTT_STAND,
+        "default:float32,per-channel:true", (gboolean) a, _NNS_UINT8, "3:16",
+        input, output, sizeof (output)));
+
+    for (i = 0; i < array_size; i++) {
+      ch = i % ch_size;
+      EXPECT_NEAR (output[i], fabs ((input[i] - average[ch]) / stddev[ch]), 1e-5);
+    }
+
+    EXPECT_TRUE (_transform_run_single (GTT_STAND,
+        "dc-average:float32,per-channel:true", (gboolean) a, _NNS_UINT8,
+        "3:16", input, output, sizeof (output)));
+
+    for (i = 0; i < array_size; i++) {
+      ch = i % ch_size;
+      EXPECT_NEAR (output[i], input[i] - average[ch], 1e-5);
+    }
+  }
+}
+
+/**
+ * @brief Test for tensor_transform clamp (float32 and int16, with and without acceleration)
+ */
+TEST (testTensorTransform, clampTypes)
+{
+  const guint array_size = 40;
+  float input_f32[array_size], output_f32[array_size];
+  int16_t input_s16[array_size], output_s16[array_size];
+  guint i, a;
+
+  for (i = 0; i < array_size; i++) {
+    input_f32[i] = ((gint) i - 20) * 1.5f;
+    input_s16[i] = ((gint) i - 20) * 100;
+  }
+
+  for (a = 0; a < 2; a++) {
+    EXPECT_TRUE (_transform_run_single (GTT_CLAMP, "-10.5:12.25", (gboolean) a,
+        _NNS_FLOAT32, "40", input_f32, output_f32, sizeof (output_f32)));
+
+    for (i = 0; i < array_size; i++)
+      EXPECT_FLOAT_EQ (output_f32[i], CLAMP (input_f32[i], -10.5f, 12.25f));
+
+    EXPECT_TRUE (_transform_run_single (GTT_CLAMP, "-250:1000", (gboolean) a,
+        _NNS_INT16, "40", input_s16, output_s16, sizeof (output_s16)));
+
+    for (i = 0; i < array_size; i++)
+      EXPECT_EQ (output_s16[i], CLAMP (input_s16[i], -250, 1000));
+  }
+}
+/**
+ * @brief Test for invalid properties of tensor_transform (duplicated index)
+ */
+TEST (testTensorTransform, transposeProperties4_n)
+{
+  GstHarness *h;
+  gchar *str = NULL;
+
+  h = gst_harness_new ("tensor_transform");
+  ASSERT_TRUE (NULL != h);
+
+  /* each index of the dimension should be given once */
+  g_object_set (h->element, "mode", GTT_TRANSPOSE, "option", "0:1:1:3", NULL);
+
+  g_object_get (h->element, "option", &str, NULL);
+  EXPECT_TRUE (str == NULL);
+
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_transform transpose (rank 5, uint16)
+ */
+TEST (testTensorTransform, transposeRank5)
+{
+  const guint in_dim[5] = { 2, 3, 4, 5, 2 };
+  const guint order[5] = { 2, 0, 3, 1, 4 };
+  const guint array_size = 2 * 3 * 4 * 5 * 2;
+  uint16_t input[array_size], output[array_size];
+  guint in_stride[5], out_dim[5], idx[5];
+  guint i, k, rem, in_idx;
+
+  in_stride[0] = 1;
+  for (k = 1; k < 5; k++)
+    in_stride[k] = in_stride[k - 1] * in_dim[k - 1];
+
+  for (k = 0; k < 5; k++)
+    out_dim[k] = in_dim[order[k]];
+
+  for (i = 0; i < array_size; i++)
+    input[i] = (uint16_t) (i * 3 + 1);
+
+  EXPECT_TRUE (_transform_run_single (GTT_TRANSPOSE, "2:0:3:1:4", FALSE,
+      _NNS_UINT16, "2:3:4:5:2", input, output, sizeof (output)));
+
+  for (i = 0; i < array_size; i++) {
+    rem = i;
+    for (k = 0; k < 5; k++) {
+      idx[k] = rem % out_dim[k];
+      rem /= out_dim[k];
+    }
+
+    in_idx = 0;
+    for (k = 0; k < 5; k++)
+      in_idx += idx[k] * in_stride[order[k]];
+
+    EXPECT_EQ (output[i], input[in_idx]);
+  }
+}
+
+/**
+ * @brief Test for tensor_transform transpose, read the rank limit and transpose the tensor of that rank.
+ */
+TEST (testTensorTransform, transposeRankLimit)
+{
+  GstElement *transform;
+  guint rank_limit = 0;
+  guint in_dim[NNS_TENSOR_RANK_LIMIT], out_dim[NNS_TENSOR_RANK_LIMIT];
+  guint order[NNS_TENSOR_RANK_LIMIT], in_stride[NNS_TENSOR_RANK_LIMIT];
+  guint idx[NNS_TENSOR_RANK_LIMIT];
+  guint i, k, rem, in_idx, array_size;
+  gchar **dim_str, **order_str;
+  gchar *dim, *option;
+  uint8_t *input, *output;
+
+  transform = gst_element_factory_make ("tensor_transform", NULL);
+  ASSERT_TRUE (transform != NULL);
+  g_object_get (transform, "transpose-rank-limit", &rank_limit, NULL);
+  gst_object_unref (transform);
+
+  EXPECT_EQ (rank_limit, (guint) NNS_TENSOR_RANK_LIMIT);
+  ASSERT_GT (rank_limit, 4U);
+
+  /* 2:3:1:2:1:...:1:2, reverse the order of the dimensions except the last one */
+  array_size = 1;
+  dim_str = g_new0 (gchar *, rank_limit + 1);
+  order_str = g_new0 (gchar *, rank_limit + 1);
+  for (k = 0; k < rank_limit; k++) {
+    if (k == 0 || k == 3 || k == rank_limit - 1)
+      in_dim[k] = 2;
+    else if (k == 1)
+      in_dim[k] = 3;
+    else
+      in_dim[k] = 1;
+
+    order[k] = (k == rank_limit - 1) ? k : rank_limit - 2 - k;
+    dim_str[k] = g_strdup_printf ("%u", in_dim[k]);
+    order_str[k] = g_strdup_printf ("%u", order[k]);
+    array_size *= in_dim[k];
+  }
+  dim = g_strjoinv (":", dim_str);
+  option = g_strjoinv (":", order_str);
+  g_strfreev (dim_str);
+  g_strfreev (order_str);
+
+  in_stride[0] = 1;
+  for (k = 1; k < rank_limit; k++)
+    in_stride[k] = in_stride[k - 1] * in_dim[k - 1];
+
+  for (k = 0; k < rank_limit; k++)
+    out_dim[k] = in_dim[order[k]];
+
+  input = (uint8_t *) g_malloc (array_size);
+  output = (uint8_t *) g_malloc0 (array_size);
+  for (i = 0; i < array_size; i++)
+    input[i] = (uint8_t) (i + 1);
+
+  EXPECT_TRUE (_transform_run_single (
+      GTT_TRANSPOSE, option, FALSE, _NNS_UINT8, dim, input, output, array_size));
+
+  for (i = 0; i < array_size; i++) {
+    rem = i;
+    for (k = 0; k < rank_limit; k++) {
+      idx[k] = rem % out_dim[k];
+      rem /= out_dim[k];
+    }
+
+    in_idx = 0;
+    for (k = 0; k < rank_limit; k++)
+      in_idx += idx[k] * in_stride[order[k]];
+
+    EXPECT_EQ (output[i], input[in_idx]);
+  }
+
+  g_free (input);
+  g_free (output);
+  g_free (dim);
+  g_free (option);
+}
+
+/**
+ * @brief Test for tensor_transform transpose (NHWC to NCHW, compare with the element-wise loop)
+ */
+TEST (testTensorTransform, transposePerformance)
+{
+  const guint ch = 3, width = 640, height = 480;
+  const gsize array_size = ch * width * height;
+  gint64 start_ts, stop_ts;
+  float *input, *output, *expected;
+  guint c, w, h;
+  gboolean ret;
+
+  input = (float *) g_malloc (sizeof (float) * array_size);
+  output = (float *) g_malloc0 (sizeof (float) * array_size);
+  expected = (float *) g_malloc0 (sizeof (float) * array_size);
+
+  for (c = 0; c < array_size; c++)
+    input[c] = (float) c;
+
+  /* 3:640:480 > 640:480:3 */
+  start_ts = g_get_real_time ();
+  ret = _transform_run_single (GTT_TRANSPOSE, "1:2:0:3", FALSE, _NNS_FLOAT32,
+      "3:640:480:1", input, output, sizeof (float) * array_size);
+  stop_ts = g_get_real_time ();
+  _print_log ("transpose element: %" G_GINT64_FORMAT, stop_ts - start_ts);
+
+  /* loop */
+  start_ts = g_get_real_time ();
+  for (h = 0; h < height; h++) {
+    for (w = 0; w < width; w++) {
+      for (c = 0; c < ch; c++) {
+        memcpy (&expected[(c * height + h) * width + w],
+            &input[(h * width + w) * ch + c], sizeof (float));
+      }
+    }
+  }
+  stop_ts = g_get_real_time ();
+  _print_log ("transpose loop: %" G_GINT64_FORMAT, stop_ts - start_ts);
+
+  EXPECT_TRUE (ret);
+  EXPECT_EQ (memcmp (output, expected, sizeof (float) * array_size), 0);
+
+  g_free (input);
+  g_free (output);
+  g_free (expected);
+}
+/**
+ * @brief Test for tensor_transform pipeline (typecast, arithmetic and transpose)
+ */
+TEST (testTensorTransform, pipeline)
+{
+  const guint ch = 3, width = 640, height = 4;
+  const guint array_size = ch * width * height;
+  uint8_t *input;
+  float *output;
+  guint c, w, h, a;
+
+  input = (uint8_t *) g_malloc (array_size);
+  output = (float *) g_malloc0 (sizeof (float) * array_size);
+
+  for (c = 0; c < array_size; c++)
+    input[c] = (uint8_t) (c * 7);
+
+  for (a = 0; a < 2; a++) {
+    EXPECT_TRUE (_transform_run_single (GTT_PIPELINE,
+        "typecast:float32|arithmetic:add:-127.5,div:127.5|clamp:-0.5:0.5|transpose:1:2:0:3",
+        (gboolean) a, _NNS_UINT8, "3:640:4:1", input, output,
+        sizeof (float) * array_size));
+
+    for (h = 0; h < height; h++) {
+      for (w = 0; w < width; w++) {
+        for (c = 0; c < ch; c++) {
+          float expected = (input[(h * width + w) * ch + c] - 127.5f) / 127.5f;
+
+          expected = CLAMP (expected, -0.5f, 0.5f);
+          EXPECT_FLOAT_EQ (output[(c * height + h) * width + w], expected);
+        }
+      }
+    }
+  }
+
+  g_free (input);
+  g_free (output);
+}
+
+/**
+ * @brief Test for tensor_transform pipeline (dimchg and per-channel stand)
+ */
+TEST (testTensorTransform, pipelineStand)
+{
+  const guint array_size = 3 * 16;
+  uint8_t input[array_size];
+  float output[array_size], expected[array_size];
+
+  for (guint i = 0; i < array_size; i++)
+    input[i] = (uint8_t) ((i * 53) % 241);
+
+  /* run the stages with separated elements */
+  EXPECT_TRUE (_transform_run_single (GTT_STAND,
+      "dc-average:float32,per-channel:true", FALSE, _NNS_UINT8, "3:16:1:1",
+      input, expected, sizeof (expected)));
+
+  EXPECT_TRUE (_transform_run_single (GTT_PIPELINE,
+      "stand:dc-average:float32,per-channel:true|dimchg:0:2", FALSE,
+      _NNS_UINT8, "3:16:1:1", input, output, sizeof (output)));
+
+  /* 3:16:1:1 > 16:1:3:1 */
+  for (guint i = 0; i < 16; i++) {
+    for (guint c = 0; c < 3; c++)
+      EXPECT_FLOAT_EQ (output[c * 16 + i], expected[i * 3 + c]);
+  }
+}
+
+/**
+ * @brief Test for invalid properties of tensor_transform pipeline
+ */
+TEST (testTensorTransform, pipelineProperties_n)
+{
+  GstHarness *h;
+  gchar *str = NULL;
+
+  h = gst_harness_new ("tensor_transform");
+  ASSERT_TRUE (NULL != h);
+
+  /* invalid mode */
+  g_object_set (h->element, "mode", GTT_PIPELINE, "option",
+      "typecast:float32|invalid:1", NULL);
+  g_object_get (h->element, "option", &str, NULL);
+  EXPECT_TRUE (str == NULL);
+
+  /* invalid option of the stage */
+  g_object_set (h->element, "option", "typecast:float32|transpose:2:3:1:0", NULL);
+  g_object_get (h->element, "option", &str, NULL);
+  EXPECT_TRUE (str == NULL);
+
+  /* nested pipeline */
+  g_object_set (h->element, "option", "pipeline:typecast:float32", NULL);
+  g_object_get (h->element, "option", &str, NULL);
+  EXPECT_TRUE (str == NULL);
+
+  gst_harness_teardown (h);
+}
+
+
+
 
 /**
  * @brief Test for tensor_transform typecast (uint8 > uint32)
@@ -2759,6 +3208,112 @@ TEST (testTensorAggregator, flushData)
   gst_harness_teardown (h);
 }
 
+/**
+ * @brief Test for tensor_aggregator (sliding window, frames-flush < frames-out)
+ */
+TEST (testTensorAggregator, slidingWindow)
+{
+  const guint frames_out = 4, num_buffers = 20;
+  GstHarness *h;
+  GstTensorsConfig config;
+  GstBuffer *outbufs[2 * num_buffers];
+  guint i, j, received;
+  gsize data_size;
+  gint data[2];
+
+  h = gst_harness_new ("tensor_aggregator");
+
+  g_object_set (h->element, "frames-in", 2, "frames-out", frames_out,
+      "frames-flush", 1, "frames-dim", 0, NULL);
+
+  /* set input tensor info and pad caps */
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1;
+  config.info.info[0].type = _NNS_INT32;
+  gst_tensor_parse_dimension ("2", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+  data_size = gst_tensors_info_get_size (&config.info, 0);
+
+  /* push 40 frames, more than the window can hold. */
+  for (i = 0; i < num_buffers; i++) {
+    data[0] = 2 * i + 1;
+    data[1] = 2 * i + 2;
+    _aggregator_test_push_buffer (h, data, data_size);
+  }
+
+  received = _harness_wait_for_output_buffer (h, 2 * num_buffers - frames_out + 1);
+  EXPECT_EQ (received, 2 * num_buffers - frames_out + 1);
+
+  /* hold all outgoing buffers, the frames should not be overwritten. */
+  for (i = 0; i < received; i++)
+    outbufs[i] = gst_harness_pull (h);
+
+  for (i = 0; i < received; i++) {
+    GstMapInfo map;
+
+    ASSERT_TRUE (gst_buffer_map (outbufs[i], &map, GST_MAP_READ));
+    ASSERT_EQ (map.size, sizeof (gint) * frames_out);
+
+    for (j = 0; j < frames_out; j++)
+      EXPECT_EQ (((gint *) map.data)[j], (gint) (i + j + 1));
+
+    gst_buffer_unmap (outbufs[i], &map);
+    gst_buffer_unref (outbufs[i]);
+  }
+
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_aggregator (sliding window with concatenation, frames-dim 2)
+ */
+TEST (testTensorAggregator, slidingWindowConcat)
+{
+  GstHarness *h;
+  GstTensorsConfig config;
+  guint i, received;
+  gsize data_in_size;
+  gint expected[96];
+
+  h = gst_harness_new ("tensor_aggregator");
+
+  g_object_set (h->element, "frames-out", 2, "frames-flush", 1, "frames-dim", 2, NULL);
+
+  /* input tensor info */
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1;
+  config.info.info[0].type = _NNS_INT32;
+  gst_tensor_parse_dimension ("3:4:2:2", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+  data_in_size = gst_tensors_info_get_size (&config.info, 0);
+
+  /* push frames 1 > 2 > 1 */
+  for (i = 0; i < 3; i++) {
+    _aggregator_test_push_buffer (h, aggr_test_frames[i % 2], data_in_size);
+  }
+
+  received = _harness_wait_for_output_buffer (h, 2U);
+  EXPECT_EQ (received, 2U);
+
+  /* out-dimension 3:4:4:2, each block (3:4:2) of the frames is concatenated. */
+  for (i = 0; i < 2; i++) {
+    memcpy (&expected[0], &aggr_test_frames[i][0], sizeof (gint) * 24);
+    memcpy (&expected[24], &aggr_test_frames[1 - i][0], sizeof (gint) * 24);
+    memcpy (&expected[48], &aggr_test_frames[i][24], sizeof (gint) * 24);
+    memcpy (&expected[72], &aggr_test_frames[1 - i][24], sizeof (gint) * 24);
+
+    _aggregator_test_check_output (h, expected, 96);
+  }
+
+  gst_harness_teardown (h);
+}
+
 /**
  * @brief Test for tensor_aggregator (supposed multi clients using tensor-meta)
  */
@@ -4089,18 +4644,78 @@ TEST (testTensorTransform, orcDiv)
 }
 
 /**
- * @brief Test for tensor_transform orc functions (convert s8 to other type)
+ * @brief Test for tensor_transform orc functions (clamp and standardization)
  */
-TEST (testTensorTransform, orcConvS8)
+TEST (testTensorTransform, orcClampStand)
 {
   const guint array_size = 10;
   guint i;
 
-  int8_t data_s8[array_size] = {
+  float data_f32[array_size] = {
     0,
   };
-
-  for (i = 0; i < array_size; i++) {
+  double data_f64[array_size] = {
+    0,
+  };
+
+  /* clamp f32 */
+  for (i = 0; i < array_size; i++) {
+    data_f32[i] = (gint) i - 5 + .5;
+  }
+
+  nns_orc_clamp_f32 (data_f32, -2.5, 1.2, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_FLOAT_EQ (data_f32[i], CLAMP ((gint) i - 5 + .5, -2.5, 1.2));
+  }
+
+  /* clamp f64 */
+  for (i = 0; i < array_size; i++) {
+    data_f64[i] = (gint) i - 5 + .2;
+  }
+
+  nns_orc_clamp_f64 (data_f64, -1.5, 2.5, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_DOUBLE_EQ (data_f64[i], CLAMP ((gint) i - 5 + .2, -1.5, 2.5));
+  }
+
+  /* standardization f32, abs ((x - average) / std) */
+  for (i = 0; i < array_size; i++) {
+    data_f32[i] = (gint) i - 3 + .1;
+  }
+
+  nns_orc_stand_f32 (data_f32, 1.5, 2.5, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_FLOAT_EQ (data_f32[i], fabs (((gint) i - 3 + .1 - 1.5) / 2.5));
+  }
+
+  /* standardization f64 */
+  for (i = 0; i < array_size; i++) {
+    data_f64[i] = (gint) i - 4 + .3;
+  }
+
+  nns_orc_stand_f64 (data_f64, -0.5, 1.5, array_size);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_DOUBLE_EQ (data_f64[i], fabs (((gint) i - 4 + .3 + 0.5) / 1.5));
+  }
+}
+
+/**
+ * @brief Test for tensor_transform orc functions (convert s8 to other type)
+ */
+TEST (testTensorTransform, orcConvS8)
+{
+  const guint array_size = 10;
+  guint i;
+
+  int8_t data_s8[array_size] = {
+    0,
+  };
+
+  for (i = 0; i < array_size; i++) {
     data_s8[i] = ((int8_t) (i + 1)) * -1;
   }
 
@@ -6841,6 +7456,148 @@ TEST (testDecoderSubplugins, flatbufInvalidParam2_n)
   EXPECT_EQ (GST_FLOW_ERROR, fb_dec->decode (NULL, &config, input, NULL));
 }
 
+/**
+ * @brief Internal function to decode the tensor with image_segment decoder and get RGBA output.
+ */
+static gboolean
+_decode_image_segment (const gchar *mode, const gchar *dim,
+    const gfloat *data, guint num_pixels, guint32 *output)
+{
+  const GstTensorDecoderDef *is_dec;
+  GstTensorsConfig config;
+  GstTensorMemory input;
+  GstBuffer *out_buf;
+  GstCaps *caps;
+  GstMapInfo map;
+  void *pdata = NULL;
+  gboolean ret = FALSE;
+
+  is_dec = nnstreamer_decoder_find ("image_segment");
+  if (!is_dec)
+    return FALSE;
+
+  gst_tensors_config_init (&config);
+  config.rate_n = 0;
+  config.rate_d = 1;
+  config.info.num_tensors = 1;
+  config.info.info[0].type = _NNS_FLOAT32;
+  gst_tensor_parse_dimension (dim, config.info.info[0].dimension);
+
+  input.data = (gpointer) data;
+  input.size = sizeof (gfloat) * gst_tensor_get_element_count (config.info.info[0].dimension);
+
+  is_dec->init (&pdata);
+  is_dec->setOption (&pdata, 0, mode);
+
+  caps = is_dec->getOutCaps (&pdata, &config);
+  if (caps)
+    gst_caps_unref (caps);
+
+  out_buf = gst_buffer_new ();
+  if (is_dec->decode (&pdata, &config, &input, out_buf) == GST_FLOW_OK
+      && gst_buffer_get_size (out_buf) == sizeof (guint32) * num_pixels
+      && gst_buffer_map (out_buf, &map, GST_MAP_READ)) {
+    memcpy (output, map.data, map.size);
+    gst_buffer_unmap (out_buf, &map);
+    ret = TRUE;
+  }
+
+  gst_buffer_unref (out_buf);
+  is_dec->exit (&pdata);
+  gst_tensors_config_free (&config);
+  return ret;
+}
+
+/**
+ * @brief Test for image_segment decoder (snpe-deeplab), compare the result with the per-pixel loop.
+ * The number of pixels is not a multiple of 4, and the large map is processed by multiple jobs.
+ */
+TEST (testDecoderSubplugins, imageSegmentSnpeDeeplab)
+{
+  const guint sizes[2][2] = { { 5, 3 }, { 257, 257 } };
+  const guint max_labels = 20;
+  guint32 color_map[23];
+  guint32 *output;
+  gfloat *data;
+  gchar *dim;
+  guint i, s, w, h, label, num_pixels;
+
+  for (s = 0; s < 2; s++) {
+    w = sizes[s][0];
+    h = sizes[s][1];
+    num_pixels = w * h;
+    ASSERT_NE (num_pixels % 4, 0U);
+
+    /* labels 0 ~ 22, the labels over 20 are out of range */
+    data = (gfloat *) g_malloc (sizeof (gfloat) * num_pixels);
+    output = (guint32 *) g_malloc0 (sizeof (guint32) * num_pixels);
+    for (i = 0; i < num_pixels; i++)
+      data[i] = (gfloat) ((i * 7) % 23);
+
+    dim = g_strdup_printf ("%u:%u:1:1", w, h);
+    EXPECT_TRUE (_decode_image_segment ("snpe-deeplab", dim, data, num_pixels, output));
+    g_free (dim);
+
+    /* the color of each label is not fixed, but the same label has the same color. */
+    memset (color_map, 0, sizeof (color_map));
+
+    for (i = 0; i < num_pixels; i++) {
+      label = (guint) data[i];
+
+      if (label == 0 || label > max_labels) {
+        EXPECT_EQ (output[i], 0U);
+      } else {
+        EXPECT_EQ (output[i] & 0xFF000000U, 0xFF000000U);
+        if (color_map[label] == 0U)
+          color_map[label] = output[i];
+        EXPECT_EQ (output[i], color_map[label]);
+      }
+    }
+
+    g_free (data);
+    g_free (output);
+  }
+}
+
+/**
+ * @brief Test for image_segment decoder (snpe-depth), compare the result with the per-pixel loop.
+ * The number of pixels is not a multiple of 4, and the large map is processed by multiple jobs.
+ */
+TEST (testDecoderSubplugins, imageSegmentSnpeDepth)
+{
+  const guint sizes[2][2] = { { 5, 3 }, { 257, 257 } };
+  guint32 *output;
+  gfloat *data, max_gray;
+  gchar *dim;
+  guint i, s, w, h, gray, num_pixels;
+
+  for (s = 0; s < 2; s++) {
+    w = sizes[s][0];
+    h = sizes[s][1];
+    num_pixels = w * h;
+    ASSERT_NE (num_pixels % 4, 0U);
+
+    /* the max value is at the last pixel, which is in the remaining data of the vector loop */
+    data = (gfloat *) g_malloc (sizeof (gfloat) * num_pixels);
+    output = (guint32 *) g_malloc0 (sizeof (guint32) * num_pixels);
+    for (i = 0; i < num_pixels; i++)
+      data[i] = (gfloat) (i % 97) * 0.37f;
+    data[num_pixels - 1] = max_gray = 100.f;
+
+    dim = g_strdup_printf ("1:%u:%u:1", w, h);
+    EXPECT_TRUE (_decode_image_segment ("snpe-depth", dim, data, num_pixels, output));
+    g_free (dim);
+
+    for (i = 0; i < num_pixels; i++) {
+      gray = (guint) ((data[i] / max_gray) * 255);
+      EXPECT_EQ (output[i], gray * 0x00010101U | 0xFF000000U);
+    }
+
+    g_free (data);
+    g_free (output);
+  }
+}
+
 /**
  * @brief Test for converter subplugins with invalid parameter
  */
@@ -7676,6 +8433,367 @@ TEST (testTensorCrop, infoDelayed_n)
   _crop_test_free (&crop_test);
 }
 
+/**
+ * @brief Test for tensor_crop, the contiguous regions share the raw data.
+ */
+TEST (testTensorCrop, cropContiguous)
+{
+  crop_test_data_s crop_test;
+  GstTensorsConfig config;
+  GstBuffer *raw_buf, *out_buf;
+  GstMemory *mem;
+  GstMapInfo map;
+  GstTensorMetaInfo meta;
+  gsize hsize;
+  guint i;
+  guint *_data, *_info, *cropped;
+
+  _crop_test_init (&crop_test);
+
+  crop_test.raw_format = _NNS_TENSOR_FORMAT_FLEXIBLE;
+  crop_test.raw_info.type = _NNS_UINT32;
+  gst_tensor_parse_dimension ("1:10:4:1", crop_test.raw_info.dimension);
+
+  crop_test.raw_size = sizeof (guint) * 40U;
+  crop_test.raw_data = g_malloc0 (crop_test.raw_size);
+  _data = (guint *) crop_test.raw_data;
+
+  for (i = 0; i < 40; i++)
+    _data[i] = i + 1;
+
+  crop_test.info_type = _NNS_UINT32;
+  crop_test.info_size = sizeof (guint) * 8U;
+  crop_test.info_num = 2U;
+  crop_test.info_data = g_malloc0 (crop_test.info_size);
+  _info = (guint *) crop_test.info_data;
+
+  /* crop info (full frame [0, 0, 10, 4] and full-width rows [0, 1, 10, 2]) */
+  _info[0] = 0U;
+  _info[1] = 0U;
+  _info[2] = 10U;
+  _info[3] = 4U;
+  _info[4] = 0U;
+  _info[5] = 1U;
+  _info[6] = 10U;
+  _info[7] = 2U;
+
+  /* caps for raw data */
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1;
+  config.info.info[0] = crop_test.raw_info;
+  config.info.format = crop_test.raw_format;
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (crop_test.raw_q, gst_tensors_caps_from_config (&config));
+
+  /* push raw buffer, the header in front of the data is same as the header of the cropped full frame. */
+  gst_tensor_info_convert_to_meta (&crop_test.raw_info, &meta);
+  meta.format = _NNS_TENSOR_FORMAT_FLEXIBLE;
+  mem = gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY, crop_test.raw_data,
+      crop_test.raw_size, 0, crop_test.raw_size, NULL, NULL);
+  raw_buf = gst_buffer_new ();
+  gst_buffer_append_memory (raw_buf, gst_tensor_meta_info_append_header (&meta, mem));
+  gst_memory_unref (mem);
+  EXPECT_EQ (gst_harness_push (crop_test.raw_q, raw_buf), GST_FLOW_OK);
+
+  _crop_test_push_info_buffer (&crop_test, crop_test.ts_info);
+
+  crop_test.received = _harness_wait_for_output_buffer (crop_test.crop, 1U);
+  EXPECT_EQ (crop_test.received, 1U);
+
+  if (crop_test.received > 0) {
+    out_buf = gst_harness_pull (crop_test.crop);
+    ASSERT_EQ (gst_buffer_n_memory (out_buf), 2U);
+
+    /* full frame, the header is same, so the raw memory is shared. */
+    mem = gst_buffer_peek_memory (out_buf, 0);
+    EXPECT_TRUE (mem->parent != NULL);
+    ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READ));
+
+    gst_tensor_meta_info_parse_header (&meta, map.data);
+    EXPECT_EQ (meta.dimension[0], 1U);
+    EXPECT_EQ (meta.dimension[1], 10U);
+    EXPECT_EQ (meta.dimension[2], 4U);
+
+    hsize = gst_tensor_meta_info_get_header_size (&meta);
+    cropped = (guint *) (map.data + hsize);
+    EXPECT_EQ (map.size - hsize, sizeof (guint) * 40U);
+    for (i = 0; i < 40; i++)
+      EXPECT_EQ (cropped[i], i + 1);
+
+    gst_memory_unmap (mem, &map);
+
+    /* full-width rows, expected [11, 12, ..., 30] */
+    mem = gst_buffer_peek_memory (out_buf, 1);
+    ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READ));
+
+    gst_tensor_meta_info_parse_header (&meta, map.data);
+    EXPECT_EQ (meta.dimension[0], 1U);
+    EXPECT_EQ (meta.dimension[1], 10U);
+    EXPECT_EQ (meta.dimension[2], 2U);
+
+    hsize = gst_tensor_meta_info_get_header_size (&meta);
+    cropped = (guint *) (map.data + hsize);
+    EXPECT_EQ (map.size - hsize, sizeof (guint) * 20U);
+    for (i = 0; i < 20; i++)
+      EXPECT_EQ (cropped[i], i + 11U);
+
+    gst_memory_unmap (mem, &map);
+    gst_buffer_unref (out_buf);
+  }
+
+  _crop_test_free (&crop_test);
+}
+
+/**
+ * @brief Test for tensor_crop, properties for roi-resize mode.
+ */
+TEST (testTensorCrop, propertyRoiResize)
+{
+  crop_test_data_s crop_test;
+  gint mode;
+  gchar *str = NULL;
+
+  _crop_test_init (&crop_test);
+
+  g_object_get (crop_test.crop->element, "mode", &mode, "roi-size", &str, NULL);
+  EXPECT_EQ (mode, 0);
+  EXPECT_STREQ (str, "");
+  g_free (str);
+
+  gst_util_set_object_arg (G_OBJECT (crop_test.crop->element), "mode", "roi-resize");
+  g_object_set (crop_test.crop->element, "roi-size", "224:160", NULL);
+  g_object_get (crop_test.crop->element, "mode", &mode, "roi-size", &str, NULL);
+  EXPECT_EQ (mode, 1);
+  EXPECT_STREQ (str, "224:160");
+  g_free (str);
+
+  /* invalid size */
+  g_object_set (crop_test.crop->element, "roi-size", "224", NULL);
+  g_object_get (crop_test.crop->element, "roi-size", &str, NULL);
+  EXPECT_STREQ (str, "");
+  g_free (str);
+
+  g_object_set (crop_test.crop->element, "roi-size", "0:10", NULL);
+  g_object_get (crop_test.crop->element, "roi-size", &str, NULL);
+  EXPECT_STREQ (str, "");
+  g_free (str);
+
+  _crop_test_free (&crop_test);
+}
+
+/**
+ * @brief Test for tensor_crop, crop and resize the regions into a batched tensor.
+ * raw buffer float32 [1, 2, ..., 40] dimension 1:10:4:1
+ * info buffer uint32 [0, 0, 10, 4] [2, 0, 1, 1] [20, 0, 3, 3]
+ */
+TEST (testTensorCrop, roiResize)
+{
+  crop_test_data_s crop_test;
+  GstBuffer *out_buf;
+  GstMemory *mem;
+  GstMapInfo map;
+  GstTensorMetaInfo meta;
+  gsize hsize;
+  guint i, x, y;
+  gfloat *_data, *resized;
+  guint *_info;
+
+  _crop_test_init (&crop_test);
+
+  gst_util_set_object_arg (G_OBJECT (crop_test.crop->element), "mode", "roi-resize");
+  g_object_set (crop_test.crop->element, "roi-size", "5:2", NULL);
+
+  crop_test.raw_info.type = _NNS_FLOAT32;
+  gst_tensor_parse_dimension ("1:10:4:1", crop_test.raw_info.dimension);
+
+  crop_test.raw_size = sizeof (gfloat) * 40U;
+  crop_test.raw_data = g_malloc0 (crop_test.raw_size);
+  _data = (gfloat *) crop_test.raw_data;
+
+  for (i = 0; i < 40; i++)
+    _data[i] = (gfloat) (i + 1);
+
+  crop_test.info_type = _NNS_UINT32;
+  crop_test.info_size = sizeof (guint) * 12U;
+  crop_test.info_num = 3U;
+  crop_test.info_data = g_malloc0 (crop_test.info_size);
+  _info = (guint *) crop_test.info_data;
+
+  /* full frame, single element and out of range */
+  _info[0] = 0U;
+  _info[1] = 0U;
+  _info[2] = 10U;
+  _info[3] = 4U;
+  _info[4] = 2U;
+  _info[5] = 0U;
+  _info[6] = 1U;
+  _info[7] = 1U;
+  _info[8] = 20U;
+  _info[9] = 0U;
+  _info[10] = 3U;
+  _info[11] = 3U;
+
+  _crop_test_push_buffer (&crop_test);
+  EXPECT_EQ (crop_test.received, 1U);
+
+  if (crop_test.received > 0) {
+    out_buf = gst_harness_pull (crop_test.crop);
+    ASSERT_EQ (gst_buffer_n_memory (out_buf), 1U);
+
+    mem = gst_buffer_peek_memory (out_buf, 0);
+    ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READ));
+
+    gst_tensor_meta_info_parse_header (&meta, map.data);
+    EXPECT_EQ (meta.type, _NNS_FLOAT32);
+    EXPECT_EQ (meta.dimension[0], 1U);
+    EXPECT_EQ (meta.dimension[1], 5U);
+    EXPECT_EQ (meta.dimension[2], 2U);
+    EXPECT_EQ (meta.dimension[3], 3U);
+
+    hsize = gst_tensor_meta_info_get_header_size (&meta);
+    resized = (gfloat *) (map.data + hsize);
+    EXPECT_EQ (map.size - hsize, sizeof (gfloat) * 30U);
+
+    /* downscaled by 2, the average of 2x2 elements */
+    for (y = 0; y < 2U; y++) {
+      for (x = 0; x < 5U; x++)
+        EXPECT_FLOAT_EQ (resized[y * 5 + x], 20.f * y + 2.f * x + 6.5f);
+    }
+
+    /* upscaled single element */
+    for (i = 10; i < 20; i++)
+      EXPECT_FLOAT_EQ (resized[i], 3.f);
+
+    /* empty region */
+    for (i = 20; i < 30; i++)
+      EXPECT_FLOAT_EQ (resized[i], 0.f);
+
+    gst_memory_unmap (mem, &map);
+    gst_buffer_unref (out_buf);
+  }
+
+  _crop_test_free (&crop_test);
+}
+
+/**
+ * @brief Test for tensor_crop, roi-resize mode with the huge size of regions, the regions are clamped without overflow.
+ * raw buffer float32 [1, 2, ..., 40] dimension 1:10:4:1
+ * info buffer uint32 [2, 1, MAX, MAX] [9, 3, MAX, MAX]
+ */
+TEST (testTensorCrop, roiResizeHugeSize)
+{
+  crop_test_data_s crop_test;
+  GstBuffer *out_buf;
+  GstMemory *mem;
+  GstMapInfo map;
+  GstTensorMetaInfo meta;
+  gsize hsize;
+  guint i, x, y;
+  gfloat *_data, *resized;
+  guint *_info;
+
+  _crop_test_init (&crop_test);
+
+  gst_util_set_object_arg (G_OBJECT (crop_test.crop->element), "mode", "roi-resize");
+  g_object_set (crop_test.crop->element, "roi-size", "8:3", NULL);
+
+  crop_test.raw_info.type = _NNS_FLOAT32;
+  gst_tensor_parse_dimension ("1:10:4:1", crop_test.raw_info.dimension);
+
+  crop_test.raw_size = sizeof (gfloat) * 40U;
+  crop_test.raw_data = g_malloc0 (crop_test.raw_size);
+  _data = (gfloat *) crop_test.raw_data;
+
+  for (i = 0; i < 40; i++)
+    _data[i] = (gfloat) (i + 1);
+
+  crop_test.info_type = _NNS_UINT32;
+  crop_test.info_size = sizeof (guint) * 8U;
+  crop_test.info_num = 2U;
+  crop_test.info_data = g_malloc0 (crop_test.info_size);
+  _info = (guint *) crop_test.info_data;
+
+  /* the position plus the size overflows */
+  _info[0] = 2U;
+  _info[1] = 1U;
+  _info[2] = G_MAXUINT;
+  _info[3] = G_MAXUINT;
+  _info[4] = 9U;
+  _info[5] = 3U;
+  _info[6] = G_MAXUINT;
+  _info[7] = G_MAXUINT;
+
+  _crop_test_push_buffer (&crop_test);
+  EXPECT_EQ (crop_test.received, 1U);
+
+  if (crop_test.received > 0) {
+    out_buf = gst_harness_pull (crop_test.crop);
+    ASSERT_EQ (gst_buffer_n_memory (out_buf), 1U);
+
+    mem = gst_buffer_peek_memory (out_buf, 0);
+    ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READ));
+
+    gst_tensor_meta_info_parse_header (&meta, map.data);
+    EXPECT_EQ (meta.dimension[1], 8U);
+    EXPECT_EQ (meta.dimension[2], 3U);
+    EXPECT_EQ (meta.dimension[3], 2U);
+
+    hsize = gst_tensor_meta_info_get_header_size (&meta);
+    resized = (gfloat *) (map.data + hsize);
+    EXPECT_EQ (map.size - hsize, sizeof (gfloat) * 48U);
+
+    /* clamped to [2, 1, 8, 3], same size as roi-size */
+    for (y = 0; y < 3U; y++) {
+      for (x = 0; x < 8U; x++)
+        EXPECT_FLOAT_EQ (resized[y * 8 + x], 10.f * (y + 1) + (x + 2) + 1.f);
+    }
+
+    /* clamped to the last element [9, 3, 1, 1] */
+    for (i = 24; i < 48; i++)
+      EXPECT_FLOAT_EQ (resized[i], 40.f);
+
+    gst_memory_unmap (mem, &map);
+    gst_buffer_unref (out_buf);
+  }
+
+  _crop_test_free (&crop_test);
+}
+
+/**
+ * @brief Test for tensor_crop, roi-resize mode without roi-size.
+ */
+TEST (testTensorCrop, roiResizeNoSize_n)
+{
+  crop_test_data_s crop_test;
+  guint *_info;
+
+  _crop_test_init (&crop_test);
+
+  gst_util_set_object_arg (G_OBJECT (crop_test.crop->element), "mode", "roi-resize");
+
+  crop_test.raw_info.type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("3:10:4:1", crop_test.raw_info.dimension);
+
+  crop_test.raw_size = 120U;
+  crop_test.raw_data = g_malloc0 (crop_test.raw_size);
+
+  crop_test.info_type = _NNS_UINT32;
+  crop_test.info_size = sizeof (guint) * 4U;
+  crop_test.info_num = 1U;
+  crop_test.info_data = g_malloc0 (crop_test.info_size);
+  _info = (guint *) crop_test.info_data;
+  _info[2] = 2U;
+  _info[3] = 2U;
+
+  /* not negotiated, no result buffer. */
+  _crop_test_push_buffer (&crop_test);
+  EXPECT_EQ (crop_test.received, 0U);
+
+  _crop_test_free (&crop_test);
+}
+
 /**
  * @brief Macro to test sparse tensor conversion for each data type.
  */
@@ -7853,6 +8971,43 @@ TEST (testTensorSparse, decInvalidProperty_n)
   gst_harness_teardown (h);
 }
 
+/**
+ * @brief Test for tensor_reposink with drop-oldest policy, the oldest buffers are dropped when the slot is full.
+ */
+TEST (testTensorRepo, dropOldest)
+{
+  GstHarness *h;
+  GstBuffer *buf;
+  guint b, level, max_level;
+  guint64 dropped;
+
+  h = gst_harness_new_parse (
+      "tensor_reposink slot-index=100 depth=2 policy=drop-oldest sync=false");
+  gst_harness_set_src_caps_str (h, "other/tensors,num_tensors=1,types=uint8,dimensions=4:1:1:1,format=static,framerate=(fraction)0/1");
+
+  /* nothing is pushed yet */
+  g_object_get (h->element, "current-level", &level, "max-level", &max_level,
+      "dropped", &dropped, NULL);
+  EXPECT_EQ (level, 0U);
+  EXPECT_EQ (max_level, 0U);
+  EXPECT_EQ (dropped, 0ULL);
+
+  /* no tensor_reposrc pops the buffers, the slot keeps the latest 2 buffers */
+  for (b = 0; b < 5; b++) {
+    buf = gst_harness_create_buffer (h, 4);
+    gst_buffer_memset (buf, 0, (guint8) b, 4);
+    EXPECT_EQ (gst_harness_push (h, buf), GST_FLOW_OK);
+  }
+
+  g_object_get (h->element, "current-level", &level, "max-level", &max_level,
+      "dropped", &dropped, NULL);
+  EXPECT_EQ (level, 2U);
+  EXPECT_EQ (max_level, 2U);
+  EXPECT_EQ (dropped, 3ULL);
+
+  gst_harness_teardown (h);
+}
+
 /**
  * @brief Main function for unit test.
  */
@@ -126,6 +126,20 @@ callCompareTest testsequence_8.golden testsequence04_8.log 4-8 "Compare 4-8" 1 0
 callCompareTest testsequence_9.golden testsequence04_9.log 4-9 "Compare 4-9" 1 0
 callCompareTest testsequence_10.golden testsequence04_10.log 4-10 "Compare 4-10" 1 0
 
+# Multiple buffers in a slot
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} multifilesrc location=testsequence_%1d.png index=0 caps=\"image/png,framerate=(fraction)3/1\" ! pngdec ! tensor_converter ! queue ! tensor_reposink silent=false slot-index=0 depth=4 policy=block tensor_reposrc silent=false slot-index=0 caps=\"other/tensor,dimension=(string)3:16:16:1,type=(string)uint8,framerate=(fraction)3/1\" ! multifilesink location=testsequence05_%1d.log" 5 0 0 $PERFORMANCE
+
+callCompareTest testsequence_1.golden testsequence05_1.log 5-1 "Compare 5-1" 1 0
+callCompareTest testsequence_2.golden testsequence05_2.log 5-2 "Compare 5-2" 1 0
+callCompareTest testsequence_3.golden testsequence05_3.log 5-3 "Compare 5-3" 1 0
+callCompareTest testsequence_4.golden testsequence05_4.log 5-4 "Compare 5-4" 1 0
+callCompareTest testsequence_5.golden testsequence05_5.log 5-5 "Compare 5-5" 1 0
+callCompareTest testsequence_6.golden testsequence05_6.log 5-6 "Compare 5-6" 1 0
+callCompareTest testsequence_7.golden testsequence05_7.log 5-7 "Compare 5-7" 1 0
+callCompareTest testsequence_8.golden testsequence05_8.log 5-8 "Compare 5-8" 1 0
+callCompareTest testsequence_9.golden testsequence05_9.log 5-9 "Compare 5-9" 1 0
+callCompareTest testsequence_10.golden testsequence05_10.log 5-10 "Compare 5-10" 1 0
+
 rm *.log *.bmp *.png *.golden *.raw *.dat
 
 report